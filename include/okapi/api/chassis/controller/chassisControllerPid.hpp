@@ -8,11 +8,13 @@
 #include "okapi/api/chassis/controller/chassisController.hpp"
 #include "okapi/api/control/iterative/iterativePosPidController.hpp"
 #include "okapi/api/util/abstractRate.hpp"
+#include "okapi/api/util/controlExecutor.hpp"
 #include "okapi/api/util/logging.hpp"
 #include "okapi/api/util/timeUtil.hpp"
 #include <atomic>
 #include <memory>
 #include <tuple>
+#include <valarray>
 
 namespace okapi {
 class ChassisControllerPID : public ChassisController {
@@ -187,16 +189,36 @@ class ChassisControllerPID : public ChassisController {
              IterativePosPIDController::Gains>
   getGains() const;
 
+  /**
+   * Records every step of the distance, turn, and angle controllers into a TelemetrySink. Each
+   * controller records into its own channel, named by adding `distance`, `turn`, or `angle` to the
+   * prefix.
+   *
+   * @param isink The sink, or `nullptr` to stop recording.
+   * @param ichannelPrefix The prefix of the channel names.
+   */
+  void setTelemetry(const std::shared_ptr<TelemetrySink> &isink,
+                    const std::string &ichannelPrefix = "ChassisControllerPID/");
+
   /**
    * Starts the internal thread. This method is called by the ChassisControllerBuilder when making a
    * new instance of this class.
    */
   void startThread();
 
+  /**
+   * Runs the control loop from a ControlExecutor instead of its own task. Call this instead of
+   * startThread().
+   *
+   * @param iexecutor The executor to run the control loop from.
+   */
+  void startOnExecutor(const std::shared_ptr<ControlExecutor> &iexecutor);
+
   /**
    * Returns the underlying thread handle.
    *
-   * @return The underlying thread handle.
+   * @return The underlying thread handle, or `nullptr` if the control loop runs from a
+   * ControlExecutor.
    */
   CrossplatformThread *getThread() const;
 
@@ -248,6 +270,11 @@ class ChassisControllerPID : public ChassisController {
   static void trampoline(void *context);
   void loop();
 
+  /**
+   * Steps the controllers for the current movement once and drives the chassis.
+   */
+  void stepMovement();
+
   /**
    * Wait for the distance setup (distancePid and anglePid) to settle.
    *
@@ -270,6 +297,12 @@ class ChassisControllerPID : public ChassisController {
   typedef enum { distance, angle, none } modeType;
   modeType mode{none};
 
+  // The state of the control loop between steps
+  modeType pastMode{none};
+  std::valarray<std::int32_t> encStartVals;
+
   CrossplatformThread *task{nullptr};
+  std::shared_ptr<ControlExecutor> executor;
+  std::uint32_t executorLoopId{0};
 };
 } // namespace okapi
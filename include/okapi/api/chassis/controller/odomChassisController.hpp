@@ -12,6 +12,7 @@
 #include "okapi/api/odometry/point.hpp"
 #include "okapi/api/units/QSpeed.hpp"
 #include "okapi/api/util/abstractRate.hpp"
+#include "okapi/api/util/controlExecutor.hpp"
 #include "okapi/api/util/logging.hpp"
 #include "okapi/api/util/timeUtil.hpp"
 #include <atomic>
@@ -127,6 +128,15 @@ class OdomChassisController : public ChassisController {
    */
   void startOdomThread();
 
+  /**
+   * Steps the odometry from a ControlExecutor instead of its own task. Call this instead of
+   * startOdomThread(). Add the odometry to the executor before the controllers which read it so it
+   * steps first whenever they are due at the same time.
+   *
+   * @param iexecutor The executor to step the odometry from.
+   */
+  void startOdomOnExecutor(const std::shared_ptr<ControlExecutor> &iexecutor);
+
   /**
    * @return The underlying thread handle.
    */
@@ -144,6 +154,8 @@ class OdomChassisController : public ChassisController {
   QAngle turnThreshold;
   std::shared_ptr<Odometry> odom;
   CrossplatformThread *odomTask{nullptr};
+  std::shared_ptr<ControlExecutor> executor;
+  std::uint32_t executorLoopId{0};
   std::atomic_bool dtorCalled{false};
   StateMode defaultStateMode{StateMode::FRAME_TRANSFORMATION};
   std::atomic_bool odomTaskRunning{false};
@@ -6,6 +6,9 @@
 #pragma once
 
 #include "okapi/api/control/async/asyncPositionController.hpp"
+#include "okapi/api/control/util/linearPath.hpp"
+#include "okapi/api/control/util/linearProfile.hpp"
+#include "okapi/api/control/util/pathTable.hpp"
 #include "okapi/api/control/util/pathfinderUtil.hpp"
 #include "okapi/api/device/motor/abstractMotor.hpp"
 #include "okapi/api/units/QAngularSpeed.hpp"
@@ -13,7 +16,7 @@
 #include "okapi/api/util/logging.hpp"
 #include "okapi/api/util/timeUtil.hpp"
 #include <atomic>
-#include <map>
+#include <optional>
 
 #include "squiggles.hpp"
 
@@ -55,8 +58,9 @@ class AsyncLinearMotionProfileController : public AsyncPositionController<std::s
    *
    * @param iwaypoints The waypoints to hit on the path.
    * @param ipathId A unique identifier to save the path with.
+   * @return The handle of the path, or an invalid handle if no path was generated.
    */
-  void generatePath(std::initializer_list<QLength> iwaypoints, const std::string &ipathId);
+  PathHandle generatePath(std::initializer_list<QLength> iwaypoints, const std::string &ipathId);
 
   /**
    * Generates a path which intersects the given waypoints and saves it internally with a key of
@@ -69,10 +73,47 @@ class AsyncLinearMotionProfileController : public AsyncPositionController<std::s
    * @param iwaypoints The waypoints to hit on the path.
    * @param ipathId A unique identifier to save the path with.
    * @param ilimits The limits to use for this path only.
+   * @return The handle of the path, or an invalid handle if no path was generated.
    */
-  void generatePath(std::initializer_list<QLength> iwaypoints,
-                    const std::string &ipathId,
-                    const PathfinderLimits &ilimits);
+  PathHandle generatePath(std::initializer_list<QLength> iwaypoints,
+                          const std::string &ipathId,
+                          const PathfinderLimits &ilimits);
+
+  /**
+   * Generates a closed-form profile from one position to another and saves it internally with a
+   * key of pathId. Call `setTarget()` with the same pathId to run it. A closed-form profile is
+   * built in constant time and stores no points, so it is ready as soon as this returns. Paths
+   * generated with `generatePath()` are still supported and can be saved alongside these.
+   *
+   * @param istart The starting position.
+   * @param iend The ending position.
+   * @param ipathId A unique identifier to save the path with.
+   * @param ishape The shape of the profile.
+   * @return The handle of the path.
+   */
+  PathHandle generateAnalyticPath(const QLength &istart,
+                                  const QLength &iend,
+                                  const std::string &ipathId,
+                                  LinearProfileShape ishape = LinearProfileShape::sCurve);
+
+  /**
+   * Generates a closed-form profile from one position to another and saves it internally with a
+   * key of pathId. Call `setTarget()` with the same pathId to run it. A closed-form profile is
+   * built in constant time and stores no points, so it is ready as soon as this returns. Paths
+   * generated with `generatePath()` are still supported and can be saved alongside these.
+   *
+   * @param istart The starting position.
+   * @param iend The ending position.
+   * @param ipathId A unique identifier to save the path with.
+   * @param ilimits The limits to use for this path only.
+   * @param ishape The shape of the profile.
+   * @return The handle of the path.
+   */
+  PathHandle generateAnalyticPath(const QLength &istart,
+                                  const QLength &iend,
+                                  const std::string &ipathId,
+                                  const PathfinderLimits &ilimits,
+                                  LinearProfileShape ishape = LinearProfileShape::sCurve);
 
   /**
    * Removes a path and frees the memory it used. This function returns `true` if the path was
@@ -84,6 +125,26 @@ class AsyncLinearMotionProfileController : public AsyncPositionController<std::s
    */
   bool removePath(const std::string &ipathId);
 
+  /**
+   * Removes a path and frees the memory it used. This function returns `true` if the path was
+   * either deleted or didn't exist in the first place. It returns `false` if the path could not be
+   * removed because it is running. The handle stays valid and refers to the same ID.
+   *
+   * @param ipath The handle of the path, previously returned by `generatePath()`.
+   * @return `true` if the path no longer exists
+   */
+  bool removePath(PathHandle ipath);
+
+  /**
+   * Gets the handle of a path ID. Once a path has been generated with the ID, the handle stays
+   * valid for the life of this controller, so it can be looked up once and used to start the path
+   * without any string work.
+   *
+   * @param ipathId A unique identifier for the path.
+   * @return The handle of the path, or an invalid handle if no path was ever saved with the ID.
+   */
+  PathHandle getPathHandle(const std::string &ipathId);
+
   /**
    * Gets the identifiers of all paths saved in this `AsyncMotionProfileController`.
    *
@@ -108,6 +169,17 @@ class AsyncLinearMotionProfileController : public AsyncPositionController<std::s
    */
   void setTarget(std::string ipathId, bool ibackwards);
 
+  /**
+   * Executes the path with the given handle. This doesn't look up or copy the path ID. If there is
+   * no path saved with the handle, the method will return. Any targets set while a path is being
+   * followed will be ignored.
+   *
+   * @param ipath The handle of the path, previously returned by `generatePath()` or
+   * `getPathHandle()`.
+   * @param ibackwards Whether to follow the profile backwards.
+   */
+  void setTarget(PathHandle ipath, bool ibackwards = false);
+
   /**
    * Writes the value of the controller output. This method might be automatically called in another
    * thread by the controller.
@@ -167,6 +239,39 @@ class AsyncLinearMotionProfileController : public AsyncPositionController<std::s
               const PathfinderLimits &ilimits,
               bool ibackwards = false);
 
+  /**
+   * Sets how `moveTo()` generates its path. If a shape is given, `moveTo()` uses a closed-form
+   * profile of that shape (see `generateAnalyticPath()`), which starts moving without waiting for
+   * a path to generate. Otherwise, it generates a path with `generatePath()`. The default is to use
+   * `generatePath()`.
+   *
+   * @param ishape The shape of the profile, or `std::nullopt` to use `generatePath()`.
+   */
+  void setMoveToShape(std::optional<LinearProfileShape> ishape);
+
+  /**
+   * @return The shape of the profile `moveTo()` uses, or `std::nullopt` if it uses
+   * `generatePath()`.
+   */
+  std::optional<LinearProfileShape> getMoveToShape() const;
+
+  /**
+   * Sets the actuation latency of the output: how long after a command is sent the motors start
+   * to apply it. The follower sends the command for the time one latency ahead of now, so the
+   * motors apply each command when the profile wants it. Use LatencyEstimator to find the latency
+   * from logged commands and measurements. The default is no latency. This takes effect the next
+   * time a path starts. If the latency is negative, an instance of `std::invalid_argument` is
+   * thrown.
+   *
+   * @param ilatency The actuation latency.
+   */
+  void setActuationLatency(QTime ilatency);
+
+  /**
+   * @return The actuation latency the follower compensates for.
+   */
+  QTime getActuationLatency() const;
+
   /**
    * Returns the last error of the controller. Does not update when disabled. Returns zero if there
    * is no path currently being followed.
@@ -247,20 +352,36 @@ class AsyncLinearMotionProfileController : public AsyncPositionController<std::s
    */
   void forceRemovePath(const std::string &ipathId);
 
+  /**
+   * Attempts to remove a path without stopping execution, then if that fails, disables the
+   * controller and removes the path.
+   *
+   * @param ipath The handle of the path that will be removed
+   */
+  void forceRemovePath(PathHandle ipath);
+
   protected:
   std::shared_ptr<Logger> logger;
-  std::map<std::string, std::vector<squiggles::ProfilePoint>> paths{};
+  // Immutable path snapshots. Must be locked with currentPathMutex when accessing the table, but
+  // not when reading a path, because the follower holds its own reference to the path it is
+  // following.
+  BasicPathTable<LinearPath> paths{};
   PathfinderLimits limits;
   std::shared_ptr<ControllerOutput<double>> output;
   QLength diameter;
   AbstractMotor::GearsetRatioPair pair;
-  double currentProfilePosition{0};
+  std::atomic<double> currentProfilePosition{0};
   TimeUtil timeUtil;
 
-  // This must be locked when accessing the current path
-  CrossplatformMutex currentPathMutex;
+  // This must be locked when accessing paths, currentPath, moveToShape, or actuationLatency. It is
+  // never locked while following a path.
+  mutable CrossplatformMutex currentPathMutex;
 
-  std::string currentPath{""};
+  PathHandle currentPath{};
+  std::string missingTargetId{}; // The target when it was set to an ID which has no path
+  PathHandle moveToPath{}; // The slot moveTo() generates its paths into
+  std::optional<LinearProfileShape> moveToShape{};
+  QTime actuationLatency{0_ms};
   std::atomic_bool isRunning{false};
   std::atomic_int direction{1};
   std::atomic_bool disabled{false};
@@ -271,11 +392,27 @@ class AsyncLinearMotionProfileController : public AsyncPositionController<std::s
   void loop();
 
   /**
-   * Follow the supplied path. Must follow the disabled lifecycle.
+   * Follow the supplied path. Must follow the disabled lifecycle. The caller keeps the path alive
+   * until this returns, so no locking is needed to read it.
    */
   virtual void executeSinglePath(const std::vector<squiggles::ProfilePoint> &path,
                                  std::unique_ptr<AbstractRate> rate);
 
+  /**
+   * Follow the supplied closed-form profile, sampling it at the time elapsed since the start of
+   * the profile. Must follow the disabled lifecycle. The caller keeps the profile alive until this
+   * returns, so no locking is needed to read it.
+   */
+  virtual void executeAnalyticPath(const LinearProfile &profile,
+                                   std::unique_ptr<AbstractRate> rate);
+
+  /**
+   * Sets the output to follow a velocity.
+   *
+   * @param ivelocity The velocity in m/s.
+   */
+  void sendVelocity(double ivelocity);
+
   /**
    * Converts linear "chassis" speed to rotational motor speed.
    *
@@ -284,8 +421,45 @@ class AsyncLinearMotionProfileController : public AsyncPositionController<std::s
    */
   QAngularSpeed convertLinearToRotational(QSpeed linear) const;
 
+  /**
+   * @param ipathId The path ID.
+   * @return The saved path, or `nullptr` if there is no path with this ID.
+   */
+  LinearPathPtr findPath(const std::string &ipathId) const;
+
+  /**
+   * @param ipath The handle of the path.
+   * @return The saved path, or `nullptr` if there is no path with this handle.
+   */
+  LinearPathPtr findPath(PathHandle ipath) const;
+
+  /**
+   * @param ipath The handle of the path.
+   * @return The ID of the path, or an empty string if the handle is invalid.
+   */
+  const std::string &getPathName(PathHandle ipath) const;
+
+  /**
+   * Gets the handle of a path ID, adding a slot for the ID if there is none. Only used when a path
+   * is saved, so looking up an unknown ID never grows the path table.
+   *
+   * @param ipathId A unique identifier for the path.
+   * @return The handle of the path.
+   */
+  PathHandle internPath(const std::string &ipathId);
+
+  /**
+   * Saves a path, replacing any path which already has the same handle.
+   *
+   * @param ipath The handle to save the path with.
+   * @param isnapshot The path.
+   */
+  void publishPath(PathHandle ipath, LinearPathPtr isnapshot);
+
   std::string getPathErrorMessage(const std::vector<PathfinderPoint> &points,
                                   const std::string &ipathId,
                                   int length);
+
+  static constexpr double DT = 0.01;
 };
 } // namespace okapi
@@ -8,14 +8,34 @@
 #include "okapi/api/chassis/controller/chassisScales.hpp"
 #include "okapi/api/chassis/model/skidSteerModel.hpp"
 #include "okapi/api/control/async/asyncPositionController.hpp"
+#include "okapi/api/control/util/binaryPathFormat.hpp"
+#include "okapi/api/control/util/feedforwardGains.hpp"
+#include "okapi/api/control/util/followStatistics.hpp"
+#include "okapi/api/control/util/pathBatch.hpp"
+#include "okapi/api/control/util/pathCache.hpp"
+#include "okapi/api/control/util/pathCompiler.hpp"
+#include "okapi/api/control/util/pathGenerationHandle.hpp"
+#include "okapi/api/control/util/pathTable.hpp"
+#include "okapi/api/control/util/pathTransform.hpp"
+#include "okapi/api/control/util/pathView.hpp"
+#include "okapi/api/control/util/splineProfile.hpp"
 #include "okapi/api/control/util/pathfinderUtil.hpp"
+#include "okapi/api/control/util/ramsete.hpp"
+#include "okapi/api/control/util/storedPath.hpp"
+#include "okapi/api/control/util/streamingPath.hpp"
+#include "okapi/api/control/util/trajectoryGenerator.hpp"
+#include "okapi/api/odometry/odometry.hpp"
 #include "okapi/api/units/QAngularSpeed.hpp"
 #include "okapi/api/units/QSpeed.hpp"
 #include "okapi/api/util/logging.hpp"
 #include "okapi/api/util/timeUtil.hpp"
+#include "okapi/api/util/workerPool.hpp"
 #include <atomic>
+#include <deque>
 #include <iostream>
 #include <map>
+#include <optional>
+#include <valarray>
 
 #include "squiggles.hpp"
 
@@ -56,8 +76,10 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
    *
    * @param iwaypoints The waypoints to hit on the path.
    * @param ipathId A unique identifier to save the path with.
+   * @return The handle of the path, or an invalid handle if there were no waypoints.
    */
-  void generatePath(std::initializer_list<PathfinderPoint> iwaypoints, const std::string &ipathId);
+  PathHandle generatePath(std::initializer_list<PathfinderPoint> iwaypoints,
+                          const std::string &ipathId);
 
   /**
    * Generates a path which intersects the given waypoints and saves it internally with a key of
@@ -74,11 +96,159 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
    * @param iwaypoints The waypoints to hit on the path.
    * @param ipathId A unique identifier to save the path with.
    * @param ilimits The limits to use for this path only.
+   * @return The handle of the path, or an invalid handle if there were no waypoints.
    */
-  void generatePath(std::initializer_list<PathfinderPoint> iwaypoints,
+  PathHandle generatePath(std::initializer_list<PathfinderPoint> iwaypoints,
+                          const std::string &ipathId,
+                          const PathfinderLimits &ilimits);
+
+  /**
+   * Generates a chain of paths which are meant to be followed back to back with `queuePaths()`.
+   * Each path may be written in its own frame, for example starting from the origin; only the
+   * length of each path is used to plan the velocities between them. The velocity where two paths
+   * meet is the same at the end of the first path and the start of the next one, so the robot does
+   * not stop between them. The chain starts and ends at rest. The velocities are chosen the same
+   * way as for streamed paths (see `setMoveToStreaming()`).
+   *
+   * Throws a `std::invalid_argument` if the number of paths and IDs differ or if a path has fewer
+   * than two waypoints. Throws a `std::runtime_error` if a path is impossible to achieve; the paths
+   * before it are saved.
+   *
+   * @param ipaths The waypoints of each path.
+   * @param ipathIds The IDs to save the paths with, one per path.
+   */
+  void generatePathChain(const std::vector<std::vector<PathfinderPoint>> &ipaths,
+                         const std::vector<std::string> &ipathIds);
+
+  /**
+   * Generates a chain of paths which are meant to be followed back to back with `queuePaths()`.
+   * See `generatePathChain()`.
+   *
+   * @param ipaths The waypoints of each path.
+   * @param ipathIds The IDs to save the paths with, one per path.
+   * @param ilimits The limits to use for these paths only.
+   */
+  void generatePathChain(const std::vector<std::vector<PathfinderPoint>> &ipaths,
+                         const std::vector<std::string> &ipathIds,
+                         const PathfinderLimits &ilimits);
+
+  /**
+   * Generates a path in the background and saves it internally with a key of pathId once it is
+   * done. This returns immediately. Generation runs on a bounded pool of worker tasks which is
+   * started the first time this is called. On the host, the pool has one worker per hardware
+   * thread, so many paths can be generated in parallel.
+   *
+   * Calling `setTarget()` with the pathId of a path which is still generating makes the controller
+   * wait for generation to finish before it starts following the path. If the generation queue is
+   * full or there are no waypoints, the returned handle is already marked as failed. If this is
+   * called again with the same pathId before the path is done, the older handle is marked as
+   * superseded and its path is never saved, even if it finishes last.
+   *
+   * @param iwaypoints The waypoints to hit on the path.
+   * @param ipathId A unique identifier to save the path with.
+   * @return A handle which tracks the generation.
+   */
+  std::shared_ptr<PathGenerationHandle>
+  generatePathAsync(std::initializer_list<PathfinderPoint> iwaypoints, const std::string &ipathId);
+
+  /**
+   * Generates a path in the background and saves it internally with a key of pathId once it is
+   * done. This returns immediately. Generation runs on a bounded pool of worker tasks which is
+   * started the first time this is called. On the host, the pool has one worker per hardware
+   * thread, so many paths can be generated in parallel.
+   *
+   * Calling `setTarget()` with the pathId of a path which is still generating makes the controller
+   * wait for generation to finish before it starts following the path. If the generation queue is
+   * full or there are no waypoints, the returned handle is already marked as failed. If this is
+   * called again with the same pathId before the path is done, the older handle is marked as
+   * superseded and its path is never saved, even if it finishes last.
+   *
+   * @param iwaypoints The waypoints to hit on the path.
+   * @param ipathId A unique identifier to save the path with.
+   * @param ilimits The limits to use for this path only.
+   * @return A handle which tracks the generation.
+   */
+  std::shared_ptr<PathGenerationHandle>
+  generatePathAsync(std::initializer_list<PathfinderPoint> iwaypoints,
                     const std::string &ipathId,
                     const PathfinderLimits &ilimits);
 
+  /**
+   * Generates every path of a manifest in the background, each with the limits given for it in the
+   * manifest. This returns immediately. The paths share the worker pool of `generatePathAsync()`,
+   * so on the host they are generated in parallel and on the brain a worker task generates them
+   * in the time the control tasks leave free. Each path is saved as soon as it is done, and
+   * calling `setTarget()` with a path which is still generating waits for it. The wheel track of
+   * the manifest is ignored in favor of the chassis scales of this controller.
+   *
+   * The returned batch reports how long each path took and how much memory it uses. Call
+   * `PathBatch::cancel()` when autonomous starts to skip the paths which have not started; the
+   * paths which are done stay saved. If no worker could be queued, every path is marked as failed.
+   * As with `generatePathAsync()`, a later request for the same ID, including a later entry of the
+   * manifest, supersedes a path of the batch which is not done.
+   *
+   * @param imanifest The paths to generate.
+   * @return A batch which tracks the paths, in the order of the manifest.
+   */
+  std::shared_ptr<PathBatch> generatePaths(const PathManifest &imanifest);
+
+  /**
+   * Saves a copy of a path moved and rotated as if it had been generated with its origin at
+   * another pose, without generating it again. A path generated from `{0_m, 0_m, 0_deg}` will
+   * start at `iorigin`. See `PathTransform::transform()`. If the source path is being generated in
+   * the background, this waits for it. If there is no source path, no path is saved.
+   *
+   * @param isource The handle of the path to copy.
+   * @param ipathId A unique identifier to save the new path with.
+   * @param iorigin Where the origin of the path is moved to.
+   * @return The handle of the new path, or an invalid handle if no path was saved.
+   */
+  PathHandle
+  transformPath(PathHandle isource, const std::string &ipathId, const PathfinderPoint &iorigin);
+
+  /**
+   * Saves a copy of a path mirrored across a line, without generating it again. The default line
+   * gives the same movement as following the path mirrored. See `PathTransform::mirror()`. If the
+   * source path is being generated in the background, this waits for it. If there is no source
+   * path, no path is saved.
+   *
+   * @param isource The handle of the path to copy.
+   * @param ipathId A unique identifier to save the new path with.
+   * @param iaxis A point on the line and the direction of the line.
+   * @return The handle of the new path, or an invalid handle if no path was saved.
+   */
+  PathHandle mirrorPath(PathHandle isource,
+                        const std::string &ipathId,
+                        const PathfinderPoint &iaxis = {0_m, 0_m, 0_deg});
+
+  /**
+   * Saves a copy of a path which retraces it from the end to the start while driving backwards,
+   * without generating it again. See `PathTransform::reverse()`. If the source path is being
+   * generated in the background, this waits for it. If there is no source path, no path is saved.
+   *
+   * @param isource The handle of the path to copy.
+   * @param ipathId A unique identifier to save the new path with.
+   * @return The handle of the new path, or an invalid handle if no path was saved.
+   */
+  PathHandle reversePath(PathHandle isource, const std::string &ipathId);
+
+  /**
+   * Saves a path which follows one path and then another, without generating either again. The
+   * second path is moved to start where the first one ends. See `PathTransform::stitch()`. The
+   * velocities at the joint must differ by no more than one timestep of the largest acceleration
+   * of either path, otherwise an instance of `std::invalid_argument` is thrown (and an error is
+   * logged). Paths which end and start stopped, or which were generated with
+   * `generatePathChain()`, always join.
+   * If either source path is being generated in the background, this waits for it. If either
+   * source path doesn't exist, no path is saved.
+   *
+   * @param ifirst The handle of the first path.
+   * @param isecond The handle of the path to follow after the first path.
+   * @param ipathId A unique identifier to save the new path with.
+   * @return The handle of the new path, or an invalid handle if no path was saved.
+   */
+  PathHandle stitchPaths(PathHandle ifirst, PathHandle isecond, const std::string &ipathId);
+
   /**
    * Removes a path and frees the memory it used. This function returns true if the path was either
    * deleted or didn't exist in the first place. It returns false if the path could not be removed
@@ -89,6 +259,24 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
    */
   bool removePath(const std::string &ipathId);
 
+  /**
+   * Removes a path and frees the memory it used. See `removePath()`. The handle stays valid.
+   *
+   * @param ipath The handle of the path.
+   * @return True if the path no longer exists
+   */
+  bool removePath(PathHandle ipath);
+
+  /**
+   * Gets the handle of a path ID. Paths can be followed by handle without looking up or copying
+   * their ID. Once a path has been saved or started generating with the ID, the handle stays valid
+   * for the life of this controller, even if the path is removed.
+   *
+   * @param ipathId The path ID.
+   * @return The handle of the path, or an invalid handle if no path was ever saved with the ID.
+   */
+  PathHandle getPathHandle(const std::string &ipathId);
+
   /**
    * Gets the identifiers of all paths saved in this `AsyncMotionProfileController`.
    *
@@ -114,6 +302,18 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
    */
   void setTarget(std::string ipathId, bool ibackwards, bool imirrored = false);
 
+  /**
+   * Executes a path with the given handle. This is the same as setting the target by ID, except it
+   * doesn't look up or copy a string. If there is no path saved with the handle, the method will
+   * return. Any targets set while a path is being followed will be ignored.
+   *
+   * @param ipath The handle of the path, from `generatePath()`, `loadPath()`, or
+   * `getPathHandle()`.
+   * @param ibackwards Whether to follow the profile backwards.
+   * @param imirrored Whether to follow the profile mirrored.
+   */
+  void setTarget(PathHandle ipath, bool ibackwards = false, bool imirrored = false);
+
   /**
    * Writes the value of the controller output. This method might be automatically called in another
    * thread by the controller. This just calls `setTarget()`.
@@ -134,6 +334,40 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
    */
   std::string getProcessValue() const override;
 
+  /**
+   * Follows several paths back to back, replacing the current target. The chassis is only stopped
+   * after the last path, so paths which end moving (see `generatePathChain()`) flow into the next
+   * one. Paths which are still generating in the background are waited for.
+   *
+   * @param ipathIds The IDs of the paths, in order.
+   * @param ibackwards Whether to follow the paths backwards.
+   * @param imirrored Whether to follow the paths mirrored.
+   */
+  void queuePaths(const std::vector<std::string> &ipathIds,
+                  bool ibackwards = false,
+                  bool imirrored = false);
+
+  /**
+   * Adds a path to the end of the queue. If the queue is still being followed, the path is
+   * followed after the others without stopping in between. Otherwise, a new queue is started with
+   * the direction and mirroring of the last target.
+   *
+   * @param ipathId The ID of the path.
+   */
+  void enqueuePath(const std::string &ipathId);
+
+  /**
+   * Adds a path to the end of the queue. See `enqueuePath()`.
+   *
+   * @param ipath The handle of the path.
+   */
+  void enqueuePath(PathHandle ipath);
+
+  /**
+   * @return The IDs of the queued paths which have not started yet.
+   */
+  std::vector<std::string> getQueuedPaths() const;
+
   /**
    * Blocks the current task until the controller has settled. This controller is settled when
    * it has finished following a path. If no path is being followed, it is settled.
@@ -142,7 +376,9 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
 
   /**
    * Generates a new path from the position (typically the current position) to the target and
-   * blocks until the controller has settled. Does not save the path which was generated.
+   * blocks until the controller has settled. Does not save the path which was generated. If
+   * streaming is enabled (see `setMoveToStreaming()`), the robot starts moving before the whole
+   * path has been generated.
    *
    * @param iwaypoints The waypoints to hit on the path.
    * @param ibackwards Whether to follow the profile backwards.
@@ -154,7 +390,9 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
 
   /**
    * Generates a new path from the position (typically the current position) to the target and
-   * blocks until the controller has settled. Does not save the path which was generated.
+   * blocks until the controller has settled. Does not save the path which was generated. If
+   * streaming is enabled (see `setMoveToStreaming()`), the robot starts moving before the whole
+   * path has been generated.
    *
    * @param iwaypoints The waypoints to hit on the path.
    * @param ilimits The limits to use for this path only.
@@ -238,23 +476,234 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
   CrossplatformThread *getThread() const;
 
   /**
-   * Saves a generated path to a file. Paths are stored as `<ipathId>.csv`. An SD card
-   * must be inserted into the brain and the directory must exist. `idirectory` can be prefixed with
-   * `/usd/`, but it this is not required.
+   * Saves a generated path to a file. CSV paths are stored as `<ipathId>.csv` and binary paths are
+   * stored as `<ipathId>.bin`. An SD card must be inserted into the brain and the directory must
+   * exist. `idirectory` can be prefixed with `/usd/`, but it this is not required.
+   *
+   * Paths are stored as CSV unless the binary format is asked for. The binary format loads much
+   * faster than CSV, but other tools can't read it. `loadPath()` prefers a binary file over a CSV
+   * file with the same ID, so store a path in one format only.
    *
    * @param idirectory The directory to store the path file in
    * @param ipathId The path ID of the generated path
+   * @param iformat The file format to store the path in
    */
-  void storePath(const std::string &idirectory, const std::string &ipathId);
+  void storePath(const std::string &idirectory,
+                 const std::string &ipathId,
+                 PathFileFormat iformat = PathFileFormat::csv);
 
   /**
-   * Loads a path from a directory on the SD card containing a path CSV file. `/usd/` is
-   * automatically prepended to `idirectory` if it is not specified.
+   * Loads a path from a directory on the SD card. `/usd/` is automatically prepended to
+   * `idirectory` if it is not specified. A binary path file (`<ipathId>.bin`) is preferred, then a
+   * squiggles CSV file (`<ipathId>.csv`), then a pair of Pathfinder CSV files
+   * (`<ipathId>.left.csv` and `<ipathId>.right.csv`).
    *
    * @param idirectory The directory that the path files are stored in
    * @param ipathId The path ID that the paths are stored under (and will be loaded into)
+   * @return The handle of the path. If no path could be loaded, no path is saved with it.
+   */
+  PathHandle loadPath(const std::string &idirectory, const std::string &ipathId);
+
+  /**
+   * Saves a path which was compiled at build time (see PathCompiler). The path is followed in
+   * place: its points are not copied, so they must outlive this controller. The points are neither
+   * compiled into motor commands nor stored compactly. Empty paths are not saved.
+   *
+   * @param ipathId A unique identifier to save the path with.
+   * @param ipath The compiled path.
+   * @return The handle of the path, or an invalid handle if the path was empty.
+   */
+  PathHandle addPathView(const std::string &ipathId, const PathView &ipath);
+
+  /**
+   * Saves every path in a header emitted by the path compiler with the ID it was compiled with. See
+   * `addPathView()`.
+   *
+   * @param ipaths The compiled paths, usually the `paths` array of the emitted header.
+   */
+  template <std::size_t N> void addPathViews(const NamedPathView (&ipaths)[N]) {
+    for (const auto &path : ipaths) {
+      addPathView(path.id, path.path);
+    }
+  }
+
+  /**
+   * Sets the cache used when generating paths. Generating a path whose waypoints, limits, and
+   * chassis dimensions match a cached path reuses the cached trajectory instead of generating it
+   * again. This applies to `generatePath()`, `generatePathAsync()`, and `moveTo()`. A cache can be
+   * shared between controllers. Pass `nullptr` to disable caching (the default).
+   *
+   * @param icache The cache.
+   */
+  void setPathCache(const std::shared_ptr<PathCache> &icache);
+
+  /**
+   * @return The cache used when generating paths, or `nullptr` if there is none.
+   */
+  std::shared_ptr<PathCache> getPathCache() const;
+
+  /**
+   * Sets whether paths are compiled into tables of ready-to-send motor commands when they are
+   * generated or loaded. Following a compiled path only reads the table, which takes less time per
+   * segment. Each compiled path uses extra memory for the table (four variants of two doubles per
+   * point). Paths which were saved before this setting was changed are not affected. Compilation is
+   * disabled by default.
+   *
+   * @param icompile Whether to compile paths.
+   */
+  void setCompileMotorCommands(bool icompile);
+
+  /**
+   * @return Whether paths are compiled into tables of motor commands.
+   */
+  bool getCompileMotorCommands() const;
+
+  /**
+   * Sets whether paths are quantized into a CompactTrajectory when they are generated or loaded.
+   * A compact path uses about a quarter of the memory of a full precision path. Each field of a
+   * point is off by at most half of 1/65535 of the range of that field over the path (see
+   * CompactTrajectory::getMaxError()). Paths which were saved before this setting was changed are
+   * not affected. Compact storage is disabled by default.
+   *
+   * @param icompact Whether to store paths compactly.
+   */
+  void setCompactPathStorage(bool icompact);
+
+  /**
+   * @return Whether paths are stored compactly.
+   */
+  bool getCompactPathStorage() const;
+
+  /**
+   * Sets whether paths are generated with TrajectoryGenerator instead of squiggles. The native
+   * generator limits the velocity in turns so neither wheel exceeds the max velocity, but it does
+   * not limit jerk. The path cache keeps the paths of each generator apart. Paths which were saved
+   * before this setting was changed are not affected. Native generation is disabled by default.
+   *
+   * @param inative Whether to generate paths with TrajectoryGenerator.
+   */
+  void setNativeTrajectoryGeneration(bool inative);
+
+  /**
+   * @return Whether paths are generated with TrajectoryGenerator.
+   */
+  bool getNativeTrajectoryGeneration() const;
+
+  /**
+   * Gets the approximate memory used by a path, including its compiled motor commands.
+   *
+   * @param ipathId The path ID.
+   * @return The number of bytes used by the path, or zero if there is no path with this ID.
+   */
+  std::size_t getPathBytesUsed(const std::string &ipathId) const;
+
+  /**
+   * Sets whether paths are followed by time instead of by segment. By default, the follower sends
+   * one point of the path per timestep, so every late timestep delays the rest of the path. When
+   * following by time, the follower instead samples the path at the time elapsed since it started,
+   * interpolating between points. A late timestep then only costs accuracy for that timestep, and
+   * the path finishes on time. This takes effect the next time a path starts.
+   *
+   * @param itimeIndexed Whether to follow paths by time.
+   */
+  void setTimeIndexedFollowing(bool itimeIndexed);
+
+  /**
+   * @return Whether paths are followed by time.
+   */
+  bool getTimeIndexedFollowing() const;
+
+  /**
+   * Gets the timing statistics of the most recent path which finished (or was interrupted). See
+   * FollowStatistics.
+   *
+   * @return The timing statistics.
+   */
+  FollowStatistics getFollowStatistics() const;
+
+  /**
+   * Sets whether paths are followed with a voltage feedforward. By default, the follower sends
+   * each side of the chassis a velocity target and leaves tracking it to the motors' internal
+   * velocity loop, which lags behind the profile whenever it accelerates. With a feedforward, the
+   * follower instead computes a voltage for each side from the velocity and acceleration the
+   * profile wants that side to have (see FeedforwardGains) and sends it with
+   * `ChassisModel::tank()`. Compiled motor commands are not used with a feedforward. This takes
+   * effect the next time a path starts.
+   *
+   * @param igains The feedforward gains, or `std::nullopt` to send velocity targets.
+   */
+  void setFeedforward(const std::optional<FeedforwardGains> &igains);
+
+  /**
+   * @return The feedforward gains, or `std::nullopt` if velocity targets are sent.
+   */
+  std::optional<FeedforwardGains> getFeedforward() const;
+
+  /**
+   * Sets the actuation latency of the chassis: how long after a command is sent the motors start
+   * to apply it. The follower sends the command for the time one latency ahead of now, so the
+   * motors apply each command when the profile wants it. Use LatencyEstimator to find the latency
+   * from logged commands and measurements. The default is no latency. This takes effect the next
+   * time a path starts. If the latency is negative, an instance of `std::invalid_argument` is
+   * thrown.
+   *
+   * @param ilatency The actuation latency.
    */
-  void loadPath(const std::string &idirectory, const std::string &ipathId);
+  void setActuationLatency(QTime ilatency);
+
+  /**
+   * @return The actuation latency the follower compensates for.
+   */
+  QTime getActuationLatency() const;
+
+  /**
+   * Sets whether paths are followed closed-loop. By default, the follower plays the wheel
+   * velocities of a path and never checks where the robot is, so wheel slip adds up into an error
+   * at the end of the path. With odometry, the follower reads the robot's pose every timestep and
+   * corrects the velocity it sends with a RAMSETE controller (see Ramsete) so the robot converges
+   * back onto the path. Paths are still relative to where the robot is when they start; the
+   * odometry only measures how far the robot has strayed since then. This also works with a
+   * feedforward, in which case the corrected velocities are sent through it. Compiled motor
+   * commands are not used with odometry. This takes effect the next time a path starts.
+   *
+   * The odometry is not stepped by this controller. It must be kept up to date by something else,
+   * such as the OdomChassisController it came from. If `ib` is not positive or `izeta` is not
+   * between zero and one, an instance of `std::invalid_argument` is thrown.
+   *
+   * @param iodometry The odometry, or `nullptr` to follow paths open-loop.
+   * @param igains The RAMSETE gains.
+   */
+  void setOdometry(const std::shared_ptr<Odometry> &iodometry,
+                   const RamseteGains &igains = RamseteGains{});
+
+  /**
+   * @return The odometry paths are followed with, or `nullptr` if they are followed open-loop.
+   */
+  std::shared_ptr<Odometry> getOdometry() const;
+
+  /**
+   * @return The RAMSETE gains used with odometry.
+   */
+  RamseteGains getRamseteGains() const;
+
+  /**
+   * Sets up streaming for `moveTo()`. When streaming, `moveTo()` splits the waypoints into chunks
+   * of `isegmentsPerChunk` waypoint-to-waypoint segments and generates them one after another. The
+   * robot starts following the first chunk as soon as `ileadTime` worth of the path has been
+   * generated, while the remaining chunks are generated, so the time it takes to generate the
+   * whole path is no longer spent waiting before the robot moves.
+   *
+   * The velocity where two chunks meet is chosen so the robot can accelerate to it from the start
+   * of the path and still stop at the end of the path, measured along straight lines between the
+   * waypoints. If a chunk is not ready when the follower reaches it, the follower holds the last
+   * command until it is. Moves with no more than one chunk are not streamed. Streaming is disabled
+   * by default.
+   *
+   * @param isegmentsPerChunk The number of waypoint-to-waypoint segments per chunk, or zero to
+   * disable streaming.
+   * @param ileadTime How much of the path must be generated before the robot starts moving.
+   */
+  void setMoveToStreaming(std::size_t isegmentsPerChunk, QTime ileadTime = 0_ms);
 
   /**
    * Attempts to remove a path without stopping execution. If that fails, disables the controller
@@ -264,34 +713,421 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
    */
   void forceRemovePath(const std::string &ipathId);
 
+  /**
+   * Attempts to remove a path without stopping execution. If that fails, disables the controller
+   * and removes the path.
+   *
+   * @param ipath The handle of the path that will be removed
+   */
+  void forceRemovePath(PathHandle ipath);
+
   protected:
   std::shared_ptr<Logger> logger;
-  std::map<std::string, std::vector<squiggles::ProfilePoint>> paths{};
+  // Immutable path snapshots and the paths being generated in the background. Must be locked with
+  // currentPathMutex when accessing the table, but not when reading a path, because the follower
+  // holds its own reference to the path it is following.
+  PathTable paths{};
   PathfinderLimits limits;
   std::shared_ptr<ChassisModel> model;
   ChassisScales scales;
   AbstractMotor::GearsetRatioPair pair;
   TimeUtil timeUtil;
 
-  // This must be locked when accessing the current path
-  CrossplatformMutex currentPathMutex;
+  // This must be locked when accessing paths or currentPath. It is never locked while following a
+  // path.
+  mutable CrossplatformMutex currentPathMutex;
 
-  std::string currentPath{""};
+  PathHandle currentPath{};
+  std::string missingTargetId{}; // The target when it was set to an ID which has no path
+  PathHandle moveToPath{}; // The slot moveTo() generates its paths into
   std::atomic_bool isRunning{false};
   std::atomic_int direction{1};
   std::atomic_bool mirrored{false};
   std::atomic_bool disabled{false};
   std::atomic_bool dtorCalled{false};
+  std::atomic_bool compileMotorCommands{false};
+  std::atomic_bool compactPathStorage{false};
+  std::atomic_bool nativeTrajectoryGeneration{false};
+  std::atomic_bool timeIndexedFollowing{false};
   CrossplatformThread *task{nullptr};
 
+  // Paths queued with queuePaths() or enqueuePath(), and whether the loop is following the queue.
+  // Guarded by currentPathMutex.
+  std::deque<PathHandle> queuedPaths{};
+  bool followingQueue{false};
+
+  // The path being streamed by moveTo(), if any. Guarded by currentPathMutex.
+  std::shared_ptr<StreamingPath> currentStream{nullptr};
+  std::size_t streamSegmentsPerChunk{0}; // Guarded by currentPathMutex
+  QTime streamLeadTime{0_ms};            // Guarded by currentPathMutex
+
+  std::optional<FeedforwardGains> feedforward{}; // Guarded by currentPathMutex
+  QTime actuationLatency{0_ms};                  // Guarded by currentPathMutex
+  std::shared_ptr<Odometry> odometry{nullptr};   // Guarded by currentPathMutex
+  RamseteGains ramseteGains{};                   // Guarded by currentPathMutex
+
+  std::unique_ptr<WorkerPool> generationPool{nullptr};
+  std::shared_ptr<PathCache> pathCache{nullptr};
+
+  /**
+   * A native generator which is not in use, and the limits it was made with.
+   */
+  struct IdleGenerator {
+    std::unique_ptr<TrajectoryGenerator> generator{nullptr};
+    PathfinderLimits limits{};
+  };
+
+  // Kept so their points are only allocated once. Each generation takes one for itself, so
+  // generations on different tasks don't wait for each other. Guarded by generatorMutex.
+  mutable CrossplatformMutex generatorMutex;
+  mutable std::vector<IdleGenerator> idleGenerators{};
+
+  mutable CrossplatformMutex followStatisticsMutex;
+  FollowStatistics lastFollowStatistics{};
+
   static void trampoline(void *context);
   void loop();
 
   /**
-   * Follow the supplied path. Must follow the disabled lifecycle.
+   * Generates a path without saving it, or returns it from the path cache if it has been generated
+   * before. Safe to call from any task.
+   *
+   * @param iwaypoints The waypoints to hit on the path.
+   * @param ilimits The limits to use for the path.
+   * @param istartVel The velocity at the start of the path in m/s.
+   * @param iendVel The velocity at the end of the path in m/s.
+   * @return The generated path.
+   */
+  std::vector<squiggles::ProfilePoint>
+  generateProfile(const std::vector<PathfinderPoint> &iwaypoints,
+                  const PathfinderLimits &ilimits,
+                  double istartVel = 0,
+                  double iendVel = 0) const;
+
+  /**
+   * Generates a path with an idle TrajectoryGenerator, which is returned to the idle generators
+   * afterwards. A generator is made if none is idle, and made again if its limits are different or
+   * the path needs more points than it has room for. Safe to call from any task, and calls on
+   * different tasks run in parallel.
+   *
+   * @param iwaypoints The waypoints to hit on the path.
+   * @param ilimits The limits to use for the path.
+   * @param istartVel The velocity at the start of the path in m/s.
+   * @param iendVel The velocity at the end of the path in m/s.
+   * @return The generated path.
+   */
+  std::vector<squiggles::ProfilePoint>
+  generateNativeProfile(const std::vector<PathfinderPoint> &iwaypoints,
+                        const PathfinderLimits &ilimits,
+                        double istartVel,
+                        double iendVel) const;
+
+  /**
+   * Builds the snapshot a path is saved as, applying the storage and compilation settings.
+   *
+   * @param ipath The path.
+   * @return The snapshot.
+   */
+  StoredPathPtr makeStoredPath(std::vector<squiggles::ProfilePoint> ipath) const;
+
+  /**
+   * Saves a path, replacing any path which already has the same handle.
+   *
+   * @param ipath The handle to save the path with.
+   * @param ipoints The path.
+   * @return The handle.
+   */
+  PathHandle publishPath(PathHandle ipath, std::vector<squiggles::ProfilePoint> ipoints);
+
+  /**
+   * Saves a snapshot, replacing any path which already has the same handle. If the old path is
+   * being followed, the follower finishes it from its own reference. A generation still pending for
+   * the handle is superseded, so it can't replace this path when it finishes. Safe to call from any
+   * task.
+   *
+   * @param ipath The handle to save the path with.
+   * @param isnapshot The snapshot.
+   * @return The handle.
+   */
+  PathHandle publishPath(PathHandle ipath, StoredPathPtr isnapshot);
+
+  /**
+   * Records that a path is being generated in the background. A generation which was already
+   * pending for the same handle is marked as superseded, so only the newest request is saved. Must
+   * be called with currentPathMutex locked.
+   *
+   * @param ipath The handle the path will be saved with.
+   * @param igeneration The generation, or `nullptr` to clear the pending generation.
+   */
+  void setPendingPath(PathHandle ipath, const std::shared_ptr<PathGenerationHandle> &igeneration);
+
+  /**
+   * Saves the result of a background generation if it is still the newest request for its handle,
+   * and clears it from the pending generations. A result which was superseded while it generated
+   * is dropped.
+   *
+   * @param ipath The handle to save the path with.
+   * @param igeneration The generation which produced the snapshot.
+   * @param isnapshot The snapshot.
+   * @return Whether the snapshot was saved.
+   */
+  bool publishGeneratedPath(PathHandle ipath,
+                            const std::shared_ptr<PathGenerationHandle> &igeneration,
+                            StoredPathPtr isnapshot);
+
+  /**
+   * Clears a background generation which did not produce a path from the pending generations.
+   *
+   * @param ipath The handle the path would have been saved with.
+   * @param igeneration The generation.
+   * @return Whether the generation was still the newest request for its handle.
+   */
+  bool clearPendingPath(PathHandle ipath, const std::shared_ptr<PathGenerationHandle> &igeneration);
+
+  /**
+   * @param ipathId The path ID.
+   * @return The saved path, or `nullptr` if there is no path with this ID.
+   */
+  StoredPathPtr findPath(const std::string &ipathId) const;
+
+  /**
+   * @param ipath The handle of the path.
+   * @return The saved path, or `nullptr` if there is no path with this handle.
+   */
+  StoredPathPtr findPath(PathHandle ipath) const;
+
+  /**
+   * Finds a path to derive another path from, waiting for it if it is being generated in the
+   * background.
+   *
+   * @param isource The handle of the path.
+   * @return The path, or `nullptr` (and a warning is logged) if there is no path with this handle.
+   */
+  StoredPathPtr findSourcePath(PathHandle isource);
+
+  /**
+   * @param ipath The handle of the path.
+   * @return The ID of the path, or an empty string if the handle is invalid.
+   */
+  const std::string &getPathName(PathHandle ipath) const;
+
+  /**
+   * Gets the handle of a path ID, adding a slot for the ID if there is none. Only used when a path
+   * is saved, so looking up an unknown ID never grows the path table.
+   *
+   * @param ipathId The path ID.
+   * @return The handle of the path.
+   */
+  PathHandle internPath(const std::string &ipathId);
+
+  /**
+   * @param ipath The handle of the path.
+   * @return The generation handle of the path if it is being generated in the background,
+   * otherwise `nullptr`.
+   */
+  std::shared_ptr<PathGenerationHandle> getPendingPath(PathHandle ipath);
+
+  struct MoveTracking;
+
+  /**
+   * Follow the supplied path. Must follow the disabled lifecycle. The caller keeps the path alive
+   * until this returns, so no locking is needed to read it. If the path has compiled motor
+   * commands, they are sent directly.
+   *
+   * @param path The path.
+   * @param rate The rate to follow the path at.
+   * @param itracking The feedback state of the move this path is part of, from `startMove()`.
+   */
+  virtual void executeSinglePath(const StoredPath &path,
+                                 std::unique_ptr<AbstractRate> rate,
+                                 MoveTracking &itracking);
+
+  /**
+   * Follows the queued paths back to back until the queue is empty. Must follow the disabled
+   * lifecycle.
+   */
+  void executePathQueue();
+
+  /**
+   * Blocks until a path which is generating in the background is done. Returns immediately if the
+   * path is not generating.
+   *
+   * @param ipath The handle of the path.
+   */
+  void waitForPendingPath(PathHandle ipath);
+
+  /**
+   * Follows the chunks of a streamed path back to back as one move, so the feedback of the
+   * feedforward and RAMSETE is measured from where the first chunk started. Must follow the
+   * disabled lifecycle.
+   *
+   * @param path The streamed path.
+   */
+  virtual void executeStreamingPath(const StreamingPath &path);
+
+  /**
+   * Generates the chunks of a streamed path and starts following it once the first chunk is
+   * ready. Blocks until every chunk is generated. Throws a `std::runtime_error` if a chunk can't be
+   * generated.
+   *
+   * @param iwaypoints The waypoints to hit on the path.
+   * @param ilimits The limits to use for the path.
+   * @param isegmentsPerChunk The number of waypoint-to-waypoint segments per chunk.
+   * @param ileadTime How much of the path must be generated before following starts.
+   * @param ibackwards Whether to follow the path backwards.
+   * @param imirrored Whether to follow the path mirrored.
+   */
+  void streamPath(const std::vector<PathfinderPoint> &iwaypoints,
+                  const PathfinderLimits &ilimits,
+                  std::size_t isegmentsPerChunk,
+                  QTime ileadTime,
+                  bool ibackwards,
+                  bool imirrored);
+
+  /**
+   * Plans the velocities where the chunks of a streamed path meet. The first and last velocities
+   * are zero. Every other velocity is as fast as possible while the robot can still accelerate to
+   * it from the start of the path and stop at the end of the path.
+   *
+   * @param iwaypoints The waypoints of the path.
+   * @param iboundaries The index of the first waypoint of each chunk, followed by the index of the
+   * last waypoint.
+   * @param ilimits The limits of the path.
+   * @return The velocity at each boundary in m/s.
+   */
+  static std::vector<double> planJunctionVelocities(const std::vector<PathfinderPoint> &iwaypoints,
+                                                    const std::vector<std::size_t> &iboundaries,
+                                                    const PathfinderLimits &ilimits);
+
+  /**
+   * Plans the velocities where consecutive pieces of a path meet, given the length of each piece.
+   * The first and last velocities are zero.
+   *
+   * @param ilengths The length of each piece in meters.
+   * @param ilimits The limits of the path.
+   * @return The velocity at the start of each piece, followed by the velocity at the end of the
+   * last piece, in m/s.
+   */
+  static std::vector<double> planJunctionVelocities(const std::vector<double> &ilengths,
+                                                    const PathfinderLimits &ilimits);
+
+  /**
+   * Measures the straight-line distance along some waypoints.
+   *
+   * @param iwaypoints The waypoints.
+   * @param ifrom The index of the first waypoint.
+   * @param ito The index of the last waypoint.
+   * @return The distance in meters.
+   */
+  static double getWaypointDistance(const std::vector<PathfinderPoint> &iwaypoints,
+                                    std::size_t ifrom,
+                                    std::size_t ito);
+
+  /**
+   * Sends the motor command at a position along a path. The position is measured in points and
+   * may fall between two points, in which case the command is interpolated between them.
+   *
+   * @param path The path.
+   * @param iposition The position along the path, between zero and the index of the last point.
+   * @param imirrored Whether the path is followed mirrored.
+   * @param ireversed `-1` if the path is followed backwards, otherwise `1`.
+   */
+  void sendMotorCommand(const StoredPath &path, double iposition, bool imirrored, int ireversed);
+
+  /**
+   * What the feedback term of a feedforward needs to remember between timesteps of a path. Sides
+   * are indexed left then right.
+   */
+  struct FeedforwardTracking {
+    std::valarray<std::int32_t> startSensors{}; ///< The sensor values when the path started.
+    double expectedDistance[2]{0, 0}; ///< The distance each side should have driven in meters.
+    double lastVelocity[2]{0, 0};     ///< The velocity each side should last have had in m/s.
+    double lastPosition{0};           ///< The reference position along the path last sent.
+  };
+
+  /**
+   * Sends the voltages a feedforward computes at a position along a path. The positions are
+   * measured as in `sendMotorCommand()`. The feedback term compares the sensors with the distance
+   * the path covers up to the reference position.
+   *
+   * @param path The path.
+   * @param ireferencePosition The position along the path the robot should be at now.
+   * @param icommandPosition The position along the path to take the velocity and acceleration
+   * from, which is ahead of the reference when compensating for actuation latency.
+   * @param imirrored Whether the path is followed mirrored.
+   * @param ireversed `-1` if the path is followed backwards, otherwise `1`.
+   * @param igains The feedforward gains.
+   * @param itracking The feedback state of this run of the path.
+   */
+  void sendVoltageCommand(const StoredPath &path,
+                          double ireferencePosition,
+                          double icommandPosition,
+                          bool imirrored,
+                          int ireversed,
+                          const FeedforwardGains &igains,
+                          FeedforwardTracking &itracking);
+
+  /**
+   * What the RAMSETE correction needs while following a path.
+   */
+  struct RamseteTracking {
+    std::shared_ptr<Odometry> odometry{}; ///< Where the robot's pose is read from.
+    RamseteGains gains{};                 ///< The RAMSETE gains.
+    OdomState start{};                    ///< The odometry state when the move started.
+    squiggles::Pose origin{};             ///< The pose of the path where the move started.
+  };
+
+  /**
+   * The feedback state of one move. A streamed path is one move split into several chunks, so its
+   * state is captured once before the first chunk and carried through every chunk.
+   */
+  struct MoveTracking {
+    std::optional<FeedforwardGains> feedforward{}; ///< The feedforward gains, if any.
+    FeedforwardTracking voltage{};                 ///< The feedback state of the feedforward.
+    RamseteTracking ramsete{};                     ///< The RAMSETE state, if there is odometry.
+  };
+
+  /**
+   * Captures the feedback state at the start of a move.
+   *
+   * @param ipath The first path of the move.
+   * @return The state.
+   */
+  MoveTracking startMove(const StoredPath &ipath);
+
+  /**
+   * Sends the motor command at a position along a path, corrected by RAMSETE toward where the
+   * robot should be. The positions are measured as in `sendMotorCommand()`. If a feedforward is
+   * given, the corrected wheel velocities are sent as voltages through it without its feedback
+   * term.
+   *
+   * @param path The path.
+   * @param ireferencePosition The position along the path the robot should be at now.
+   * @param icommandPosition The position along the path to take the velocity from, which is ahead
+   * of the reference when compensating for actuation latency.
+   * @param imirrored Whether the path is followed mirrored.
+   * @param ireversed `-1` if the path is followed backwards, otherwise `1`.
+   * @param itracking The odometry, gains, and start of the move.
+   * @param ifeedforward The feedforward gains, or `std::nullopt` to send velocity targets.
+   */
+  void sendRamseteCommand(const StoredPath &path,
+                          double ireferencePosition,
+                          double icommandPosition,
+                          bool imirrored,
+                          int ireversed,
+                          const RamseteTracking &itracking,
+                          const std::optional<FeedforwardGains> &ifeedforward);
+
+  /**
+   * Compiles a path into a packed table of motor commands for every variant of the path, laid out
+   * as described by `StoredPath::commandOffset()`.
+   *
+   * @param ipath The path.
+   * @return The motor commands, or an empty table if the path does not have two wheel velocities
+   * per point.
    */
-  virtual void executeSinglePath(const std::vector<squiggles::ProfilePoint> &path,
-                                 std::unique_ptr<AbstractRate> rate);
+  std::vector<MotorCommand>
+  compileMotorCommandTable(const std::vector<squiggles::ProfilePoint> &ipath) const;
 
   /**
    * Converts linear chassis speed to rotational motor speed.
@@ -316,11 +1152,15 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
   static std::string makeFilePath(const std::string &directory, const std::string &filename);
 
   void internalStorePath(std::ostream &file, const std::string &ipathId);
+  void internalStoreBinaryPath(std::ostream &file, const std::string &ipathId);
   void internalLoadPath(std::istream &file, const std::string &ipathId);
+  bool internalLoadBinaryPath(std::istream &file, const std::string &ipathId);
   void internalLoadPathfinderPath(std::istream &leftFile,
                                   std::istream &rightFile,
                                   const std::string &ipathId);
 
   static constexpr double DT = 0.01;
+  static constexpr std::size_t maxQueuedGenerations = 32;
+  static constexpr std::size_t minGeneratorCapacity = 2000; // 20 s of points
 };
 } // namespace okapi
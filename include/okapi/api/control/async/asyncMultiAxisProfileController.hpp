@@ -0,0 +1,337 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/async/asyncPositionController.hpp"
+#include "okapi/api/control/controllerOutput.hpp"
+#include "okapi/api/control/util/pathTable.hpp"
+#include "okapi/api/control/util/synchronizedProfile.hpp"
+#include "okapi/api/device/motor/abstractMotor.hpp"
+#include "okapi/api/units/QAngularSpeed.hpp"
+#include "okapi/api/units/QSpeed.hpp"
+#include "okapi/api/util/logging.hpp"
+#include "okapi/api/util/timeUtil.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace okapi {
+/**
+ * One axis driven by an AsyncMultiAxisProfileController.
+ */
+struct LinearAxis {
+  std::shared_ptr<ControllerOutput<double>> output; ///< The output to write velocity targets to.
+  QLength diameter;                     ///< The effective diameter for whatever the motor spins.
+  AbstractMotor::GearsetRatioPair pair; ///< The gearset.
+  PathfinderLimits limits;              ///< The limits of the axis.
+};
+
+class AsyncMultiAxisProfileController : public AsyncPositionController<std::string, double> {
+  public:
+  /**
+   * An Async Controller which follows closed-form 1D motion profiles on several axes at once, such
+   * as a lift and an arm. The axes share one timeline (see SynchronizedProfile), so they all start
+   * and finish together, and one task drives every axis.
+   *
+   * If there are no axes or any gear ratio is zero, an instance of `std::invalid_argument` is
+   * thrown.
+   *
+   * @param itimeUtil The TimeUtil.
+   * @param iaxes The axes to drive.
+   * @param ilogger The logger this instance will log to.
+   */
+  AsyncMultiAxisProfileController(
+    const TimeUtil &itimeUtil,
+    std::vector<LinearAxis> iaxes,
+    const std::shared_ptr<Logger> &ilogger = Logger::getDefaultLogger());
+
+  AsyncMultiAxisProfileController(AsyncMultiAxisProfileController &&other) = delete;
+
+  AsyncMultiAxisProfileController &operator=(AsyncMultiAxisProfileController &&other) = delete;
+
+  ~AsyncMultiAxisProfileController() override;
+
+  /**
+   * Generates a synchronized profile and saves it internally with a key of pathId. Call
+   * `setTarget()` with the same pathId to run it. The profile is built in constant time per axis,
+   * so it is ready as soon as this returns.
+   *
+   * If there is not exactly one move per axis, an instance of `std::invalid_argument` is thrown
+   * (and an error is logged).
+   *
+   * @param imoves The move of each axis, in the same order as the axes.
+   * @param ipathId A unique identifier to save the path with.
+   * @param ishape The shape of the profiles.
+   * @return The handle of the path.
+   */
+  PathHandle generatePath(const std::vector<LinearMove> &imoves,
+                          const std::string &ipathId,
+                          LinearProfileShape ishape = LinearProfileShape::sCurve);
+
+  /**
+   * Removes a path and frees the memory it used. This function returns `true` if the path was
+   * either deleted or didn't exist in the first place. It returns `false` if the path could not be
+   * removed because it is running.
+   *
+   * @param ipathId A unique identifier for the path, previously passed to `generatePath()`.
+   * @return `true` if the path no longer exists
+   */
+  bool removePath(const std::string &ipathId);
+
+  /**
+   * Removes a path and frees the memory it used. This function returns `true` if the path was
+   * either deleted or didn't exist in the first place. It returns `false` if the path could not be
+   * removed because it is running. The handle stays valid and refers to the same ID.
+   *
+   * @param ipath The handle of the path, previously returned by `generatePath()`.
+   * @return `true` if the path no longer exists
+   */
+  bool removePath(PathHandle ipath);
+
+  /**
+   * Gets the handle of a path ID. Once a path has been generated with the ID, the handle stays
+   * valid for the life of this controller, so it can be looked up once and used to start the path
+   * without any string work.
+   *
+   * @param ipathId A unique identifier for the path.
+   * @return The handle of the path, or an invalid handle if no path was ever saved with the ID.
+   */
+  PathHandle getPathHandle(const std::string &ipathId);
+
+  /**
+   * Gets the identifiers of all paths saved in this `AsyncMultiAxisProfileController`.
+   *
+   * @return The identifiers of all paths
+   */
+  std::vector<std::string> getPaths();
+
+  /**
+   * Executes a path with the given ID. If there is no path matching the ID, the method will
+   * return. Any targets set while a path is being followed will be ignored.
+   *
+   * @param ipathId A unique identifier for the path, previously passed to `generatePath()`.
+   */
+  void setTarget(std::string ipathId) override;
+
+  /**
+   * Executes the path with the given handle. This doesn't look up or copy the path ID. If there is
+   * no path saved with the handle, the method will return. Any targets set while a path is being
+   * followed will be ignored.
+   *
+   * @param ipath The handle of the path, previously returned by `generatePath()` or
+   * `getPathHandle()`.
+   */
+  void setTarget(PathHandle ipath);
+
+  /**
+   * Writes the value of the controller output. This method might be automatically called in another
+   * thread by the controller.
+   *
+   * This just calls `setTarget()`.
+   */
+  void controllerSet(std::string ivalue) override;
+
+  /**
+   * Gets the last set target, or the default target if none was set.
+   *
+   * @return the last target
+   */
+  std::string getTarget() override;
+
+  /**
+   * Gets the last set target, or the default target if none was set.
+   *
+   * @return the last target
+   */
+  virtual std::string getTarget() const;
+
+  /**
+   * This is overridden to return the current path.
+   *
+   * @return The most recent value of the process variable.
+   */
+  std::string getProcessValue() const override;
+
+  /**
+   * Blocks the current task until the controller has settled. This controller is settled when
+   * it has finished following a path. If no path is being followed, it is settled.
+   */
+  void waitUntilSettled() override;
+
+  /**
+   * Generates a synchronized profile for the moves and blocks until the controller has settled.
+   * Does not save the path which was generated.
+   *
+   * @param imoves The move of each axis, in the same order as the axes.
+   * @param ishape The shape of the profiles.
+   */
+  void moveTo(const std::vector<LinearMove> &imoves,
+              LinearProfileShape ishape = LinearProfileShape::sCurve);
+
+  /**
+   * @return The number of axes.
+   */
+  std::size_t getAxisCount() const;
+
+  /**
+   * Returns where the profile of an axis is. Does not update when disabled.
+   *
+   * @param iaxis The index of the axis.
+   * @return The position of the axis in meters.
+   */
+  double getAxisPosition(std::size_t iaxis) const;
+
+  /**
+   * Returns the last error of the controller, which is the error of the axis furthest from its
+   * end. Does not update when disabled. Returns zero if there is no path currently being followed.
+   *
+   * @return the last error
+   */
+  double getError() const override;
+
+  /**
+   * Returns whether the controller has settled at the target. Determining what settling means is
+   * implementation-dependent.
+   *
+   * If the controller is disabled, this method must return `true`.
+   *
+   * @return whether the controller is settled
+   */
+  bool isSettled() override;
+
+  /**
+   * Resets the controller's internal state so it is similar to when it was first initialized, while
+   * keeping any user-configured information. This implementation also stops movement.
+   */
+  void reset() override;
+
+  /**
+   * Changes whether the controller is off or on. Turning the controller on after it was off will
+   * NOT cause the controller to move to its last set target.
+   */
+  void flipDisable() override;
+
+  /**
+   * Sets whether the controller is off or on. Turning the controller on after it was off will
+   * NOT cause the controller to move to its last set target, unless it was reset in that time.
+   *
+   * @param iisDisabled whether the controller is disabled
+   */
+  void flipDisable(bool iisDisabled) override;
+
+  /**
+   * Returns whether the controller is currently disabled.
+   *
+   * @return whether the controller is currently disabled
+   */
+  bool isDisabled() const override;
+
+  /**
+   * This implementation does nothing because the API always requires the starting positions to be
+   * specified.
+   */
+  void tarePosition() override;
+
+  /**
+   * This implementation does nothing because the maximum velocity of each axis is configured in
+   * its limits.
+   *
+   * @param imaxVelocity Ignored.
+   */
+  void setMaxVelocity(std::int32_t imaxVelocity) override;
+
+  /**
+   * Starts the internal thread. This should not be called by normal users. This method is called
+   * by the AsyncMotionProfileControllerBuilder when making a new instance of this class.
+   */
+  void startThread();
+
+  /**
+   * Returns the underlying thread handle.
+   *
+   * @return The underlying thread handle.
+   */
+  CrossplatformThread *getThread() const;
+
+  /**
+   * Attempts to remove a path without stopping execution, then if that fails, disables the
+   * controller and removes the path.
+   *
+   * @param ipathId The path ID that will be removed
+   */
+  void forceRemovePath(const std::string &ipathId);
+
+  /**
+   * Attempts to remove a path without stopping execution, then if that fails, disables the
+   * controller and removes the path.
+   *
+   * @param ipath The handle of the path that will be removed
+   */
+  void forceRemovePath(PathHandle ipath);
+
+  protected:
+  std::shared_ptr<Logger> logger;
+  std::vector<LinearAxis> axes;
+  std::vector<PathfinderLimits> limits; // The limits of each axis for SynchronizedProfile
+  std::vector<std::atomic<double>> axisPositions;
+  TimeUtil timeUtil;
+
+  // This must be locked when accessing paths or currentPath. It is never locked while following a
+  // path, because the follower holds its own reference to the path it is following.
+  mutable CrossplatformMutex currentPathMutex;
+
+  BasicPathTable<SynchronizedProfile> paths{};
+  PathHandle currentPath{};
+  std::string missingTargetId{}; // The target when it was set to an ID which has no path
+  PathHandle moveToPath{}; // The unnamed slot moveTo() generates its paths into
+  std::atomic_bool isRunning{false};
+  std::atomic_bool disabled{false};
+  std::atomic_bool dtorCalled{false};
+  CrossplatformThread *task{nullptr};
+
+  static void trampoline(void *context);
+  void loop();
+
+  /**
+   * Follow the supplied profile on every axis, sampling it at the time elapsed since its start.
+   * Must follow the disabled lifecycle. The caller keeps the profile alive until this returns, so
+   * no locking is needed to read it.
+   */
+  virtual void executeProfile(const SynchronizedProfile &profile,
+                              std::unique_ptr<AbstractRate> rate);
+
+  /**
+   * Sets the output of an axis to follow a velocity.
+   *
+   * @param iaxis The index of the axis.
+   * @param ivelocity The velocity in m/s.
+   */
+  void sendVelocity(std::size_t iaxis, double ivelocity);
+
+  /**
+   * Generates a synchronized profile and saves it with a handle. See `generatePath()`.
+   *
+   * @param imoves The move of each axis, in the same order as the axes.
+   * @param ipath The handle to save the path with.
+   * @param ishape The shape of the profiles.
+   */
+  void generateProfile(const std::vector<LinearMove> &imoves,
+                       PathHandle ipath,
+                       LinearProfileShape ishape);
+
+  /**
+   * @param ipath The handle of the path.
+   * @return The ID of the path, or an empty string if the handle is invalid or has no ID.
+   */
+  const std::string &getPathName(PathHandle ipath) const;
+
+  /**
+   * @param ipath The handle of the path.
+   * @return The saved path, or `nullptr` if there is no path with this handle.
+   */
+  std::shared_ptr<const SynchronizedProfile> findPath(PathHandle ipath) const;
+};
+} // namespace okapi
@@ -93,6 +93,16 @@ class AsyncPosPIDController : public AsyncWrapper<double, double>,
    */
   IterativePosPIDController::Gains getGains() const;
 
+  /**
+   * Records every step of the internal controller into a channel of a TelemetrySink. See
+   * IterativePosPIDController::setTelemetry().
+   *
+   * @param isink The sink, or `nullptr` to stop recording.
+   * @param ichannelName The name of the channel to record into.
+   */
+  void setTelemetry(std::shared_ptr<TelemetrySink> isink,
+                    const std::string &ichannelName = "AsyncPosPIDController");
+
   protected:
   std::shared_ptr<OffsetableControllerInput> offsettableInput;
   std::shared_ptr<IterativePosPIDController> internalController;
@@ -11,6 +11,7 @@
 #include "okapi/api/control/util/settledUtil.hpp"
 #include "okapi/api/coreProsAPI.hpp"
 #include "okapi/api/util/abstractRate.hpp"
+#include "okapi/api/util/controlExecutor.hpp"
 #include "okapi/api/util/logging.hpp"
 #include "okapi/api/util/mathUtil.hpp"
 #include "okapi/api/util/supplier.hpp"
@@ -52,6 +53,9 @@ class AsyncWrapper : virtual public AsyncController<Input, Output> {
 
   ~AsyncWrapper() override {
     dtorCalled.store(true, std::memory_order_release);
+    if (executor) {
+      executor->remove(executorLoopId);
+    }
     delete task;
   }
 
@@ -124,6 +128,9 @@ class AsyncWrapper : virtual public AsyncController<Input, Output> {
    */
   void setSampleTime(const QTime &isampleTime) {
     controller->setSampleTime(isampleTime);
+    if (executor) {
+      executor->setPeriod(executorLoopId, isampleTime);
+    }
   }
 
   /**
@@ -231,10 +238,25 @@ class AsyncWrapper : virtual public AsyncController<Input, Output> {
     }
   }
 
+  /**
+   * Runs the controller from a ControlExecutor instead of its own task. The controller is stepped
+   * every sample time. Call this instead of startThread().
+   *
+   * @param iexecutor The executor to run the controller from.
+   */
+  void startOnExecutor(const std::shared_ptr<ControlExecutor> &iexecutor) {
+    if (!task && !executor) {
+      executor = iexecutor;
+      executorLoopId =
+        executor->add("AsyncWrapper", controller->getSampleTime(), [this] { stepController(); });
+    }
+  }
+
   /**
    * Returns the underlying thread handle.
    *
-   * @return The underlying thread handle.
+   * @return The underlying thread handle, or `nullptr` if the controller runs from a
+   * ControlExecutor.
    */
   CrossplatformThread *getThread() const {
     return task;
@@ -251,6 +273,8 @@ class AsyncWrapper : virtual public AsyncController<Input, Output> {
   double ratio;
   std::atomic_bool dtorCalled{false};
   CrossplatformThread *task{nullptr};
+  std::shared_ptr<ControlExecutor> executor;
+  std::uint32_t executorLoopId{0};
 
   static void trampoline(void *context) {
     if (context) {
@@ -261,14 +285,20 @@ class AsyncWrapper : virtual public AsyncController<Input, Output> {
   void loop() {
     auto rate = rateSupplier.get();
     while (!dtorCalled.load(std::memory_order_acquire) && !task->notifyTake(0)) {
-      if (!isDisabled()) {
-        output->controllerSet(controller->step(input->controllerGet()));
-      }
-
+      stepController();
       rate->delayUntil(controller->getSampleTime());
     }
   }
 
+  /**
+   * Steps the controller once and writes its output, unless it is disabled.
+   */
+  void stepController() {
+    if (!isDisabled()) {
+      output->controllerSet(controller->step(input->controllerGet()));
+    }
+  }
+
   /**
    * Resumes moving after the controller is reset. Should not cause movement if the controller is
    * turned off, reset, and turned back on.
@@ -12,6 +12,7 @@
 #include "okapi/api/filter/filter.hpp"
 #include "okapi/api/filter/passthroughFilter.hpp"
 #include "okapi/api/util/logging.hpp"
+#include "okapi/api/util/telemetrySink.hpp"
 #include "okapi/api/util/timeUtil.hpp"
 #include <limits>
 #include <memory>
@@ -237,6 +238,17 @@ class IterativePosPIDController : public IterativePositionController<double, dou
    */
   Gains getGains() const;
 
+  /**
+   * Records the target, reading, error, P, I, and D terms, output, and dt of every step which
+   * updates the output into a channel of a TelemetrySink, such as a TelemetryRecorder. Safe to
+   * call while another task is stepping the controller.
+   *
+   * @param isink The sink, or `nullptr` to stop recording.
+   * @param ichannelName The name of the channel to record into.
+   */
+  void setTelemetry(std::shared_ptr<TelemetrySink> isink,
+                    const std::string &ichannelName = "IterativePosPIDController");
+
   protected:
   std::shared_ptr<Logger> logger;
   double kP, kI, kD, kBias;
@@ -272,5 +284,12 @@ class IterativePosPIDController : public IterativePositionController<double, dou
 
   std::unique_ptr<AbstractTimer> loopDtTimer;
   std::unique_ptr<SettledUtil> settledUtil;
+
+  // The sink and channel are swapped together so step() never sees one without the other
+  struct TelemetryDestination {
+    std::shared_ptr<TelemetrySink> sink;
+    std::uint16_t channel;
+  };
+  std::shared_ptr<const TelemetryDestination> telemetry{nullptr};
 };
 } // namespace okapi
@@ -0,0 +1,95 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+#include "squiggles.hpp"
+
+namespace okapi {
+/**
+ * The file formats a motion profile path can be stored in.
+ */
+enum class PathFileFormat {
+  binary, ///< The versioned binary format described by BinaryPathFormat, stored as `<id>.bin`.
+  csv     ///< The squiggles CSV format, stored as `<id>.csv`. The default.
+};
+
+/**
+ * A versioned binary encoding for generated paths. A file consists of a fixed 16 byte header
+ * followed by packed, fixed-size point records. All values are little-endian.
+ *
+ * Header:
+ *   - `uint32` magic (`"OKPF"`)
+ *   - `uint16` format version
+ *   - `uint16` number of wheel velocities per point
+ *   - `uint32` number of points
+ *   - `uint32` CRC-32 of the point records
+ *
+ * Point record (one `double` per field):
+ *   - `x`, `y`, `yaw`, `vel`, `accel`, `jerk`, `curvature`, `time`
+ *   - one entry per wheel velocity
+ *
+ * Because the records start on an 8 byte boundary, a file can be read into memory with a single
+ * read (or mapped into memory on the host) and decoded in place without any text parsing.
+ */
+class BinaryPathFormat {
+  public:
+  static constexpr std::uint32_t magic = 0x46504B4F; // "OKPF" in little-endian order
+  static constexpr std::uint16_t version = 1;
+  static constexpr std::size_t headerSize = 16;
+  static constexpr std::size_t fieldsPerPoint = 8;
+
+  /**
+   * Encodes a path into a buffer.
+   *
+   * @param ipath The path to encode.
+   * @return The encoded path.
+   */
+  static std::vector<std::uint8_t> encode(const std::vector<squiggles::ProfilePoint> &ipath);
+
+  /**
+   * Decodes a path from a buffer, such as a file read in one go or a memory mapped file. Returns
+   * an empty optional if the buffer does not hold a valid path (wrong magic number, unsupported
+   * version, truncated data, or a checksum mismatch).
+   *
+   * @param idata The start of the encoded path.
+   * @param isize The number of bytes available at `idata`.
+   * @return The decoded path, if it was valid.
+   */
+  static std::optional<std::vector<squiggles::ProfilePoint>> decode(const std::uint8_t *idata,
+                                                                    std::size_t isize);
+
+  /**
+   * Encodes a path and writes it to a stream.
+   *
+   * @param ifile The stream to write to.
+   * @param ipath The path to write.
+   */
+  static void write(std::ostream &ifile, const std::vector<squiggles::ProfilePoint> &ipath);
+
+  /**
+   * Reads the rest of a stream into memory in one read and decodes it.
+   *
+   * @param ifile The stream to read from.
+   * @return The decoded path, if it was valid.
+   */
+  static std::optional<std::vector<squiggles::ProfilePoint>> read(std::istream &ifile);
+
+  /**
+   * Computes the CRC-32 (IEEE 802.3 polynomial) of a buffer.
+   *
+   * @param idata The start of the buffer.
+   * @param isize The length of the buffer.
+   * @return The checksum.
+   */
+  static std::uint32_t crc32(const std::uint8_t *idata, std::size_t isize);
+};
+} // namespace okapi
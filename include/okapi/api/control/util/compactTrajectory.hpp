@@ -0,0 +1,132 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "squiggles.hpp"
+
+namespace okapi {
+/**
+ * A compact, read-only copy of a generated path. Every field of every point is quantized to a
+ * 16-bit fixed-point value spread evenly over the range of that field in the path, so a point takes
+ * 2 bytes per field instead of the 8 bytes per field (plus a heap allocated wheel velocity vector)
+ * a `squiggles::ProfilePoint` takes.
+ *
+ * The points are stored as a struct of arrays (one column per field) in a single allocation.
+ *
+ * The quantization error of each field is bounded: a decoded value never differs from the original
+ * value by more than `getMaxError()` for that field, which is half of one quantization step plus
+ * a small allowance for floating point rounding.
+ */
+class CompactTrajectory {
+  public:
+  /**
+   * The fields of a point, in column order. The wheel velocities follow these columns.
+   */
+  enum class Field : std::size_t { x, y, yaw, vel, accel, jerk, curvature, time };
+
+  static constexpr std::size_t fieldCount = 8;
+  static constexpr std::size_t maxWheelCount = 4;
+
+  /**
+   * An empty trajectory.
+   */
+  CompactTrajectory() = default;
+
+  /**
+   * Quantizes a path. Throws a `std::invalid_argument` if a point has more than `maxWheelCount`
+   * wheel velocities, if the points do not all have the same number of wheel velocities, or if any
+   * value is not finite.
+   *
+   * @param ipath The path to quantize.
+   */
+  explicit CompactTrajectory(const std::vector<squiggles::ProfilePoint> &ipath);
+
+  CompactTrajectory(CompactTrajectory &&other) noexcept = default;
+
+  CompactTrajectory &operator=(CompactTrajectory &&other) noexcept = default;
+
+  /**
+   * @return The number of points.
+   */
+  std::size_t size() const;
+
+  /**
+   * @return Whether there are no points.
+   */
+  bool empty() const;
+
+  /**
+   * @return The number of wheel velocities per point.
+   */
+  std::size_t getWheelCount() const;
+
+  /**
+   * @param ifield The field.
+   * @param iindex The index of the point.
+   * @return The decoded value of the field.
+   */
+  double get(Field ifield, std::size_t iindex) const;
+
+  /**
+   * @param iwheel The index of the wheel.
+   * @param iindex The index of the point.
+   * @return The decoded wheel velocity.
+   */
+  double getWheelVelocity(std::size_t iwheel, std::size_t iindex) const;
+
+  /**
+   * Decodes a point.
+   *
+   * @param iindex The index of the point.
+   * @return The decoded point.
+   */
+  squiggles::ProfilePoint at(std::size_t iindex) const;
+
+  /**
+   * Decodes every point.
+   *
+   * @return The decoded path.
+   */
+  std::vector<squiggles::ProfilePoint> toProfile() const;
+
+  /**
+   * @param ifield The field.
+   * @return The largest difference between a decoded value of this field and its original value.
+   */
+  double getMaxError(Field ifield) const;
+
+  /**
+   * @param iwheel The index of the wheel.
+   * @return The largest difference between a decoded wheel velocity and its original value.
+   */
+  double getWheelVelocityMaxError(std::size_t iwheel) const;
+
+  /**
+   * @return The number of bytes used by this trajectory, including the object itself.
+   */
+  std::size_t getBytesUsed() const;
+
+  protected:
+  struct ColumnRange {
+    double offset{0};
+    double scale{0};
+  };
+
+  std::size_t pointCount{0};
+  std::size_t wheelCount{0};
+  std::array<ColumnRange, fieldCount + maxWheelCount> ranges{};
+  std::unique_ptr<std::uint16_t[]> columns{nullptr};
+
+  double decode(std::size_t icolumn, std::size_t iindex) const;
+  double maxError(std::size_t icolumn) const;
+};
+} // namespace okapi
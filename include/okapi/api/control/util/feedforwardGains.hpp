@@ -0,0 +1,37 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+namespace okapi {
+/**
+ * Gains of a voltage feedforward for one side of a drive. The voltage sent to a side is
+ *
+ *   `kS * sign(v) + kV * v + kA * a + kP * (expected distance - measured distance)`
+ *
+ * where `v` and `a` are the velocity and acceleration the profile wants that side's wheels to
+ * have. `kS`, `kV`, and `kA` are usually found with a characterization routine. `kP` is an optional
+ * feedback term which corrects the distance the wheels drifted from the profile; leave it at zero
+ * to follow the profile open-loop.
+ */
+struct FeedforwardGains {
+  double kS{0}; ///< The voltage needed to overcome static friction, in volts.
+  double kV{0}; ///< The voltage per wheel velocity, in volts per m/s.
+  double kA{0}; ///< The voltage per wheel acceleration, in volts per m/s/s.
+  double kP{0}; ///< The voltage per meter of wheel distance error, in volts per meter.
+
+  /**
+   * Computes the feedforward voltage, without the feedback term.
+   *
+   * @param ivelocity The wheel velocity in m/s.
+   * @param iacceleration The wheel acceleration in m/s/s.
+   * @return The voltage in volts.
+   */
+  double calculate(const double ivelocity, const double iacceleration) const {
+    const double staticSign = ivelocity > 0 ? 1 : (ivelocity < 0 ? -1 : 0);
+    return kS * staticSign + kV * ivelocity + kA * iacceleration;
+  }
+};
+} // namespace okapi
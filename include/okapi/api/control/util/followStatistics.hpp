@@ -0,0 +1,24 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/units/QTime.hpp"
+#include <cstddef>
+
+namespace okapi {
+/**
+ * Timing statistics of one run of a path follower. The lateness of a tick is how much later than
+ * one timestep after the previous tick it started. A tick is late if its lateness is more than
+ * `lateTickTolerance`, which absorbs the resolution of the millisecond timer.
+ */
+struct FollowStatistics {
+  static constexpr QTime lateTickTolerance = millisecond;
+
+  std::size_t ticks{0};     ///< The number of ticks the path was followed for.
+  std::size_t lateTicks{0}; ///< The number of late ticks.
+  QTime maxLateness{0_ms};  ///< The largest lateness of any tick.
+};
+} // namespace okapi
@@ -0,0 +1,49 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/units/QTime.hpp"
+#include <vector>
+
+namespace okapi {
+/**
+ * Estimates the actuation latency of a motor from a log of the velocities it was commanded and the
+ * velocities it was measured at, sampled together at a fixed period. The log can come from a
+ * simulator, a mock, or a real robot following a path. The estimate is the delay which best lines
+ * the measurements up with the commands, so it is a suggestion for
+ * `AsyncMotionProfileController::setActuationLatency()`.
+ *
+ * The commands and measurements may be in different units because they are compared by
+ * correlation, not by value. The log should include the motor speeding up or slowing down, since a
+ * constant velocity looks the same at every delay.
+ */
+class LatencyEstimator {
+  public:
+  /**
+   * The result of an estimate.
+   */
+  struct Estimate {
+    QTime latency;      ///< The estimated latency, a whole number of sample periods.
+    double correlation; ///< How well the delayed commands match the measurements, up to 1.
+  };
+
+  /**
+   * Estimates the latency. If the logs are different lengths, empty, or too short to try every
+   * delay up to `imaxLatency` with at least half of the samples overlapping, or if the sample
+   * period is not positive, an instance of `std::invalid_argument` is thrown.
+   *
+   * @param icommanded The commanded velocities.
+   * @param imeasured The measured velocities, sampled at the same times as the commands.
+   * @param isamplePeriod The time between samples.
+   * @param imaxLatency The largest latency to consider.
+   * @return The estimate.
+   */
+  static Estimate estimate(const std::vector<double> &icommanded,
+                           const std::vector<double> &imeasured,
+                           QTime isamplePeriod,
+                           QTime imaxLatency);
+};
+} // namespace okapi
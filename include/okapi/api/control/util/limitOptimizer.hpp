@@ -0,0 +1,148 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/chassis/controller/chassisScales.hpp"
+#include "okapi/api/control/util/pathfinderUtil.hpp"
+#include "okapi/api/control/util/trajectoryGenerator.hpp"
+#include "okapi/api/device/motor/abstractMotor.hpp"
+#include "okapi/api/units/QSpeed.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include "okapi/api/util/logging.hpp"
+#include "okapi/api/util/timeUtil.hpp"
+#include "okapi/api/util/workerPool.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace okapi {
+/**
+ * The measured limits of a skid-steer chassis.
+ */
+struct DriveConstraints {
+  double maxMotorAccel;    ///< The fastest the motors can accelerate the robot in m/s/s.
+  double maxTractionAccel; ///< The most total acceleration before the wheels slip in m/s/s.
+  double maxJerk;          ///< The jerk limit to give the limits which are found in m/s/s/s.
+  double usableSpeed{0.9}; ///< The fraction of the free speed of the motors to use.
+};
+
+/**
+ * A constraint which limits how fast a path can be followed.
+ */
+enum class LimitConstraint {
+  motorSpeed,        ///< The wheels are at the usable speed of the motors.
+  motorAcceleration, ///< The robot accelerates as fast as the motors can.
+  traction           ///< The acceleration along and across the path is at the traction limit.
+};
+
+/**
+ * The fastest limits LimitOptimizer found for a path.
+ */
+struct LimitSearchResult {
+  PathfinderLimits limits;    ///< The limits to generate the path with.
+  QTime duration;             ///< The time it takes to follow the path with these limits.
+  LimitConstraint binding;    ///< The constraint the path comes closest to.
+  double motorSpeedUsage;     ///< The max velocity as a fraction of the usable motor speed.
+  double motorAccelUsage;     ///< The max acceleration as a fraction of the motor limit.
+  double tractionUsage;       ///< The peak total acceleration as a fraction of the traction limit.
+  std::size_t evaluatedCount; ///< The number of limits which were tried.
+};
+
+/**
+ * Searches for the `PathfinderLimits` which follow a path in the least time without exceeding
+ * what the chassis can do. Each candidate is generated with TrajectoryGenerator, which keeps both
+ * wheels under the max velocity, and is feasible if the acceleration along the path combined with
+ * the acceleration across it (velocity squared times curvature) stays under the traction limit.
+ * The max velocity is searched up to the usable speed of the motors and the max acceleration up
+ * to the motor limit.
+ *
+ * The search tries a grid of limits, then a finer grid around the best one. The candidates are
+ * spread over a WorkerPool, so on the host every hardware thread is used. The limits found are
+ * for TrajectoryGenerator, so follow the path with
+ * `AsyncMotionProfileController::setNativeTrajectoryGeneration()` turned on.
+ */
+class LimitOptimizer {
+  public:
+  /**
+   * If any constraint is not positive, an instance of `std::invalid_argument` is thrown.
+   *
+   * @param itimeUtil The TimeUtil used to run the workers.
+   * @param iscales The dimensions of the chassis.
+   * @param ipair The gearset of the drive motors.
+   * @param iconstraints The measured limits of the chassis.
+   * @param igridSize The number of values of each limit to try in each pass.
+   * @param iworkerCount The number of worker tasks to search with.
+   * @param ilogger The logger this instance will log to.
+   */
+  LimitOptimizer(const TimeUtil &itimeUtil,
+                 const ChassisScales &iscales,
+                 const AbstractMotor::GearsetRatioPair &ipair,
+                 const DriveConstraints &iconstraints,
+                 std::size_t igridSize = 12,
+                 std::size_t iworkerCount = WorkerPool::getDefaultWorkerCount(),
+                 const std::shared_ptr<Logger> &ilogger = Logger::getDefaultLogger());
+
+  /**
+   * Finds the fastest limits for a path. If the path has fewer than two waypoints, an instance of
+   * `std::invalid_argument` is thrown. If no limits are feasible, an instance of
+   * `std::runtime_error` is thrown.
+   *
+   * @param iwaypoints The waypoints of the path.
+   * @return The fastest limits and how close they come to each constraint.
+   */
+  LimitSearchResult optimize(const std::vector<PathfinderPoint> &iwaypoints);
+
+  /**
+   * @return The fastest the wheels can go at the usable speed of the motors.
+   */
+  QSpeed getMaxWheelSpeed() const;
+
+  protected:
+  /**
+   * How one set of limits did.
+   */
+  struct Candidate {
+    PathfinderLimits limits;
+    bool feasible{false};
+    double duration{0};
+    double peakAccel{0};
+  };
+
+  std::shared_ptr<Logger> logger;
+  TimeUtil timeUtil;
+  ChassisScales scales;
+  DriveConstraints constraints;
+  double maxWheelSpeed;
+  std::size_t gridSize;
+  WorkerPool pool;
+
+  /**
+   * Generates a path with some limits and measures it. The generator is made the first time, and
+   * after that only has its limits changed, so the points are allocated and the shape of the path
+   * is built once for every candidate which shares it. It is made again if the path does not fit.
+   *
+   * @param iwaypoints The waypoints of the path.
+   * @param ilimits The limits to try.
+   * @param igenerator The generator to reuse, or `nullptr` to make one.
+   * @return How the limits did.
+   */
+  Candidate evaluate(const std::vector<PathfinderPoint> &iwaypoints,
+                     const PathfinderLimits &ilimits,
+                     std::unique_ptr<TrajectoryGenerator> &igenerator) const;
+
+  /**
+   * Evaluates a grid of limits on the workers and blocks until they are all done.
+   *
+   * @param iwaypoints The waypoints of the path.
+   * @param ivelocities The max velocities to try.
+   * @param iaccels The max accelerations to try with each max velocity.
+   * @return The candidates, one row per max velocity.
+   */
+  std::vector<Candidate> evaluateGrid(const std::vector<PathfinderPoint> &iwaypoints,
+                                      const std::vector<double> &ivelocities,
+                                      const std::vector<double> &iaccels);
+};
+} // namespace okapi
@@ -0,0 +1,66 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/linearProfile.hpp"
+#include <cstddef>
+#include <memory>
+#include <variant>
+#include <vector>
+
+#include "squiggles.hpp"
+
+namespace okapi {
+/**
+ * A path saved in AsyncLinearMotionProfileController. Like a StoredPath, it is immutable once it
+ * has been published and is shared through `std::shared_ptr`.
+ *
+ * The path is either a list of points generated by squiggles or a closed-form LinearProfile, which
+ * has no points.
+ */
+struct LinearPath {
+  /**
+   * @param iprofile The points of the path.
+   */
+  explicit LinearPath(std::vector<squiggles::ProfilePoint> iprofile);
+
+  /**
+   * @param ianalytic The closed-form profile of the path.
+   */
+  explicit LinearPath(LinearProfile ianalytic);
+
+  /**
+   * @return The number of points in the path, which is zero for a closed-form path.
+   */
+  std::size_t size() const;
+
+  /**
+   * @return Whether the path is closed-form instead of a list of points.
+   */
+  bool isAnalytic() const;
+
+  /**
+   * @return The points of the path. Only valid if `isAnalytic()` is false, otherwise an instance
+   * of `std::bad_variant_access` is thrown.
+   */
+  const std::vector<squiggles::ProfilePoint> &getProfile() const;
+
+  /**
+   * @return The closed-form profile of the path. Only valid if `isAnalytic()` is true, otherwise
+   * an instance of `std::bad_variant_access` is thrown.
+   */
+  const LinearProfile &getAnalytic() const;
+
+  /**
+   * @return The approximate number of bytes this path uses.
+   */
+  std::size_t getBytesUsed() const;
+
+  const std::variant<std::vector<squiggles::ProfilePoint>, LinearProfile> path;
+};
+
+using LinearPathPtr = std::shared_ptr<const LinearPath>;
+} // namespace okapi
@@ -0,0 +1,148 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/pathfinderUtil.hpp"
+#include "okapi/api/units/QLength.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include <array>
+#include <cstddef>
+
+namespace okapi {
+/**
+ * The shape of a LinearProfile.
+ */
+enum class LinearProfileShape {
+  trapezoidal, ///< Piecewise constant acceleration. Ignores the jerk limit.
+  sCurve       ///< Piecewise constant jerk. The acceleration is continuous.
+};
+
+/**
+ * A closed-form, rest-to-rest 1D motion profile. Instead of storing a point per timestep, the
+ * profile is stored as at most seven phases of constant jerk (or constant acceleration), so it
+ * takes a fixed, small amount of memory, builds in constant time, and can be sampled at any time
+ * in constant time.
+ *
+ * If the move is too short to reach the maximum velocity (or the maximum acceleration), the peak
+ * velocity is lowered so the profile still starts and ends at rest.
+ */
+class LinearProfile {
+  public:
+  /**
+   * The state of the profile at some time.
+   */
+  struct State {
+    double position;     ///< The position in meters.
+    double velocity;     ///< The velocity in m/s.
+    double acceleration; ///< The acceleration in m/s/s.
+  };
+
+  /**
+   * A profile which does not move.
+   */
+  LinearProfile() = default;
+
+  /**
+   * A profile from one position to another. The profile moves backwards if `iend` is before
+   * `istart`. If the limits are not all positive (the jerk limit only matters for
+   * `LinearProfileShape::sCurve`), an instance of `std::invalid_argument` is thrown.
+   *
+   * @param ishape The shape of the profile.
+   * @param istart The starting position.
+   * @param iend The ending position.
+   * @param ilimits The velocity, acceleration, and jerk limits.
+   */
+  LinearProfile(LinearProfileShape ishape,
+                const QLength &istart,
+                const QLength &iend,
+                const PathfinderLimits &ilimits);
+
+  /**
+   * Evaluates the profile. Times before the start hold the starting position and times after the
+   * end hold the ending position.
+   *
+   * @param itime The time since the start of the profile.
+   * @return The state of the profile at that time.
+   */
+  State sample(QTime itime) const;
+
+  /**
+   * Slows the profile down so it takes longer to follow. Time is scaled uniformly, so the velocity
+   * is divided by the scale, the acceleration by its square, and the jerk by its cube, which keeps
+   * the profile within its limits. If the duration is shorter than the duration of this profile,
+   * an instance of `std::invalid_argument` is thrown. A profile which does not move is unchanged.
+   *
+   * @param iduration The duration of the slower profile.
+   * @return The slower profile.
+   */
+  LinearProfile stretchedTo(QTime iduration) const;
+
+  /**
+   * @return The time it takes to follow the profile.
+   */
+  QTime getDuration() const;
+
+  /**
+   * @return The starting position in meters.
+   */
+  double getStart() const;
+
+  /**
+   * @return The ending position in meters.
+   */
+  double getEnd() const;
+
+  /**
+   * @return The largest speed reached in m/s.
+   */
+  double getPeakVelocity() const;
+
+  /**
+   * @return The shape of the profile.
+   */
+  LinearProfileShape getShape() const;
+
+  protected:
+  /**
+   * A phase of constant jerk. The position and velocity are relative to the start of the profile
+   * and measured in the direction of travel.
+   */
+  struct Phase {
+    double startTime;
+    double position;
+    double velocity;
+    double acceleration;
+    double jerk;
+  };
+
+  static constexpr std::size_t maxPhaseCount = 7;
+
+  LinearProfileShape shape{LinearProfileShape::trapezoidal};
+  double start{0};
+  double end{0};
+  double sign{1};
+  double duration{0};
+  double peakVelocity{0};
+  std::array<Phase, maxPhaseCount> phases{};
+  std::size_t phaseCount{0};
+
+  /**
+   * Appends a phase which starts where the previous one ended.
+   *
+   * @param iduration The length of the phase in seconds. Empty phases are skipped.
+   * @param iacceleration The acceleration at the start of the phase.
+   * @param ijerk The jerk during the phase.
+   */
+  void addPhase(double iduration, double iacceleration, double ijerk);
+
+  /**
+   * @return The acceleration at the end of the last phase.
+   */
+  double getFinalAcceleration() const;
+
+  static State evaluate(const Phase &iphase, double idt);
+};
+} // namespace okapi
@@ -0,0 +1,132 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/pathGenerationHandle.hpp"
+#include "okapi/api/coreProsAPI.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include "okapi/api/util/timeUtil.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace okapi {
+/**
+ * Tracks a batch of paths which are generated together, such as the paths of a PathManifest. Each
+ * path has its own PathGenerationHandle. Workers claim the paths one at a time, so cancelling the
+ * batch skips every path no worker has started, while the paths which are already finished stay
+ * saved and can be followed.
+ */
+class PathBatch {
+  public:
+  /**
+   * @param ihandles The handle of each path, in the order they should be generated.
+   * @param itimeUtil The TimeUtil used when waiting for the batch.
+   */
+  PathBatch(std::vector<std::shared_ptr<PathGenerationHandle>> ihandles,
+            const TimeUtil &itimeUtil);
+
+  /**
+   * @return The number of paths in the batch.
+   */
+  std::size_t size() const;
+
+  /**
+   * @param iindex The index of the path.
+   * @return The handle of the path.
+   */
+  const std::shared_ptr<PathGenerationHandle> &getHandle(std::size_t iindex) const;
+
+  /**
+   * @param iindex The index of the path.
+   * @return How long the path took to generate, or zero if it is not done or failed.
+   */
+  QTime getGenerationTime(std::size_t iindex) const;
+
+  /**
+   * @param iindex The index of the path.
+   * @return The approximate number of bytes the path uses, or zero if it is not done or failed.
+   */
+  std::size_t getBytesUsed(std::size_t iindex) const;
+
+  /**
+   * @return The number of bytes used by every path which is done.
+   */
+  std::size_t getTotalBytesUsed() const;
+
+  /**
+   * @return The number of paths which were generated successfully.
+   */
+  std::size_t getSucceededCount() const;
+
+  /**
+   * @return Whether every path has finished, successfully or not.
+   */
+  bool isDone() const;
+
+  /**
+   * Blocks the current task until every path has finished.
+   *
+   * @return Whether every path was generated successfully.
+   */
+  bool waitUntilDone() const;
+
+  /**
+   * Stops the batch early. Paths which are being generated are allowed to finish, and every path
+   * no worker has started is marked as failed and is no longer waited for by the controller. Call
+   * this at the start of autonomous so the workers stop competing with the control tasks.
+   */
+  void cancel();
+
+  /**
+   * @return Whether the batch was cancelled.
+   */
+  bool isCancelled() const;
+
+  /**
+   * Claims the next path to generate. Used by the workers of the controller which owns this batch.
+   *
+   * @return The index of the path, or `size()` if every path is claimed or the batch was cancelled.
+   */
+  std::size_t claimNext();
+
+  /**
+   * Gets the first path which `cancel()` skipped. Every path from it to the end was never claimed.
+   * If a cancel is in progress, this waits for it to finish. Used by the workers of the controller
+   * which owns this batch to clean up after the skipped paths.
+   *
+   * @return The index of the first skipped path, or `size()` if the batch was not cancelled.
+   */
+  std::size_t getFirstSkipped() const;
+
+  /**
+   * Records how a path was generated. Must be called before the handle of the path is marked as
+   * done. Used by the controller which owns this batch.
+   *
+   * @param iindex The index of the path.
+   * @param igenerationTime How long the path took to generate.
+   * @param ibytesUsed The approximate number of bytes the path uses.
+   */
+  void recordResult(std::size_t iindex, QTime igenerationTime, std::size_t ibytesUsed);
+
+  protected:
+  std::vector<std::shared_ptr<PathGenerationHandle>> handles;
+  TimeUtil timeUtil;
+
+  // Each entry is written once by the worker which claimed the path, before its handle is marked
+  // as done, so reading an entry after observing that is safe
+  std::vector<QTime> generationTimes;
+  std::vector<std::size_t> bytesUsed;
+
+  std::atomic_size_t nextIndex{0};
+  std::atomic_bool cancelled{false};
+
+  // Held for the whole of cancel() so firstSkipped can't be read while only part of it is done
+  mutable CrossplatformMutex cancelMutex;
+  std::size_t firstSkipped;
+};
+} // namespace okapi
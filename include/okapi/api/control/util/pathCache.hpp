@@ -0,0 +1,174 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/pathfinderUtil.hpp"
+#include "okapi/api/coreProsAPI.hpp"
+#include "okapi/api/units/QLength.hpp"
+#include "okapi/api/util/logging.hpp"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "squiggles.hpp"
+
+namespace okapi {
+/**
+ * A content-addressed cache of generated paths. Paths are keyed by everything that determines the
+ * generated trajectory (the waypoints, the limits, the wheel track, the timestep, the start and end
+ * velocities, and the generator), so generating the same path again returns the cached trajectory
+ * instead of running the spline generator. Entries are found by a hash of the inputs, and the
+ * inputs themselves are stored with each entry and compared on every lookup, so a hash collision
+ * is a miss rather than the wrong trajectory.
+ *
+ * The cache evicts the least recently used paths once the memory budget is exceeded. It can
+ * optionally persist paths to a directory (typically on the SD card) so it is still warm after a
+ * reboot. This class is safe to use from multiple tasks.
+ */
+class PathCache {
+  public:
+  /**
+   * The inputs of a path and their hash.
+   */
+  struct Key {
+    std::uint64_t hash{0};
+    std::string inputs{}; ///< Every input of the path, serialized.
+
+    bool operator==(const Key &rhs) const {
+      return hash == rhs.hash && inputs == rhs.inputs;
+    }
+
+    bool operator!=(const Key &rhs) const {
+      return !(rhs == *this);
+    }
+  };
+
+  using Path = std::shared_ptr<const std::vector<squiggles::ProfilePoint>>;
+
+  /**
+   * A content-addressed cache of generated paths.
+   *
+   * @param imaxBytes The memory budget for cached paths.
+   * @param ilogger The logger this instance will log to.
+   */
+  explicit PathCache(std::size_t imaxBytes = 256 * 1024,
+                     const std::shared_ptr<Logger> &ilogger = Logger::getDefaultLogger());
+
+  /**
+   * Computes the key for a path. Every input is serialized, along with the number of waypoints, so
+   * paths with different inputs never have the same key, even if their hashes collide.
+   *
+   * @param iwaypoints The waypoints of the path.
+   * @param ilimits The limits used to generate the path.
+   * @param iwheelTrack The wheel track of the chassis.
+   * @param idt The timestep of the path in seconds.
+   * @param istartVel The velocity at the start of the path in m/s.
+   * @param iendVel The velocity at the end of the path in m/s.
+   * @param inative Whether the path was generated with TrajectoryGenerator instead of squiggles.
+   * @return The key.
+   */
+  static Key makeKey(const std::vector<PathfinderPoint> &iwaypoints,
+                     const PathfinderLimits &ilimits,
+                     const QLength &iwheelTrack,
+                     double idt,
+                     double istartVel = 0,
+                     double iendVel = 0,
+                     bool inative = false);
+
+  /**
+   * Looks up a path. If it is not in memory and a persistence directory is set, it is loaded from
+   * there. A path saved with the same hash but different inputs is not returned. Counts a hit or a
+   * miss.
+   *
+   * @param ikey The key of the path.
+   * @return The path, or `nullptr` if it is not cached.
+   */
+  Path get(const Key &ikey);
+
+  /**
+   * Adds a path to the cache, evicting the least recently used paths if needed. If a persistence
+   * directory is set, the path is also written there along with its inputs. Paths larger than the
+   * whole budget are not kept in memory. A path whose hash collides with a cached path replaces
+   * it.
+   *
+   * @param ikey The key of the path.
+   * @param ipath The path.
+   */
+  void put(const Key &ikey, Path ipath);
+
+  /**
+   * Sets the directory paths are persisted to. An empty string disables persistence. The
+   * directory must exist. On the brain, this should be on the SD card (e.g. `/usd/paths`).
+   *
+   * @param idirectory The directory.
+   */
+  void setPersistenceDirectory(const std::string &idirectory);
+
+  /**
+   * Removes every path from memory. Persisted paths are kept.
+   */
+  void clear();
+
+  /**
+   * @return The number of lookups which found a path.
+   */
+  std::size_t getHits() const;
+
+  /**
+   * @return The number of lookups which did not find a path.
+   */
+  std::size_t getMisses() const;
+
+  /**
+   * @return The number of paths in memory.
+   */
+  std::size_t size() const;
+
+  /**
+   * @return The approximate memory used by the paths in memory.
+   */
+  std::size_t getBytesUsed() const;
+
+  /**
+   * @return The memory budget.
+   */
+  std::size_t getMaxBytes() const;
+
+  /**
+   * Estimates the memory used by a path.
+   *
+   * @param ipath The path.
+   * @return The approximate number of bytes the path uses.
+   */
+  static std::size_t estimateBytes(const std::vector<squiggles::ProfilePoint> &ipath);
+
+  protected:
+  struct Entry {
+    std::string inputs;
+    Path path;
+    std::size_t bytes;
+    std::list<std::uint64_t>::iterator lruPosition;
+  };
+
+  std::shared_ptr<Logger> logger;
+  const std::size_t maxBytes;
+  std::string persistenceDirectory{""};
+
+  // Must be locked when accessing any of the members below
+  mutable CrossplatformMutex mutex;
+  std::unordered_map<std::uint64_t, Entry> entries{}; // By the hash of the key
+  std::list<std::uint64_t> lru{};                     // Most recently used first
+  std::size_t bytesUsed{0};
+  std::size_t hits{0};
+  std::size_t misses{0};
+
+  void insert(const Key &ikey, Path ipath);
+  static std::string makeFileName(const std::string &idirectory, const Key &ikey);
+};
+} // namespace okapi
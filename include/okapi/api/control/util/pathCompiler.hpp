@@ -0,0 +1,69 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/pathfinderUtil.hpp"
+#include "okapi/api/units/QLength.hpp"
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace okapi {
+/**
+ * A list of paths to compile at build time.
+ */
+struct PathManifest {
+  struct Entry {
+    std::string id;
+    std::vector<PathfinderPoint> waypoints;
+    PathfinderLimits limits;
+  };
+
+  QLength wheelTrack{0_m};
+  std::vector<Entry> paths{};
+};
+
+/**
+ * Compiles paths on the host so the robot does not have to generate or load them at startup. The
+ * compiler turns a manifest into a C++ header of `constexpr` arrays, which
+ * `AsyncMotionProfileController::addPathViews()` follows in place.
+ *
+ * A manifest is a text file with one directive per line. Everything after a `#` is a comment.
+ *
+ * ```
+ * wheelTrack 0.3           # The wheel track in meters.
+ * limits 1.0 2.0 10.0      # The max velocity, acceleration, and jerk for the paths below it.
+ * path A 0 0 0 1 0 0       # An ID followed by waypoints as x (m), y (m), and theta (deg).
+ * ```
+ */
+class PathCompiler {
+  public:
+  /**
+   * Parses a manifest. If the manifest is malformed, an instance of `std::invalid_argument` is
+   * thrown which describes the line at fault.
+   *
+   * @param imanifest The manifest.
+   * @return The parsed manifest.
+   */
+  static PathManifest parseManifest(std::istream &imanifest);
+
+  /**
+   * Generates every path in a manifest and writes them as a C++ header. The header declares one
+   * `constexpr okapi::StaticPathPoint` array per path and a `constexpr okapi::NamedPathView` array
+   * called `paths` which lists them, all inside the given namespace. If a path can't be compiled,
+   * an instance of `std::invalid_argument` is thrown.
+   *
+   * @param iout The stream to write the header to.
+   * @param imanifest The manifest.
+   * @param inamespace The namespace to declare the paths in.
+   * @param idt The timestep between points.
+   */
+  static void emitHeader(std::ostream &iout,
+                         const PathManifest &imanifest,
+                         const std::string &inamespace,
+                         double idt);
+};
+} // namespace okapi
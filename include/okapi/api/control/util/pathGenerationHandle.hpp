@@ -0,0 +1,92 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/util/timeUtil.hpp"
+#include <atomic>
+#include <string>
+
+namespace okapi {
+/**
+ * Tracks a path which is being generated in the background. Returned by
+ * `AsyncMotionProfileController::generatePathAsync()`.
+ */
+class PathGenerationHandle {
+  public:
+  enum class State {
+    queued,     ///< Waiting for a free worker.
+    generating, ///< A worker is generating the path.
+    done,       ///< The path was generated and can be followed.
+    failed,     ///< The path could not be generated. See `getErrorMessage()`.
+    superseded  ///< A newer path was saved with the same ID, so this one was dropped.
+  };
+
+  /**
+   * @param ipathId The ID the path will be saved with.
+   * @param itimeUtil The TimeUtil used when waiting for the path.
+   */
+  PathGenerationHandle(std::string ipathId, const TimeUtil &itimeUtil);
+
+  /**
+   * @return The ID the path will be saved with.
+   */
+  const std::string &getPathId() const;
+
+  /**
+   * @return The current state of the generation.
+   */
+  State getState() const;
+
+  /**
+   * @return Whether generation has finished, successfully or not, or was superseded.
+   */
+  bool isDone() const;
+
+  /**
+   * Blocks the current task until generation has finished or was superseded.
+   *
+   * @return Whether the path was generated successfully.
+   */
+  bool waitUntilDone() const;
+
+  /**
+   * @return Why generation failed, or an empty string if it has not failed.
+   */
+  std::string getErrorMessage() const;
+
+  /**
+   * Marks the path as generating if it is still queued. Used by the controller which owns this
+   * handle.
+   */
+  void markGenerating();
+
+  /**
+   * Marks the path as done. Used by the controller which owns this handle.
+   */
+  void markDone();
+
+  /**
+   * Marks the path as failed. Used by the controller which owns this handle.
+   *
+   * @param ierrorMessage Why generation failed.
+   */
+  void markFailed(const std::string &ierrorMessage);
+
+  /**
+   * Marks the path as superseded by a newer path with the same ID. Used by the controller which
+   * owns this handle.
+   */
+  void markSuperseded();
+
+  protected:
+  const std::string pathId;
+  TimeUtil timeUtil;
+  std::atomic<State> state{State::queued};
+
+  // Only written before state becomes failed, so reading it after observing failed is safe
+  std::string errorMessage{""};
+};
+} // namespace okapi
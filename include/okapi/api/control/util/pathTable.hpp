@@ -0,0 +1,179 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/pathGenerationHandle.hpp"
+#include "okapi/api/control/util/storedPath.hpp"
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace okapi {
+/**
+ * A reference to a path saved in a motion profile controller. A handle is an index into the
+ * controller's table of paths, so starting a path with a handle doesn't look up or copy its name.
+ * A handle stays valid for the life of the controller which returned it: removing or replacing the
+ * path keeps the handle, and saving a path with the same name again reuses it.
+ */
+class PathHandle {
+  public:
+  /**
+   * A handle which doesn't refer to any path.
+   */
+  constexpr PathHandle() = default;
+
+  /**
+   * @param iindex The index of the path in its table.
+   */
+  constexpr explicit PathHandle(const std::uint32_t iindex) : index(iindex) {
+  }
+
+  /**
+   * @return Whether this handle refers to a path name.
+   */
+  constexpr bool isValid() const {
+    return index != invalidIndex;
+  }
+
+  /**
+   * @return The index of the path in its table.
+   */
+  constexpr std::uint32_t getIndex() const {
+    return index;
+  }
+
+  constexpr bool operator==(const PathHandle &rhs) const {
+    return index == rhs.index;
+  }
+
+  constexpr bool operator!=(const PathHandle &rhs) const {
+    return index != rhs.index;
+  }
+
+  static constexpr std::uint32_t invalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+  private:
+  std::uint32_t index{invalidIndex};
+};
+
+/**
+ * The paths saved in a motion profile controller, in a flat table indexed by PathHandle. Each name
+ * is interned into one slot the first time it is seen and keeps that slot for the life of the
+ * table, so a handle always refers to the same name. Slots are never moved, so a reference returned
+ * by `getName()` stays valid for the life of the table.
+ *
+ * This class is not thread-safe. The controllers guard their table with their path mutex.
+ *
+ * @tparam Path The type of the immutable paths the table holds. The table is instantiated for
+ * StoredPath (see `PathTable`), LinearPath, and SynchronizedProfile.
+ */
+template <typename Path> class BasicPathTable {
+  public:
+  using PathPtr = std::shared_ptr<const Path>;
+
+  /**
+   * Finds the handle of a name, adding a slot for it if it doesn't have one yet.
+   *
+   * @param iname The name of the path.
+   * @return The handle.
+   */
+  PathHandle intern(const std::string &iname);
+
+  /**
+   * Adds a slot without a name. The slot can only be reached through the returned handle, so no
+   * path saved by name can ever collide with it.
+   *
+   * @return The handle.
+   */
+  PathHandle addUnnamed();
+
+  /**
+   * Finds the handle of a name without adding a slot.
+   *
+   * @param iname The name of the path.
+   * @return The handle, or an invalid handle if the name has never been interned.
+   */
+  PathHandle find(const std::string &iname) const;
+
+  /**
+   * @param ihandle The handle.
+   * @return The name of the path, or an empty string if the handle is invalid or has no name.
+   */
+  const std::string &getName(PathHandle ihandle) const;
+
+  /**
+   * @param ihandle The handle.
+   * @return The path, or `nullptr` if the handle is invalid or there is no path saved with it.
+   */
+  PathPtr get(PathHandle ihandle) const;
+
+  /**
+   * Saves a path in a slot, replacing any path already there.
+   *
+   * @param ihandle A valid handle from this table.
+   * @param ipath The path, or `nullptr` to remove the path.
+   */
+  void set(PathHandle ihandle, PathPtr ipath);
+
+  /**
+   * @param ihandle The handle.
+   * @return The path which is being generated into this slot, or `nullptr` if there is none.
+   */
+  std::shared_ptr<PathGenerationHandle> getPending(PathHandle ihandle) const;
+
+  /**
+   * Records that a path is being generated into a slot.
+   *
+   * @param ihandle A valid handle from this table.
+   * @param ipending The generation, or `nullptr` when it has finished.
+   */
+  void setPending(PathHandle ihandle, std::shared_ptr<PathGenerationHandle> ipending);
+
+  /**
+   * @return The names of the slots which have a path saved in them, in sorted order. Slots without
+   * a name are not included.
+   */
+  std::vector<std::string> getNames() const;
+
+  /**
+   * @return Every path being generated.
+   */
+  std::vector<std::shared_ptr<PathGenerationHandle>> getAllPending() const;
+
+  /**
+   * Removes every path and generation. The names stay interned so existing handles stay valid.
+   */
+  void clear();
+
+  private:
+  struct Slot {
+    std::string name;
+    PathPtr path{nullptr};
+    std::shared_ptr<PathGenerationHandle> pending{nullptr};
+  };
+
+  const Slot *findSlot(PathHandle ihandle) const;
+
+  std::deque<Slot> slots{};
+  std::map<std::string, PathHandle, std::less<>> handles{};
+};
+
+struct LinearPath;
+class SynchronizedProfile;
+
+extern template class BasicPathTable<StoredPath>;
+extern template class BasicPathTable<LinearPath>;
+extern template class BasicPathTable<SynchronizedProfile>;
+
+/**
+ * The table of a motion profile controller which follows StoredPaths.
+ */
+using PathTable = BasicPathTable<StoredPath>;
+} // namespace okapi
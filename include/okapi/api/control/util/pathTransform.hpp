@@ -0,0 +1,85 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/pathfinderUtil.hpp"
+#include <vector>
+
+#include "squiggles.hpp"
+
+namespace okapi {
+/**
+ * Derives new paths from existing ones without generating a spline again. Each operation visits
+ * every point once, so reusing a base shape from another start pose or side of the field costs a
+ * copy of the path instead of a new generation.
+ *
+ * Poses are given in the same frame as the waypoints of `generatePath()`: x forwards, y to the
+ * right, and theta clockwise.
+ */
+class PathTransform {
+  public:
+  /**
+   * Moves and rotates a path as if it had been generated with its origin at another pose. A path
+   * generated from `{0_m, 0_m, 0_deg}` will start at `iorigin`.
+   *
+   * @param ipath The path.
+   * @param iorigin Where the origin of the path is moved to.
+   * @return The moved path.
+   */
+  static std::vector<squiggles::ProfilePoint> transform(std::vector<squiggles::ProfilePoint> ipath,
+                                                        const PathfinderPoint &iorigin);
+
+  /**
+   * Mirrors a path across a line. The default line is the heading of a path generated from
+   * `{0_m, 0_m, 0_deg}`, which gives the same movement as following the path mirrored. The left
+   * and right wheels are swapped.
+   *
+   * @param ipath The path.
+   * @param iaxis A point on the line and the direction of the line.
+   * @return The mirrored path.
+   */
+  static std::vector<squiggles::ProfilePoint>
+  mirror(std::vector<squiggles::ProfilePoint> ipath,
+         const PathfinderPoint &iaxis = {0_m, 0_m, 0_deg});
+
+  /**
+   * Reverses a path so it retraces its points from the end to the start while driving backwards.
+   * The robot keeps the heading it had at each point.
+   *
+   * @param ipath The path.
+   * @return The reversed path.
+   */
+  static std::vector<squiggles::ProfilePoint> reverse(std::vector<squiggles::ProfilePoint> ipath);
+
+  /**
+   * Joins two paths. The second path is moved and rotated so it starts where the first one ends,
+   * and its first point is dropped because it is the same as the last point of the first path. If
+   * the velocity at the end of the first path and the start of the second path differ by more
+   * than `imaxVelocityJump`, an instance of `std::invalid_argument` is thrown.
+   *
+   * @param ifirst The first path.
+   * @param isecond The path to follow after the first path.
+   * @param imaxVelocityJump The largest change in velocity allowed at the joint in m/s.
+   * @return The joined path.
+   */
+  static std::vector<squiggles::ProfilePoint>
+  stitch(std::vector<squiggles::ProfilePoint> ifirst,
+         const std::vector<squiggles::ProfilePoint> &isecond,
+         double imaxVelocityJump);
+
+  /**
+   * Joins two paths like `stitch()` above, allowing the change in velocity either path could make
+   * in one of its own timesteps at its own largest acceleration.
+   *
+   * @param ifirst The first path.
+   * @param isecond The path to follow after the first path.
+   * @return The joined path.
+   */
+  static std::vector<squiggles::ProfilePoint>
+  stitch(std::vector<squiggles::ProfilePoint> ifirst,
+         const std::vector<squiggles::ProfilePoint> &isecond);
+};
+} // namespace okapi
@@ -0,0 +1,95 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstddef>
+
+namespace okapi {
+/**
+ * One point of a path compiled at build time. This is a literal type so compiled paths can be
+ * `constexpr` arrays, which the linker places in flash instead of on the heap.
+ */
+struct StaticPathPoint {
+  double x;
+  double y;
+  double yaw;
+  double vel;
+  double accel;
+  double jerk;
+  double curvature;
+  double time;
+  double wheelVelocities[2]; ///< The left and right wheel velocities.
+};
+
+/**
+ * A non-owning, read-only view of the points of a compiled path. The points must outlive every
+ * controller the view is given to, which is always true for the `constexpr` arrays emitted by the
+ * path compiler.
+ */
+class PathView {
+  public:
+  /**
+   * An empty view.
+   */
+  constexpr PathView() = default;
+
+  /**
+   * @param ipoints The first point.
+   * @param isize The number of points.
+   */
+  constexpr PathView(const StaticPathPoint *ipoints, const std::size_t isize)
+    : points(ipoints), count(isize) {
+  }
+
+  /**
+   * @param ipoints The points.
+   */
+  template <std::size_t N>
+  constexpr PathView(const StaticPathPoint (&ipoints)[N]) : points(ipoints), count(N) {
+  }
+
+  /**
+   * @return The number of points.
+   */
+  constexpr std::size_t size() const {
+    return count;
+  }
+
+  /**
+   * @return Whether there are no points.
+   */
+  constexpr bool empty() const {
+    return count == 0;
+  }
+
+  /**
+   * @return The first point.
+   */
+  constexpr const StaticPathPoint *data() const {
+    return points;
+  }
+
+  /**
+   * @param iindex The index of the point.
+   * @return The point.
+   */
+  constexpr const StaticPathPoint &operator[](const std::size_t iindex) const {
+    return points[iindex];
+  }
+
+  protected:
+  const StaticPathPoint *points{nullptr};
+  std::size_t count{0};
+};
+
+/**
+ * A compiled path and the ID it was compiled with.
+ */
+struct NamedPathView {
+  const char *id;
+  PathView path;
+};
+} // namespace okapi
@@ -0,0 +1,53 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "squiggles.hpp"
+
+namespace okapi {
+/**
+ * Gains of a RAMSETE controller. The defaults work for most robots with distances in meters and
+ * angles in radians.
+ */
+struct RamseteGains {
+  double b{2.0};    ///< How aggressively to correct errors. Must be positive.
+  double zeta{0.7}; ///< How much to damp the correction, between zero and one.
+};
+
+/**
+ * The RAMSETE nonlinear trajectory tracking controller. Given where a differential drive should
+ * be, how fast it should be moving there, and where it actually is, it computes the linear and
+ * angular velocity which drive the error to zero. Poses are in the path's frame: x and y in
+ * meters and yaw in radians counterclockwise, like the points of a squiggles path.
+ */
+class Ramsete {
+  public:
+  /**
+   * A velocity command for the whole chassis.
+   */
+  struct Command {
+    double linear;  ///< The linear velocity in m/s.
+    double angular; ///< The angular velocity in rad/s, counterclockwise.
+  };
+
+  /**
+   * Computes a corrected velocity. If the robot is exactly where it should be, this returns the
+   * reference velocity unchanged.
+   *
+   * @param ireference Where the robot should be.
+   * @param ilinear The linear velocity the path wants at the reference in m/s.
+   * @param iangular The angular velocity the path wants at the reference in rad/s.
+   * @param iactual Where the robot is.
+   * @param igains The gains.
+   * @return The corrected velocity.
+   */
+  static Command calculate(const squiggles::Pose &ireference,
+                           double ilinear,
+                           double iangular,
+                           const squiggles::Pose &iactual,
+                           const RamseteGains &igains);
+};
+} // namespace okapi
@@ -0,0 +1,41 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/pathfinderUtil.hpp"
+#include "okapi/api/units/QLength.hpp"
+#include <vector>
+
+#include "squiggles.hpp"
+
+namespace okapi {
+/**
+ * Generates paths for a skid-steer chassis with squiggles. AsyncMotionProfileController generates
+ * its paths with this on the robot and PathCompiler compiles paths with it on the host, so a
+ * compiled path matches one generated on the robot.
+ */
+class SplineProfile {
+  public:
+  /**
+   * Generates a path through the waypoints.
+   *
+   * @param iwaypoints The waypoints to hit on the path.
+   * @param ilimits The limits of the path.
+   * @param iwheelTrack The wheel track of the chassis.
+   * @param idt The timestep between points.
+   * @param istartVel The velocity at the start of the path in m/s.
+   * @param iendVel The velocity at the end of the path in m/s.
+   * @return The path.
+   */
+  static std::vector<squiggles::ProfilePoint>
+  generate(const std::vector<PathfinderPoint> &iwaypoints,
+           const PathfinderLimits &ilimits,
+           const QLength &iwheelTrack,
+           double idt,
+           double istartVel = 0,
+           double iendVel = 0);
+};
+} // namespace okapi
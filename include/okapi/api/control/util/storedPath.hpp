@@ -0,0 +1,162 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/compactTrajectory.hpp"
+#include "okapi/api/control/util/pathView.hpp"
+#include <cstddef>
+#include <memory>
+#include <variant>
+#include <vector>
+
+#include "squiggles.hpp"
+
+namespace okapi {
+/**
+ * A ready-to-send pair of motor commands, normalized to the range `[-1, 1]` of the gearset.
+ */
+struct MotorCommand {
+  double left;
+  double right;
+};
+
+/**
+ * A path saved in a motion profile controller. A StoredPath is immutable once it has been
+ * published, and it is shared through `std::shared_ptr`. The task following a path holds its own
+ * reference, so replacing or removing the path while it is being followed never invalidates the
+ * data being followed and the follower never has to lock anything.
+ *
+ * The points are held in exactly one form: at full precision, quantized in a CompactTrajectory, or
+ * compiled into the program and referenced by a PathView.
+ */
+struct StoredPath {
+  /**
+   * The number of command variants in a compiled path (every combination of mirrored and
+   * reversed).
+   */
+  static constexpr std::size_t commandVariantCount = 4;
+
+  /**
+   * @param iprofile The profile of the path.
+   * @param icommands The compiled motor commands, laid out as described by `commandOffset()`, or
+   * empty if the path is not compiled.
+   */
+  explicit StoredPath(std::vector<squiggles::ProfilePoint> iprofile,
+                      std::vector<MotorCommand> icommands = {});
+
+  /**
+   * @param icompact The quantized profile of the path.
+   * @param icommands The compiled motor commands, laid out as described by `commandOffset()`, or
+   * empty if the path is not compiled.
+   */
+  explicit StoredPath(CompactTrajectory icompact, std::vector<MotorCommand> icommands = {});
+
+  /**
+   * @param iview The compiled points of the path. They are not copied.
+   */
+  explicit StoredPath(PathView iview);
+
+  /**
+   * @return The number of points in the path.
+   */
+  std::size_t size() const;
+
+  /**
+   * @return Whether the points are quantized.
+   */
+  bool isCompact() const;
+
+  /**
+   * @return Whether the points are compiled into the program.
+   */
+  bool isView() const;
+
+  /**
+   * @return The full precision points. Only valid if the path is neither compact nor a view,
+   * otherwise an instance of `std::bad_variant_access` is thrown.
+   */
+  const std::vector<squiggles::ProfilePoint> &getProfile() const;
+
+  /**
+   * @return The quantized points. Only valid if `isCompact()` is true, otherwise an instance of
+   * `std::bad_variant_access` is thrown.
+   */
+  const CompactTrajectory &getCompact() const;
+
+  /**
+   * @return The compiled points. Only valid if `isView()` is true, otherwise an instance of
+   * `std::bad_variant_access` is thrown.
+   */
+  const PathView &getView() const;
+
+  /**
+   * @param iwheel The index of the wheel.
+   * @param iindex The index of the point.
+   * @return The wheel velocity of the point.
+   */
+  double getWheelVelocity(std::size_t iwheel, std::size_t iindex) const;
+
+  /**
+   * @param iindex The index of the point.
+   * @return The pose of the point.
+   */
+  squiggles::Pose getPose(std::size_t iindex) const;
+
+  /**
+   * @return A full precision copy of the points. Compact paths are decoded.
+   */
+  std::vector<squiggles::ProfilePoint> toProfile() const;
+
+  /**
+   * @return The approximate number of bytes this path uses, including the motor command table. The
+   * points of a view are not counted because they are not on the heap.
+   */
+  std::size_t getBytesUsed() const;
+
+  /**
+   * @return Whether the motor commands for this path were compiled.
+   */
+  bool hasCommands() const;
+
+  /**
+   * Gets the compiled motor commands of a variant. There is one command per profile point. Only
+   * valid if `hasCommands()` is true.
+   *
+   * @param imirrored Whether the path is followed mirrored.
+   * @param ireversed Whether the path is followed backwards.
+   * @return The first command of the variant.
+   */
+  const MotorCommand *getCommands(bool imirrored, bool ireversed) const;
+
+  /**
+   * Computes where a variant starts in the packed command array. The variants are stored one after
+   * another, each `isegments` long.
+   *
+   * @param imirrored Whether the variant is mirrored.
+   * @param ireversed Whether the variant is reversed.
+   * @param isegments The number of points in the path.
+   * @return The index of the first command of the variant.
+   */
+  static constexpr std::size_t
+  commandOffset(const bool imirrored, const bool ireversed, const std::size_t isegments) {
+    return (static_cast<std::size_t>(imirrored) + 2 * static_cast<std::size_t>(ireversed)) *
+           isegments;
+  }
+
+  /**
+   * Estimates the memory used by a full precision path.
+   *
+   * @param iprofile The path.
+   * @return The approximate number of bytes the path uses.
+   */
+  static std::size_t estimateBytes(const std::vector<squiggles::ProfilePoint> &iprofile);
+
+  const std::variant<std::vector<squiggles::ProfilePoint>, CompactTrajectory, PathView> points;
+  const std::vector<MotorCommand> commands;
+};
+
+using StoredPathPtr = std::shared_ptr<const StoredPath>;
+} // namespace okapi
@@ -0,0 +1,90 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/storedPath.hpp"
+#include "okapi/api/coreProsAPI.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include <atomic>
+#include <vector>
+
+namespace okapi {
+/**
+ * A path which is followed as a sequence of chunks, back to back, while later chunks may still be
+ * generating. One task (the producer) appends chunks in order and another task (the follower)
+ * reads them. Consecutive chunks must agree on the velocity where they meet so the follower can go
+ * from one to the next without stopping. This class is safe to use from multiple tasks.
+ */
+class StreamingPath {
+  public:
+  /**
+   * A path which is followed as a sequence of chunks.
+   *
+   * @param ichunkCount The number of chunks the producer will append.
+   * @param ileadTime How much of the path must be available before the follower starts.
+   */
+  StreamingPath(std::size_t ichunkCount, QTime ileadTime);
+
+  /**
+   * Appends the next chunk. Called by the producer.
+   *
+   * @param ichunk The chunk.
+   */
+  void append(StoredPathPtr ichunk);
+
+  /**
+   * Marks that the producer will not append any more chunks because generating one failed. Called
+   * by the producer.
+   */
+  void markFailed();
+
+  /**
+   * @param iindex The index of the chunk.
+   * @return The chunk, or `nullptr` if it has not been appended yet.
+   */
+  StoredPathPtr getChunk(std::size_t iindex) const;
+
+  /**
+   * @return The number of chunks the producer will append.
+   */
+  std::size_t getChunkCount() const;
+
+  /**
+   * @return The number of chunks which have been appended.
+   */
+  std::size_t getAvailableChunkCount() const;
+
+  /**
+   * @return The total number of points in the chunks which have been appended.
+   */
+  std::size_t getAvailablePointCount() const;
+
+  /**
+   * @return Whether every chunk has been appended.
+   */
+  bool isComplete() const;
+
+  /**
+   * @return Whether the producer failed to generate a chunk.
+   */
+  bool hasFailed() const;
+
+  /**
+   * @return How much of the path must be available before the follower starts.
+   */
+  QTime getLeadTime() const;
+
+  protected:
+  const std::size_t chunkCount;
+  const QTime leadTime;
+  std::atomic_bool failed{false};
+
+  // Must be locked when accessing chunks or availablePoints
+  mutable CrossplatformMutex mutex;
+  std::vector<StoredPathPtr> chunks{};
+  std::size_t availablePoints{0};
+};
+} // namespace okapi
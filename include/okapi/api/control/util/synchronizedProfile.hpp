@@ -0,0 +1,83 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/linearProfile.hpp"
+#include "okapi/api/units/QLength.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace okapi {
+/**
+ * A move of one axis of a SynchronizedProfile.
+ */
+struct LinearMove {
+  QLength start; ///< The starting position.
+  QLength end;   ///< The ending position.
+};
+
+/**
+ * Closed-form profiles for several linear axes which share one timeline. Each axis gets its own
+ * LinearProfile, and every profile is then stretched to the duration of the slowest one, so all
+ * the axes start and finish together. That common duration is the shortest one every axis can
+ * manage within its limits.
+ */
+class SynchronizedProfile {
+  public:
+  /**
+   * A profile with no axes.
+   */
+  SynchronizedProfile() = default;
+
+  /**
+   * If there are no moves, the number of moves and limits differ, or any limits are invalid (see
+   * LinearProfile), an instance of `std::invalid_argument` is thrown.
+   *
+   * @param ishape The shape of every profile.
+   * @param imoves The move of each axis.
+   * @param ilimits The limits of each axis, in the same order as the moves.
+   */
+  SynchronizedProfile(LinearProfileShape ishape,
+                      const std::vector<LinearMove> &imoves,
+                      const std::vector<PathfinderLimits> &ilimits);
+
+  /**
+   * Evaluates one axis. Times outside the profile hold the ends, as in LinearProfile.
+   *
+   * @param iaxis The index of the axis.
+   * @param itime The time since the start of the profile.
+   * @return The state of the axis at that time.
+   */
+  LinearProfile::State sample(std::size_t iaxis, QTime itime) const;
+
+  /**
+   * @return The time it takes every axis to finish.
+   */
+  QTime getDuration() const;
+
+  /**
+   * @return The number of axes.
+   */
+  std::size_t getAxisCount() const;
+
+  /**
+   * @param iaxis The index of the axis.
+   * @return The stretched profile of the axis.
+   */
+  const LinearProfile &getProfile(std::size_t iaxis) const;
+
+  /**
+   * @return The index of the axis which takes the longest, and so sets the duration.
+   */
+  std::size_t getLimitingAxis() const;
+
+  protected:
+  std::vector<LinearProfile> profiles{};
+  QTime duration{0_ms};
+  std::size_t limitingAxis{0};
+};
+} // namespace okapi
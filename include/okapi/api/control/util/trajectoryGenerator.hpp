@@ -0,0 +1,178 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/pathfinderUtil.hpp"
+#include "okapi/api/units/QLength.hpp"
+#include <cstddef>
+#include <vector>
+
+#include "squiggles.hpp"
+
+namespace okapi {
+/**
+ * Generates 2D trajectories for a skid-steer chassis without squiggles. Each pair of waypoints is
+ * joined by a quintic Hermite segment, and the whole path is then time parameterized so that
+ * neither wheel exceeds the max velocity (which slows the robot down in turns) and the
+ * acceleration stays within the max acceleration. The max jerk is not used.
+ *
+ * The points are written into a buffer which is allocated once, when the generator is
+ * constructed, so generating a path again does not allocate unless the number of waypoints
+ * changes. Each segment only depends on its two waypoints, so `setWaypoint()` rebuilds the shape
+ * of at most two segments before parameterizing the path again, and `setLimits()` rebuilds none.
+ *
+ * The points match those of `SplineProfile::generate()`: poses are in meters and radians
+ * with x and y swapped relative to the waypoints, the first point is at time zero, and there is
+ * one point per timestep.
+ */
+class TrajectoryGenerator {
+  public:
+  /**
+   * @param ilimits The limits of the paths.
+   * @param iwheelTrack The wheel track of the chassis.
+   * @param idt The timestep between points in seconds.
+   * @param icapacity The most points a path can have. A path which needs more points throws.
+   */
+  TrajectoryGenerator(const PathfinderLimits &ilimits,
+                      const QLength &iwheelTrack,
+                      double idt = 0.01,
+                      std::size_t icapacity = 2000);
+
+  /**
+   * Generates a path through the waypoints. If there are fewer than two waypoints, an instance of
+   * `std::invalid_argument` is thrown. If the path is impossible to achieve with the given start
+   * and end velocities or needs more points than the capacity, an instance of
+   * `std::runtime_error` is thrown and the previous path is lost.
+   *
+   * @param iwaypoints The waypoints to hit on the path.
+   * @param istartVel The velocity at the start of the path in m/s.
+   * @param iendVel The velocity at the end of the path in m/s.
+   * @return The number of points in the path.
+   */
+  std::size_t generate(const std::vector<PathfinderPoint> &iwaypoints,
+                       double istartVel = 0,
+                       double iendVel = 0);
+
+  /**
+   * Moves one waypoint of the last path and generates it again. Only the segments on either side
+   * of the waypoint are rebuilt. If there is no waypoint with this index, an instance of
+   * `std::invalid_argument` is thrown. Errors are otherwise the same as for `generate()`.
+   *
+   * @param iindex The index of the waypoint.
+   * @param iwaypoint The new waypoint.
+   * @return The number of points in the path.
+   */
+  std::size_t setWaypoint(std::size_t iindex, const PathfinderPoint &iwaypoint);
+
+  /**
+   * Changes the limits and generates the last path again. The shape of the path does not depend on
+   * the limits, so no segments are rebuilt. If the limits are not positive, an instance of
+   * `std::invalid_argument` is thrown. Errors are otherwise the same as for `generate()`.
+   *
+   * @param ilimits The new limits.
+   * @return The number of points in the path, or zero if no path has been generated yet.
+   */
+  std::size_t setLimits(const PathfinderLimits &ilimits);
+
+  /**
+   * @return The number of points in the path.
+   */
+  std::size_t size() const;
+
+  /**
+   * @return The most points a path can have.
+   */
+  std::size_t getCapacity() const;
+
+  /**
+   * @return The number of points the last path needed, even if it did not fit in the capacity. Zero
+   * if the last path failed before it was time parameterized.
+   */
+  std::size_t getRequiredCapacity() const;
+
+  /**
+   * @param iindex The index of the point, less than `size()`.
+   * @return The point. The reference is valid until the generator is destroyed, but the point
+   * changes when a path is generated again.
+   */
+  const squiggles::ProfilePoint &operator[](std::size_t iindex) const;
+
+  /**
+   * @return A copy of the points of the path.
+   */
+  std::vector<squiggles::ProfilePoint> toProfile() const;
+
+  /**
+   * @return The number of segments whose shape was built by the last call to `generate()` or
+   * `setWaypoint()`.
+   */
+  std::size_t getRebuiltSegmentCount() const;
+
+  /**
+   * The number of pieces each segment is divided into to measure its length and curvature.
+   */
+  static constexpr std::size_t samplesPerSegment = 100;
+
+  /**
+   * The length of the tangents at the waypoints, as a multiple of the distance between them.
+   */
+  static constexpr double tangentScale = 1.2;
+
+  protected:
+  struct Sample {
+    double x;
+    double y;
+    double yaw;
+    double curvature;
+    double distance; // From the start of the segment
+  };
+
+  PathfinderLimits limits;
+  double halfTrack;
+  double dt;
+  double startVel{0};
+  double endVel{0};
+  std::vector<PathfinderPoint> waypoints{};
+
+  // samplesPerSegment + 1 samples for each segment. The last sample of a segment is at the same
+  // place as the first sample of the next one.
+  std::vector<Sample> samples{};
+  std::vector<double> velocities{};
+  std::vector<double> times{};
+
+  std::vector<squiggles::ProfilePoint> points;
+  std::size_t count{0};
+  std::size_t requiredCapacity{0};
+  std::size_t rebuiltSegments{0};
+
+  /**
+   * Samples the shape of a segment.
+   *
+   * @param isegment The index of the segment, which starts at the waypoint with the same index.
+   */
+  void buildSegment(std::size_t isegment);
+
+  /**
+   * Time parameterizes the sampled path and writes its points.
+   *
+   * @return The number of points.
+   */
+  std::size_t parameterize();
+
+  /**
+   * @param iindex The index of a sample along the whole path, skipping the duplicate samples where
+   * segments meet.
+   * @return The sample.
+   */
+  const Sample &sampleAt(std::size_t iindex) const;
+
+  /**
+   * @param iindex The index of a sample along the whole path, greater than zero.
+   * @return The distance from the sample before it.
+   */
+  double stepDistance(std::size_t iindex) const;
+};
+} // namespace okapi
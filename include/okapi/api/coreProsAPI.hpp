@@ -102,6 +102,22 @@ class CrossplatformThread {
 #endif
   }
 
+  /**
+   * The name of the current task, read without allocating. On the brain, this is the name the
+   * kernel stores for the task. On the host, the name is built the first time each thread asks for
+   * it and kept for the rest of the thread's life.
+   *
+   * @return The name of the current task. Valid until the task ends.
+   */
+  static const char *getCurrentName() noexcept {
+#ifdef THREADS_STD
+    thread_local const std::string name = getName();
+    return name.c_str();
+#else
+    return pros::c::task_get_name(NULL);
+#endif
+  }
+
   CROSSPLATFORM_THREAD_T thread;
 };
 
@@ -0,0 +1,52 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace okapi {
+/**
+ * Consistent Overhead Byte Stuffing. Encoding removes every zero byte from a buffer while adding
+ * at most one byte per 254, so a zero byte can mark the end of each frame in a stream. A reader
+ * which joins the stream partway through, or loses some bytes, finds the start of the next frame
+ * at the next zero byte.
+ */
+class Cobs {
+  public:
+  /**
+   * @param ilength The length of a buffer.
+   * @return The most bytes the buffer can take up once it is encoded.
+   */
+  static constexpr std::size_t maxEncodedLength(const std::size_t ilength) {
+    return ilength + ilength / 254 + 1;
+  }
+
+  /**
+   * Encodes a buffer. The zero byte which ends the frame is not added.
+   *
+   * @param idata The buffer to encode.
+   * @param ilength The length of the buffer.
+   * @param oencoded Where to write the encoded buffer. Must hold `maxEncodedLength(ilength)` bytes.
+   * @return The length of the encoded buffer.
+   */
+  static std::size_t encode(const std::uint8_t *idata, std::size_t ilength, std::uint8_t *oencoded);
+
+  /**
+   * Decodes a buffer, without the zero byte which ended its frame.
+   *
+   * @param iencoded The buffer to decode.
+   * @param ilength The length of the buffer.
+   * @param odata Where to write the decoded buffer. Must hold `ilength` bytes.
+   * @param olength The length of the decoded buffer.
+   * @return Whether the buffer was valid.
+   */
+  static bool decode(const std::uint8_t *iencoded,
+                     std::size_t ilength,
+                     std::uint8_t *odata,
+                     std::size_t &olength);
+};
+} // namespace okapi
@@ -0,0 +1,156 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/coreProsAPI.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include "okapi/api/util/abstractTimer.hpp"
+#include "okapi/api/util/logging.hpp"
+#include "okapi/api/util/timeUtil.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace okapi {
+/**
+ * Runs many periodic control loops from one task. Each loop is added with a period and a step
+ * function, and the executor calls the step functions in the order of their deadlines. Loops which
+ * are due at the same time run in the order they were added, so the phase between two loops (for
+ * example, odometry and a controller which reads it) is the same every run.
+ *
+ * Running every loop from one task saves the stack and the context switches of a task per loop.
+ * The executor keeps its own clock in whole milliseconds which only moves from one deadline to
+ * the next, and it sleeps with an AbstractRate, so a slow step delays the loops after it but does
+ * not shift their phase. A batch of steps which runs past the next deadline is counted as an
+ * overrun.
+ *
+ * Step functions run without the executor locked, so they may add loops, remove other loops, and
+ * change periods (for example, through a controller's setSampleTime()). Once remove() returns, the
+ * loop's step function is not running and never runs again, so a step function must not remove
+ * its own loop.
+ */
+class ControlExecutor {
+  public:
+  /**
+   * Runs periodic control loops from one task. Call startThread() to start running them.
+   *
+   * @param itimeUtil The TimeUtil used to run the task and measure overruns.
+   * @param ilogger The logger this instance will log to.
+   */
+  explicit ControlExecutor(const TimeUtil &itimeUtil,
+                           const std::shared_ptr<Logger> &ilogger = Logger::getDefaultLogger());
+
+  ControlExecutor(ControlExecutor &&other) = delete;
+
+  ControlExecutor &operator=(ControlExecutor &&other) = delete;
+
+  ~ControlExecutor();
+
+  /**
+   * Adds a loop. It first runs the next time the executor steps.
+   *
+   * @param iname The name of the loop, used in log messages.
+   * @param iperiod The time between steps. Rounded to the nearest millisecond, which must be at
+   * least 1 ms.
+   * @param istep The step function.
+   * @return The ID of the loop.
+   */
+  std::uint32_t add(const std::string &iname, QTime iperiod, std::function<void()> istep);
+
+  /**
+   * Removes a loop. Waits for the loop to finish stepping if it is stepping, so this must not be
+   * called from the loop's own step function.
+   *
+   * @param iid The ID of the loop.
+   * @return Whether the loop existed.
+   */
+  bool remove(std::uint32_t iid);
+
+  /**
+   * Changes the period of a loop. The new period starts after the loop's next step.
+   *
+   * @param iid The ID of the loop.
+   * @param iperiod The time between steps. Rounded to the nearest millisecond, which must be at
+   * least 1 ms.
+   * @return Whether the loop existed.
+   */
+  bool setPeriod(std::uint32_t iid, QTime iperiod);
+
+  /**
+   * Runs every loop which is due, in the order of their deadlines, then moves the executor's clock
+   * to the next deadline. The task calls this every time it wakes up, so only call it yourself if
+   * the task is not started.
+   *
+   * @return The time until the next deadline.
+   */
+  QTime step();
+
+  /**
+   * @return The number of loops.
+   */
+  std::size_t getLoopCount() const;
+
+  /**
+   * @return The number of times a batch of steps ran past the next deadline.
+   */
+  std::size_t getOverrunCount() const;
+
+  /**
+   * Starts the task which runs the loops.
+   */
+  void startThread();
+
+  /**
+   * @return The underlying thread handle.
+   */
+  CrossplatformThread *getThread() const;
+
+  protected:
+  struct Loop {
+    std::uint32_t id;
+    std::string name;
+    std::uint32_t period;
+    std::uint32_t deadline;
+    std::function<void()> step;
+    bool running{false}; // Whether the step function is running
+    bool removed{false}; // Whether the loop was removed, so it must not run again
+  };
+
+  std::shared_ptr<Logger> logger;
+  TimeUtil timeUtil;
+  std::unique_ptr<AbstractTimer> timer;
+
+  // Guards the loops and the executor's clock, but is not held while a step function runs
+  mutable CrossplatformMutex loopMutex;
+  std::vector<std::shared_ptr<Loop>> loops;
+  std::uint32_t nextId{0};
+  std::uint32_t now{0};
+  bool hasStepped{false};
+  QTime startTime{0_ms};
+
+  // The loops which are due in the current step. Only used by step(), and kept between steps so
+  // stepping doesn't allocate.
+  std::vector<std::shared_ptr<Loop>> dueLoops;
+
+  std::atomic_size_t overrunCount{0};
+  std::atomic_bool dtorCalled{false};
+  CrossplatformThread *task{nullptr};
+
+  std::uint32_t toPeriod(QTime iperiod) const;
+
+  /**
+   * @param iloop The loop.
+   * @return Whether the loop's step function is running.
+   */
+  bool isStepping(const Loop &iloop) const;
+
+  static void trampoline(void *context);
+  void loop();
+};
+} // namespace okapi
@@ -0,0 +1,85 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace okapi {
+/**
+ * One log statement waiting in a LogRingBuffer. Records have a fixed size so writing one never
+ * allocates. Names and messages which are too long are truncated.
+ */
+struct LogRecord {
+  static constexpr std::size_t maxThreadNameLength = 31;
+  static constexpr std::size_t maxMessageLength = 255;
+
+  long time;                                  ///< When the statement was logged in ms.
+  const char *levelName;                      ///< The name of the log level, such as "INFO".
+  char threadName[maxThreadNameLength + 1];   ///< The name of the task which logged it.
+  char message[maxMessageLength + 1];         ///< The message.
+};
+
+/**
+ * A bounded ring buffer of LogRecords which any number of tasks can write to without locking and
+ * one task reads from. Each slot has a sequence number which says whether it is free or holds a
+ * record, so a writer only has to claim a slot with one compare-and-swap. A writer never waits
+ * for the reader: if the buffer is full, the record is dropped and counted instead.
+ */
+class LogRingBuffer {
+  public:
+  /**
+   * @param icapacity The number of records the buffer can hold. Rounded up to a power of two.
+   */
+  explicit LogRingBuffer(std::size_t icapacity);
+
+  /**
+   * Copies a record into the buffer. Safe to call from any number of tasks at once.
+   *
+   * @param itime When the statement was logged in ms.
+   * @param ilevelName The name of the log level. Must be a string literal.
+   * @param ithreadName The name of the task which logged it.
+   * @param imessage The message.
+   * @return Whether the record was written, or `false` if the buffer was full and it was dropped.
+   */
+  bool push(long itime,
+            const char *ilevelName,
+            std::string_view ithreadName,
+            std::string_view imessage) noexcept;
+
+  /**
+   * Takes the oldest record out of the buffer. Only one task may call this at a time.
+   *
+   * @param orecord The record to copy the oldest record into.
+   * @return Whether there was a record to take.
+   */
+  bool pop(LogRecord &orecord) noexcept;
+
+  /**
+   * @return The number of records which were dropped because the buffer was full.
+   */
+  std::size_t getDroppedCount() const noexcept;
+
+  /**
+   * @return The number of records the buffer can hold.
+   */
+  std::size_t getCapacity() const noexcept;
+
+  protected:
+  struct Slot {
+    std::atomic_size_t sequence;
+    LogRecord record;
+  };
+
+  std::size_t mask;
+  std::unique_ptr<Slot[]> slots;
+  std::atomic_size_t writeIndex{0};
+  std::size_t readIndex{0};
+  std::atomic_size_t droppedCount{0};
+};
+} // namespace okapi
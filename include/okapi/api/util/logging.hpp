@@ -6,8 +6,11 @@
 #pragma once
 
 #include "okapi/api/coreProsAPI.hpp"
+#include "okapi/api/util/abstractRate.hpp"
 #include "okapi/api/util/abstractTimer.hpp"
+#include "okapi/api/util/logRingBuffer.hpp"
 #include "okapi/api/util/mathUtil.hpp"
+#include <atomic>
 #include <memory>
 #include <mutex>
 
@@ -16,10 +19,26 @@
 #include "okapi/impl/util/timer.hpp"
 #endif
 
-#define LOG_DEBUG(msg) logger->debug([=]() { return msg; })
-#define LOG_INFO(msg) logger->info([=]() { return msg; })
-#define LOG_WARN(msg) logger->warn([=]() { return msg; })
-#define LOG_ERROR(msg) logger->error([=]() { return msg; })
+/**
+ * The most verbose log level which is compiled in, as the value of a `Logger::LogLevel`. Log
+ * statements more verbose than this compile to nothing, whatever level the Logger is set to. For
+ * example, build with `-DOKAPI_COMPILED_LOG_LEVEL=2` to keep only warnings and errors.
+ */
+#ifndef OKAPI_COMPILED_LOG_LEVEL
+#define OKAPI_COMPILED_LOG_LEVEL 4
+#endif
+
+#define OKAPI_LOG_AT(level, msg)                                                                   \
+  do {                                                                                             \
+    if constexpr (okapi::Logger::isCompiledIn(okapi::Logger::LogLevel::level)) {                   \
+      logger->level([=]() { return msg; });                                                        \
+    }                                                                                              \
+  } while (false)
+
+#define LOG_DEBUG(msg) OKAPI_LOG_AT(debug, msg)
+#define LOG_INFO(msg) OKAPI_LOG_AT(info, msg)
+#define LOG_WARN(msg) OKAPI_LOG_AT(warn, msg)
+#define LOG_ERROR(msg) OKAPI_LOG_AT(error, msg)
 
 #define LOG_DEBUG_S(msg) LOG_DEBUG(std::string(msg))
 #define LOG_INFO_S(msg) LOG_INFO(std::string(msg))
@@ -65,77 +84,112 @@ class Logger {
    */
   Logger(std::unique_ptr<AbstractTimer> itimer, FILE *ifile, const LogLevel &ilevel) noexcept;
 
+  /**
+   * A logger that opens the input file by name and writes to it from a low priority flusher task.
+   * Log statements are copied into a lock-free ring buffer instead of being written to the file,
+   * so logging never blocks the task which logs. If the buffer is full, the statement is dropped
+   * and counted (see getDroppedCount()). Messages longer than `LogRecord::maxMessageLength` are
+   * truncated.
+   *
+   * @param itimer A timer used to get the current time for log statements.
+   * @param ifileName The name of the log file to open.
+   * @param ilevel The log level. Log statements more verbose than this level will be disabled.
+   * @param iflusherRate The rate used to idle the flusher task between flushes.
+   * @param ibufferCapacity The number of log statements the ring buffer can hold.
+   */
+  Logger(std::unique_ptr<AbstractTimer> itimer,
+         std::string_view ifileName,
+         const LogLevel &ilevel,
+         std::unique_ptr<AbstractRate> iflusherRate,
+         std::size_t ibufferCapacity = 64) noexcept;
+
+  /**
+   * A logger that uses an existing file handle and writes to it from a low priority flusher task.
+   * See the constructor which takes a file name for how the flusher works. The file will be closed
+   * when the logger is destructed.
+   *
+   * @param itimer A timer used to get the current time for log statements.
+   * @param ifile The log file to open. Will be closed by the logger!
+   * @param ilevel The log level. Log statements more verbose than this level will be disabled.
+   * @param iflusherRate The rate used to idle the flusher task between flushes.
+   * @param ibufferCapacity The number of log statements the ring buffer can hold.
+   */
+  Logger(std::unique_ptr<AbstractTimer> itimer,
+         FILE *ifile,
+         const LogLevel &ilevel,
+         std::unique_ptr<AbstractRate> iflusherRate,
+         std::size_t ibufferCapacity = 64) noexcept;
+
   ~Logger();
 
+  /**
+   * @param ilevel The log level.
+   * @return Whether log statements at this level are compiled in (see `OKAPI_COMPILED_LOG_LEVEL`).
+   */
+  static constexpr bool isCompiledIn(const LogLevel &ilevel) noexcept {
+    return toUnderlyingType(ilevel) <= OKAPI_COMPILED_LOG_LEVEL;
+  }
+
   constexpr bool isDebugLevelEnabled() const noexcept {
-    return toUnderlyingType(logLevel) >= toUnderlyingType(LogLevel::debug);
+    return isCompiledIn(LogLevel::debug) &&
+           toUnderlyingType(logLevel) >= toUnderlyingType(LogLevel::debug);
   }
 
   template <typename T> void debug(T ilazyMessage) noexcept {
     if (isDebugLevelEnabled() && logfile && timer) {
-      std::scoped_lock lock(logfileMutex);
-      fprintf(logfile,
-              "%ld (%s) DEBUG: %s\n",
-              static_cast<long>(timer->millis().convert(millisecond)),
-              CrossplatformThread::getName().c_str(),
-              ilazyMessage().c_str());
+      write("DEBUG", ilazyMessage());
     }
   }
 
   constexpr bool isInfoLevelEnabled() const noexcept {
-    return toUnderlyingType(logLevel) >= toUnderlyingType(LogLevel::info);
+    return isCompiledIn(LogLevel::info) &&
+           toUnderlyingType(logLevel) >= toUnderlyingType(LogLevel::info);
   }
 
   template <typename T> void info(T ilazyMessage) noexcept {
     if (isInfoLevelEnabled() && logfile && timer) {
-      std::scoped_lock lock(logfileMutex);
-      fprintf(logfile,
-              "%ld (%s) INFO: %s\n",
-              static_cast<long>(timer->millis().convert(millisecond)),
-              CrossplatformThread::getName().c_str(),
-              ilazyMessage().c_str());
+      write("INFO", ilazyMessage());
     }
   }
 
   constexpr bool isWarnLevelEnabled() const noexcept {
-    return toUnderlyingType(logLevel) >= toUnderlyingType(LogLevel::warn);
+    return isCompiledIn(LogLevel::warn) &&
+           toUnderlyingType(logLevel) >= toUnderlyingType(LogLevel::warn);
   }
 
   template <typename T> void warn(T ilazyMessage) noexcept {
     if (isWarnLevelEnabled() && logfile && timer) {
-      std::scoped_lock lock(logfileMutex);
-      fprintf(logfile,
-              "%ld (%s) WARN: %s\n",
-              static_cast<long>(timer->millis().convert(millisecond)),
-              CrossplatformThread::getName().c_str(),
-              ilazyMessage().c_str());
+      write("WARN", ilazyMessage());
     }
   }
 
   constexpr bool isErrorLevelEnabled() const noexcept {
-    return toUnderlyingType(logLevel) >= toUnderlyingType(LogLevel::error);
+    return isCompiledIn(LogLevel::error) &&
+           toUnderlyingType(logLevel) >= toUnderlyingType(LogLevel::error);
   }
 
   template <typename T> void error(T ilazyMessage) noexcept {
     if (isErrorLevelEnabled() && logfile && timer) {
-      std::scoped_lock lock(logfileMutex);
-      fprintf(logfile,
-              "%ld (%s) ERROR: %s\n",
-              static_cast<long>(timer->millis().convert(millisecond)),
-              CrossplatformThread::getName().c_str(),
-              ilazyMessage().c_str());
+      write("ERROR", ilazyMessage());
     }
   }
 
   /**
-   * Closes the connection to the log file.
+   * Closes the connection to the log file. If the logger has a flusher task, the flusher is
+   * stopped and every buffered log statement is written first.
    */
-  constexpr void close() noexcept {
-    if (logfile) {
-      fclose(logfile);
-      logfile = nullptr;
-    }
-  }
+  void close() noexcept;
+
+  /**
+   * Writes every buffered log statement to the log file now. Does nothing if the logger does not
+   * have a flusher task.
+   */
+  void flush() noexcept;
+
+  /**
+   * @return The number of log statements which were dropped because the ring buffer was full.
+   */
+  std::size_t getDroppedCount() const noexcept;
 
   /**
    * @return The default logger.
@@ -156,6 +210,26 @@ class Logger {
   FILE *logfile;
   CrossplatformMutex logfileMutex;
 
+  std::unique_ptr<LogRingBuffer> buffer;
+  std::unique_ptr<AbstractRate> flusherRate;
+  CrossplatformThread *flusher{nullptr};
+  std::atomic_bool flusherStopped{false};
+  std::atomic_bool flusherExited{false};
+  std::size_t reportedDroppedCount{0};
+
+  /**
+   * Writes a log statement to the log file, or to the ring buffer if there is a flusher task.
+   */
+  void write(const char *ilevelName, const std::string &imessage) noexcept;
+
+  /**
+   * Writes every buffered log statement to the log file. Must be called with logfileMutex locked.
+   */
+  void drain() noexcept;
+
+  static void trampoline(void *context);
+  void flusherLoop();
+
   static bool isSerialStream(std::string_view filename);
 };
 
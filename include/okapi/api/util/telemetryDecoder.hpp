@@ -0,0 +1,62 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/util/telemetryRecorder.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace okapi {
+/**
+ * The contents of a telemetry file, one column per field.
+ */
+struct TelemetryLog {
+  std::vector<std::string> channelNames; ///< The name of each channel.
+  std::vector<std::uint16_t> channels;   ///< The channel of each sample.
+  std::vector<std::uint32_t> times;      ///< The time of each sample in ms.
+
+  /**
+   * The target, reading, error, p, i, d, output, and dt in ms of each sample, in that order.
+   */
+  std::vector<float> values[TelemetryRecorder::valueColumnCount];
+
+  /**
+   * @return The number of samples.
+   */
+  std::size_t size() const;
+
+  /**
+   * @param iindex The index of the sample.
+   * @return The sample.
+   */
+  TelemetrySample getSample(std::size_t iindex) const;
+};
+
+/**
+ * Reads the files written by TelemetryRecorder on the host and converts them to CSV.
+ */
+class TelemetryDecoder {
+  public:
+  /**
+   * Reads a telemetry file. If the file is not a telemetry file or is cut short, an instance of
+   * `std::runtime_error` is thrown.
+   *
+   * @param ifile The file to read. Must be opened in binary mode.
+   * @return The contents of the file.
+   */
+  static TelemetryLog decode(FILE *ifile);
+
+  /**
+   * Writes a telemetry log as CSV with a header row and one row per sample.
+   *
+   * @param ifile The file to write to.
+   * @param ilog The telemetry log.
+   */
+  static void writeCsv(FILE *ifile, const TelemetryLog &ilog);
+};
+} // namespace okapi
@@ -0,0 +1,80 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace okapi {
+/**
+ * The frames of a TelemetryStream. Each frame holds one message: a MessageId, the message, and a
+ * CRC-16 of both, encoded with Cobs and followed by a zero byte. All values are little-endian.
+ * The messages are:
+ *
+ * - `channelInfo`: the channel (`uint16`), its ChannelKind (`uint8`), and its name.
+ * - `controllerSample`: the channel (`uint16`), the time in ms (`uint32`), and one `float` for
+ *   each of target, reading, error, p, i, d, output, and dt in ms.
+ * - `odometrySample`: the channel (`uint16`), the time in ms (`uint32`), and one `float` for each
+ *   of x in meters, y in meters, and theta in radians.
+ */
+class TelemetryFrame {
+  public:
+  enum class MessageId : std::uint8_t {
+    channelInfo = 1,      ///< The name and kind of a channel.
+    controllerSample = 2, ///< A TelemetrySample.
+    odometrySample = 3    ///< An odometry pose.
+  };
+
+  enum class ChannelKind : std::uint8_t {
+    controller = 0, ///< Controllers publish TelemetrySamples into the channel.
+    odometry = 1    ///< The stream reads the pose of an Odometry.
+  };
+
+  /**
+   * The longest channel name which is sent. Longer names are truncated.
+   */
+  static constexpr std::size_t maxChannelNameLength = 64;
+
+  /**
+   * The longest a frame can be, including the zero byte which ends it.
+   */
+  static constexpr std::size_t maxFrameLength = 128;
+
+  /**
+   * Builds a frame from a message.
+   *
+   * @param imessage The message, starting with its MessageId.
+   * @param ilength The length of the message.
+   * @param oframe Where to write the frame. Must hold `maxFrameLength` bytes.
+   * @return The length of the frame, including the zero byte which ends it.
+   */
+  static std::size_t
+  encode(const std::uint8_t *imessage, std::size_t ilength, std::uint8_t *oframe);
+
+  /**
+   * Reads the message out of a frame and checks its CRC.
+   *
+   * @param iframe The frame, without the zero byte which ended it.
+   * @param ilength The length of the frame.
+   * @param omessage Where to write the message. Must hold `ilength` bytes.
+   * @param olength The length of the message.
+   * @return Whether the frame was valid and its CRC matched.
+   */
+  static bool decode(const std::uint8_t *iframe,
+                     std::size_t ilength,
+                     std::uint8_t *omessage,
+                     std::size_t &olength);
+
+  /**
+   * Computes the CRC-16 (CCITT polynomial, initial value 0xFFFF) of a buffer.
+   *
+   * @param idata The start of the buffer.
+   * @param ilength The length of the buffer.
+   * @return The checksum.
+   */
+  static std::uint16_t crc16(const std::uint8_t *idata, std::size_t ilength);
+};
+} // namespace okapi
@@ -0,0 +1,126 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/coreProsAPI.hpp"
+#include "okapi/api/util/abstractTimer.hpp"
+#include "okapi/api/util/telemetrySink.hpp"
+#include "okapi/api/util/timeUtil.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace okapi {
+/**
+ * Records TelemetrySamples from controllers in memory and saves them to a compact binary file,
+ * which TelemetryDecoder turns back into rows on the host. Each controller records into its own
+ * channel. Recording a sample claims a slot with one atomic add and stores a few floats, so it
+ * does not block and is cheap enough to leave on during matches. The recorder has a fixed
+ * capacity which is allocated up front. Once it is full, new samples are dropped and counted.
+ *
+ * The file is columnar: every value of one column is stored before the next column starts, which
+ * keeps each column compact and easy to read on its own. The layout, in little-endian order, is:
+ *
+ * - The magic bytes `OKTM`, the format version (`uint16`), the number of channels (`uint16`), and
+ *   the number of samples (`uint32`).
+ * - The name of each channel as its length (`uint16`) followed by its characters.
+ * - The channel of each sample (`uint16`), then the time of each sample in ms (`uint32`).
+ * - One `float` column for each of target, reading, error, p, i, d, output, and dt in ms.
+ */
+class TelemetryRecorder : public TelemetrySink {
+  public:
+  /**
+   * The magic bytes at the start of a telemetry file.
+   */
+  static constexpr char magic[4] = {'O', 'K', 'T', 'M'};
+
+  /**
+   * The version of the file format.
+   */
+  static constexpr std::uint16_t formatVersion = 1;
+
+  /**
+   * The number of float columns in a telemetry file.
+   */
+  static constexpr std::size_t valueColumnCount = 8;
+
+  /**
+   * @param itimeUtil The TimeUtil used to timestamp samples.
+   * @param icapacity The number of samples the recorder can hold.
+   */
+  TelemetryRecorder(const TimeUtil &itimeUtil, std::size_t icapacity = 8192);
+
+  /**
+   * Adds a channel for a controller to record into. Adding a channel with a name which already
+   * exists returns the existing channel.
+   *
+   * @param iname The name of the channel.
+   * @return The channel.
+   */
+  std::uint16_t addChannel(const std::string &iname) override;
+
+  /**
+   * Records a sample. Safe to call from any number of tasks at once.
+   *
+   * @param ichannel The channel returned by addChannel().
+   * @param isample The sample.
+   * @return Whether the sample was recorded, or `false` if the recorder was full.
+   */
+  bool record(std::uint16_t ichannel, const TelemetrySample &isample) noexcept override;
+
+  /**
+   * @return The number of samples which are recorded.
+   */
+  std::size_t getSampleCount() const noexcept;
+
+  /**
+   * @return The number of samples which were dropped because the recorder was full.
+   */
+  std::size_t getDroppedCount() const noexcept;
+
+  /**
+   * @return The number of samples the recorder can hold.
+   */
+  std::size_t getCapacity() const noexcept;
+
+  /**
+   * Writes every recorded sample to a file. Samples which are still being recorded are skipped.
+   *
+   * @param ifile The file to write to. Must be opened in binary mode. It is not closed.
+   * @return Whether every byte was written.
+   */
+  bool write(FILE *ifile);
+
+  /**
+   * Writes every recorded sample to a file, replacing it if it exists.
+   *
+   * @param ifileName The name of the file, such as `/usd/telemetry.bin`.
+   * @return Whether the file was opened and every byte was written.
+   */
+  bool save(std::string_view ifileName);
+
+  protected:
+  std::unique_ptr<AbstractTimer> timer;
+  std::size_t capacity;
+
+  CrossplatformMutex channelMutex;
+  std::vector<std::string> channelNames;
+
+  // Each column has one entry per slot. A slot's columns are written by the task which claimed it,
+  // which then sets its ready flag.
+  std::vector<std::uint16_t> channels;
+  std::vector<std::uint32_t> times;
+  std::vector<float> values[valueColumnCount];
+  std::unique_ptr<std::atomic_bool[]> ready;
+
+  std::atomic_size_t nextSlot{0};
+  std::atomic_size_t droppedCount{0};
+};
+} // namespace okapi
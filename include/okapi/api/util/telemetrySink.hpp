@@ -0,0 +1,54 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/units/QTime.hpp"
+#include <cstdint>
+#include <string>
+
+namespace okapi {
+/**
+ * What a controller did in one step. Terms a controller does not have are left as zero.
+ */
+struct TelemetrySample {
+  double target{0};  ///< The target.
+  double reading{0}; ///< The reading from the sensor.
+  double error{0};   ///< The error.
+  double p{0};       ///< The proportional term of the output.
+  double i{0};       ///< The integral term of the output.
+  double d{0};       ///< The derivative term of the output.
+  double output{0};  ///< The output.
+  QTime dt{0_ms};    ///< The time since the previous step.
+};
+
+/**
+ * Something controllers can publish TelemetrySamples into each step, such as a TelemetryRecorder
+ * or a TelemetryStream.
+ */
+class TelemetrySink {
+  public:
+  virtual ~TelemetrySink() = default;
+
+  /**
+   * Adds a channel for a controller to publish into. Adding a channel with a name which already
+   * exists returns the existing channel.
+   *
+   * @param iname The name of the channel.
+   * @return The channel.
+   */
+  virtual std::uint16_t addChannel(const std::string &iname) = 0;
+
+  /**
+   * Publishes a sample. Must be safe to call from any number of tasks at once and must not block
+   * for long, because controllers call it every step.
+   *
+   * @param ichannel The channel returned by addChannel().
+   * @param isample The sample.
+   * @return Whether the sample was accepted.
+   */
+  virtual bool record(std::uint16_t ichannel, const TelemetrySample &isample) noexcept = 0;
+};
+} // namespace okapi
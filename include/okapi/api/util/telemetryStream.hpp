@@ -0,0 +1,144 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/coreProsAPI.hpp"
+#include "okapi/api/odometry/odometry.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include "okapi/api/util/abstractTimer.hpp"
+#include "okapi/api/util/logging.hpp"
+#include "okapi/api/util/telemetryFrame.hpp"
+#include "okapi/api/util/telemetrySink.hpp"
+#include "okapi/api/util/timeUtil.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace okapi {
+/**
+ * Streams controller and odometry telemetry over a serial stream while the robot runs. Controllers
+ * publish into the stream like any other TelemetrySink, and the stream keeps only the newest
+ * sample of each channel. A task sends the samples which changed, and the pose of each odometry
+ * channel, at a fixed rate. TelemetryStreamDecoder reads the stream on the host.
+ *
+ * Each message is one TelemetryFrame. Every channel is announced again every announce period so a
+ * reader which starts late learns the names. A controller sample takes 43 bytes, which is less than
+ * half of the same values printed as text.
+ */
+class TelemetryStream : public TelemetrySink {
+  public:
+  using MessageId = TelemetryFrame::MessageId;
+  using ChannelKind = TelemetryFrame::ChannelKind;
+
+  /**
+   * Streams telemetry to a file. Call startThread() to start streaming. On the brain, open
+   * `/ser/sout` in binary mode and turn off the PROS stream multiplexing with
+   * `pros::c::serctl(SERCTL_DISABLE_COBS, nullptr)` so the frames are sent as they are.
+   *
+   * @param itimeUtil The TimeUtil used to timestamp samples and run the task.
+   * @param ifile The file to write to. It is not closed.
+   * @param iperiod How often to send the samples which changed.
+   * @param iannouncePeriod How often to announce every channel again.
+   * @param ilogger The logger this instance will log to.
+   */
+  TelemetryStream(const TimeUtil &itimeUtil,
+                  FILE *ifile,
+                  QTime iperiod = 50_ms,
+                  QTime iannouncePeriod = 1_s,
+                  const std::shared_ptr<Logger> &ilogger = Logger::getDefaultLogger());
+
+  TelemetryStream(TelemetryStream &&other) = delete;
+
+  TelemetryStream &operator=(TelemetryStream &&other) = delete;
+
+  ~TelemetryStream() override;
+
+  /**
+   * Adds a channel for a controller to publish into. Adding a channel with a name which already
+   * exists returns the existing channel.
+   *
+   * @param iname The name of the channel.
+   * @return The channel.
+   */
+  std::uint16_t addChannel(const std::string &iname) override;
+
+  /**
+   * Replaces the newest sample of a channel. It is sent the next time the task runs.
+   *
+   * @param ichannel The channel returned by addChannel().
+   * @param isample The sample.
+   * @return Whether the channel exists.
+   */
+  bool record(std::uint16_t ichannel, const TelemetrySample &isample) noexcept override;
+
+  /**
+   * Adds a channel which sends the pose of an Odometry every time the task runs.
+   *
+   * @param iname The name of the channel.
+   * @param iodometry The odometry to read.
+   * @return The channel.
+   */
+  std::uint16_t addOdometryChannel(const std::string &iname, std::shared_ptr<Odometry> iodometry);
+
+  /**
+   * Sends the samples which changed and the pose of each odometry channel now, announcing the
+   * channels first if the announce period has passed. The task calls this every period, so only
+   * call it yourself if the task is not started.
+   */
+  void publish();
+
+  /**
+   * @return The number of bytes written to the file.
+   */
+  std::size_t getBytesWritten() const;
+
+  /**
+   * Starts the task which publishes every period.
+   */
+  void startThread();
+
+  protected:
+  struct Channel {
+    std::string name;
+    ChannelKind kind{ChannelKind::controller};
+    std::shared_ptr<Odometry> odometry;
+    TelemetrySample sample{};
+    std::uint32_t time{0};
+    bool changed{false};
+  };
+
+  std::shared_ptr<Logger> logger;
+  TimeUtil timeUtil;
+  std::unique_ptr<AbstractTimer> timer;
+  FILE *file;
+  QTime period;
+  QTime announcePeriod;
+
+  // Guards the channels and when they were announced
+  CrossplatformMutex channelMutex;
+  std::vector<Channel> channels;
+  QTime lastAnnounceTime{0_ms};
+  bool hasAnnounced{false};
+
+  // The frames publish() is about to write
+  std::vector<std::uint8_t> output;
+
+  std::atomic_size_t bytesWritten{0};
+  std::atomic_bool dtorCalled{false};
+  CrossplatformThread *task{nullptr};
+
+  std::uint16_t addChannelOfKind(const std::string &iname,
+                                 ChannelKind ikind,
+                                 std::shared_ptr<Odometry> iodometry);
+  void appendFrame(const std::uint8_t *imessage, std::size_t ilength);
+
+  static void trampoline(void *context);
+  void loop();
+};
+} // namespace okapi
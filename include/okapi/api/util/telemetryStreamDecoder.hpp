@@ -0,0 +1,84 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/odometry/odomState.hpp"
+#include "okapi/api/util/telemetryFrame.hpp"
+#include "okapi/api/util/telemetrySink.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace okapi {
+/**
+ * A sample read from a TelemetryStream.
+ */
+struct TelemetryStreamMessage {
+  TelemetryFrame::MessageId id; ///< Either `controllerSample` or `odometrySample`.
+  std::uint16_t channel;         ///< The channel.
+  std::uint32_t time;            ///< The time of the sample in ms.
+  TelemetrySample sample;        ///< The sample, for a controller channel.
+  OdomState state;               ///< The pose, for an odometry channel.
+};
+
+/**
+ * Reads the frames of a TelemetryStream on the host. Bytes can be fed in as they arrive, in pieces
+ * of any size. A frame which is damaged is skipped and counted, and reading picks up again at the
+ * next frame.
+ */
+class TelemetryStreamDecoder {
+  public:
+  /**
+   * Reads bytes from the stream.
+   *
+   * @param idata The bytes.
+   * @param ilength The number of bytes.
+   * @return The samples in every frame which the bytes completed.
+   */
+  std::vector<TelemetryStreamMessage> feed(const std::uint8_t *idata, std::size_t ilength);
+
+  /**
+   * @param ichannel The channel.
+   * @return The name of the channel, or `channel <n>` if it has not been announced yet.
+   */
+  std::string getChannelName(std::uint16_t ichannel) const;
+
+  /**
+   * @return The number of frames which were skipped because they were damaged.
+   */
+  std::size_t getCorruptFrameCount() const;
+
+  /**
+   * Writes the header row of the CSV written by writeCsv().
+   *
+   * @param ifile The file to write to.
+   */
+  static void writeCsvHeader(FILE *ifile);
+
+  /**
+   * Writes a sample as one CSV row. Columns which do not apply to the kind of channel are empty.
+   *
+   * @param ifile The file to write to.
+   * @param imessage The sample.
+   */
+  void writeCsv(FILE *ifile, const TelemetryStreamMessage &imessage) const;
+
+  protected:
+  std::vector<std::uint8_t> frame;
+  bool isFrameTooLong{false};
+  std::map<std::uint16_t, std::string> channelNames;
+  std::size_t corruptFrameCount{0};
+
+  /**
+   * Decodes a whole frame, without the zero byte which ended it.
+   *
+   * @param omessages Where to add the sample in the frame, if it has one.
+   */
+  void decodeFrame(std::vector<TelemetryStreamMessage> &omessages);
+};
+} // namespace okapi
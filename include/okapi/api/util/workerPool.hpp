@@ -0,0 +1,91 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/coreProsAPI.hpp"
+#include "okapi/api/util/logging.hpp"
+#include "okapi/api/util/timeUtil.hpp"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace okapi {
+/**
+ * A bounded pool of worker tasks which run jobs in the order they were submitted. Workers poll the
+ * job queue, so no condition variables are needed and the pool works the same on the brain and on
+ * the host. On the brain, the workers run just above the lowest priority so they never delay the
+ * control tasks.
+ */
+class WorkerPool {
+  public:
+  /**
+   * A bounded pool of worker tasks.
+   *
+   * @param itimeUtil The TimeUtil used to idle the workers.
+   * @param iworkerCount The number of worker tasks to start. Must be at least one.
+   * @param imaxQueuedJobs The maximum number of jobs which can wait in the queue.
+   * @param ilogger The logger this instance will log to.
+   */
+  WorkerPool(const TimeUtil &itimeUtil,
+             std::size_t iworkerCount = getDefaultWorkerCount(),
+             std::size_t imaxQueuedJobs = 32,
+             const std::shared_ptr<Logger> &ilogger = Logger::getDefaultLogger());
+
+  WorkerPool(WorkerPool &&other) = delete;
+
+  WorkerPool &operator=(WorkerPool &&other) = delete;
+
+  /**
+   * Stops the workers. Jobs which are currently running are allowed to finish. Jobs which are still
+   * in the queue are dropped.
+   */
+  ~WorkerPool();
+
+  /**
+   * Queues a job to be run by a worker. Returns `false` without queueing the job if the queue is
+   * full.
+   *
+   * @param ijob The job to run.
+   * @return Whether the job was queued.
+   */
+  bool submit(std::function<void()> ijob);
+
+  /**
+   * @return The number of worker tasks.
+   */
+  std::size_t getWorkerCount() const;
+
+  /**
+   * @return The number of jobs which are queued or running.
+   */
+  std::size_t getPendingJobCount() const;
+
+  /**
+   * The default number of workers. On the host this is one per hardware thread. On the brain this
+   * is one, because there is only one core to share with the control tasks.
+   *
+   * @return The default number of workers.
+   */
+  static std::size_t getDefaultWorkerCount();
+
+  protected:
+  std::shared_ptr<Logger> logger;
+  TimeUtil timeUtil;
+  std::size_t maxQueuedJobs;
+
+  CrossplatformMutex queueMutex;
+  std::deque<std::function<void()>> jobs{};
+  std::atomic_size_t activeJobs{0};
+  std::atomic_size_t queuedJobs{0};
+  std::atomic_bool dtorCalled{false};
+  std::vector<CrossplatformThread *> workers{};
+
+  static void trampoline(void *context);
+  void loop();
+};
+} // namespace okapi
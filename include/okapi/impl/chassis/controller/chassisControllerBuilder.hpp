@@ -11,6 +11,7 @@
 #include "okapi/api/chassis/model/hDriveModel.hpp"
 #include "okapi/api/chassis/model/skidSteerModel.hpp"
 #include "okapi/api/chassis/model/xDriveModel.hpp"
+#include "okapi/api/util/controlExecutor.hpp"
 #include "okapi/api/util/logging.hpp"
 #include "okapi/api/util/mathUtil.hpp"
 #include "okapi/impl/device/motor/motor.hpp"
@@ -388,6 +389,16 @@ class ChassisControllerBuilder {
    */
   ChassisControllerBuilder &withLogger(const std::shared_ptr<Logger> &ilogger);
 
+  /**
+   * Runs the ChassisControllerPID and the odometry from a ControlExecutor instead of their own
+   * tasks. ChassisControllerIntegrated has no task and ignores this. The executor is not parented
+   * to the current task by this builder.
+   *
+   * @param iexecutor The executor.
+   * @return An ongoing builder.
+   */
+  ChassisControllerBuilder &withExecutor(const std::shared_ptr<ControlExecutor> &iexecutor);
+
   /**
    * Parents the internal tasks started by this builder to the current task, meaning they will be
    * deleted once the current task is deleted. The `initialize` and `competition_initialize` tasks
@@ -479,6 +490,7 @@ class ChassisControllerBuilder {
   bool differentOdomScales{false};
   ChassisScales odomScales{{1, 1}, imev5GreenTPR};
   std::shared_ptr<Logger> controllerLogger = Logger::getDefaultLogger();
+  std::shared_ptr<ControlExecutor> executor;
 
   bool hasOdom{false}; // Whether odometry was passed
   std::shared_ptr<Odometry> odometry;
@@ -7,6 +7,7 @@
 
 #include "okapi/api/chassis/controller/chassisController.hpp"
 #include "okapi/api/control/async/asyncLinearMotionProfileController.hpp"
+#include "okapi/api/control/async/asyncMultiAxisProfileController.hpp"
 #include "okapi/api/control/async/asyncMotionProfileController.hpp"
 #include "okapi/api/util/logging.hpp"
 #include "okapi/impl/device/motor/motor.hpp"
@@ -91,6 +92,22 @@ class AsyncMotionProfileControllerBuilder {
                                                   const ChassisScales &iscales,
                                                   const AbstractMotor::GearsetRatioPair &ipair);
 
+  /**
+   * Adds an axis. This must be used with buildMultiAxisMotionProfileController(). Axes are driven
+   * in the order they are added.
+   *
+   * @param ioutput The output of the axis.
+   * @param idiameter The diameter of the mechanical part the motor spins.
+   * @param ipair The gearset.
+   * @param ilimits The limits of the axis.
+   * @return An ongoing builder.
+   */
+  AsyncMotionProfileControllerBuilder &
+  withAxis(const std::shared_ptr<ControllerOutput<double>> &ioutput,
+           const QLength &idiameter,
+           const AbstractMotor::GearsetRatioPair &ipair,
+           const PathfinderLimits &ilimits);
+
   /**
    * Sets the limits.
    *
@@ -99,6 +116,99 @@ class AsyncMotionProfileControllerBuilder {
    */
   AsyncMotionProfileControllerBuilder &withLimits(const PathfinderLimits &ilimits);
 
+  /**
+   * Sets the cache used when generating paths. This must be used with
+   * buildMotionProfileController(). See AsyncMotionProfileController::setPathCache().
+   *
+   * @param icache The path cache.
+   * @return An ongoing builder.
+   */
+  AsyncMotionProfileControllerBuilder &withPathCache(const std::shared_ptr<PathCache> &icache);
+
+  /**
+   * Compiles paths into tables of motor commands when they are generated or loaded. This must be
+   * used with buildMotionProfileController(). See
+   * AsyncMotionProfileController::setCompileMotorCommands().
+   *
+   * @return An ongoing builder.
+   */
+  AsyncMotionProfileControllerBuilder &withCompiledMotorCommands();
+
+  /**
+   * Stores paths compactly when they are generated or loaded. This must be used with
+   * buildMotionProfileController(). See AsyncMotionProfileController::setCompactPathStorage().
+   *
+   * @return An ongoing builder.
+   */
+  AsyncMotionProfileControllerBuilder &withCompactPathStorage();
+
+  /**
+   * Generates paths with TrajectoryGenerator instead of squiggles. This must be used with
+   * buildMotionProfileController(). See
+   * AsyncMotionProfileController::setNativeTrajectoryGeneration().
+   *
+   * @return An ongoing builder.
+   */
+  AsyncMotionProfileControllerBuilder &withNativeTrajectoryGeneration();
+
+  /**
+   * Follows paths by time instead of by segment. This must be used with
+   * buildMotionProfileController(). See AsyncMotionProfileController::setTimeIndexedFollowing().
+   *
+   * @return An ongoing builder.
+   */
+  AsyncMotionProfileControllerBuilder &withTimeIndexedFollowing();
+
+  /**
+   * Streams paths generated by `moveTo()`. This must be used with buildMotionProfileController().
+   * See AsyncMotionProfileController::setMoveToStreaming().
+   *
+   * @param isegmentsPerChunk The number of waypoint-to-waypoint segments per chunk.
+   * @param ileadTime How much of the path must be generated before the robot starts moving.
+   * @return An ongoing builder.
+   */
+  AsyncMotionProfileControllerBuilder &withMoveToStreaming(std::size_t isegmentsPerChunk,
+                                                           QTime ileadTime = 0_ms);
+
+  /**
+   * Follows paths with a voltage feedforward. This must be used with
+   * buildMotionProfileController(). See AsyncMotionProfileController::setFeedforward().
+   *
+   * @param igains The feedforward gains.
+   * @return An ongoing builder.
+   */
+  AsyncMotionProfileControllerBuilder &withFeedforward(const FeedforwardGains &igains);
+
+  /**
+   * Follows paths closed-loop using odometry, such as that of an OdomChassisController. This must
+   * be used with buildMotionProfileController(). See AsyncMotionProfileController::setOdometry().
+   *
+   * @param iodometry The odometry.
+   * @param igains The RAMSETE gains.
+   * @return An ongoing builder.
+   */
+  AsyncMotionProfileControllerBuilder &withOdometry(const std::shared_ptr<Odometry> &iodometry,
+                                                    const RamseteGains &igains = RamseteGains{});
+
+  /**
+   * Makes `moveTo()` follow a closed-form profile instead of generating a path. This must be used
+   * with buildLinearMotionProfileController(). See
+   * AsyncLinearMotionProfileController::setMoveToShape().
+   *
+   * @param ishape The shape of the profile.
+   * @return An ongoing builder.
+   */
+  AsyncMotionProfileControllerBuilder &withLinearMoveToShape(LinearProfileShape ishape);
+
+  /**
+   * Sends path commands early to make up for the motors' actuation latency. See
+   * AsyncMotionProfileController::setActuationLatency().
+   *
+   * @param ilatency The actuation latency.
+   * @return An ongoing builder.
+   */
+  AsyncMotionProfileControllerBuilder &withActuationLatency(QTime ilatency);
+
   /**
    * Sets the TimeUtilFactory used when building the controller. The default is the static
    * TimeUtilFactory.
@@ -148,6 +258,13 @@ class AsyncMotionProfileControllerBuilder {
    */
   std::shared_ptr<AsyncLinearMotionProfileController> buildLinearMotionProfileController();
 
+  /**
+   * Builds the AsyncMultiAxisProfileController.
+   *
+   * @return A fully built AsyncMultiAxisProfileController.
+   */
+  std::shared_ptr<AsyncMultiAxisProfileController> buildMultiAxisMotionProfileController();
+
   /**
    * Builds the AsyncMotionProfileController.
    *
@@ -165,10 +282,24 @@ class AsyncMotionProfileControllerBuilder {
   std::shared_ptr<ControllerOutput<double>> output;
   QLength diameter;
 
+  std::vector<LinearAxis> axes{};
+
   bool hasModel{false};
   std::shared_ptr<ChassisModel> model;
   ChassisScales scales{{1, 1}, imev5GreenTPR};
   AbstractMotor::GearsetRatioPair pair{AbstractMotor::gearset::invalid};
+  std::shared_ptr<PathCache> pathCache{nullptr};
+  bool compileMotorCommands{false};
+  bool compactPathStorage{false};
+  bool nativeTrajectoryGeneration{false};
+  bool timeIndexedFollowing{false};
+  std::size_t streamSegmentsPerChunk{0};
+  QTime streamLeadTime{0_ms};
+  std::optional<LinearProfileShape> linearMoveToShape{};
+  std::optional<FeedforwardGains> feedforward{};
+  std::shared_ptr<Odometry> odometry{nullptr};
+  RamseteGains ramseteGains{};
+  QTime actuationLatency{0_ms};
   TimeUtilFactory timeUtilFactory = TimeUtilFactory();
   std::shared_ptr<Logger> controllerLogger = Logger::getDefaultLogger();
 
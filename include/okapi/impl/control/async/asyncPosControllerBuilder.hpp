@@ -8,6 +8,7 @@
 #include "okapi/api/control/async/asyncPosIntegratedController.hpp"
 #include "okapi/api/control/async/asyncPosPidController.hpp"
 #include "okapi/api/control/async/asyncPositionController.hpp"
+#include "okapi/api/util/controlExecutor.hpp"
 #include "okapi/api/util/logging.hpp"
 #include "okapi/impl/device/motor/motor.hpp"
 #include "okapi/impl/device/motor/motorGroup.hpp"
@@ -128,6 +129,16 @@ class AsyncPosControllerBuilder {
    */
   AsyncPosControllerBuilder &withLogger(const std::shared_ptr<Logger> &ilogger);
 
+  /**
+   * Runs the PID controller from a ControlExecutor instead of its own task. Controllers which use
+   * integrated control have no task and ignore this. The executor is not parented to the current
+   * task by this builder.
+   *
+   * @param iexecutor The executor.
+   * @return An ongoing builder.
+   */
+  AsyncPosControllerBuilder &withExecutor(const std::shared_ptr<ControlExecutor> &iexecutor);
+
   /**
    * Parents the internal tasks started by this builder to the current task, meaning they will be
    * deleted once the current task is deleted. The `initialize` and `competition_initialize` tasks
@@ -181,6 +192,7 @@ class AsyncPosControllerBuilder {
 
   TimeUtilFactory timeUtilFactory = TimeUtilFactory();
   std::shared_ptr<Logger> controllerLogger = Logger::getDefaultLogger();
+  std::shared_ptr<ControlExecutor> executor;
 
   bool isParentedToCurrentTask{true};
 
@@ -8,6 +8,7 @@
 #include "okapi/api/control/async/asyncVelIntegratedController.hpp"
 #include "okapi/api/control/async/asyncVelPidController.hpp"
 #include "okapi/api/control/async/asyncVelocityController.hpp"
+#include "okapi/api/util/controlExecutor.hpp"
 #include "okapi/api/util/logging.hpp"
 #include "okapi/impl/device/motor/motor.hpp"
 #include "okapi/impl/device/motor/motorGroup.hpp"
@@ -137,6 +138,16 @@ class AsyncVelControllerBuilder {
    */
   AsyncVelControllerBuilder &withLogger(const std::shared_ptr<Logger> &ilogger);
 
+  /**
+   * Runs the PID controller from a ControlExecutor instead of its own task. Controllers which use
+   * integrated control have no task and ignore this. The executor is not parented to the current
+   * task by this builder.
+   *
+   * @param iexecutor The executor.
+   * @return An ongoing builder.
+   */
+  AsyncVelControllerBuilder &withExecutor(const std::shared_ptr<ControlExecutor> &iexecutor);
+
   /**
    * Parents the internal tasks started by this builder to the current task, meaning they will be
    * deleted once the current task is deleted. The `initialize` and `competition_initialize` tasks
@@ -194,6 +205,7 @@ class AsyncVelControllerBuilder {
 
   TimeUtilFactory timeUtilFactory = TimeUtilFactory();
   std::shared_ptr<Logger> controllerLogger = Logger::getDefaultLogger();
+  std::shared_ptr<ControlExecutor> executor;
 
   bool isParentedToCurrentTask{true};
 
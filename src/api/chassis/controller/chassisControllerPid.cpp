@@ -38,75 +38,81 @@ ChassisControllerPID::ChassisControllerPID(
 
 ChassisControllerPID::~ChassisControllerPID() {
   dtorCalled.store(true, std::memory_order_release);
+  if (executor) {
+    executor->remove(executorLoopId);
+    stop();
+  }
   delete task;
 }
 
 void ChassisControllerPID::loop() {
   LOG_INFO_S("Started ChassisControllerPID task.");
 
-  auto encStartVals = chassisModel->getSensorVals();
-  std::valarray<std::int32_t> encVals;
-  double distanceElapsed = 0, angleChange = 0;
-  modeType pastMode = none;
   auto rate = timeUtil.getRate();
-
   while (!dtorCalled.load(std::memory_order_acquire) && !task->notifyTake(0)) {
-    /**
-     * doneLooping is set to false by moveDistanceAsync and turnAngleAsync and then set to true by
-     * waitUntilSettled
-     */
-    if (doneLooping.load(std::memory_order_acquire)) {
-      doneLoopingSeen.store(true, std::memory_order_release);
-    } else {
-      if (mode != pastMode || newMovement.load(std::memory_order_acquire)) {
-        encStartVals = chassisModel->getSensorVals();
-        newMovement.store(false, std::memory_order_release);
-      }
+    stepMovement();
+    rate->delayUntil(threadSleepTime);
+  }
 
-      switch (mode) {
-      case distance:
-        encVals = chassisModel->getSensorVals() - encStartVals;
-        distanceElapsed = static_cast<double>((encVals[0] + encVals[1])) / 2.0;
-        angleChange = static_cast<double>(encVals[0] - encVals[1]);
+  stop();
 
-        distancePid->step(distanceElapsed);
-        anglePid->step(angleChange);
+  LOG_INFO_S("Stopped ChassisControllerPID task.");
+}
 
-        if (velocityMode) {
-          chassisModel->driveVector(distancePid->getOutput(), anglePid->getOutput());
-        } else {
-          chassisModel->driveVectorVoltage(distancePid->getOutput(), anglePid->getOutput());
-        }
+void ChassisControllerPID::stepMovement() {
+  /**
+   * doneLooping is set to false by moveDistanceAsync and turnAngleAsync and then set to true by
+   * waitUntilSettled
+   */
+  if (doneLooping.load(std::memory_order_acquire)) {
+    doneLoopingSeen.store(true, std::memory_order_release);
+    return;
+  }
 
-        break;
+  if (mode != pastMode || newMovement.load(std::memory_order_acquire)) {
+    encStartVals = chassisModel->getSensorVals();
+    newMovement.store(false, std::memory_order_release);
+  }
 
-      case angle:
-        encVals = chassisModel->getSensorVals() - encStartVals;
-        angleChange = (encVals[0] - encVals[1]) / 2.0;
+  std::valarray<std::int32_t> encVals;
+  double distanceElapsed = 0, angleChange = 0;
 
-        turnPid->step(angleChange);
+  switch (mode) {
+  case distance:
+    encVals = chassisModel->getSensorVals() - encStartVals;
+    distanceElapsed = static_cast<double>((encVals[0] + encVals[1])) / 2.0;
+    angleChange = static_cast<double>(encVals[0] - encVals[1]);
 
-        if (velocityMode) {
-          chassisModel->driveVector(0, turnPid->getOutput());
-        } else {
-          chassisModel->driveVectorVoltage(0, turnPid->getOutput());
-        }
+    distancePid->step(distanceElapsed);
+    anglePid->step(angleChange);
 
-        break;
+    if (velocityMode) {
+      chassisModel->driveVector(distancePid->getOutput(), anglePid->getOutput());
+    } else {
+      chassisModel->driveVectorVoltage(distancePid->getOutput(), anglePid->getOutput());
+    }
+
+    break;
+
+  case angle:
+    encVals = chassisModel->getSensorVals() - encStartVals;
+    angleChange = (encVals[0] - encVals[1]) / 2.0;
 
-      default:
-        break;
-      }
+    turnPid->step(angleChange);
 
-      pastMode = mode;
+    if (velocityMode) {
+      chassisModel->driveVector(0, turnPid->getOutput());
+    } else {
+      chassisModel->driveVectorVoltage(0, turnPid->getOutput());
     }
 
-    rate->delayUntil(threadSleepTime);
-  }
+    break;
 
-  stop();
+  default:
+    break;
+  }
 
-  LOG_INFO_S("Stopped ChassisControllerPID task.");
+  pastMode = mode;
 }
 
 void ChassisControllerPID::trampoline(void *context) {
@@ -316,12 +322,27 @@ ChassisControllerPID::getGains() const {
   return std::make_tuple(distancePid->getGains(), turnPid->getGains(), anglePid->getGains());
 }
 
+void ChassisControllerPID::setTelemetry(const std::shared_ptr<TelemetrySink> &isink,
+                                        const std::string &ichannelPrefix) {
+  distancePid->setTelemetry(isink, ichannelPrefix + "distance");
+  turnPid->setTelemetry(isink, ichannelPrefix + "turn");
+  anglePid->setTelemetry(isink, ichannelPrefix + "angle");
+}
+
 void ChassisControllerPID::startThread() {
   if (!task) {
     task = new CrossplatformThread(trampoline, this, "ChassisControllerPID");
   }
 }
 
+void ChassisControllerPID::startOnExecutor(const std::shared_ptr<ControlExecutor> &iexecutor) {
+  if (!task && !executor) {
+    executor = iexecutor;
+    executorLoopId =
+      executor->add("ChassisControllerPID", threadSleepTime, [this] { stepMovement(); });
+  }
+}
+
 CrossplatformThread *ChassisControllerPID::getThread() const {
   return task;
 }
@@ -22,6 +22,9 @@ OdomChassisController::OdomChassisController(TimeUtil itimeUtil,
 
 OdomChassisController::~OdomChassisController() {
   dtorCalled.store(true, std::memory_order_release);
+  if (executor) {
+    executor->remove(executorLoopId);
+  }
   delete odomTask;
 }
 
@@ -59,6 +62,15 @@ void OdomChassisController::startOdomThread() {
   }
 }
 
+void OdomChassisController::startOdomOnExecutor(
+  const std::shared_ptr<ControlExecutor> &iexecutor) {
+  if (!odomTask && !executor) {
+    executor = iexecutor;
+    executorLoopId = executor->add("OdomChassisController", 10_ms, [this] { odom->step(); });
+    odomTaskRunning = true;
+  }
+}
+
 void OdomChassisController::trampoline(void *context) {
   if (context) {
     static_cast<OdomChassisController *>(context)->loop();
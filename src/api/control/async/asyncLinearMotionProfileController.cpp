@@ -5,6 +5,8 @@
  */
 #include "okapi/api/control/async/asyncLinearMotionProfileController.hpp"
 #include "okapi/api/util/mathUtil.hpp"
+#include <algorithm>
+#include <cmath>
 #include <mutex>
 #include <numeric>
 
@@ -29,31 +31,38 @@ AsyncLinearMotionProfileController::AsyncLinearMotionProfileController(
     LOG_ERROR(msg);
     throw std::invalid_argument(msg);
   }
+
+  moveToPath = paths.intern("__moveTo");
 }
 
 AsyncLinearMotionProfileController::~AsyncLinearMotionProfileController() {
   dtorCalled.store(true, std::memory_order_release);
 
-  // Free paths before deleting the task
-  std::scoped_lock lock(currentPathMutex);
-  paths.clear();
+  // Free paths before deleting the task. The lock must be released before deleting the task
+  // because the task might be waiting on it.
+  {
+    std::scoped_lock lock(currentPathMutex);
+    paths.clear();
+  }
 
   delete task;
 }
 
-void AsyncLinearMotionProfileController::generatePath(std::initializer_list<QLength> iwaypoints,
-                                                      const std::string &ipathId) {
-  generatePath(iwaypoints, ipathId, limits);
+PathHandle
+AsyncLinearMotionProfileController::generatePath(std::initializer_list<QLength> iwaypoints,
+                                                 const std::string &ipathId) {
+  return generatePath(iwaypoints, ipathId, limits);
 }
 
-void AsyncLinearMotionProfileController::generatePath(std::initializer_list<QLength> iwaypoints,
-                                                      const std::string &ipathId,
-                                                      const PathfinderLimits &ilimits) {
+PathHandle
+AsyncLinearMotionProfileController::generatePath(std::initializer_list<QLength> iwaypoints,
+                                                 const std::string &ipathId,
+                                                 const PathfinderLimits &ilimits) {
   if (iwaypoints.size() == 0) {
     // No point in generating a path
     LOG_WARN_S("AsyncLinearMotionProfileController: Not generating a path because no "
                "waypoints were given.");
-    return;
+    return PathHandle();
   }
 
   std::vector<squiggles::Pose> points;
@@ -66,16 +75,56 @@ void AsyncLinearMotionProfileController::generatePath(std::initializer_list<QLen
 
   auto constraints = squiggles::Constraints(ilimits.maxVel, ilimits.maxAccel, ilimits.maxJerk);
   auto splineGenerator =
-    squiggles::SplineGenerator(constraints, std::make_shared<squiggles::PassthroughModel>(), 0.01);
-  auto path = splineGenerator.generate(points);
+    squiggles::SplineGenerator(constraints, std::make_shared<squiggles::PassthroughModel>(), DT);
+  auto path = std::make_shared<const LinearPath>(splineGenerator.generate(points));
+  const auto handle = internPath(ipathId);
+  publishPath(handle, path);
 
-  // Free the old path before overwriting it
-  forceRemovePath(ipathId);
+  LOG_INFO("AsyncLinearMotionProfileController: Completely done generating path " + ipathId);
+  LOG_DEBUG("AsyncLinearMotionProfileController: Path length: " +
+            std::to_string(path->size()));
+  return handle;
+}
+
+PathHandle AsyncLinearMotionProfileController::generateAnalyticPath(
+  const QLength &istart,
+  const QLength &iend,
+  const std::string &ipathId,
+  const LinearProfileShape ishape) {
+  return generateAnalyticPath(istart, iend, ipathId, limits, ishape);
+}
+
+PathHandle AsyncLinearMotionProfileController::generateAnalyticPath(
+  const QLength &istart,
+  const QLength &iend,
+  const std::string &ipathId,
+  const PathfinderLimits &ilimits,
+  const LinearProfileShape ishape) {
+  LinearPathPtr path;
+  try {
+    path = std::make_shared<const LinearPath>(LinearProfile(ishape, istart, iend, ilimits));
+  } catch (const std::invalid_argument &e) {
+    LOG_ERROR("AsyncLinearMotionProfileController: Could not generate path " + ipathId + ": " +
+              e.what());
+    throw;
+  }
 
-  paths.emplace(ipathId, path);
+  const auto handle = internPath(ipathId);
+  publishPath(handle, path);
 
   LOG_INFO("AsyncLinearMotionProfileController: Completely done generating path " + ipathId);
-  LOG_DEBUG("AsyncLinearMotionProfileController: Path length: " + std::to_string(path.size()));
+  LOG_DEBUG("AsyncLinearMotionProfileController: Path duration: " +
+            std::to_string(path->getAnalytic().getDuration().convert(second)) + " s");
+  return handle;
+}
+
+void AsyncLinearMotionProfileController::publishPath(const PathHandle ipath,
+                                                     LinearPathPtr isnapshot) {
+  // Free the old path before overwriting it
+  forceRemovePath(ipath);
+
+  std::scoped_lock lock(currentPathMutex);
+  paths.set(ipath, std::move(isnapshot));
 }
 
 std::string
@@ -98,17 +147,29 @@ AsyncLinearMotionProfileController::getPathErrorMessage(const std::vector<Pathfi
 }
 
 bool AsyncLinearMotionProfileController::removePath(const std::string &ipathId) {
-  if (!isDisabled() && isRunning.load(std::memory_order_acquire) && getTarget() == ipathId) {
-    LOG_WARN("AsyncLinearMotionProfileController: Attempted to remove currently running path " +
-             ipathId);
-    return false;
+  PathHandle path;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    path = paths.find(ipathId);
   }
 
+  // A path which was never saved doesn't exist
+  return !path.isValid() || removePath(path);
+}
+
+bool AsyncLinearMotionProfileController::removePath(const PathHandle ipath) {
   std::scoped_lock lock(currentPathMutex);
 
-  auto oldPath = paths.find(ipathId);
-  if (oldPath != paths.end()) {
-    paths.erase(ipathId);
+  if (!isDisabled() && isRunning.load(std::memory_order_acquire) && currentPath == ipath) {
+    LOG_WARN("AsyncLinearMotionProfileController: Attempted to remove currently running path " +
+             paths.getName(ipath));
+    return false;
+  }
+
+  // If the path is being followed, the follower keeps its own reference, so erasing it here only
+  // drops the controller's reference
+  if (ipath.isValid()) {
+    paths.set(ipath, nullptr);
   }
 
   /*
@@ -119,14 +180,19 @@ bool AsyncLinearMotionProfileController::removePath(const std::string &ipathId)
   return true;
 }
 
-std::vector<std::string> AsyncLinearMotionProfileController::getPaths() {
-  std::vector<std::string> keys;
+PathHandle AsyncLinearMotionProfileController::getPathHandle(const std::string &ipathId) {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.find(ipathId);
+}
 
-  for (const auto &path : paths) {
-    keys.push_back(path.first);
-  }
+PathHandle AsyncLinearMotionProfileController::internPath(const std::string &ipathId) {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.intern(ipathId);
+}
 
-  return keys;
+std::vector<std::string> AsyncLinearMotionProfileController::getPaths() {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.getNames();
 }
 
 void AsyncLinearMotionProfileController::setTarget(std::string ipathId) {
@@ -134,10 +200,38 @@ void AsyncLinearMotionProfileController::setTarget(std::string ipathId) {
 }
 
 void AsyncLinearMotionProfileController::setTarget(std::string ipathId, const bool ibackwards) {
-  LOG_INFO("AsyncLinearMotionProfileController: Set target to: " + ipathId + " (ibackwards" +
-           std::to_string(ibackwards) + ")");
+  PathHandle path;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    path = paths.find(ipathId);
+    if (!path.isValid()) {
+      // Remember the ID for getTarget() without adding a slot for it to the table
+      currentPath = PathHandle();
+      missingTargetId = ipathId;
+    }
+  }
+
+  if (!path.isValid()) {
+    LOG_WARN(
+      "AsyncLinearMotionProfileController: Target was set to non-existent path with name: " +
+      ipathId);
+    return;
+  }
+
+  setTarget(path, ibackwards);
+}
+
+void AsyncLinearMotionProfileController::setTarget(const PathHandle ipath, const bool ibackwards) {
+  // Only capture the handle so nothing is copied unless the message is logged
+  LOG_INFO("AsyncLinearMotionProfileController: Set target to: " + getPathName(ipath) +
+           " (ibackwards" + std::to_string(ibackwards) + ")");
+
+  {
+    std::scoped_lock lock(currentPathMutex);
+    currentPath = ipath;
+    missingTargetId.clear();
+  }
 
-  currentPath = ipathId;
   direction.store(boolToSign(!ibackwards), std::memory_order_release);
   isRunning.store(true, std::memory_order_release);
 }
@@ -147,15 +241,24 @@ void AsyncLinearMotionProfileController::controllerSet(const std::string ivalue)
 }
 
 std::string AsyncLinearMotionProfileController::getTarget() {
-  return currentPath;
+  std::scoped_lock lock(currentPathMutex);
+  return currentPath.isValid() ? paths.getName(currentPath) : missingTargetId;
 }
 
 std::string AsyncLinearMotionProfileController::getTarget() const {
-  return currentPath;
+  std::scoped_lock lock(currentPathMutex);
+  return currentPath.isValid() ? paths.getName(currentPath) : missingTargetId;
 }
 
 std::string AsyncLinearMotionProfileController::getProcessValue() const {
-  return currentPath;
+  std::scoped_lock lock(currentPathMutex);
+  return currentPath.isValid() ? paths.getName(currentPath) : missingTargetId;
+}
+
+const std::string &AsyncLinearMotionProfileController::getPathName(const PathHandle ipath) const {
+  // Interned names are never moved, so the reference outlives the lock
+  std::scoped_lock lock(currentPathMutex);
+  return paths.getName(ipath);
 }
 
 void AsyncLinearMotionProfileController::loop() {
@@ -165,19 +268,31 @@ void AsyncLinearMotionProfileController::loop() {
 
   while (!dtorCalled.load(std::memory_order_acquire) && !task->notifyTake(0)) {
     if (isRunning.load(std::memory_order_acquire) && !isDisabled()) {
-      LOG_INFO("AsyncLinearMotionProfileController: Running with path: " + currentPath);
+      PathHandle target;
+      {
+        std::scoped_lock lock(currentPathMutex);
+        target = currentPath;
+      }
 
-      auto path = paths.find(currentPath);
+      LOG_INFO("AsyncLinearMotionProfileController: Running with path: " + getPathName(target));
 
-      if (path == paths.end()) {
+      // Take our own reference to the path so it stays valid even if it is removed or replaced
+      // while we follow it
+      const auto path = findPath(target);
+
+      if (!path) {
         LOG_WARN(
           "AsyncLinearMotionProfileController: Target was set to non-existent path with name: " +
-          currentPath);
+          getPathName(target));
       } else {
-        LOG_DEBUG("AsyncLinearMotionProfileController: Path length is " +
-                  std::to_string(path->second.size()));
+        if (path->isAnalytic()) {
+          executeAnalyticPath(path->getAnalytic(), timeUtil.getRate());
+        } else {
+          LOG_DEBUG("AsyncLinearMotionProfileController: Path length is " +
+                    std::to_string(path->size()));
 
-        executeSinglePath(path->second, timeUtil.getRate());
+          executeSinglePath(path->getProfile(), timeUtil.getRate());
+        }
 
         // Set 0 after the path because:
         // 1. We only support an exit velocity of zero
@@ -201,26 +316,50 @@ void AsyncLinearMotionProfileController::executeSinglePath(
   std::unique_ptr<AbstractRate> rate) {
   const auto reversed = direction.load(std::memory_order_acquire);
 
-  std::scoped_lock pathLock(currentPathMutex);
-  // store this locally so we aren't accessing the path when we don't know if it's valid
-  std::size_t pathSize = path.size();
-  currentPathMutex.unlock();
-  for (std::size_t i = 0; i < pathSize && !isDisabled(); ++i) {
-    // This mutex is used to combat an edge case of an edge case
-    // if a running path is asked to be removed at the moment this loop is executing
-    std::scoped_lock lock(currentPathMutex);
+  // Send each command one actuation latency early so the motors apply it when the path wants it
+  const auto lookahead =
+    static_cast<std::size_t>(std::round(getActuationLatency().convert(second) / DT));
 
+  for (std::size_t i = 0; i < path.size() && !isDisabled(); ++i) {
     const auto segDT = path[i].time * millisecond;
-    currentProfilePosition = path[i].vector.pose.x;
+    currentProfilePosition.store(path[i].vector.pose.x, std::memory_order_release);
+    sendVelocity(path[std::min(i + lookahead, path.size() - 1)].vector.vel * reversed);
+    rate->delayUntil(segDT);
+  }
+}
 
-    const auto motorRPM = convertLinearToRotational(path[i].vector.vel * mps).convert(rpm);
-    output->controllerSet(motorRPM / toUnderlyingType(pair.internalGearset) * reversed);
+void AsyncLinearMotionProfileController::executeAnalyticPath(const LinearProfile &profile,
+                                                             std::unique_ptr<AbstractRate> rate) {
+  const auto reversed = direction.load(std::memory_order_acquire);
+  const auto duration = profile.getDuration();
+  const auto latency = getActuationLatency();
 
-    // Unlock before the delay to be nice to other tasks
-    currentPathMutex.unlock();
+  const auto timer = timeUtil.getTimer();
+  const QTime start = timer->millis();
 
-    rate->delayUntil(segDT);
+  while (!isDisabled()) {
+    // Sampling by time means a late tick catches up to where the profile should be now
+    const QTime elapsed = timer->millis() - start;
+    if (elapsed >= duration) {
+      break;
+    }
+
+    const auto state = profile.sample(elapsed);
+    currentProfilePosition.store(state.position, std::memory_order_release);
+
+    // Send the command one actuation latency early so the motors apply it when the profile wants it
+    sendVelocity(profile.sample(elapsed + latency).velocity * reversed);
+    rate->delayUntil(10_ms);
   }
+
+  if (!isDisabled()) {
+    currentProfilePosition.store(profile.getEnd(), std::memory_order_release);
+  }
+}
+
+void AsyncLinearMotionProfileController::sendVelocity(const double ivelocity) {
+  const auto motorRPM = convertLinearToRotational(ivelocity * mps).convert(rpm);
+  output->controllerSet(motorRPM / toUnderlyingType(pair.internalGearset));
 }
 
 QAngularSpeed AsyncLinearMotionProfileController::convertLinearToRotational(QSpeed linear) const {
@@ -254,26 +393,78 @@ void AsyncLinearMotionProfileController::moveTo(const QLength &iposition,
                                                 const QLength &itarget,
                                                 const PathfinderLimits &ilimits,
                                                 const bool ibackwards) {
-  static int moveToCount = 0;
-  std::string name = "__moveTo" + std::to_string(moveToCount++);
-  generatePath({iposition, itarget}, name, ilimits);
-  setTarget(name, ibackwards);
+  // Every move reuses the same slot so no name is formatted
+  if (const auto shape = getMoveToShape(); shape) {
+    generateAnalyticPath(iposition, itarget, getPathName(moveToPath), ilimits, *shape);
+  } else {
+    generatePath({iposition, itarget}, getPathName(moveToPath), ilimits);
+  }
+
+  setTarget(moveToPath, ibackwards);
   waitUntilSettled();
-  if (!removePath(name)) {
+  if (!removePath(moveToPath)) {
     // Failed to remove path (Warn and move on)
     LOG_WARN_S("AsyncLinearMotionProfileController: Couldn't remove path after moveTo");
   }
 }
 
+void AsyncLinearMotionProfileController::setMoveToShape(
+  const std::optional<LinearProfileShape> ishape) {
+  std::scoped_lock lock(currentPathMutex);
+  moveToShape = ishape;
+}
+
+std::optional<LinearProfileShape> AsyncLinearMotionProfileController::getMoveToShape() const {
+  std::scoped_lock lock(currentPathMutex);
+  return moveToShape;
+}
+
+void AsyncLinearMotionProfileController::setActuationLatency(const QTime ilatency) {
+  if (ilatency < 0_ms) {
+    std::string msg("AsyncLinearMotionProfileController: The actuation latency can't be negative.");
+    LOG_ERROR(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  std::scoped_lock lock(currentPathMutex);
+  actuationLatency = ilatency;
+}
+
+QTime AsyncLinearMotionProfileController::getActuationLatency() const {
+  std::scoped_lock lock(currentPathMutex);
+  return actuationLatency;
+}
+
 double AsyncLinearMotionProfileController::getError() const {
-  if (const auto path = paths.find(getTarget()); path == paths.end()) {
+  PathHandle target;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    target = currentPath;
+  }
+
+  if (const auto path = findPath(target); !path) {
+    return 0;
+  } else if (path->isAnalytic()) {
+    return path->getAnalytic().getEnd() - currentProfilePosition.load(std::memory_order_acquire);
+  } else if (path->size() == 0) {
     return 0;
   } else {
     // The last position in the path is the target position
-    return path->second.back().vector.pose.x - currentProfilePosition;
+    return path->getProfile().back().vector.pose.x -
+           currentProfilePosition.load(std::memory_order_acquire);
   }
 }
 
+LinearPathPtr AsyncLinearMotionProfileController::findPath(const std::string &ipathId) const {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.get(paths.find(ipathId));
+}
+
+LinearPathPtr AsyncLinearMotionProfileController::findPath(const PathHandle ipath) const {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.get(ipath);
+}
+
 bool AsyncLinearMotionProfileController::isSettled() {
   return isDisabled() || !isRunning.load(std::memory_order_acquire);
 }
@@ -324,10 +515,23 @@ void AsyncLinearMotionProfileController::setMaxVelocity(std::int32_t) {
 }
 
 void AsyncLinearMotionProfileController::forceRemovePath(const std::string &ipathId) {
-  if (!removePath(ipathId)) {
-    LOG_WARN("AsyncLinearMotionProfileController: Disabling controller to remove path " + ipathId);
+  PathHandle path;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    path = paths.find(ipathId);
+  }
+
+  if (path.isValid()) {
+    forceRemovePath(path);
+  }
+}
+
+void AsyncLinearMotionProfileController::forceRemovePath(const PathHandle ipath) {
+  if (!removePath(ipath)) {
+    LOG_WARN("AsyncLinearMotionProfileController: Disabling controller to remove path " +
+             getPathName(ipath));
     flipDisable(true);
-    removePath(ipathId);
+    removePath(ipath);
   }
 }
 
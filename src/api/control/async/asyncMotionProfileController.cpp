@@ -4,6 +4,7 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <mutex>
@@ -32,56 +33,533 @@ AsyncMotionProfileController::AsyncMotionProfileController(
     LOG_ERROR(msg);
     throw std::invalid_argument(msg);
   }
+  moveToPath = paths.intern("__moveTo");
 }
 
 AsyncMotionProfileController::~AsyncMotionProfileController() {
   dtorCalled.store(true, std::memory_order_release);
 
-  // Free paths before deleting the task
-  std::scoped_lock lock(currentPathMutex);
-  paths.clear();
+  // Stop the generation workers first because their jobs reference this controller
+  generationPool.reset();
+
+  // Free paths before deleting the task. The lock must be released before deleting the task
+  // because the task might be waiting on it.
+  {
+    std::scoped_lock lock(currentPathMutex);
+    for (const auto &pending : paths.getAllPending()) {
+      if (!pending->isDone()) {
+        pending->markFailed("The controller was destroyed before the path was generated.");
+      }
+    }
+    paths.clear();
+  }
 
   delete task;
 }
 
-void AsyncMotionProfileController::generatePath(std::initializer_list<PathfinderPoint> iwaypoints,
+PathHandle
+AsyncMotionProfileController::generatePath(std::initializer_list<PathfinderPoint> iwaypoints,
+                                           const std::string &ipathId) {
+  return generatePath(iwaypoints, ipathId, limits);
+}
+
+PathHandle
+AsyncMotionProfileController::generatePath(std::initializer_list<PathfinderPoint> iwaypoints,
+                                           const std::string &ipathId,
+                                           const PathfinderLimits &ilimits) {
+  if (iwaypoints.size() == 0) {
+    // No point in generating a path
+    LOG_WARN_S(
+      "AsyncMotionProfileController: Not generating a path because no waypoints were given.");
+    return PathHandle();
+  }
+
+  LOG_INFO_S("AsyncMotionProfileController: Preparing trajectory");
+
+  auto path = generateProfile(iwaypoints, ilimits);
+  const auto pathSize = path.size();
+  const auto handle = publishPath(internPath(ipathId), std::move(path));
+
+  LOG_INFO("AsyncMotionProfileController: Completely done generating path " + ipathId);
+  LOG_DEBUG("AsyncMotionProfileController: Path length: " + std::to_string(pathSize));
+  return handle;
+}
+
+void AsyncMotionProfileController::generatePathChain(
+  const std::vector<std::vector<PathfinderPoint>> &ipaths,
+  const std::vector<std::string> &ipathIds) {
+  generatePathChain(ipaths, ipathIds, limits);
+}
+
+void AsyncMotionProfileController::generatePathChain(
+  const std::vector<std::vector<PathfinderPoint>> &ipaths,
+  const std::vector<std::string> &ipathIds,
+  const PathfinderLimits &ilimits) {
+  if (ipaths.size() != ipathIds.size()) {
+    std::string msg("AsyncMotionProfileController: Got " + std::to_string(ipaths.size()) +
+                    " paths but " + std::to_string(ipathIds.size()) + " path IDs.");
+    LOG_ERROR(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  if (ipaths.empty()) {
+    LOG_WARN_S("AsyncMotionProfileController: Not generating a chain because no paths were given.");
+    return;
+  }
+
+  // Plan the velocities over the whole chain from the length of each path. Each path is measured
+  // on its own because consecutive paths are often written in their own frames, so the gap between
+  // the end of one path and the start of the next is not driven.
+  std::vector<double> lengths;
+  for (std::size_t i = 0; i < ipaths.size(); ++i) {
+    if (ipaths[i].size() < 2) {
+      std::string msg("AsyncMotionProfileController: Path " + ipathIds[i] +
+                      " in the chain has fewer than two waypoints.");
+      LOG_ERROR(msg);
+      throw std::invalid_argument(msg);
+    }
+
+    lengths.push_back(getWaypointDistance(ipaths[i], 0, ipaths[i].size() - 1));
+  }
+
+  const auto velocities = planJunctionVelocities(lengths, ilimits);
+
+  for (std::size_t i = 0; i < ipaths.size(); ++i) {
+    LOG_INFO("AsyncMotionProfileController: Generating path " + ipathIds[i] + " of a chain");
+    publishPath(internPath(ipathIds[i]),
+                generateProfile(ipaths[i], ilimits, velocities[i], velocities[i + 1]));
+  }
+}
+
+std::shared_ptr<PathGenerationHandle>
+AsyncMotionProfileController::generatePathAsync(std::initializer_list<PathfinderPoint> iwaypoints,
                                                 const std::string &ipathId) {
-  generatePath(iwaypoints, ipathId, limits);
+  return generatePathAsync(iwaypoints, ipathId, limits);
 }
 
-void AsyncMotionProfileController::generatePath(std::initializer_list<PathfinderPoint> iwaypoints,
+std::shared_ptr<PathGenerationHandle>
+AsyncMotionProfileController::generatePathAsync(std::initializer_list<PathfinderPoint> iwaypoints,
                                                 const std::string &ipathId,
                                                 const PathfinderLimits &ilimits) {
+  auto handle = std::make_shared<PathGenerationHandle>(ipathId, timeUtil);
+
   if (iwaypoints.size() == 0) {
-    // No point in generating a path
     LOG_WARN_S(
       "AsyncMotionProfileController: Not generating a path because no waypoints were given.");
-    return;
+    handle->markFailed("No waypoints were given.");
+    return handle;
   }
 
-  std::vector<squiggles::Pose> points;
-  points.reserve(iwaypoints.size());
-  for (auto &point : iwaypoints) {
-    points.push_back(squiggles::Pose{
-      point.y.convert(meter), point.x.convert(meter), (90_deg - point.theta).convert(radian)});
+  const auto path = internPath(ipathId);
+  std::scoped_lock lock(currentPathMutex);
+
+  if (!generationPool) {
+    generationPool = std::make_unique<WorkerPool>(
+      timeUtil, WorkerPool::getDefaultWorkerCount(), maxQueuedGenerations, logger);
   }
 
-  LOG_INFO_S("AsyncMotionProfileController: Preparing trajectory");
+  setPendingPath(path, handle);
 
-  auto constraints = squiggles::Constraints(ilimits.maxVel, ilimits.maxAccel, ilimits.maxJerk);
-  auto splineGenerator = squiggles::SplineGenerator(
-    constraints,
-    std::make_shared<squiggles::TankModel>(scales.wheelTrack.convert(meter), constraints),
-    DT);
-  auto path = splineGenerator.generate(points);
+  const bool queued = generationPool->submit(
+    [this, path, handle, waypoints = std::vector<PathfinderPoint>(iwaypoints), ilimits]() {
+      handle->markGenerating();
+      if (handle->getState() != PathGenerationHandle::State::generating) {
+        // A newer request for the same ID replaced this one while it was queued
+        return;
+      }
 
-  // Free the old path before overwriting it
-  forceRemovePath(ipathId);
+      try {
+        auto snapshot = makeStoredPath(generateProfile(waypoints, ilimits));
+        if (publishGeneratedPath(path, handle, std::move(snapshot))) {
+          handle->markDone();
+          LOG_INFO("AsyncMotionProfileController: Completely done generating path " +
+                   handle->getPathId());
+        } else {
+          LOG_INFO("AsyncMotionProfileController: Dropped path " + handle->getPathId() +
+                   " because a newer request for it replaced this one");
+        }
+      } catch (const std::exception &e) {
+        LOG_ERROR("AsyncMotionProfileController: Failed to generate path " +
+                  handle->getPathId() + ": " + e.what());
+        if (clearPendingPath(path, handle)) {
+          handle->markFailed(e.what());
+        }
+      }
+    });
 
-  paths.insert({ipathId, path});
+  if (!queued) {
+    paths.setPending(path, nullptr);
+    handle->markFailed("The path generation queue is full.");
+  }
 
-  LOG_INFO("AsyncMotionProfileController: Completely done generating path " + ipathId);
-  LOG_DEBUG("AsyncMotionProfileController: Path length: " + std::to_string(path.size()));
+  return handle;
+}
+
+std::shared_ptr<PathBatch>
+AsyncMotionProfileController::generatePaths(const PathManifest &imanifest) {
+  std::vector<PathHandle> pathHandles;
+  std::vector<std::shared_ptr<PathGenerationHandle>> generationHandles;
+  pathHandles.reserve(imanifest.paths.size());
+  generationHandles.reserve(imanifest.paths.size());
+  for (const auto &entry : imanifest.paths) {
+    pathHandles.push_back(internPath(entry.id));
+    generationHandles.push_back(std::make_shared<PathGenerationHandle>(entry.id, timeUtil));
+  }
+
+  auto batch = std::make_shared<PathBatch>(generationHandles, timeUtil);
+  if (imanifest.paths.empty()) {
+    return batch;
+  }
+
+  LOG_INFO("AsyncMotionProfileController: Generating a batch of " +
+           std::to_string(imanifest.paths.size()) + " paths");
+
+  std::scoped_lock lock(currentPathMutex);
+
+  if (!generationPool) {
+    generationPool = std::make_unique<WorkerPool>(
+      timeUtil, WorkerPool::getDefaultWorkerCount(), maxQueuedGenerations, logger);
+  }
+
+  for (std::size_t i = 0; i < pathHandles.size(); ++i) {
+    setPendingPath(pathHandles[i], generationHandles[i]);
+  }
+
+  // Each job claims paths until there are none left, so there only needs to be one job per worker
+  // and the queue can't overflow however long the manifest is
+  const auto job = [this, batch, pathHandles, entries = imanifest.paths]() {
+    const auto timer = timeUtil.getTimer();
+
+    auto i = batch->claimNext();
+    for (; i < batch->size() && !dtorCalled.load(std::memory_order_acquire);
+         i = batch->claimNext()) {
+      const auto &handle = batch->getHandle(i);
+      handle->markGenerating();
+      if (handle->getState() != PathGenerationHandle::State::generating) {
+        // A newer request for the same ID replaced this one before it started
+        continue;
+      }
+
+      try {
+        const QTime start = timer->millis();
+        auto snapshot = makeStoredPath(generateProfile(entries[i].waypoints, entries[i].limits));
+        const QTime elapsed = timer->millis() - start;
+        const auto bytesUsed = snapshot->getBytesUsed();
+
+        if (publishGeneratedPath(pathHandles[i], handle, std::move(snapshot))) {
+          batch->recordResult(i, elapsed, bytesUsed);
+          handle->markDone();
+          LOG_INFO("AsyncMotionProfileController: Generated path " + entries[i].id +
+                   " of a batch in " + std::to_string(elapsed.convert(millisecond)) + " ms");
+        } else {
+          LOG_INFO("AsyncMotionProfileController: Dropped path " + entries[i].id +
+                   " of a batch because a newer request for it replaced this one");
+        }
+      } catch (const std::exception &e) {
+        LOG_ERROR("AsyncMotionProfileController: Failed to generate path " + entries[i].id +
+                  " of a batch: " + e.what());
+        if (clearPendingPath(pathHandles[i], handle)) {
+          handle->markFailed(e.what());
+        }
+      }
+    }
+
+    if (i < batch->size()) {
+      // The controller is being destroyed, so neither the path this job claimed last nor the paths
+      // no job claimed will be generated
+      if (clearPendingPath(pathHandles[i], batch->getHandle(i))) {
+        batch->getHandle(i)->markFailed(
+          "The controller was destroyed before the path was generated.");
+      }
+      batch->cancel();
+    }
+
+    // The paths a cancel skipped will never be generated, so stop waiting for them
+    for (auto skipped = batch->getFirstSkipped(); skipped < batch->size(); ++skipped) {
+      clearPendingPath(pathHandles[skipped], batch->getHandle(skipped));
+    }
+  };
+
+  const auto jobCount = std::min(generationPool->getWorkerCount(), pathHandles.size());
+  std::size_t queuedCount = 0;
+  for (std::size_t i = 0; i < jobCount; ++i) {
+    if (generationPool->submit(job)) {
+      ++queuedCount;
+    }
+  }
+
+  if (queuedCount == 0) {
+    LOG_ERROR_S("AsyncMotionProfileController: Could not queue a batch because the path "
+                "generation queue is full.");
+    for (std::size_t i = 0; i < pathHandles.size(); ++i) {
+      if (paths.getPending(pathHandles[i]) == generationHandles[i]) {
+        paths.setPending(pathHandles[i], nullptr);
+      }
+      generationHandles[i]->markFailed("The path generation queue is full.");
+    }
+  }
+
+  return batch;
+}
+
+PathHandle AsyncMotionProfileController::transformPath(const PathHandle isource,
+                                                       const std::string &ipathId,
+                                                       const PathfinderPoint &iorigin) {
+  const auto source = findSourcePath(isource);
+  if (!source) {
+    return PathHandle();
+  }
+
+  LOG_INFO("AsyncMotionProfileController: Saving transformed path " + ipathId);
+  return publishPath(internPath(ipathId),
+                     PathTransform::transform(source->toProfile(), iorigin));
+}
+
+PathHandle AsyncMotionProfileController::mirrorPath(const PathHandle isource,
+                                                    const std::string &ipathId,
+                                                    const PathfinderPoint &iaxis) {
+  const auto source = findSourcePath(isource);
+  if (!source) {
+    return PathHandle();
+  }
+
+  LOG_INFO("AsyncMotionProfileController: Saving mirrored path " + ipathId);
+  return publishPath(internPath(ipathId), PathTransform::mirror(source->toProfile(), iaxis));
+}
+
+PathHandle AsyncMotionProfileController::reversePath(const PathHandle isource,
+                                                     const std::string &ipathId) {
+  const auto source = findSourcePath(isource);
+  if (!source) {
+    return PathHandle();
+  }
+
+  LOG_INFO("AsyncMotionProfileController: Saving reversed path " + ipathId);
+  return publishPath(internPath(ipathId), PathTransform::reverse(source->toProfile()));
+}
+
+PathHandle AsyncMotionProfileController::stitchPaths(const PathHandle ifirst,
+                                                     const PathHandle isecond,
+                                                     const std::string &ipathId) {
+  const auto firstPath = findSourcePath(ifirst);
+  const auto secondPath = findSourcePath(isecond);
+  if (!firstPath || !secondPath) {
+    return PathHandle();
+  }
+
+  std::vector<squiggles::ProfilePoint> stitched;
+  try {
+    // Allow the change in velocity the paths themselves make in one timestep, since they may have
+    // been generated with other limits than the controller's
+    stitched = PathTransform::stitch(firstPath->toProfile(), secondPath->toProfile());
+  } catch (const std::invalid_argument &e) {
+    LOG_ERROR("AsyncMotionProfileController: Could not save stitched path " + ipathId + ": " +
+              e.what());
+    throw;
+  }
+
+  LOG_INFO("AsyncMotionProfileController: Saving stitched path " + ipathId);
+  return publishPath(internPath(ipathId), std::move(stitched));
+}
+
+std::vector<squiggles::ProfilePoint>
+AsyncMotionProfileController::generateProfile(const std::vector<PathfinderPoint> &iwaypoints,
+                                              const PathfinderLimits &ilimits,
+                                              const double istartVel,
+                                              const double iendVel) const {
+  // Copy the pointer so the cache can't be swapped out from under us
+  const auto cache = std::atomic_load(&pathCache);
+  const bool native = nativeTrajectoryGeneration.load(std::memory_order_acquire);
+  PathCache::Key key;
+  if (cache) {
+    key =
+      PathCache::makeKey(iwaypoints, ilimits, scales.wheelTrack, DT, istartVel, iendVel, native);
+    if (auto cached = cache->get(key); cached) {
+      LOG_DEBUG_S("AsyncMotionProfileController: Using cached trajectory");
+      return *cached;
+    }
+  }
+
+  std::vector<squiggles::ProfilePoint> path;
+  if (native) {
+    path = generateNativeProfile(iwaypoints, ilimits, istartVel, iendVel);
+  } else {
+    path = SplineProfile::generate(iwaypoints, ilimits, scales.wheelTrack, DT, istartVel, iendVel);
+  }
+
+  if (cache) {
+    cache->put(key, std::make_shared<const std::vector<squiggles::ProfilePoint>>(path));
+  }
+
+  return path;
+}
+
+std::vector<squiggles::ProfilePoint>
+AsyncMotionProfileController::generateNativeProfile(const std::vector<PathfinderPoint> &iwaypoints,
+                                                    const PathfinderLimits &ilimits,
+                                                    const double istartVel,
+                                                    const double iendVel) const {
+  // A straight path of the same length takes at most d/v + v/a to drive, so start with room for
+  // that. Curves make the path longer and slower, which the retry below covers.
+  const double distance =
+    iwaypoints.empty() ? 0 : getWaypointDistance(iwaypoints, 0, iwaypoints.size() - 1);
+  std::size_t estimate = 0;
+  if (ilimits.maxVel > 0 && ilimits.maxAccel > 0) {
+    const double duration = distance / ilimits.maxVel + ilimits.maxVel / ilimits.maxAccel;
+    estimate = static_cast<std::size_t>(std::ceil(duration / DT)) + 1;
+  }
+
+  const auto isReusable = [&](const IdleGenerator &iidle) {
+    return iidle.limits.maxVel == ilimits.maxVel && iidle.limits.maxAccel == ilimits.maxAccel &&
+           iidle.limits.maxJerk == ilimits.maxJerk && iidle.generator->getCapacity() >= estimate;
+  };
+
+  IdleGenerator entry;
+  {
+    std::scoped_lock lock(generatorMutex);
+    // Prefer a generator which can be used as it is, otherwise take any to replace
+    auto idle = std::find_if(idleGenerators.begin(), idleGenerators.end(), isReusable);
+    if (idle == idleGenerators.end() && !idleGenerators.empty()) {
+      idle = std::prev(idleGenerators.end());
+    }
+
+    if (idle != idleGenerators.end()) {
+      entry = std::move(*idle);
+      idleGenerators.erase(idle);
+    }
+  }
+
+  const auto makeGenerator = [&](const std::size_t icapacity) {
+    entry.generator = std::make_unique<TrajectoryGenerator>(
+      ilimits, scales.wheelTrack, DT, std::max(icapacity, minGeneratorCapacity));
+    entry.limits = ilimits;
+  };
+
+  if (!entry.generator || !isReusable(entry)) {
+    makeGenerator(estimate);
+  }
+
+  try {
+    entry.generator->generate(iwaypoints, istartVel, iendVel);
+  } catch (const std::runtime_error &) {
+    const auto required = entry.generator->getRequiredCapacity();
+    if (required <= entry.generator->getCapacity()) {
+      throw;
+    }
+
+    LOG_DEBUG("AsyncMotionProfileController: Growing a trajectory generator to " +
+              std::to_string(required) + " points");
+    makeGenerator(required);
+    entry.generator->generate(iwaypoints, istartVel, iendVel);
+  }
+
+  auto profile = entry.generator->toProfile();
+
+  std::scoped_lock lock(generatorMutex);
+  idleGenerators.push_back(std::move(entry));
+  return profile;
+}
+
+PathHandle AsyncMotionProfileController::publishPath(const PathHandle ipath,
+                                                     std::vector<squiggles::ProfilePoint> ipoints) {
+  // Build the snapshot before taking the lock so publishing it is just a pointer swap
+  return publishPath(ipath, makeStoredPath(std::move(ipoints)));
+}
+
+PathHandle AsyncMotionProfileController::publishPath(const PathHandle ipath,
+                                                     StoredPathPtr isnapshot) {
+  // A follower of the old path keeps its own reference to it, so it can be replaced while it runs
+  std::scoped_lock lock(currentPathMutex);
+  paths.set(ipath, std::move(isnapshot));
+
+  // This is now the latest request for the ID, so a generation still running for it is dropped
+  setPendingPath(ipath, nullptr);
+  return ipath;
+}
+
+PathHandle AsyncMotionProfileController::addPathView(const std::string &ipathId,
+                                                     const PathView &ipath) {
+  if (ipath.empty()) {
+    LOG_WARN("AsyncMotionProfileController: Not adding path " + ipathId + " because it is empty.");
+    return PathHandle();
+  }
+
+  const auto handle =
+    publishPath(internPath(ipathId), std::make_shared<const StoredPath>(ipath));
+  LOG_INFO("AsyncMotionProfileController: Added compiled path " + ipathId);
+  return handle;
+}
+
+StoredPathPtr
+AsyncMotionProfileController::makeStoredPath(std::vector<squiggles::ProfilePoint> ipath) const {
+  std::vector<MotorCommand> commands;
+  if (compileMotorCommands.load(std::memory_order_acquire)) {
+    commands = compileMotorCommandTable(ipath);
+  }
+
+  if (compactPathStorage.load(std::memory_order_acquire)) {
+    return std::make_shared<const StoredPath>(CompactTrajectory(ipath), std::move(commands));
+  }
+
+  return std::make_shared<const StoredPath>(std::move(ipath), std::move(commands));
+}
+
+void AsyncMotionProfileController::setPendingPath(
+  const PathHandle ipath,
+  const std::shared_ptr<PathGenerationHandle> &igeneration) {
+  if (auto pending = paths.getPending(ipath); pending && pending != igeneration) {
+    // The older generation is dropped when it finishes. Mark it now so nobody waits for it.
+    if (!pending->isDone()) {
+      pending->markSuperseded();
+    }
+  }
+
+  paths.setPending(ipath, igeneration);
+}
+
+bool AsyncMotionProfileController::publishGeneratedPath(
+  const PathHandle ipath,
+  const std::shared_ptr<PathGenerationHandle> &igeneration,
+  StoredPathPtr isnapshot) {
+  std::scoped_lock lock(currentPathMutex);
+
+  // A newer request for the same ID may have replaced this one while it was generating
+  if (paths.getPending(ipath) != igeneration) {
+    return false;
+  }
+
+  paths.set(ipath, std::move(isnapshot));
+  paths.setPending(ipath, nullptr);
+  return true;
+}
+
+bool AsyncMotionProfileController::clearPendingPath(
+  const PathHandle ipath,
+  const std::shared_ptr<PathGenerationHandle> &igeneration) {
+  std::scoped_lock lock(currentPathMutex);
+
+  if (paths.getPending(ipath) != igeneration) {
+    return false;
+  }
+
+  paths.setPending(ipath, nullptr);
+  return true;
+}
+
+StoredPathPtr AsyncMotionProfileController::findPath(const std::string &ipathId) const {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.get(paths.find(ipathId));
+}
+
+StoredPathPtr AsyncMotionProfileController::findPath(const PathHandle ipath) const {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.get(ipath);
+}
+
+std::shared_ptr<PathGenerationHandle>
+AsyncMotionProfileController::getPendingPath(const PathHandle ipath) {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.getPending(ipath);
 }
 
 std::string
@@ -104,16 +582,29 @@ AsyncMotionProfileController::getPathErrorMessage(const std::vector<PathfinderPo
 }
 
 bool AsyncMotionProfileController::removePath(const std::string &ipathId) {
-  if (!isDisabled() && isRunning.load(std::memory_order_acquire) && getTarget() == ipathId) {
-    LOG_WARN("AsyncMotionProfileController: Attempted to remove currently running path " + ipathId);
-    return false;
+  PathHandle path;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    path = paths.find(ipathId);
   }
 
+  // A path which was never saved doesn't exist
+  return !path.isValid() || removePath(path);
+}
+
+bool AsyncMotionProfileController::removePath(const PathHandle ipath) {
   std::scoped_lock lock(currentPathMutex);
 
-  auto oldPath = paths.find(ipathId);
-  if (oldPath != paths.end()) {
-    paths.erase(ipathId);
+  if (!isDisabled() && isRunning.load(std::memory_order_acquire) && currentPath == ipath) {
+    LOG_WARN("AsyncMotionProfileController: Attempted to remove currently running path " +
+             paths.getName(ipath));
+    return false;
+  }
+
+  // If the path is being followed, the follower keeps its own reference, so erasing it here only
+  // drops the controller's reference
+  if (ipath.isValid()) {
+    paths.set(ipath, nullptr);
   }
 
   // A return value of true provides no feedback about whether the path was actually removed but
@@ -121,14 +612,19 @@ bool AsyncMotionProfileController::removePath(const std::string &ipathId) {
   return true;
 }
 
-std::vector<std::string> AsyncMotionProfileController::getPaths() {
-  std::vector<std::string> keys;
+PathHandle AsyncMotionProfileController::getPathHandle(const std::string &ipathId) {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.find(ipathId);
+}
 
-  for (const auto &path : paths) {
-    keys.push_back(path.first);
-  }
+PathHandle AsyncMotionProfileController::internPath(const std::string &ipathId) {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.intern(ipathId);
+}
 
-  return keys;
+std::vector<std::string> AsyncMotionProfileController::getPaths() {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.getNames();
 }
 
 void AsyncMotionProfileController::setTarget(std::string ipathId) {
@@ -138,25 +634,140 @@ void AsyncMotionProfileController::setTarget(std::string ipathId) {
 void AsyncMotionProfileController::setTarget(std::string ipathId,
                                              const bool ibackwards,
                                              const bool imirrored) {
-  LOG_INFO("AsyncMotionProfileController: Set target to: " + ipathId + " (ibackwards=" +
-           std::to_string(ibackwards) + ", imirrored=" + std::to_string(imirrored) + ")");
+  PathHandle path;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    path = paths.find(ipathId);
+    if (!path.isValid()) {
+      // Remember the ID for getTarget() without adding a slot for it to the table
+      currentPath = PathHandle();
+      missingTargetId = ipathId;
+      currentStream = nullptr;
+      queuedPaths.clear();
+      followingQueue = false;
+    }
+  }
+
+  if (!path.isValid()) {
+    LOG_WARN("AsyncMotionProfileController: Target was set to non-existent path with name: " +
+             ipathId);
+    return;
+  }
+
+  setTarget(path, ibackwards, imirrored);
+}
+
+void AsyncMotionProfileController::setTarget(const PathHandle ipath,
+                                             const bool ibackwards,
+                                             const bool imirrored) {
+  // Only capture the handle so nothing is copied unless the message is logged
+  LOG_INFO("AsyncMotionProfileController: Set target to: " + getPathName(ipath) +
+           " (ibackwards=" + std::to_string(ibackwards) +
+           ", imirrored=" + std::to_string(imirrored) + ")");
+
+  {
+    std::scoped_lock lock(currentPathMutex);
+    currentPath = ipath;
+    missingTargetId.clear();
+    currentStream = nullptr;
+    queuedPaths.clear();
+    followingQueue = false;
+  }
+
+  direction.store(boolToSign(!ibackwards), std::memory_order_release);
+  mirrored.store(imirrored, std::memory_order_release);
+  isRunning.store(true, std::memory_order_release);
+}
+
+void AsyncMotionProfileController::queuePaths(const std::vector<std::string> &ipathIds,
+                                              const bool ibackwards,
+                                              const bool imirrored) {
+  LOG_INFO("AsyncMotionProfileController: Queueing " + std::to_string(ipathIds.size()) +
+           " paths (ibackwards=" + std::to_string(ibackwards) +
+           ", imirrored=" + std::to_string(imirrored) + ")");
+
+  std::scoped_lock lock(currentPathMutex);
+  currentStream = nullptr;
+  missingTargetId.clear();
+  queuedPaths.clear();
+  for (const auto &pathId : ipathIds) {
+    if (const auto path = paths.find(pathId); path.isValid()) {
+      queuedPaths.push_back(path);
+    } else {
+      LOG_WARN("AsyncMotionProfileController: Not queueing non-existent path " + pathId);
+    }
+  }
+  followingQueue = true;
 
-  currentPath = ipathId;
   direction.store(boolToSign(!ibackwards), std::memory_order_release);
   mirrored.store(imirrored, std::memory_order_release);
   isRunning.store(true, std::memory_order_release);
 }
 
+void AsyncMotionProfileController::enqueuePath(const std::string &ipathId) {
+  const auto path = getPathHandle(ipathId);
+  if (!path.isValid()) {
+    LOG_WARN("AsyncMotionProfileController: Not enqueueing non-existent path " + ipathId);
+    return;
+  }
+
+  enqueuePath(path);
+}
+
+void AsyncMotionProfileController::enqueuePath(const PathHandle ipath) {
+  LOG_INFO("AsyncMotionProfileController: Enqueueing path " + getPathName(ipath));
+
+  std::scoped_lock lock(currentPathMutex);
+  queuedPaths.push_back(ipath);
+
+  // The loop checks followingQueue under the lock before it stops running, so this can't be lost
+  if (!followingQueue) {
+    currentStream = nullptr;
+    missingTargetId.clear();
+    followingQueue = true;
+    isRunning.store(true, std::memory_order_release);
+  }
+}
+
+std::vector<std::string> AsyncMotionProfileController::getQueuedPaths() const {
+  std::scoped_lock lock(currentPathMutex);
+  std::vector<std::string> pathIds;
+  for (const auto path : queuedPaths) {
+    pathIds.push_back(paths.getName(path));
+  }
+  return pathIds;
+}
+
 void AsyncMotionProfileController::controllerSet(std::string ivalue) {
   setTarget(ivalue);
 }
 
 std::string AsyncMotionProfileController::getTarget() {
-  return currentPath;
+  std::scoped_lock lock(currentPathMutex);
+  return currentPath.isValid() ? paths.getName(currentPath) : missingTargetId;
 }
 
 std::string AsyncMotionProfileController::getProcessValue() const {
-  return currentPath;
+  std::scoped_lock lock(currentPathMutex);
+  return currentPath.isValid() ? paths.getName(currentPath) : missingTargetId;
+}
+
+StoredPathPtr AsyncMotionProfileController::findSourcePath(const PathHandle isource) {
+  waitForPendingPath(isource);
+
+  auto path = findPath(isource);
+  if (!path) {
+    LOG_WARN("AsyncMotionProfileController: Can't derive a path from non-existent path " +
+             getPathName(isource));
+  }
+
+  return path;
+}
+
+const std::string &AsyncMotionProfileController::getPathName(const PathHandle ipath) const {
+  // Interned names are never moved, so the reference outlives the lock
+  std::scoped_lock lock(currentPathMutex);
+  return paths.getName(ipath);
 }
 
 void AsyncMotionProfileController::loop() {
@@ -166,24 +777,69 @@ void AsyncMotionProfileController::loop() {
 
   while (!dtorCalled.load(std::memory_order_acquire) && !task->notifyTake(0)) {
     if (isRunning.load(std::memory_order_acquire) && !isDisabled()) {
-      LOG_INFO("AsyncMotionProfileController: Running with path: " + currentPath);
+      std::shared_ptr<StreamingPath> stream;
+      bool queue;
+      {
+        std::scoped_lock lock(currentPathMutex);
+        stream = currentStream;
+        queue = followingQueue;
+      }
 
-      auto path = paths.find(currentPath);
-      if (path == paths.end()) {
-        LOG_WARN("AsyncMotionProfileController: Target was set to non-existent path with name: " +
-                 currentPath);
-      } else {
-        LOG_DEBUG("AsyncMotionProfileController: Path length is " +
-                  std::to_string(path->second.size()));
+      if (stream) {
+        LOG_INFO_S("AsyncMotionProfileController: Running with a streamed path");
+        executeStreamingPath(*stream);
 
-        executeSinglePath(path->second, timeUtil.getRate());
+        // Stop the chassis after the path, even if it ended early because a chunk failed
+        model->stop();
+
+        LOG_INFO_S("AsyncMotionProfileController: Done moving");
+      } else if (queue) {
+        LOG_INFO_S("AsyncMotionProfileController: Running with the path queue");
+        executePathQueue();
 
-        // Stop the chassis after the path because:
-        // 1. We only support an exit velocity of zero
-        // 2. Because of (1), we should make sure the system is stopped
+        // Stop the chassis after the last path in the queue
         model->stop();
 
         LOG_INFO_S("AsyncMotionProfileController: Done moving");
+
+        // A path may have been enqueued while the chassis was stopping. If so, keep running.
+        std::scoped_lock lock(currentPathMutex);
+        if (!followingQueue) {
+          isRunning.store(false, std::memory_order_release);
+        }
+        continue;
+      } else {
+        PathHandle target;
+        {
+          std::scoped_lock lock(currentPathMutex);
+          target = currentPath;
+        }
+
+        // The name is only looked up if the message is logged
+        LOG_INFO("AsyncMotionProfileController: Running with path: " + getPathName(target));
+
+        waitForPendingPath(target);
+
+        // Take our own reference to the path so it stays valid even if it is removed or replaced
+        // while we follow it
+        const auto path = findPath(target);
+        if (!path) {
+          LOG_WARN("AsyncMotionProfileController: Target was set to non-existent path with name: " +
+                   getPathName(target));
+        } else {
+          LOG_DEBUG("AsyncMotionProfileController: Path length is " +
+                    std::to_string(path->size()));
+
+          auto tracking = startMove(*path);
+          executeSinglePath(*path, timeUtil.getRate(), tracking);
+
+          // Stop the chassis after the path because:
+          // 1. We only support an exit velocity of zero
+          // 2. Because of (1), we should make sure the system is stopped
+          model->stop();
+
+          LOG_INFO_S("AsyncMotionProfileController: Done moving");
+        }
       }
 
       isRunning.store(false, std::memory_order_release);
@@ -195,40 +851,505 @@ void AsyncMotionProfileController::loop() {
   LOG_INFO_S("Stopped AsyncMotionProfileController task.");
 }
 
-void AsyncMotionProfileController::executeSinglePath(
-  const std::vector<squiggles::ProfilePoint> &path,
-  std::unique_ptr<AbstractRate> rate) {
+AsyncMotionProfileController::MoveTracking
+AsyncMotionProfileController::startMove(const StoredPath &ipath) {
+  MoveTracking tracking;
+
+  tracking.feedforward = getFeedforward();
+  if (tracking.feedforward && ipath.size() > 0) {
+    tracking.voltage.startSensors = model->getSensorVals();
+
+    // Integrate the expected distance from the start of the path, which may not be at rest
+    const int reversed = direction.load(std::memory_order_acquire);
+    const bool followMirrored = mirrored.load(std::memory_order_acquire);
+    for (std::size_t side = 0; side < 2; ++side) {
+      const std::size_t wheel = followMirrored ? 1 - side : side;
+      tracking.voltage.lastVelocity[side] = ipath.getWheelVelocity(wheel, 0) * reversed;
+    }
+  }
+
+  {
+    std::scoped_lock lock(currentPathMutex);
+    tracking.ramsete.odometry = odometry;
+    tracking.ramsete.gains = ramseteGains;
+  }
+  if (tracking.ramsete.odometry && ipath.size() > 0) {
+    tracking.ramsete.start = tracking.ramsete.odometry->getState();
+    tracking.ramsete.origin = ipath.getPose(0);
+  }
+
+  return tracking;
+}
+
+void AsyncMotionProfileController::executeSinglePath(const StoredPath &path,
+                                                    std::unique_ptr<AbstractRate> rate,
+                                                    MoveTracking &itracking) {
   const int reversed = direction.load(std::memory_order_acquire);
   const bool followMirrored = mirrored.load(std::memory_order_acquire);
+  const bool followByTime = timeIndexedFollowing.load(std::memory_order_acquire);
+  const auto segDT = DT * second;
+  const double lastPosition = static_cast<double>(path.size()) - 1;
+
+  // Send each command one actuation latency early so the motors apply it when the path wants it
+  const double lookahead = getActuationLatency().convert(second) / DT;
+
+  // Positions along this path start from zero again, even partway through a move
+  itracking.voltage.lastPosition = 0;
+
+  const auto timer = timeUtil.getTimer();
+  const QTime start = timer->millis();
+  QTime lastTick = start;
+  FollowStatistics stats;
+
+  while (!isDisabled()) {
+    const QTime now = timer->millis();
+    if (stats.ticks > 0) {
+      const QTime lateness = now - lastTick - segDT;
+      if (lateness > FollowStatistics::lateTickTolerance) {
+        ++stats.lateTicks;
+      }
+      stats.maxLateness = std::max(stats.maxLateness, lateness);
+    }
+    lastTick = now;
+
+    // When following by time, a late tick skips ahead to where the path should be now instead of
+    // pushing the rest of the path back
+    const double position =
+      followByTime ? (now - start).convert(second) / DT : static_cast<double>(stats.ticks);
+    if (position > lastPosition) {
+      break;
+    }
 
-  currentPathMutex.lock();
-  // store this locally so we aren't accessing the path when we don't know if it's valid
-  std::size_t pathSize = path.size();
-  currentPathMutex.unlock();
-  for (std::size_t i = 0; i < pathSize && !isDisabled(); ++i) {
-    // This mutex is used to combat an edge case of an edge case
-    // if a running path is asked to be removed at the moment this loop is executing
-    std::scoped_lock lock(currentPathMutex);
+    const double commandPosition = std::min(position + lookahead, lastPosition);
+    if (itracking.ramsete.odometry) {
+      sendRamseteCommand(path,
+                         position,
+                         commandPosition,
+                         followMirrored,
+                         reversed,
+                         itracking.ramsete,
+                         itracking.feedforward);
+    } else if (itracking.feedforward) {
+      sendVoltageCommand(path,
+                         position,
+                         commandPosition,
+                         followMirrored,
+                         reversed,
+                         *itracking.feedforward,
+                         itracking.voltage);
+    } else {
+      sendMotorCommand(path, commandPosition, followMirrored, reversed);
+    }
+    ++stats.ticks;
+
+    rate->delayUntil(segDT);
+  }
+
+  std::scoped_lock lock(followStatisticsMutex);
+  lastFollowStatistics = stats;
+}
+
+void AsyncMotionProfileController::executePathQueue() {
+  while (true) {
+    PathHandle pathId;
+    {
+      std::scoped_lock lock(currentPathMutex);
+      if (queuedPaths.empty() || isDisabled() || dtorCalled.load(std::memory_order_acquire)) {
+        // Drop the rest of the queue if the controller was disabled
+        queuedPaths.clear();
+        followingQueue = false;
+        return;
+      }
+
+      pathId = queuedPaths.front();
+      queuedPaths.pop_front();
+      currentPath = pathId;
+    }
+
+    LOG_INFO("AsyncMotionProfileController: Running with queued path: " + getPathName(pathId));
+    waitForPendingPath(pathId);
+
+    const auto path = findPath(pathId);
+    if (!path) {
+      LOG_WARN("AsyncMotionProfileController: Queued path does not exist: " + getPathName(pathId));
+      continue;
+    }
+
+    auto tracking = startMove(*path);
+    executeSinglePath(*path, timeUtil.getRate(), tracking);
+  }
+}
+
+void AsyncMotionProfileController::waitForPendingPath(const PathHandle ipath) {
+  auto pending = getPendingPath(ipath);
+  if (!pending || pending->isDone()) {
+    return;
+  }
+
+  LOG_INFO("AsyncMotionProfileController: Waiting for path " + pending->getPathId() +
+           " to finish generating");
+
+  // Look the generation up again each time because a newer request may supersede it
+  auto rate = timeUtil.getRate();
+  while (pending && !pending->isDone() && !isDisabled() &&
+         !dtorCalled.load(std::memory_order_acquire)) {
+    rate->delayUntil(1_ms);
+    pending = getPendingPath(ipath);
+  }
+}
+
+void AsyncMotionProfileController::executeStreamingPath(const StreamingPath &path) {
+  auto rate = timeUtil.getRate();
+  const auto segDT = DT * second;
+  const auto shouldStop = [&]() {
+    return isDisabled() || dtorCalled.load(std::memory_order_acquire);
+  };
+
+  // Let the producer get ahead before starting
+  while (!shouldStop() && !path.isComplete() && !path.hasFailed() &&
+         static_cast<double>(path.getAvailablePointCount()) * segDT < path.getLeadTime()) {
+    rate->delayUntil(1_ms);
+  }
+
+  // The chunks are one move, so the robot is tracked from where the first chunk starts
+  std::optional<MoveTracking> tracking;
+  for (std::size_t i = 0; i < path.getChunkCount() && !shouldStop(); ++i) {
+    auto chunk = path.getChunk(i);
+    if (!chunk && !path.hasFailed()) {
+      // The robot keeps moving with the last command until the chunk is ready
+      LOG_WARN("AsyncMotionProfileController: Waiting for chunk " + std::to_string(i) +
+               " of a streamed path. Consider increasing the lead time.");
+      while (!chunk && !path.hasFailed() && !shouldStop()) {
+        rate->delayUntil(1_ms);
+        chunk = path.getChunk(i);
+      }
+    }
+
+    if (!chunk) {
+      break;
+    }
+
+    if (!tracking) {
+      tracking = startMove(*chunk);
+    }
+    executeSinglePath(*chunk, timeUtil.getRate(), *tracking);
+  }
+}
+
+void AsyncMotionProfileController::streamPath(const std::vector<PathfinderPoint> &iwaypoints,
+                                              const PathfinderLimits &ilimits,
+                                              const std::size_t isegmentsPerChunk,
+                                              const QTime ileadTime,
+                                              const bool ibackwards,
+                                              const bool imirrored) {
+  std::vector<std::size_t> boundaries;
+  for (std::size_t i = 0; i < iwaypoints.size() - 1; i += isegmentsPerChunk) {
+    boundaries.push_back(i);
+  }
+  boundaries.push_back(iwaypoints.size() - 1);
+
+  const auto velocities = planJunctionVelocities(iwaypoints, boundaries, ilimits);
+  auto stream = std::make_shared<StreamingPath>(boundaries.size() - 1, ileadTime);
+
+  for (std::size_t i = 0; i + 1 < boundaries.size(); ++i) {
+    const std::vector<PathfinderPoint> chunkWaypoints(
+      iwaypoints.begin() + static_cast<std::ptrdiff_t>(boundaries[i]),
+      iwaypoints.begin() + static_cast<std::ptrdiff_t>(boundaries[i + 1]) + 1);
+
+    try {
+      stream->append(
+        makeStoredPath(generateProfile(chunkWaypoints, ilimits, velocities[i], velocities[i + 1])));
+    } catch (const std::exception &e) {
+      stream->markFailed();
+
+      std::string msg = "AsyncMotionProfileController: Failed to generate chunk " +
+                        std::to_string(i) + " of a streamed path: " + e.what();
+      LOG_ERROR(msg);
+
+      // Let the follower stop the robot after the chunks it already has
+      waitUntilSettled();
+      throw std::runtime_error(msg);
+    }
+
+    if (i == 0) {
+      {
+        std::scoped_lock lock(currentPathMutex);
+        currentPath = PathHandle();
+        currentStream = stream;
+        queuedPaths.clear();
+        followingQueue = false;
+      }
+
+      direction.store(boolToSign(!ibackwards), std::memory_order_release);
+      mirrored.store(imirrored, std::memory_order_release);
+      isRunning.store(true, std::memory_order_release);
+    }
+  }
+
+  waitUntilSettled();
+
+  std::scoped_lock lock(currentPathMutex);
+  if (currentStream == stream) {
+    currentStream = nullptr;
+  }
+}
+
+std::vector<double>
+AsyncMotionProfileController::planJunctionVelocities(const std::vector<PathfinderPoint> &iwaypoints,
+                                                     const std::vector<std::size_t> &iboundaries,
+                                                     const PathfinderLimits &ilimits) {
+  std::vector<double> lengths;
+  for (std::size_t i = 1; i < iboundaries.size(); ++i) {
+    lengths.push_back(getWaypointDistance(iwaypoints, iboundaries[i - 1], iboundaries[i]));
+  }
+
+  return planJunctionVelocities(lengths, ilimits);
+}
+
+std::vector<double>
+AsyncMotionProfileController::planJunctionVelocities(const std::vector<double> &ilengths,
+                                                     const PathfinderLimits &ilimits) {
+  std::vector<double> velocities(ilengths.size() + 1, ilimits.maxVel);
+  velocities.front() = 0;
+  velocities.back() = 0;
+
+  // v^2 = v0^2 + 2ad, forwards from the start and then backwards from the end
+  for (std::size_t i = 1; i < velocities.size(); ++i) {
+    velocities[i] = std::min(velocities[i],
+                             std::sqrt(velocities[i - 1] * velocities[i - 1] +
+                                       2 * ilimits.maxAccel * ilengths[i - 1]));
+  }
+
+  for (std::size_t i = velocities.size() - 1; i > 0; --i) {
+    velocities[i - 1] = std::min(
+      velocities[i - 1],
+      std::sqrt(velocities[i] * velocities[i] + 2 * ilimits.maxAccel * ilengths[i - 1]));
+  }
+
+  return velocities;
+}
+
+double AsyncMotionProfileController::getWaypointDistance(
+  const std::vector<PathfinderPoint> &iwaypoints,
+  const std::size_t ifrom,
+  const std::size_t ito) {
+  double total = 0;
+  for (std::size_t i = ifrom; i < ito; ++i) {
+    total += std::hypot((iwaypoints[i + 1].x - iwaypoints[i].x).convert(meter),
+                        (iwaypoints[i + 1].y - iwaypoints[i].y).convert(meter));
+  }
+  return total;
+}
+
+void AsyncMotionProfileController::sendMotorCommand(const StoredPath &path,
+                                                   const double iposition,
+                                                   const bool imirrored,
+                                                   const int ireversed) {
+  const auto index = static_cast<std::size_t>(iposition);
+  const auto next = std::min(index + 1, path.size() - 1);
+  const double fraction = iposition - index;
+  const auto interpolate = [fraction](const double a, const double b) {
+    return a + (b - a) * fraction;
+  };
+
+  if (path.hasCommands()) {
+    // The commands were computed when the path was saved, so just send them
+    const MotorCommand *commands = path.getCommands(imirrored, ireversed < 0);
+    model->left(interpolate(commands[index].left, commands[next].left));
+    model->right(interpolate(commands[index].right, commands[next].right));
+    return;
+  }
+
+  const double leftVel =
+    interpolate(path.getWheelVelocity(0, index), path.getWheelVelocity(0, next));
+  const double rightVel =
+    interpolate(path.getWheelVelocity(1, index), path.getWheelVelocity(1, next));
+  const auto leftRPM = convertLinearToRotational(leftVel * mps).convert(rpm);
+  const auto rightRPM = convertLinearToRotational(rightVel * mps).convert(rpm);
+
+  const double rightSpeed = rightRPM / toUnderlyingType(pair.internalGearset) * ireversed;
+  const double leftSpeed = leftRPM / toUnderlyingType(pair.internalGearset) * ireversed;
+  if (imirrored) {
+    model->left(rightSpeed);
+    model->right(leftSpeed);
+  } else {
+    model->left(leftSpeed);
+    model->right(rightSpeed);
+  }
+}
+
+void AsyncMotionProfileController::sendVoltageCommand(const StoredPath &path,
+                                                     const double ireferencePosition,
+                                                     const double icommandPosition,
+                                                     const bool imirrored,
+                                                     const int ireversed,
+                                                     const FeedforwardGains &igains,
+                                                     FeedforwardTracking &itracking) {
+  const auto lastIndex = path.size() - 1;
+  const auto referenceIndex = static_cast<std::size_t>(ireferencePosition);
+  const auto referenceNext = std::min(referenceIndex + 1, lastIndex);
+  const double referenceFraction = ireferencePosition - referenceIndex;
+  const auto commandIndex = static_cast<std::size_t>(icommandPosition);
+  const auto commandNext = std::min(commandIndex + 1, lastIndex);
+  const double commandFraction = icommandPosition - commandIndex;
+  const double dt = (ireferencePosition - itracking.lastPosition) * DT;
+
+  const bool useFeedback = igains.kP != 0 && itracking.startSensors.size() >= 2;
+  const auto sensors = useFeedback ? model->getSensorVals() : std::valarray<std::int32_t>{};
+
+  double volts[2];
+  for (std::size_t side = 0; side < 2; ++side) {
+    // Mirroring swaps which wheel of the path each side of the robot follows
+    const std::size_t wheel = imirrored ? 1 - side : side;
+    const double current = path.getWheelVelocity(wheel, commandIndex);
+    const double following = path.getWheelVelocity(wheel, commandNext);
+    const double velocity = (current + (following - current) * commandFraction) * ireversed;
+    const double acceleration = (following - current) / DT * ireversed;
+
+    // The robot is where the path is now, not where the early command is from
+    const double referenceCurrent = path.getWheelVelocity(wheel, referenceIndex);
+    const double referenceFollowing = path.getWheelVelocity(wheel, referenceNext);
+    const double referenceVelocity =
+      (referenceCurrent + (referenceFollowing - referenceCurrent) * referenceFraction) * ireversed;
+
+    itracking.expectedDistance[side] +=
+      (itracking.lastVelocity[side] + referenceVelocity) / 2 * dt;
+    itracking.lastVelocity[side] = referenceVelocity;
+
+    volts[side] = igains.calculate(velocity, acceleration);
+    if (useFeedback && sensors.size() >= 2) {
+      const double measured = (sensors[side] - itracking.startSensors[side]) / scales.straight;
+      volts[side] += igains.kP * (itracking.expectedDistance[side] - measured);
+    }
+  }
+
+  itracking.lastPosition = ireferencePosition;
+
+  // tank() takes a fraction of the max voltage, which is in millivolts
+  const double maxVolts = model->getMaxVoltage() / 1000;
+  model->tank(volts[0] / maxVolts, volts[1] / maxVolts);
+}
 
-    const auto segDT = DT * second;
-    const auto leftRPM = convertLinearToRotational(path[i].wheel_velocities[0] * mps).convert(rpm);
-    const auto rightRPM = convertLinearToRotational(path[i].wheel_velocities[1] * mps).convert(rpm);
+void AsyncMotionProfileController::sendRamseteCommand(
+  const StoredPath &path,
+  const double ireferencePosition,
+  const double icommandPosition,
+  const bool imirrored,
+  const int ireversed,
+  const RamseteTracking &itracking,
+  const std::optional<FeedforwardGains> &ifeedforward) {
+  const auto lastIndex = path.size() - 1;
+  const auto referenceIndex = static_cast<std::size_t>(ireferencePosition);
+  const auto commandIndex = static_cast<std::size_t>(icommandPosition);
+  const auto commandNext = std::min(commandIndex + 1, lastIndex);
+  const double commandFraction = icommandPosition - commandIndex;
+
+  // Interpolate where the robot should be, turning the short way between the two headings
+  const auto current = path.getPose(referenceIndex);
+  const auto following = path.getPose(std::min(referenceIndex + 1, lastIndex));
+  const double referenceFraction = ireferencePosition - referenceIndex;
+  const squiggles::Pose reference(
+    current.x + (following.x - current.x) * referenceFraction,
+    current.y + (following.y - current.y) * referenceFraction,
+    current.yaw +
+      std::remainder(following.yaw - current.yaw, static_cast<double>(2_pi)) * referenceFraction);
+
+  // Odometry measures x forwards, y to the right, and theta clockwise. Find how far the robot has
+  // moved since the move started in the frame of the robot at the start, with y to the left and
+  // theta counterclockwise like the path.
+  const auto state = itracking.odometry->getState();
+  const double startTheta = -itracking.start.theta.convert(radian);
+  const double dx = (state.x - itracking.start.x).convert(meter);
+  const double dy = -(state.y - itracking.start.y).convert(meter);
+  double forward = std::cos(startTheta) * dx + std::sin(startTheta) * dy;
+  double left = -std::sin(startTheta) * dx + std::cos(startTheta) * dy;
+  double turned = -state.theta.convert(radian) - startTheta;
+
+  // Following backwards or mirrored flips the robot's movement relative to the path, so undo that
+  // to compare it with the path
+  if (ireversed < 0) {
+    forward = -forward;
+    turned = -turned;
+  }
+  if (imirrored) {
+    left = -left;
+    turned = -turned;
+  }
 
-    const double rightSpeed = rightRPM / toUnderlyingType(pair.internalGearset) * reversed;
-    const double leftSpeed = leftRPM / toUnderlyingType(pair.internalGearset) * reversed;
-    if (followMirrored) {
-      model->left(rightSpeed);
-      model->right(leftSpeed);
+  const auto &origin = itracking.origin;
+  const squiggles::Pose actual(
+    origin.x + forward * std::cos(origin.yaw) - left * std::sin(origin.yaw),
+    origin.y + forward * std::sin(origin.yaw) + left * std::cos(origin.yaw),
+    origin.yaw + turned);
+
+  double wheelVelocities[2];
+  double wheelAccelerations[2];
+  for (std::size_t wheel = 0; wheel < 2; ++wheel) {
+    const double now = path.getWheelVelocity(wheel, commandIndex);
+    const double next = path.getWheelVelocity(wheel, commandNext);
+    wheelVelocities[wheel] = now + (next - now) * commandFraction;
+    wheelAccelerations[wheel] = (next - now) / DT;
+  }
+
+  const double track = scales.wheelTrack.convert(meter);
+  const auto command = Ramsete::calculate(reference,
+                                          (wheelVelocities[0] + wheelVelocities[1]) / 2,
+                                          (wheelVelocities[1] - wheelVelocities[0]) / track,
+                                          actual,
+                                          itracking.gains);
+  const double corrected[2] = {command.linear - command.angular * track / 2,
+                               command.linear + command.angular * track / 2};
+
+  // Mirroring swaps which wheel of the path each side of the robot follows
+  double sides[2];
+  for (std::size_t side = 0; side < 2; ++side) {
+    const std::size_t wheel = imirrored ? 1 - side : side;
+    if (ifeedforward) {
+      sides[side] = ifeedforward->calculate(corrected[wheel] * ireversed,
+                                            wheelAccelerations[wheel] * ireversed);
     } else {
-      model->left(leftSpeed);
-      model->right(rightSpeed);
+      sides[side] = convertLinearToRotational(corrected[wheel] * mps).convert(rpm) /
+                    toUnderlyingType(pair.internalGearset) * ireversed;
     }
+  }
 
-    // Unlock before the delay to be nice to other tasks
-    currentPathMutex.unlock();
+  if (ifeedforward) {
+    // tank() takes a fraction of the max voltage, which is in millivolts
+    const double maxVolts = model->getMaxVoltage() / 1000;
+    model->tank(sides[0] / maxVolts, sides[1] / maxVolts);
+  } else {
+    model->left(sides[0]);
+    model->right(sides[1]);
+  }
+}
 
-    rate->delayUntil(segDT);
+std::vector<MotorCommand> AsyncMotionProfileController::compileMotorCommandTable(
+  const std::vector<squiggles::ProfilePoint> &ipath) const {
+  const std::size_t segments = ipath.size();
+  for (const auto &point : ipath) {
+    if (point.wheel_velocities.size() < 2) {
+      LOG_WARN_S("AsyncMotionProfileController: Not compiling a path without wheel velocities");
+      return {};
+    }
   }
+
+  std::vector<MotorCommand> commands(segments * StoredPath::commandVariantCount);
+  const double gearset = toUnderlyingType(pair.internalGearset);
+
+  for (std::size_t i = 0; i < segments; ++i) {
+    const double left =
+      convertLinearToRotational(ipath[i].wheel_velocities[0] * mps).convert(rpm) / gearset;
+    const double right =
+      convertLinearToRotational(ipath[i].wheel_velocities[1] * mps).convert(rpm) / gearset;
+
+    // Mirroring swaps the sides and reversing negates both of them
+    commands[StoredPath::commandOffset(false, false, segments) + i] = {left, right};
+    commands[StoredPath::commandOffset(true, false, segments) + i] = {right, left};
+    commands[StoredPath::commandOffset(false, true, segments) + i] = {-left, -right};
+    commands[StoredPath::commandOffset(true, true, segments) + i] = {-right, -left};
+  }
+
+  return commands;
 }
 
 QAngularSpeed AsyncMotionProfileController::convertLinearToRotational(QSpeed linear) const {
@@ -262,12 +1383,30 @@ void AsyncMotionProfileController::moveTo(std::initializer_list<PathfinderPoint>
                                           const PathfinderLimits &ilimits,
                                           const bool ibackwards,
                                           const bool imirrored) {
-  static int moveToCount = 0;
-  std::string name = "__moveTo" + std::to_string(moveToCount++);
-  generatePath(iwaypoints, name, ilimits);
-  setTarget(name, ibackwards, imirrored);
+  std::size_t segmentsPerChunk;
+  QTime leadTime;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    segmentsPerChunk = streamSegmentsPerChunk;
+    leadTime = streamLeadTime;
+  }
+
+  if (iwaypoints.size() == 0) {
+    LOG_WARN_S("AsyncMotionProfileController: Not moving because no waypoints were given.");
+    return;
+  }
+
+  // Only stream if there is more than one chunk
+  if (segmentsPerChunk > 0 && iwaypoints.size() > segmentsPerChunk + 1) {
+    streamPath(iwaypoints, ilimits, segmentsPerChunk, leadTime, ibackwards, imirrored);
+    return;
+  }
+
+  // Every move reuses the same slot so no name is formatted or looked up
+  publishPath(moveToPath, generateProfile(iwaypoints, ilimits));
+  setTarget(moveToPath, ibackwards, imirrored);
   waitUntilSettled();
-  forceRemovePath(name);
+  forceRemovePath(moveToPath);
 }
 
 PathfinderPoint AsyncMotionProfileController::getError() const {
@@ -324,10 +1463,12 @@ CrossplatformThread *AsyncMotionProfileController::getThread() const {
 }
 
 void AsyncMotionProfileController::storePath(const std::string &idirectory,
-                                             const std::string &ipathId) {
-  std::string filePath = makeFilePath(idirectory, ipathId + ".csv");
+                                             const std::string &ipathId,
+                                             const PathFileFormat iformat) {
+  const bool isBinary = iformat == PathFileFormat::binary;
+  std::string filePath = makeFilePath(idirectory, ipathId + (isBinary ? ".bin" : ".csv"));
   std::ofstream file;
-  file.open(filePath, std::ofstream::out);
+  file.open(filePath, isBinary ? std::ofstream::out | std::ofstream::binary : std::ofstream::out);
 
   // Make sure we can open the file successfully
   if (!file.good()) {
@@ -335,21 +1476,38 @@ void AsyncMotionProfileController::storePath(const std::string &idirectory,
     return;
   }
 
-  internalStorePath(file, ipathId);
+  if (isBinary) {
+    internalStoreBinaryPath(file, ipathId);
+  } else {
+    internalStorePath(file, ipathId);
+  }
 
   file.close();
 }
 
-void AsyncMotionProfileController::loadPath(const std::string &idirectory,
-                                            const std::string &ipathId) {
+PathHandle AsyncMotionProfileController::loadPath(const std::string &idirectory,
+                                                  const std::string &ipathId) {
+  const auto handle = internPath(ipathId);
+
+  std::string binaryPath = makeFilePath(idirectory, ipathId + ".bin");
+  std::ifstream binaryPathFile;
+  binaryPathFile.open(binaryPath, std::ifstream::in | std::ifstream::binary);
+  if (binaryPathFile.good()) {
+    // give preference to a binary path stored for this id because it is the fastest to load
+    const bool loaded = internalLoadBinaryPath(binaryPathFile, ipathId);
+    binaryPathFile.close();
+    if (loaded) {
+      return handle;
+    }
+  }
+
   std::string squigglesPath = makeFilePath(idirectory, ipathId + ".csv");
   std::ifstream squigglesPathFile;
   squigglesPathFile.open(squigglesPath, std::ifstream::in);
   if (squigglesPathFile.good()) {
-    // give preference to a squiggles path stored for this id
     internalLoadPath(squigglesPathFile, ipathId);
     squigglesPathFile.close();
-    return;
+    return handle;
   }
 
   // There's no Squiggles path, let's check for Pathfinder files
@@ -367,38 +1525,65 @@ void AsyncMotionProfileController::loadPath(const std::string &idirectory,
     if (rightPathFile.good()) {
       LOG_WARN("AsyncMotionProfileController: Couldn't open file " + leftFilePath + " for reading");
       rightPathFile.close();
-      return;
+      return handle;
     }
     if (leftPathFile.good()) {
       LOG_WARN("AsyncMotionProfileController: Couldn't open file " + rightFilePath +
                " for reading");
       leftPathFile.close();
-      return;
+      return handle;
     }
     LOG_WARN("AsyncMotionProfileController: Couldn't find any path files for id " + ipathId);
   }
+
+  return handle;
 }
 
 void AsyncMotionProfileController::internalStorePath(std::ostream &file,
                                                      const std::string &ipathId) {
-  auto pathData = this->paths.find(ipathId);
+  auto pathData = findPath(ipathId);
 
   // Make sure path exists
-  if (pathData == paths.end()) {
+  if (!pathData) {
     LOG_WARN("AsyncMotionProfileController: Controller was asked to serialize non-existent path " +
              ipathId);
     // Do nothing- can't serialize nonexistent path
   } else {
-    squiggles::serialize_path(file, pathData->second);
+    squiggles::serialize_path(file, pathData->toProfile());
   }
 }
 
+void AsyncMotionProfileController::internalStoreBinaryPath(std::ostream &file,
+                                                           const std::string &ipathId) {
+  auto pathData = findPath(ipathId);
+
+  // Make sure path exists
+  if (!pathData) {
+    LOG_WARN("AsyncMotionProfileController: Controller was asked to serialize non-existent path " +
+             ipathId);
+  } else {
+    BinaryPathFormat::write(file, pathData->toProfile());
+  }
+}
+
+bool AsyncMotionProfileController::internalLoadBinaryPath(std::istream &file,
+                                                          const std::string &ipathId) {
+  auto path = BinaryPathFormat::read(file);
+  if (!path) {
+    LOG_WARN("AsyncMotionProfileController: Binary path file for " + ipathId +
+             " is corrupt or has an unsupported version");
+    return false;
+  }
+
+  publishPath(internPath(ipathId), std::move(path.value()));
+  return true;
+}
+
 void AsyncMotionProfileController::internalLoadPath(std::istream &file,
                                                     const std::string &ipathId) {
 
   auto path = squiggles::deserialize_path(file);
-  forceRemovePath(ipathId);
-  paths.emplace(ipathId, path.value());
+  publishPath(internPath(ipathId), path.value());
 }
 
 void AsyncMotionProfileController::internalLoadPathfinderPath(std::istream &leftFile,
@@ -406,8 +1591,7 @@ void AsyncMotionProfileController::internalLoadPathfinderPath(std::istream &left
                                                               const std::string &ipathId) {
 
   auto path = squiggles::deserialize_pathfinder_path(leftFile, rightFile);
-  forceRemovePath(ipathId);
-  paths.emplace(ipathId, path.value());
+  publishPath(internPath(ipathId), path.value());
 }
 
 std::string AsyncMotionProfileController::makeFilePath(const std::string &directory,
@@ -447,11 +1631,134 @@ std::string AsyncMotionProfileController::makeFilePath(const std::string &direct
   return path;
 }
 
+void AsyncMotionProfileController::setPathCache(const std::shared_ptr<PathCache> &icache) {
+  std::atomic_store(&pathCache, icache);
+}
+
+std::shared_ptr<PathCache> AsyncMotionProfileController::getPathCache() const {
+  return std::atomic_load(&pathCache);
+}
+
+void AsyncMotionProfileController::setCompileMotorCommands(const bool icompile) {
+  compileMotorCommands.store(icompile, std::memory_order_release);
+}
+
+bool AsyncMotionProfileController::getCompileMotorCommands() const {
+  return compileMotorCommands.load(std::memory_order_acquire);
+}
+
+void AsyncMotionProfileController::setCompactPathStorage(const bool icompact) {
+  compactPathStorage.store(icompact, std::memory_order_release);
+}
+
+bool AsyncMotionProfileController::getCompactPathStorage() const {
+  return compactPathStorage.load(std::memory_order_acquire);
+}
+
+void AsyncMotionProfileController::setNativeTrajectoryGeneration(const bool inative) {
+  nativeTrajectoryGeneration.store(inative, std::memory_order_release);
+}
+
+bool AsyncMotionProfileController::getNativeTrajectoryGeneration() const {
+  return nativeTrajectoryGeneration.load(std::memory_order_acquire);
+}
+
+std::size_t AsyncMotionProfileController::getPathBytesUsed(const std::string &ipathId) const {
+  if (const auto path = findPath(ipathId); path) {
+    return path->getBytesUsed();
+  }
+
+  return 0;
+}
+
+void AsyncMotionProfileController::setTimeIndexedFollowing(const bool itimeIndexed) {
+  timeIndexedFollowing.store(itimeIndexed, std::memory_order_release);
+}
+
+bool AsyncMotionProfileController::getTimeIndexedFollowing() const {
+  return timeIndexedFollowing.load(std::memory_order_acquire);
+}
+
+FollowStatistics AsyncMotionProfileController::getFollowStatistics() const {
+  std::scoped_lock lock(followStatisticsMutex);
+  return lastFollowStatistics;
+}
+
+void AsyncMotionProfileController::setFeedforward(const std::optional<FeedforwardGains> &igains) {
+  std::scoped_lock lock(currentPathMutex);
+  feedforward = igains;
+}
+
+std::optional<FeedforwardGains> AsyncMotionProfileController::getFeedforward() const {
+  std::scoped_lock lock(currentPathMutex);
+  return feedforward;
+}
+
+void AsyncMotionProfileController::setActuationLatency(const QTime ilatency) {
+  if (ilatency < 0_ms) {
+    std::string msg("AsyncMotionProfileController: The actuation latency can't be negative.");
+    LOG_ERROR(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  std::scoped_lock lock(currentPathMutex);
+  actuationLatency = ilatency;
+}
+
+QTime AsyncMotionProfileController::getActuationLatency() const {
+  std::scoped_lock lock(currentPathMutex);
+  return actuationLatency;
+}
+
+void AsyncMotionProfileController::setOdometry(const std::shared_ptr<Odometry> &iodometry,
+                                              const RamseteGains &igains) {
+  if (!(igains.b > 0) || !(igains.zeta >= 0 && igains.zeta <= 1)) {
+    std::string msg("AsyncMotionProfileController: The RAMSETE gains must have a positive b and a "
+                    "zeta between zero and one.");
+    LOG_ERROR(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  std::scoped_lock lock(currentPathMutex);
+  odometry = iodometry;
+  ramseteGains = igains;
+}
+
+std::shared_ptr<Odometry> AsyncMotionProfileController::getOdometry() const {
+  std::scoped_lock lock(currentPathMutex);
+  return odometry;
+}
+
+RamseteGains AsyncMotionProfileController::getRamseteGains() const {
+  std::scoped_lock lock(currentPathMutex);
+  return ramseteGains;
+}
+
+void AsyncMotionProfileController::setMoveToStreaming(const std::size_t isegmentsPerChunk,
+                                                     const QTime ileadTime) {
+  std::scoped_lock lock(currentPathMutex);
+  streamSegmentsPerChunk = isegmentsPerChunk;
+  streamLeadTime = ileadTime;
+}
+
 void AsyncMotionProfileController::forceRemovePath(const std::string &ipathId) {
-  if (!removePath(ipathId)) {
-    LOG_WARN("AsyncMotionProfileController: Disabling controller to remove path " + ipathId);
+  PathHandle path;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    path = paths.find(ipathId);
+  }
+
+  if (path.isValid()) {
+    forceRemovePath(path);
+  }
+}
+
+void AsyncMotionProfileController::forceRemovePath(const PathHandle ipath) {
+  if (!removePath(ipath)) {
+    LOG_WARN("AsyncMotionProfileController: Disabling controller to remove path " +
+             getPathName(ipath));
     flipDisable(true);
-    removePath(ipathId);
+    removePath(ipath);
   }
 }
 } // namespace okapi
@@ -0,0 +1,411 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/async/asyncMultiAxisProfileController.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include <cmath>
+#include <mutex>
+
+namespace okapi {
+AsyncMultiAxisProfileController::AsyncMultiAxisProfileController(
+  const TimeUtil &itimeUtil,
+  std::vector<LinearAxis> iaxes,
+  const std::shared_ptr<Logger> &ilogger)
+  : logger(ilogger), axes(std::move(iaxes)), axisPositions(axes.size()), timeUtil(itimeUtil) {
+  if (axes.empty()) {
+    std::string msg("AsyncMultiAxisProfileController: There must be at least one axis.");
+    LOG_ERROR(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  limits.reserve(axes.size());
+  for (const auto &axis : axes) {
+    if (axis.pair.ratio == 0) {
+      std::string msg(
+        "AsyncMultiAxisProfileController: The gear ratio cannot be zero! Check if you are "
+        "using integer division.");
+      LOG_ERROR(msg);
+      throw std::invalid_argument(msg);
+    }
+
+    limits.push_back(axis.limits);
+  }
+
+  // The slot has no ID, so it can't collide with a path the user saved
+  moveToPath = paths.addUnnamed();
+}
+
+AsyncMultiAxisProfileController::~AsyncMultiAxisProfileController() {
+  dtorCalled.store(true, std::memory_order_release);
+
+  // Free paths before deleting the task. The lock must be released before deleting the task
+  // because the task might be waiting on it.
+  {
+    std::scoped_lock lock(currentPathMutex);
+    paths.clear();
+  }
+
+  delete task;
+}
+
+PathHandle
+AsyncMultiAxisProfileController::generatePath(const std::vector<LinearMove> &imoves,
+                                              const std::string &ipathId,
+                                              const LinearProfileShape ishape) {
+  PathHandle handle;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    handle = paths.intern(ipathId);
+  }
+
+  generateProfile(imoves, handle, ishape);
+  return handle;
+}
+
+void AsyncMultiAxisProfileController::generateProfile(const std::vector<LinearMove> &imoves,
+                                                      const PathHandle ipath,
+                                                      const LinearProfileShape ishape) {
+  std::shared_ptr<const SynchronizedProfile> path;
+  try {
+    path = std::make_shared<const SynchronizedProfile>(ishape, imoves, limits);
+  } catch (const std::invalid_argument &e) {
+    LOG_ERROR("AsyncMultiAxisProfileController: Could not generate path " + getPathName(ipath) +
+              ": " + e.what());
+    throw;
+  }
+
+  // Free the old path before overwriting it
+  forceRemovePath(ipath);
+
+  {
+    std::scoped_lock lock(currentPathMutex);
+    paths.set(ipath, path);
+  }
+
+  LOG_INFO("AsyncMultiAxisProfileController: Completely done generating path " +
+           getPathName(ipath));
+  LOG_DEBUG("AsyncMultiAxisProfileController: Path duration: " +
+            std::to_string(path->getDuration().convert(second)) + " s, limited by axis " +
+            std::to_string(path->getLimitingAxis()));
+}
+
+bool AsyncMultiAxisProfileController::removePath(const std::string &ipathId) {
+  PathHandle path;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    path = paths.find(ipathId);
+  }
+
+  // A path which was never saved doesn't exist
+  return !path.isValid() || removePath(path);
+}
+
+bool AsyncMultiAxisProfileController::removePath(const PathHandle ipath) {
+  std::scoped_lock lock(currentPathMutex);
+
+  if (!isDisabled() && isRunning.load(std::memory_order_acquire) && currentPath == ipath) {
+    LOG_WARN("AsyncMultiAxisProfileController: Attempted to remove currently running path " +
+             paths.getName(ipath));
+    return false;
+  }
+
+  // If the path is being followed, the follower keeps its own reference, so erasing it here only
+  // drops the controller's reference
+  if (ipath.isValid()) {
+    paths.set(ipath, nullptr);
+  }
+
+  /*
+   * A return value of true provides no feedback about whether the
+   * path was actually removed but instead tells us that the path
+   * does not exist at this moment
+   */
+  return true;
+}
+
+PathHandle AsyncMultiAxisProfileController::getPathHandle(const std::string &ipathId) {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.find(ipathId);
+}
+
+std::vector<std::string> AsyncMultiAxisProfileController::getPaths() {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.getNames();
+}
+
+void AsyncMultiAxisProfileController::setTarget(std::string ipathId) {
+  PathHandle path;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    path = paths.find(ipathId);
+    if (!path.isValid()) {
+      // Remember the ID for getTarget() without adding a slot for it to the table
+      currentPath = PathHandle();
+      missingTargetId = ipathId;
+    }
+  }
+
+  if (!path.isValid()) {
+    LOG_WARN("AsyncMultiAxisProfileController: Target was set to non-existent path with name: " +
+             ipathId);
+    return;
+  }
+
+  setTarget(path);
+}
+
+void AsyncMultiAxisProfileController::setTarget(const PathHandle ipath) {
+  // Only capture the handle so nothing is copied unless the message is logged
+  LOG_INFO("AsyncMultiAxisProfileController: Set target to: " + getPathName(ipath));
+
+  {
+    std::scoped_lock lock(currentPathMutex);
+    currentPath = ipath;
+    missingTargetId.clear();
+  }
+
+  isRunning.store(true, std::memory_order_release);
+}
+
+void AsyncMultiAxisProfileController::controllerSet(const std::string ivalue) {
+  setTarget(ivalue);
+}
+
+std::string AsyncMultiAxisProfileController::getTarget() {
+  std::scoped_lock lock(currentPathMutex);
+  return currentPath.isValid() ? paths.getName(currentPath) : missingTargetId;
+}
+
+std::string AsyncMultiAxisProfileController::getTarget() const {
+  std::scoped_lock lock(currentPathMutex);
+  return currentPath.isValid() ? paths.getName(currentPath) : missingTargetId;
+}
+
+std::string AsyncMultiAxisProfileController::getProcessValue() const {
+  std::scoped_lock lock(currentPathMutex);
+  return currentPath.isValid() ? paths.getName(currentPath) : missingTargetId;
+}
+
+const std::string &AsyncMultiAxisProfileController::getPathName(const PathHandle ipath) const {
+  // Interned names are never moved, so the reference outlives the lock
+  std::scoped_lock lock(currentPathMutex);
+  return paths.getName(ipath);
+}
+
+void AsyncMultiAxisProfileController::loop() {
+  LOG_INFO_S("Started AsyncMultiAxisProfileController task.");
+
+  auto rate = timeUtil.getRate();
+
+  while (!dtorCalled.load(std::memory_order_acquire) && !task->notifyTake(0)) {
+    if (isRunning.load(std::memory_order_acquire) && !isDisabled()) {
+      PathHandle target;
+      {
+        std::scoped_lock lock(currentPathMutex);
+        target = currentPath;
+      }
+
+      LOG_INFO("AsyncMultiAxisProfileController: Running with path: " + getPathName(target));
+
+      // Take our own reference to the path so it stays valid even if it is removed or replaced
+      // while we follow it
+      const auto path = findPath(target);
+
+      if (!path) {
+        LOG_WARN(
+          "AsyncMultiAxisProfileController: Target was set to non-existent path with name: " +
+          getPathName(target));
+      } else {
+        executeProfile(*path, timeUtil.getRate());
+
+        // Every profile ends at rest, so make sure every axis is stopped
+        for (auto &axis : axes) {
+          axis.output->controllerSet(0);
+        }
+
+        LOG_INFO_S("AsyncMultiAxisProfileController: Done moving");
+      }
+
+      isRunning.store(false, std::memory_order_release);
+    }
+
+    rate->delayUntil(10_ms);
+  }
+
+  LOG_INFO_S("Stopped AsyncMultiAxisProfileController task.");
+}
+
+void AsyncMultiAxisProfileController::executeProfile(const SynchronizedProfile &profile,
+                                                     std::unique_ptr<AbstractRate> rate) {
+  const auto duration = profile.getDuration();
+  const auto timer = timeUtil.getTimer();
+  const QTime start = timer->millis();
+
+  while (!isDisabled()) {
+    // Sampling by time means a late tick catches up to where the profile should be now, and every
+    // axis is sampled at the same time so they stay in step
+    const QTime elapsed = timer->millis() - start;
+    if (elapsed >= duration) {
+      break;
+    }
+
+    for (std::size_t i = 0; i < axes.size(); ++i) {
+      const auto state = profile.sample(i, elapsed);
+      axisPositions[i].store(state.position, std::memory_order_release);
+      sendVelocity(i, state.velocity);
+    }
+
+    rate->delayUntil(10_ms);
+  }
+
+  if (!isDisabled()) {
+    for (std::size_t i = 0; i < axes.size(); ++i) {
+      axisPositions[i].store(profile.getProfile(i).getEnd(), std::memory_order_release);
+    }
+  }
+}
+
+void AsyncMultiAxisProfileController::sendVelocity(const std::size_t iaxis,
+                                                   const double ivelocity) {
+  const auto &axis = axes[iaxis];
+  const QAngularSpeed motorSpeed =
+    (ivelocity * mps * (360_deg / (axis.diameter * 1_pi))) * axis.pair.ratio;
+  axis.output->controllerSet(motorSpeed.convert(rpm) /
+                             toUnderlyingType(axis.pair.internalGearset));
+}
+
+void AsyncMultiAxisProfileController::trampoline(void *context) {
+  if (context) {
+    static_cast<AsyncMultiAxisProfileController *>(context)->loop();
+  }
+}
+
+void AsyncMultiAxisProfileController::waitUntilSettled() {
+  LOG_INFO_S("AsyncMultiAxisProfileController: Waiting to settle");
+
+  auto rate = timeUtil.getRate();
+  while (!isSettled()) {
+    rate->delayUntil(10_ms);
+  }
+
+  LOG_INFO_S("AsyncMultiAxisProfileController: Done waiting to settle");
+}
+
+void AsyncMultiAxisProfileController::moveTo(const std::vector<LinearMove> &imoves,
+                                             const LinearProfileShape ishape) {
+  generateProfile(imoves, moveToPath, ishape);
+  setTarget(moveToPath);
+  waitUntilSettled();
+  if (!removePath(moveToPath)) {
+    // Failed to remove path (Warn and move on)
+    LOG_WARN_S("AsyncMultiAxisProfileController: Couldn't remove path after moveTo");
+  }
+}
+
+std::size_t AsyncMultiAxisProfileController::getAxisCount() const {
+  return axes.size();
+}
+
+double AsyncMultiAxisProfileController::getAxisPosition(const std::size_t iaxis) const {
+  return axisPositions[iaxis].load(std::memory_order_acquire);
+}
+
+double AsyncMultiAxisProfileController::getError() const {
+  std::shared_ptr<const SynchronizedProfile> path;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    path = paths.get(currentPath);
+  }
+
+  if (!path) {
+    return 0;
+  }
+
+  double error = 0;
+  for (std::size_t i = 0; i < axes.size(); ++i) {
+    const double axisError = path->getProfile(i).getEnd() - getAxisPosition(i);
+    if (std::abs(axisError) > std::abs(error)) {
+      error = axisError;
+    }
+  }
+
+  return error;
+}
+
+std::shared_ptr<const SynchronizedProfile>
+AsyncMultiAxisProfileController::findPath(const PathHandle ipath) const {
+  std::scoped_lock lock(currentPathMutex);
+  return paths.get(ipath);
+}
+
+bool AsyncMultiAxisProfileController::isSettled() {
+  return isDisabled() || !isRunning.load(std::memory_order_acquire);
+}
+
+void AsyncMultiAxisProfileController::reset() {
+  // Interrupt executeProfile() by disabling the controller
+  flipDisable(true);
+
+  LOG_INFO_S("AsyncMultiAxisProfileController: Waiting to reset");
+
+  auto rate = timeUtil.getRate();
+  while (isRunning.load(std::memory_order_acquire)) {
+    rate->delayUntil(1_ms);
+  }
+
+  flipDisable(false);
+}
+
+void AsyncMultiAxisProfileController::flipDisable() {
+  flipDisable(!disabled.load(std::memory_order_acquire));
+}
+
+void AsyncMultiAxisProfileController::flipDisable(const bool iisDisabled) {
+  LOG_INFO("AsyncMultiAxisProfileController: flipDisable " + std::to_string(iisDisabled));
+  disabled.store(iisDisabled, std::memory_order_release);
+  // loop() will set the outputs to 0 when executeProfile() is done
+}
+
+bool AsyncMultiAxisProfileController::isDisabled() const {
+  return disabled.load(std::memory_order_acquire);
+}
+
+void AsyncMultiAxisProfileController::startThread() {
+  if (!task) {
+    task = new CrossplatformThread(trampoline, this, "AsyncMultiAxisProfileController");
+  }
+}
+
+CrossplatformThread *AsyncMultiAxisProfileController::getThread() const {
+  return task;
+}
+
+void AsyncMultiAxisProfileController::tarePosition() {
+}
+
+void AsyncMultiAxisProfileController::setMaxVelocity(std::int32_t) {
+}
+
+void AsyncMultiAxisProfileController::forceRemovePath(const std::string &ipathId) {
+  PathHandle path;
+  {
+    std::scoped_lock lock(currentPathMutex);
+    path = paths.find(ipathId);
+  }
+
+  if (path.isValid()) {
+    forceRemovePath(path);
+  }
+}
+
+void AsyncMultiAxisProfileController::forceRemovePath(const PathHandle ipath) {
+  if (!removePath(ipath)) {
+    LOG_WARN("AsyncMultiAxisProfileController: Disabling controller to remove path " +
+             getPathName(ipath));
+    flipDisable(true);
+    removePath(ipath);
+  }
+}
+} // namespace okapi
@@ -70,4 +70,9 @@ void AsyncPosPIDController::setGains(const IterativePosPIDController::Gains &iga
 IterativePosPIDController::Gains AsyncPosPIDController::getGains() const {
   return internalController->getGains();
 }
+
+void AsyncPosPIDController::setTelemetry(std::shared_ptr<TelemetrySink> isink,
+                                         const std::string &ichannelName) {
+  internalController->setTelemetry(std::move(isink), ichannelName);
+}
 } // namespace okapi
@@ -144,6 +144,19 @@ double IterativePosPIDController::step(const double inewReading) {
 
       output = std::clamp(kP * error + integral - kD * derivative + kBias, outputMin, outputMax);
 
+      // Copy the pointer so the sink can't be swapped out from under us
+      if (const auto destination = std::atomic_load(&telemetry); destination) {
+        destination->sink->record(destination->channel,
+                                  {target,
+                                   inewReading,
+                                   error,
+                                   kP * error,
+                                   integral,
+                                   -kD * derivative,
+                                   output,
+                                   loopDtTimer->getDtFromHardMark()});
+      }
+
       lastError = error;
       loopDtTimer->clearHardMark(); // Important that we only clear if dt >= sampleTime
 
@@ -217,6 +230,17 @@ IterativePosPIDController::Gains IterativePosPIDController::getGains() const {
   return {kP, kI / sampleTime.convert(second), kD * sampleTime.convert(second), kBias};
 }
 
+void IterativePosPIDController::setTelemetry(std::shared_ptr<TelemetrySink> isink,
+                                             const std::string &ichannelName) {
+  std::shared_ptr<const TelemetryDestination> destination{nullptr};
+  if (isink) {
+    const auto channel = isink->addChannel(ichannelName);
+    destination = std::make_shared<const TelemetryDestination>(
+      TelemetryDestination{std::move(isink), channel});
+  }
+  std::atomic_store(&telemetry, std::move(destination));
+}
+
 bool IterativePosPIDController::Gains::operator==(
   const IterativePosPIDController::Gains &rhs) const {
   return kP == rhs.kP && kI == rhs.kI && kD == rhs.kD && kBias == rhs.kBias;
@@ -0,0 +1,169 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/binaryPathFormat.hpp"
+#include <array>
+#include <cstring>
+#include <iterator>
+
+namespace okapi {
+namespace {
+template <typename T> void putLE(std::uint8_t *out, const T ivalue) {
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    out[i] = static_cast<std::uint8_t>((ivalue >> (8 * i)) & 0xFF);
+  }
+}
+
+template <typename T> T getLE(const std::uint8_t *in) {
+  T value = 0;
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    value |= static_cast<T>(static_cast<T>(in[i]) << (8 * i));
+  }
+  return value;
+}
+
+// Both the V5 brain and the hosts we build tests on are little-endian with IEEE-754 doubles, so
+// doubles are copied byte-for-byte.
+void putDouble(std::uint8_t *&out, const double ivalue) {
+  std::memcpy(out, &ivalue, sizeof(double));
+  out += sizeof(double);
+}
+
+double getDouble(const std::uint8_t *&in) {
+  double value;
+  std::memcpy(&value, in, sizeof(double));
+  in += sizeof(double);
+  return value;
+}
+
+std::array<std::uint32_t, 256> makeCrcTable() {
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    std::uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+} // namespace
+
+std::vector<std::uint8_t>
+BinaryPathFormat::encode(const std::vector<squiggles::ProfilePoint> &ipath) {
+  const std::size_t wheelCount = ipath.empty() ? 0 : ipath.front().wheel_velocities.size();
+  const std::size_t recordSize = (fieldsPerPoint + wheelCount) * sizeof(double);
+
+  std::vector<std::uint8_t> out(headerSize + recordSize * ipath.size());
+
+  std::uint8_t *record = out.data() + headerSize;
+  for (const auto &point : ipath) {
+    putDouble(record, point.vector.pose.x);
+    putDouble(record, point.vector.pose.y);
+    putDouble(record, point.vector.pose.yaw);
+    putDouble(record, point.vector.vel);
+    putDouble(record, point.vector.accel);
+    putDouble(record, point.vector.jerk);
+    putDouble(record, point.curvature);
+    putDouble(record, point.time);
+    for (std::size_t i = 0; i < wheelCount; ++i) {
+      putDouble(record, i < point.wheel_velocities.size() ? point.wheel_velocities[i] : 0.0);
+    }
+  }
+
+  putLE<std::uint32_t>(out.data(), magic);
+  putLE<std::uint16_t>(out.data() + 4, version);
+  putLE<std::uint16_t>(out.data() + 6, static_cast<std::uint16_t>(wheelCount));
+  putLE<std::uint32_t>(out.data() + 8, static_cast<std::uint32_t>(ipath.size()));
+  putLE<std::uint32_t>(out.data() + 12, crc32(out.data() + headerSize, out.size() - headerSize));
+
+  return out;
+}
+
+std::optional<std::vector<squiggles::ProfilePoint>>
+BinaryPathFormat::decode(const std::uint8_t *idata, const std::size_t isize) {
+  if (idata == nullptr || isize < headerSize || getLE<std::uint32_t>(idata) != magic ||
+      getLE<std::uint16_t>(idata + 4) != version) {
+    return std::nullopt;
+  }
+
+  const std::size_t wheelCount = getLE<std::uint16_t>(idata + 6);
+  const std::size_t pointCount = getLE<std::uint32_t>(idata + 8);
+  const std::uint32_t checksum = getLE<std::uint32_t>(idata + 12);
+  const std::size_t recordSize = (fieldsPerPoint + wheelCount) * sizeof(double);
+
+  if ((isize - headerSize) / recordSize < pointCount) {
+    return std::nullopt;
+  }
+
+  const std::size_t payloadSize = recordSize * pointCount;
+  if (crc32(idata + headerSize, payloadSize) != checksum) {
+    return std::nullopt;
+  }
+
+  std::vector<squiggles::ProfilePoint> path;
+  path.reserve(pointCount);
+
+  const std::uint8_t *record = idata + headerSize;
+  for (std::size_t i = 0; i < pointCount; ++i) {
+    squiggles::ProfilePoint point;
+    point.vector.pose.x = getDouble(record);
+    point.vector.pose.y = getDouble(record);
+    point.vector.pose.yaw = getDouble(record);
+    point.vector.vel = getDouble(record);
+    point.vector.accel = getDouble(record);
+    point.vector.jerk = getDouble(record);
+    point.curvature = getDouble(record);
+    point.time = getDouble(record);
+    point.wheel_velocities.resize(wheelCount);
+    for (auto &wheelVelocity : point.wheel_velocities) {
+      wheelVelocity = getDouble(record);
+    }
+    path.push_back(std::move(point));
+  }
+
+  return path;
+}
+
+void BinaryPathFormat::write(std::ostream &ifile,
+                             const std::vector<squiggles::ProfilePoint> &ipath) {
+  const auto buffer = encode(ipath);
+  ifile.write(reinterpret_cast<const char *>(buffer.data()),
+              static_cast<std::streamsize>(buffer.size()));
+}
+
+std::optional<std::vector<squiggles::ProfilePoint>> BinaryPathFormat::read(std::istream &ifile) {
+  std::vector<std::uint8_t> buffer;
+
+  const auto start = ifile.tellg();
+  ifile.seekg(0, std::ios::end);
+  const auto end = ifile.tellg();
+
+  if (start != std::istream::pos_type(-1) && end != std::istream::pos_type(-1)) {
+    // Seekable stream (a file), so grab all of it with one read
+    ifile.seekg(start);
+    buffer.resize(static_cast<std::size_t>(end - start));
+    ifile.read(reinterpret_cast<char *>(buffer.data()),
+               static_cast<std::streamsize>(buffer.size()));
+    buffer.resize(static_cast<std::size_t>(ifile.gcount()));
+  } else {
+    ifile.clear();
+    buffer.assign(std::istreambuf_iterator<char>(ifile), std::istreambuf_iterator<char>());
+  }
+
+  return decode(buffer.data(), buffer.size());
+}
+
+std::uint32_t BinaryPathFormat::crc32(const std::uint8_t *idata, const std::size_t isize) {
+  static const auto table = makeCrcTable();
+
+  std::uint32_t crc = 0xFFFFFFFFu;
+  for (std::size_t i = 0; i < isize; ++i) {
+    crc = table[(crc ^ idata[i]) & 0xFF] ^ (crc >> 8);
+  }
+
+  return crc ^ 0xFFFFFFFFu;
+}
+} // namespace okapi
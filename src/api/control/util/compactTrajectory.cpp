@@ -0,0 +1,169 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/compactTrajectory.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace okapi {
+namespace {
+constexpr double quantizationSteps = std::numeric_limits<std::uint16_t>::max();
+
+double getColumnValue(const squiggles::ProfilePoint &ipoint, const std::size_t icolumn) {
+  switch (icolumn) {
+  case 0:
+    return ipoint.vector.pose.x;
+  case 1:
+    return ipoint.vector.pose.y;
+  case 2:
+    return ipoint.vector.pose.yaw;
+  case 3:
+    return ipoint.vector.vel;
+  case 4:
+    return ipoint.vector.accel;
+  case 5:
+    return ipoint.vector.jerk;
+  case 6:
+    return ipoint.curvature;
+  case 7:
+    return ipoint.time;
+  default:
+    return ipoint.wheel_velocities[icolumn - CompactTrajectory::fieldCount];
+  }
+}
+} // namespace
+
+CompactTrajectory::CompactTrajectory(const std::vector<squiggles::ProfilePoint> &ipath)
+  : pointCount(ipath.size()), wheelCount(ipath.empty() ? 0 : ipath[0].wheel_velocities.size()) {
+  if (wheelCount > maxWheelCount) {
+    throw std::invalid_argument("CompactTrajectory: Can't store more than " +
+                                std::to_string(maxWheelCount) + " wheel velocities per point.");
+  }
+
+  for (const auto &point : ipath) {
+    if (point.wheel_velocities.size() != wheelCount) {
+      throw std::invalid_argument(
+        "CompactTrajectory: Every point must have the same number of wheel velocities.");
+    }
+  }
+
+  const std::size_t columnCount = fieldCount + wheelCount;
+  columns = std::make_unique<std::uint16_t[]>(columnCount * pointCount);
+
+  for (std::size_t column = 0; column < columnCount; ++column) {
+    double low = std::numeric_limits<double>::infinity();
+    double high = -std::numeric_limits<double>::infinity();
+    for (const auto &point : ipath) {
+      const double value = getColumnValue(point, column);
+      if (!std::isfinite(value)) {
+        throw std::invalid_argument("CompactTrajectory: The path contains a non-finite value.");
+      }
+
+      low = std::min(low, value);
+      high = std::max(high, value);
+    }
+
+    if (pointCount == 0) {
+      continue;
+    }
+
+    auto &range = ranges[column];
+    range.offset = low;
+    range.scale = (high - low) / quantizationSteps;
+
+    std::uint16_t *out = columns.get() + column * pointCount;
+    for (std::size_t i = 0; i < pointCount; ++i) {
+      if (range.scale > 0) {
+        const double steps = std::round((getColumnValue(ipath[i], column) - low) / range.scale);
+        out[i] = static_cast<std::uint16_t>(std::clamp(steps, 0.0, quantizationSteps));
+      } else {
+        out[i] = 0;
+      }
+    }
+  }
+}
+
+std::size_t CompactTrajectory::size() const {
+  return pointCount;
+}
+
+bool CompactTrajectory::empty() const {
+  return pointCount == 0;
+}
+
+std::size_t CompactTrajectory::getWheelCount() const {
+  return wheelCount;
+}
+
+double CompactTrajectory::get(const Field ifield, const std::size_t iindex) const {
+  return decode(static_cast<std::size_t>(ifield), iindex);
+}
+
+double CompactTrajectory::getWheelVelocity(const std::size_t iwheel,
+                                           const std::size_t iindex) const {
+  return decode(fieldCount + iwheel, iindex);
+}
+
+squiggles::ProfilePoint CompactTrajectory::at(const std::size_t iindex) const {
+  std::vector<double> wheelVelocities(wheelCount);
+  for (std::size_t wheel = 0; wheel < wheelCount; ++wheel) {
+    wheelVelocities[wheel] = getWheelVelocity(wheel, iindex);
+  }
+
+  return squiggles::ProfilePoint(
+    squiggles::ControlVector(squiggles::Pose(get(Field::x, iindex),
+                                             get(Field::y, iindex),
+                                             get(Field::yaw, iindex)),
+                             get(Field::vel, iindex),
+                             get(Field::accel, iindex),
+                             get(Field::jerk, iindex)),
+    wheelVelocities,
+    get(Field::curvature, iindex),
+    get(Field::time, iindex));
+}
+
+std::vector<squiggles::ProfilePoint> CompactTrajectory::toProfile() const {
+  std::vector<squiggles::ProfilePoint> out;
+  out.reserve(pointCount);
+  for (std::size_t i = 0; i < pointCount; ++i) {
+    out.emplace_back(at(i));
+  }
+  return out;
+}
+
+double CompactTrajectory::getMaxError(const Field ifield) const {
+  return maxError(static_cast<std::size_t>(ifield));
+}
+
+double CompactTrajectory::getWheelVelocityMaxError(const std::size_t iwheel) const {
+  return maxError(fieldCount + iwheel);
+}
+
+std::size_t CompactTrajectory::getBytesUsed() const {
+  return sizeof(CompactTrajectory) +
+         (fieldCount + wheelCount) * pointCount * sizeof(std::uint16_t);
+}
+
+double CompactTrajectory::decode(const std::size_t icolumn, const std::size_t iindex) const {
+  const auto &range = ranges[icolumn];
+  return range.offset + columns[icolumn * pointCount + iindex] * range.scale;
+}
+
+double CompactTrajectory::maxError(const std::size_t icolumn) const {
+  const auto &range = ranges[icolumn];
+  if (range.scale == 0) {
+    // Every value in the column is the offset, which is stored exactly
+    return 0;
+  }
+
+  // Rounding to the nearest step is off by at most half a step. Decoding adds a few ulps of the
+  // largest magnitude in the column.
+  const double magnitude =
+    std::max(std::abs(range.offset), std::abs(range.offset + quantizationSteps * range.scale));
+  return range.scale / 2 + 4 * std::numeric_limits<double>::epsilon() * magnitude;
+}
+} // namespace okapi
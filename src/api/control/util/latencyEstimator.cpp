@@ -0,0 +1,82 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/latencyEstimator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace okapi {
+namespace {
+/**
+ * Computes the Pearson correlation of `ia[i]` and `ib[i + ilag]` over the overlapping samples.
+ */
+double correlationAtLag(const std::vector<double> &ia,
+                        const std::vector<double> &ib,
+                        const std::size_t ilag) {
+  const std::size_t count = ia.size() - ilag;
+  double meanA = 0;
+  double meanB = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    meanA += ia[i];
+    meanB += ib[i + ilag];
+  }
+  meanA /= count;
+  meanB /= count;
+
+  double covariance = 0;
+  double varianceA = 0;
+  double varianceB = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const double a = ia[i] - meanA;
+    const double b = ib[i + ilag] - meanB;
+    covariance += a * b;
+    varianceA += a * a;
+    varianceB += b * b;
+  }
+
+  if (varianceA == 0 || varianceB == 0) {
+    return 0;
+  }
+
+  return covariance / std::sqrt(varianceA * varianceB);
+}
+} // namespace
+
+LatencyEstimator::Estimate LatencyEstimator::estimate(const std::vector<double> &icommanded,
+                                                      const std::vector<double> &imeasured,
+                                                      const QTime isamplePeriod,
+                                                      const QTime imaxLatency) {
+  if (icommanded.size() != imeasured.size() || icommanded.empty()) {
+    throw std::invalid_argument(
+      "LatencyEstimator: The logs must be the same length and not empty.");
+  }
+
+  if (isamplePeriod <= 0_ms) {
+    throw std::invalid_argument("LatencyEstimator: The sample period must be positive.");
+  }
+
+  // Allow for rounding so a latency of exactly N periods includes a lag of N
+  const double periods = (imaxLatency / isamplePeriod).getValue();
+  const auto maxLag = static_cast<std::size_t>(std::max(0.0, std::floor(periods + 1e-9)));
+  if (maxLag > icommanded.size() / 2) {
+    throw std::invalid_argument("LatencyEstimator: The logs are too short. " +
+                                std::to_string(icommanded.size()) +
+                                " samples can only be checked for a delay of up to " +
+                                std::to_string(icommanded.size() / 2) + " samples.");
+  }
+
+  Estimate best{0_ms, correlationAtLag(icommanded, imeasured, 0)};
+  for (std::size_t lag = 1; lag <= maxLag; ++lag) {
+    if (const double correlation = correlationAtLag(icommanded, imeasured, lag);
+        correlation > best.correlation) {
+      best = {static_cast<double>(lag) * isamplePeriod, correlation};
+    }
+  }
+
+  return best;
+}
+} // namespace okapi
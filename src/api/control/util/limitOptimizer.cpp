@@ -0,0 +1,228 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/limitOptimizer.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+namespace okapi {
+namespace {
+// Slow candidates take many points, and those which need more than this are treated as infeasible
+constexpr std::size_t candidateCapacity = 10000;
+constexpr double candidateDT = 0.01;
+
+/**
+ * Evenly spaced values from just above a lower bound up to an upper bound, inclusive.
+ */
+std::vector<double> spaceValues(const double ilow, const double ihigh, const std::size_t icount) {
+  std::vector<double> values;
+  values.reserve(icount);
+  for (std::size_t i = 1; i <= icount; ++i) {
+    values.push_back(ilow + (ihigh - ilow) * i / icount);
+  }
+  return values;
+}
+
+/**
+ * The points a straight path as long as the waypoints are apart needs, which takes at most
+ * d/v + v/a to drive. Curves make the path longer and slower, which growing the generator covers.
+ */
+std::size_t estimateCapacity(const std::vector<PathfinderPoint> &iwaypoints,
+                             const PathfinderLimits &ilimits) {
+  double distance = 0;
+  for (std::size_t i = 1; i < iwaypoints.size(); ++i) {
+    distance += std::hypot((iwaypoints[i].x - iwaypoints[i - 1].x).convert(meter),
+                           (iwaypoints[i].y - iwaypoints[i - 1].y).convert(meter));
+  }
+
+  const double duration = distance / ilimits.maxVel + ilimits.maxVel / ilimits.maxAccel;
+  if (!(duration < candidateCapacity * candidateDT)) {
+    return candidateCapacity;
+  }
+  return static_cast<std::size_t>(std::ceil(duration / candidateDT)) + 1;
+}
+} // namespace
+
+LimitOptimizer::LimitOptimizer(const TimeUtil &itimeUtil,
+                               const ChassisScales &iscales,
+                               const AbstractMotor::GearsetRatioPair &ipair,
+                               const DriveConstraints &iconstraints,
+                               const std::size_t igridSize,
+                               const std::size_t iworkerCount,
+                               const std::shared_ptr<Logger> &ilogger)
+  : logger(ilogger),
+    timeUtil(itimeUtil),
+    scales(iscales),
+    constraints(iconstraints),
+    maxWheelSpeed(toUnderlyingType(ipair.internalGearset) / ipair.ratio / 60 * 1_pi *
+                  iscales.wheelDiameter.convert(meter) * iconstraints.usableSpeed),
+    gridSize(std::max<std::size_t>(igridSize, 2)),
+    pool(itimeUtil, iworkerCount, iworkerCount, ilogger) {
+  if (!(iconstraints.maxMotorAccel > 0) || !(iconstraints.maxTractionAccel > 0) ||
+      !(iconstraints.maxJerk > 0) || !(iconstraints.usableSpeed > 0) || !(maxWheelSpeed > 0)) {
+    std::string msg("LimitOptimizer: The constraints and the motor speed must be positive.");
+    LOG_ERROR(msg);
+    throw std::invalid_argument(msg);
+  }
+}
+
+LimitSearchResult LimitOptimizer::optimize(const std::vector<PathfinderPoint> &iwaypoints) {
+  if (iwaypoints.size() < 2) {
+    std::string msg("LimitOptimizer: The path must have at least two waypoints.");
+    LOG_ERROR(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  const double maxAccel = constraints.maxMotorAccel;
+
+  // A coarse grid over every limit the motors allow
+  auto candidates = evaluateGrid(iwaypoints,
+                                 spaceValues(0, maxWheelSpeed, gridSize),
+                                 spaceValues(0, maxAccel, gridSize));
+  std::size_t evaluatedCount = candidates.size();
+
+  const auto isBetter = [](const Candidate &a, const Candidate &b) {
+    if (!a.feasible || !b.feasible) {
+      return a.feasible;
+    }
+    return a.duration < b.duration || (a.duration == b.duration && a.peakAccel < b.peakAccel);
+  };
+
+  auto best = *std::min_element(candidates.begin(), candidates.end(), isBetter);
+  if (!best.feasible) {
+    std::string msg("LimitOptimizer: No limits can follow the path without slipping.");
+    LOG_ERROR(msg);
+    throw std::runtime_error(msg);
+  }
+
+  // Then a finer grid within one coarse step of the best limits
+  const double velocityStep = maxWheelSpeed / gridSize;
+  const double accelStep = maxAccel / gridSize;
+  const double lowVelocity = std::max(best.limits.maxVel - velocityStep, 0.0);
+  const double lowAccel = std::max(best.limits.maxAccel - accelStep, 0.0);
+  candidates = evaluateGrid(
+    iwaypoints,
+    spaceValues(lowVelocity, std::min(best.limits.maxVel + velocityStep, maxWheelSpeed), gridSize),
+    spaceValues(lowAccel, std::min(best.limits.maxAccel + accelStep, maxAccel), gridSize));
+  evaluatedCount += candidates.size();
+
+  const auto fine = *std::min_element(candidates.begin(), candidates.end(), isBetter);
+  if (isBetter(fine, best)) {
+    best = fine;
+  }
+
+  LimitSearchResult result{best.limits,
+                           best.duration * second,
+                           LimitConstraint::motorSpeed,
+                           best.limits.maxVel / maxWheelSpeed,
+                           best.limits.maxAccel / maxAccel,
+                           best.peakAccel / constraints.maxTractionAccel,
+                           evaluatedCount};
+
+  // The constraint the path uses the most of is the one stopping it from going faster
+  if (result.motorAccelUsage > result.motorSpeedUsage &&
+      result.motorAccelUsage >= result.tractionUsage) {
+    result.binding = LimitConstraint::motorAcceleration;
+  } else if (result.tractionUsage > result.motorSpeedUsage) {
+    result.binding = LimitConstraint::traction;
+  }
+
+  LOG_INFO("LimitOptimizer: Found limits {" + std::to_string(best.limits.maxVel) + ", " +
+           std::to_string(best.limits.maxAccel) + "} taking " + std::to_string(best.duration) +
+           " s after trying " + std::to_string(evaluatedCount));
+  return result;
+}
+
+QSpeed LimitOptimizer::getMaxWheelSpeed() const {
+  return maxWheelSpeed * mps;
+}
+
+LimitOptimizer::Candidate
+LimitOptimizer::evaluate(const std::vector<PathfinderPoint> &iwaypoints,
+                         const PathfinderLimits &ilimits,
+                         std::unique_ptr<TrajectoryGenerator> &igenerator) const {
+  Candidate candidate{ilimits};
+
+  const auto makeGenerator = [&](const std::size_t icapacity) {
+    igenerator =
+      std::make_unique<TrajectoryGenerator>(ilimits, scales.wheelTrack, candidateDT, icapacity);
+    return igenerator->generate(iwaypoints);
+  };
+
+  try {
+    std::size_t size;
+    try {
+      size = igenerator ? igenerator->setLimits(ilimits)
+                        : makeGenerator(estimateCapacity(iwaypoints, ilimits));
+    } catch (const std::runtime_error &) {
+      // Only a path which is too long for the generator is worth generating again
+      const auto required = igenerator->getRequiredCapacity();
+      if (required <= igenerator->getCapacity() || required > candidateCapacity) {
+        throw;
+      }
+
+      size = makeGenerator(required);
+    }
+
+    const auto &generator = *igenerator;
+    for (std::size_t i = 0; i < size; ++i) {
+      const auto &point = generator[i];
+      const double lateral = point.vector.vel * point.vector.vel * point.curvature;
+      candidate.peakAccel = std::max(candidate.peakAccel, std::hypot(point.vector.accel, lateral));
+    }
+
+    candidate.duration = generator[size - 1].time;
+    candidate.feasible = candidate.peakAccel <= constraints.maxTractionAccel;
+  } catch (const std::exception &) {
+    // The path is impossible or too slow with these limits
+  }
+
+  return candidate;
+}
+
+std::vector<LimitOptimizer::Candidate>
+LimitOptimizer::evaluateGrid(const std::vector<PathfinderPoint> &iwaypoints,
+                             const std::vector<double> &ivelocities,
+                             const std::vector<double> &iaccels) {
+  std::vector<Candidate> candidates(ivelocities.size() * iaccels.size());
+  std::atomic_size_t doneRows{0};
+
+  // One job per row. Each job writes only its own row, so the rows need no locking.
+  for (std::size_t row = 0; row < ivelocities.size(); ++row) {
+    auto job = [&, row] {
+      try {
+        // The candidates of a row share a generator. The slowest acceleration comes first, so the
+        // generator is sized for the longest path of the row.
+        std::unique_ptr<TrajectoryGenerator> generator;
+        for (std::size_t col = 0; col < iaccels.size(); ++col) {
+          candidates[row * iaccels.size() + col] =
+            evaluate(iwaypoints, {ivelocities[row], iaccels[col], constraints.maxJerk}, generator);
+        }
+      } catch (...) {
+        // The rest of the row stays infeasible
+      }
+
+      // Always count the row, or the wait below would never finish and the queued jobs would
+      // outlive the candidates they write to
+      doneRows.fetch_add(1, std::memory_order_release);
+    };
+
+    // Run the row here if every worker is busy, which also keeps this task useful
+    if (!pool.submit(job)) {
+      job();
+    }
+  }
+
+  auto rate = timeUtil.getRate();
+  while (doneRows.load(std::memory_order_acquire) < ivelocities.size()) {
+    rate->delayUntil(1_ms);
+  }
+
+  return candidates;
+}
+} // namespace okapi
@@ -0,0 +1,40 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/linearPath.hpp"
+#include "okapi/api/control/util/storedPath.hpp"
+
+namespace okapi {
+LinearPath::LinearPath(std::vector<squiggles::ProfilePoint> iprofile) : path(std::move(iprofile)) {
+}
+
+LinearPath::LinearPath(LinearProfile ianalytic) : path(std::move(ianalytic)) {
+}
+
+std::size_t LinearPath::size() const {
+  return isAnalytic() ? 0 : getProfile().size();
+}
+
+bool LinearPath::isAnalytic() const {
+  return std::holds_alternative<LinearProfile>(path);
+}
+
+const std::vector<squiggles::ProfilePoint> &LinearPath::getProfile() const {
+  return std::get<std::vector<squiggles::ProfilePoint>>(path);
+}
+
+const LinearProfile &LinearPath::getAnalytic() const {
+  return std::get<LinearProfile>(path);
+}
+
+std::size_t LinearPath::getBytesUsed() const {
+  if (isAnalytic()) {
+    return sizeof(LinearPath);
+  }
+
+  return sizeof(LinearPath) + StoredPath::estimateBytes(getProfile()) -
+         sizeof(std::vector<squiggles::ProfilePoint>);
+}
+} // namespace okapi
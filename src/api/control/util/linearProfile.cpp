@@ -0,0 +1,189 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/linearProfile.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace okapi {
+LinearProfile::LinearProfile(const LinearProfileShape ishape,
+                             const QLength &istart,
+                             const QLength &iend,
+                             const PathfinderLimits &ilimits)
+  : shape(ishape), start(istart.convert(meter)), end(iend.convert(meter)) {
+  const double maxVel = ilimits.maxVel;
+  const double maxAccel = ilimits.maxAccel;
+  const double maxJerk = ilimits.maxJerk;
+
+  if (!(maxVel > 0) || !(maxAccel > 0) || (shape == LinearProfileShape::sCurve && !(maxJerk > 0))) {
+    throw std::invalid_argument("LinearProfile: The limits must be positive.");
+  }
+
+  sign = end < start ? -1 : 1;
+  const double distance = std::abs(end - start);
+  if (distance == 0) {
+    return;
+  }
+
+  if (shape == LinearProfileShape::trapezoidal) {
+    // Accelerate at the limit until the peak velocity, cruise, then decelerate symmetrically. If
+    // accelerating and decelerating would cover more than the distance, the profile is a triangle.
+    peakVelocity = std::min(maxVel, std::sqrt(distance * maxAccel));
+    const double accelTime = peakVelocity / maxAccel;
+    const double cruiseTime = distance / peakVelocity - accelTime;
+
+    addPhase(accelTime, maxAccel, 0);
+    addPhase(cruiseTime, 0, 0);
+    addPhase(accelTime, -maxAccel, 0);
+  } else {
+    // The time spent changing the acceleration (jerkTime) and the total time spent speeding up
+    // (accelTime) to reach a peak velocity. Speeding up covers peak * accelTime / 2 by symmetry.
+    double jerkTime = 0;
+    double accelTime = 0;
+    const auto solveAccelPhase = [&](const double ipeak) {
+      if (ipeak * maxJerk >= maxAccel * maxAccel) {
+        jerkTime = maxAccel / maxJerk;
+        accelTime = jerkTime + ipeak / maxAccel;
+      } else {
+        // The acceleration limit is never reached
+        jerkTime = std::sqrt(ipeak / maxJerk);
+        accelTime = 2 * jerkTime;
+      }
+    };
+
+    peakVelocity = maxVel;
+    solveAccelPhase(peakVelocity);
+
+    if (peakVelocity * accelTime > distance) {
+      // Too short to cruise. Solve peak * accelTime(peak) = distance, first assuming the
+      // acceleration limit is reached, then without it.
+      const double jerkRatio = maxAccel / maxJerk;
+      peakVelocity =
+        maxAccel * (std::sqrt(jerkRatio * jerkRatio + 4 * distance / maxAccel) - jerkRatio) / 2;
+      if (peakVelocity * maxJerk < maxAccel * maxAccel) {
+        peakVelocity = std::cbrt(distance * distance * maxJerk / 4);
+      }
+
+      solveAccelPhase(peakVelocity);
+    }
+
+    const double constAccelTime = accelTime - 2 * jerkTime;
+    const double cruiseTime = distance / peakVelocity - accelTime;
+
+    addPhase(jerkTime, 0, maxJerk);
+    addPhase(constAccelTime, getFinalAcceleration(), 0);
+    addPhase(jerkTime, getFinalAcceleration(), -maxJerk);
+    addPhase(cruiseTime, 0, 0);
+    addPhase(jerkTime, 0, -maxJerk);
+    addPhase(constAccelTime, getFinalAcceleration(), 0);
+    addPhase(jerkTime, getFinalAcceleration(), maxJerk);
+  }
+}
+
+LinearProfile::State LinearProfile::sample(const QTime itime) const {
+  const double time = itime.convert(second);
+  if (phaseCount == 0 || time <= 0) {
+    return {start, 0, 0};
+  }
+
+  if (time >= duration) {
+    return {end, 0, 0};
+  }
+
+  // There are at most seven phases, so a linear search is still constant time
+  std::size_t index = 0;
+  while (index + 1 < phaseCount && phases[index + 1].startTime <= time) {
+    ++index;
+  }
+
+  const auto &phase = phases[index];
+  const auto state = evaluate(phase, time - phase.startTime);
+  return {start + sign * state.position, sign * state.velocity, sign * state.acceleration};
+}
+
+LinearProfile LinearProfile::stretchedTo(const QTime iduration) const {
+  const double target = iduration.convert(second);
+  if (target < duration) {
+    throw std::invalid_argument("LinearProfile: Can't stretch a profile which takes " +
+                                std::to_string(duration) + " s to " + std::to_string(target) +
+                                " s.");
+  }
+
+  LinearProfile out(*this);
+  if (phaseCount == 0 || target == duration) {
+    return out;
+  }
+
+  const double scale = target / duration;
+  for (std::size_t i = 0; i < phaseCount; ++i) {
+    auto &phase = out.phases[i];
+    phase.startTime *= scale;
+    phase.velocity /= scale;
+    phase.acceleration /= scale * scale;
+    phase.jerk /= scale * scale * scale;
+  }
+
+  out.duration = target;
+  out.peakVelocity /= scale;
+  return out;
+}
+
+QTime LinearProfile::getDuration() const {
+  return duration * second;
+}
+
+double LinearProfile::getStart() const {
+  return start;
+}
+
+double LinearProfile::getEnd() const {
+  return end;
+}
+
+double LinearProfile::getPeakVelocity() const {
+  return peakVelocity;
+}
+
+LinearProfileShape LinearProfile::getShape() const {
+  return shape;
+}
+
+void LinearProfile::addPhase(const double iduration,
+                             const double iacceleration,
+                             const double ijerk) {
+  if (!(iduration > 0)) {
+    return;
+  }
+
+  Phase phase{duration, 0, 0, iacceleration, ijerk};
+  if (phaseCount > 0) {
+    const auto &previous = phases[phaseCount - 1];
+    const auto previousEnd = evaluate(previous, duration - previous.startTime);
+    phase.position = previousEnd.position;
+    phase.velocity = previousEnd.velocity;
+  }
+
+  phases[phaseCount++] = phase;
+  duration += iduration;
+}
+
+double LinearProfile::getFinalAcceleration() const {
+  if (phaseCount == 0) {
+    return 0;
+  }
+
+  const auto &last = phases[phaseCount - 1];
+  return evaluate(last, duration - last.startTime).acceleration;
+}
+
+LinearProfile::State LinearProfile::evaluate(const Phase &iphase, const double idt) {
+  return {iphase.position + iphase.velocity * idt + iphase.acceleration * idt * idt / 2 +
+            iphase.jerk * idt * idt * idt / 6,
+          iphase.velocity + iphase.acceleration * idt + iphase.jerk * idt * idt / 2,
+          iphase.acceleration + iphase.jerk * idt};
+}
+} // namespace okapi
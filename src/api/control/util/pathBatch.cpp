@@ -0,0 +1,120 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pathBatch.hpp"
+#include <algorithm>
+#include <mutex>
+
+namespace okapi {
+PathBatch::PathBatch(std::vector<std::shared_ptr<PathGenerationHandle>> ihandles,
+                     const TimeUtil &itimeUtil)
+  : handles(std::move(ihandles)),
+    timeUtil(itimeUtil),
+    generationTimes(handles.size(), 0_ms),
+    bytesUsed(handles.size(), 0),
+    firstSkipped(handles.size()) {
+}
+
+std::size_t PathBatch::size() const {
+  return handles.size();
+}
+
+const std::shared_ptr<PathGenerationHandle> &PathBatch::getHandle(const std::size_t iindex) const {
+  return handles[iindex];
+}
+
+QTime PathBatch::getGenerationTime(const std::size_t iindex) const {
+  if (handles[iindex]->getState() != PathGenerationHandle::State::done) {
+    return 0_ms;
+  }
+
+  return generationTimes[iindex];
+}
+
+std::size_t PathBatch::getBytesUsed(const std::size_t iindex) const {
+  if (handles[iindex]->getState() != PathGenerationHandle::State::done) {
+    return 0;
+  }
+
+  return bytesUsed[iindex];
+}
+
+std::size_t PathBatch::getTotalBytesUsed() const {
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < handles.size(); ++i) {
+    total += getBytesUsed(i);
+  }
+  return total;
+}
+
+std::size_t PathBatch::getSucceededCount() const {
+  std::size_t count = 0;
+  for (const auto &handle : handles) {
+    if (handle->getState() == PathGenerationHandle::State::done) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+bool PathBatch::isDone() const {
+  for (const auto &handle : handles) {
+    if (!handle->isDone()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PathBatch::waitUntilDone() const {
+  auto rate = timeUtil.getRate();
+  while (!isDone()) {
+    rate->delayUntil(1_ms);
+  }
+
+  return getSucceededCount() == handles.size();
+}
+
+void PathBatch::cancel() {
+  std::scoped_lock lock(cancelMutex);
+  cancelled.store(true, std::memory_order_release);
+
+  // Claim every path no worker has started so the workers find nothing left to do
+  const auto skipped = nextIndex.exchange(handles.size(), std::memory_order_acq_rel);
+  firstSkipped = std::min(firstSkipped, skipped);
+  for (std::size_t i = skipped; i < handles.size(); ++i) {
+    // A path which a newer request superseded is already done
+    if (!handles[i]->isDone()) {
+      handles[i]->markFailed("The batch was cancelled before the path was generated.");
+    }
+  }
+}
+
+bool PathBatch::isCancelled() const {
+  return cancelled.load(std::memory_order_acquire);
+}
+
+std::size_t PathBatch::claimNext() {
+  // Don't let the index run past the end, so cancel() only skips paths which were never claimed
+  auto index = nextIndex.load(std::memory_order_acquire);
+  while (index < handles.size() &&
+         !nextIndex.compare_exchange_weak(index, index + 1, std::memory_order_acq_rel)) {
+  }
+
+  return std::min(index, handles.size());
+}
+
+std::size_t PathBatch::getFirstSkipped() const {
+  std::scoped_lock lock(cancelMutex);
+  return firstSkipped;
+}
+
+void PathBatch::recordResult(const std::size_t iindex,
+                             const QTime igenerationTime,
+                             const std::size_t ibytesUsed) {
+  generationTimes[iindex] = igenerationTime;
+  bytesUsed[iindex] = ibytesUsed;
+}
+} // namespace okapi
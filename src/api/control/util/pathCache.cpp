@@ -0,0 +1,245 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pathCache.hpp"
+#include "okapi/api/control/util/binaryPathFormat.hpp"
+#include "okapi/api/control/util/storedPath.hpp"
+#include <cstring>
+#include <fstream>
+#include <mutex>
+
+namespace okapi {
+namespace {
+constexpr std::uint64_t fnvOffsetBasis = 0xCBF29CE484222325ull;
+constexpr std::uint64_t fnvPrime = 0x100000001B3ull;
+
+// Persisted files start with this, then the length of the inputs, the inputs, and the path
+constexpr std::uint32_t inputsMagic = 0x4B43504F; // "OPCK" in little-endian order
+
+void appendDouble(std::string &inputs, const double ivalue) {
+  // Treat -0 and 0 as the same value so they produce the same key
+  const double value = ivalue == 0 ? 0.0 : ivalue;
+  char bytes[sizeof(double)];
+  std::memcpy(bytes, &value, sizeof(double));
+  inputs.append(bytes, sizeof(double));
+}
+
+void writeInputs(std::ostream &ifile, const std::string &iinputs) {
+  const auto length = static_cast<std::uint32_t>(iinputs.size());
+  ifile.write(reinterpret_cast<const char *>(&inputsMagic), sizeof(inputsMagic));
+  ifile.write(reinterpret_cast<const char *>(&length), sizeof(length));
+  ifile.write(iinputs.data(), static_cast<std::streamsize>(iinputs.size()));
+}
+
+/**
+ * Reads the inputs at the start of a persisted file and checks they are the expected ones. Files
+ * written before the inputs were stored have no magic, so they never match.
+ */
+bool readInputs(std::istream &ifile, const std::string &iexpected) {
+  std::uint32_t magic = 0;
+  std::uint32_t length = 0;
+  ifile.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+  ifile.read(reinterpret_cast<char *>(&length), sizeof(length));
+  if (!ifile.good() || magic != inputsMagic || length != iexpected.size()) {
+    return false;
+  }
+
+  std::string inputs(length, '\0');
+  ifile.read(inputs.data(), static_cast<std::streamsize>(length));
+  return ifile.good() && inputs == iexpected;
+}
+} // namespace
+
+PathCache::PathCache(const std::size_t imaxBytes, const std::shared_ptr<Logger> &ilogger)
+  : logger(ilogger), maxBytes(imaxBytes) {
+}
+
+PathCache::Key PathCache::makeKey(const std::vector<PathfinderPoint> &iwaypoints,
+                                  const PathfinderLimits &ilimits,
+                                  const QLength &iwheelTrack,
+                                  const double idt,
+                                  const double istartVel,
+                                  const double iendVel,
+                                  const bool inative) {
+  Key key;
+  key.inputs.reserve((3 * iwaypoints.size() + 9) * sizeof(double));
+
+  // Write the number of waypoints and every other field, even at its default, so the inputs of two
+  // different paths can never run together into the same sequence of bytes
+  appendDouble(key.inputs, static_cast<double>(iwaypoints.size()));
+  for (const auto &point : iwaypoints) {
+    appendDouble(key.inputs, point.x.convert(meter));
+    appendDouble(key.inputs, point.y.convert(meter));
+    appendDouble(key.inputs, point.theta.convert(radian));
+  }
+
+  appendDouble(key.inputs, ilimits.maxVel);
+  appendDouble(key.inputs, ilimits.maxAccel);
+  appendDouble(key.inputs, ilimits.maxJerk);
+  appendDouble(key.inputs, iwheelTrack.convert(meter));
+  appendDouble(key.inputs, idt);
+  appendDouble(key.inputs, istartVel);
+  appendDouble(key.inputs, iendVel);
+  appendDouble(key.inputs, inative ? 1 : 0);
+
+  key.hash = fnvOffsetBasis;
+  for (const auto byte : key.inputs) {
+    key.hash ^= static_cast<std::uint8_t>(byte);
+    key.hash *= fnvPrime;
+  }
+
+  return key;
+}
+
+PathCache::Path PathCache::get(const Key &ikey) {
+  std::string directory;
+
+  {
+    std::scoped_lock lock(mutex);
+
+    if (auto entry = entries.find(ikey.hash); entry != entries.end()) {
+      if (entry->second.inputs == ikey.inputs) {
+        lru.splice(lru.begin(), lru, entry->second.lruPosition);
+        ++hits;
+        return entry->second.path;
+      }
+
+      LOG_DEBUG_S("PathCache: Ignoring a cached path whose hash collides with the lookup");
+    }
+
+    directory = persistenceDirectory;
+  }
+
+  if (!directory.empty()) {
+    // Don't hold the lock while reading from the SD card
+    std::ifstream file(makeFileName(directory, ikey), std::ifstream::in | std::ifstream::binary);
+    if (file.good()) {
+      if (!readInputs(file, ikey.inputs)) {
+        LOG_DEBUG_S("PathCache: Ignoring a persisted path whose inputs don't match the lookup");
+      } else if (auto path = BinaryPathFormat::read(file); path) {
+        auto shared = std::make_shared<const std::vector<squiggles::ProfilePoint>>(
+          std::move(path.value()));
+
+        std::scoped_lock lock(mutex);
+        insert(ikey, shared);
+        ++hits;
+        return shared;
+      } else {
+        LOG_WARN("PathCache: Ignoring corrupt cache file " + makeFileName(directory, ikey));
+      }
+    }
+  }
+
+  std::scoped_lock lock(mutex);
+  ++misses;
+  return nullptr;
+}
+
+void PathCache::put(const Key &ikey, Path ipath) {
+  if (!ipath) {
+    return;
+  }
+
+  std::string directory;
+
+  {
+    std::scoped_lock lock(mutex);
+    insert(ikey, ipath);
+    directory = persistenceDirectory;
+  }
+
+  if (!directory.empty()) {
+    std::ofstream file(makeFileName(directory, ikey), std::ofstream::out | std::ofstream::binary);
+    if (file.good()) {
+      writeInputs(file, ikey.inputs);
+      BinaryPathFormat::write(file, *ipath);
+    } else {
+      LOG_WARN("PathCache: Couldn't open file " + makeFileName(directory, ikey) + " for writing");
+    }
+  }
+}
+
+void PathCache::setPersistenceDirectory(const std::string &idirectory) {
+  std::scoped_lock lock(mutex);
+  persistenceDirectory = idirectory;
+  if (!persistenceDirectory.empty() && persistenceDirectory.back() == '/') {
+    persistenceDirectory.pop_back();
+  }
+}
+
+void PathCache::clear() {
+  std::scoped_lock lock(mutex);
+  entries.clear();
+  lru.clear();
+  bytesUsed = 0;
+}
+
+std::size_t PathCache::getHits() const {
+  std::scoped_lock lock(mutex);
+  return hits;
+}
+
+std::size_t PathCache::getMisses() const {
+  std::scoped_lock lock(mutex);
+  return misses;
+}
+
+std::size_t PathCache::size() const {
+  std::scoped_lock lock(mutex);
+  return entries.size();
+}
+
+std::size_t PathCache::getBytesUsed() const {
+  std::scoped_lock lock(mutex);
+  return bytesUsed;
+}
+
+std::size_t PathCache::getMaxBytes() const {
+  return maxBytes;
+}
+
+std::size_t PathCache::estimateBytes(const std::vector<squiggles::ProfilePoint> &ipath) {
+  return StoredPath::estimateBytes(ipath);
+}
+
+void PathCache::insert(const Key &ikey, Path ipath) {
+  const std::size_t bytes = estimateBytes(*ipath) + ikey.inputs.size();
+
+  // One entry per hash, so a colliding path replaces the old one
+  if (auto existing = entries.find(ikey.hash); existing != entries.end()) {
+    bytesUsed -= existing->second.bytes;
+    lru.erase(existing->second.lruPosition);
+    entries.erase(existing);
+  }
+
+  if (bytes > maxBytes) {
+    LOG_DEBUG("PathCache: Not keeping a path of " + std::to_string(bytes) +
+              " bytes in memory because it is larger than the budget");
+    return;
+  }
+
+  while (bytesUsed + bytes > maxBytes && !lru.empty()) {
+    auto evicted = entries.find(lru.back());
+    bytesUsed -= evicted->second.bytes;
+    entries.erase(evicted);
+    lru.pop_back();
+  }
+
+  lru.push_front(ikey.hash);
+  entries.emplace(ikey.hash, Entry{ikey.inputs, std::move(ipath), bytes, lru.begin()});
+  bytesUsed += bytes;
+}
+
+std::string PathCache::makeFileName(const std::string &idirectory, const Key &ikey) {
+  static const char *hexDigits = "0123456789abcdef";
+
+  std::string name(16, '0');
+  for (int i = 15; i >= 0; --i) {
+    name[static_cast<std::size_t>(i)] = hexDigits[(ikey.hash >> (4 * (15 - i))) & 0xF];
+  }
+
+  return idirectory + "/" + name + ".bin";
+}
+} // namespace okapi
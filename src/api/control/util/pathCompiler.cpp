@@ -0,0 +1,185 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pathCompiler.hpp"
+#include "okapi/api/control/util/splineProfile.hpp"
+#include "okapi/api/units/QAngle.hpp"
+#include <cmath>
+#include <iomanip>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace okapi {
+namespace {
+std::invalid_argument manifestError(const std::size_t iline, const std::string &imessage) {
+  return std::invalid_argument("PathCompiler: Line " + std::to_string(iline) + ": " + imessage);
+}
+
+std::string escape(const std::string &istring) {
+  std::string out;
+  for (const char c : istring) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+  return out;
+}
+
+void emitValue(std::ostream &iout, const double ivalue, const std::string &ipathId) {
+  if (!std::isfinite(ivalue)) {
+    throw std::invalid_argument("PathCompiler: Path " + ipathId + " contains a non-finite value.");
+  }
+
+  iout << ivalue;
+}
+} // namespace
+
+PathManifest PathCompiler::parseManifest(std::istream &imanifest) {
+  PathManifest manifest;
+  std::set<std::string> ids;
+  bool hasLimits = false;
+  PathfinderLimits limits{0, 0, 0};
+
+  std::string line;
+  for (std::size_t lineNumber = 1; std::getline(imanifest, line); ++lineNumber) {
+    if (const auto comment = line.find('#'); comment != std::string::npos) {
+      line.erase(comment);
+    }
+
+    std::istringstream tokens(line);
+    std::string directive;
+    if (!(tokens >> directive)) {
+      continue;
+    }
+
+    if (directive == "wheelTrack") {
+      double track;
+      if (!(tokens >> track) || !(track > 0)) {
+        throw manifestError(lineNumber, "wheelTrack needs a positive length in meters.");
+      }
+      manifest.wheelTrack = track * meter;
+    } else if (directive == "limits") {
+      if (!(tokens >> limits.maxVel >> limits.maxAccel >> limits.maxJerk)) {
+        throw manifestError(lineNumber, "limits needs a max velocity, acceleration, and jerk.");
+      }
+      hasLimits = true;
+    } else if (directive == "path") {
+      PathManifest::Entry entry;
+      if (!(tokens >> entry.id)) {
+        throw manifestError(lineNumber, "path needs an ID.");
+      }
+
+      if (!hasLimits) {
+        throw manifestError(lineNumber, "path " + entry.id + " comes before any limits.");
+      }
+
+      if (!ids.insert(entry.id).second) {
+        throw manifestError(lineNumber, "path " + entry.id + " was already declared.");
+      }
+
+      double x, y, theta;
+      while (tokens >> x) {
+        if (!(tokens >> y >> theta)) {
+          throw manifestError(lineNumber,
+                              "path " + entry.id + " has a waypoint without an x, y, and theta.");
+        }
+        entry.waypoints.push_back({x * meter, y * meter, theta * degree});
+      }
+
+      if (!tokens.eof()) {
+        throw manifestError(lineNumber,
+                            "path " + entry.id + " has a waypoint which isn't a number.");
+      }
+
+      if (entry.waypoints.empty()) {
+        throw manifestError(lineNumber, "path " + entry.id + " has no waypoints.");
+      }
+
+      entry.limits = limits;
+      manifest.paths.push_back(std::move(entry));
+    } else {
+      throw manifestError(lineNumber, "Unknown directive " + directive + ".");
+    }
+  }
+
+  if (manifest.wheelTrack == 0_m && !manifest.paths.empty()) {
+    throw std::invalid_argument("PathCompiler: The manifest has no wheelTrack.");
+  }
+
+  return manifest;
+}
+
+void PathCompiler::emitHeader(std::ostream &iout,
+                              const PathManifest &imanifest,
+                              const std::string &inamespace,
+                              const double idt) {
+  if (imanifest.paths.empty()) {
+    throw std::invalid_argument("PathCompiler: The manifest has no paths.");
+  }
+
+  std::ostringstream out;
+  out << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+  out << "// Generated by the OkapiLib path compiler. Do not edit.\n"
+      << "#pragma once\n\n"
+      << "#include \"okapi/api/control/util/pathView.hpp\"\n\n"
+      << "namespace " << inamespace << " {\n";
+
+  for (std::size_t i = 0; i < imanifest.paths.size(); ++i) {
+    const auto &entry = imanifest.paths[i];
+    const auto profile =
+      SplineProfile::generate(entry.waypoints, entry.limits, imanifest.wheelTrack, idt);
+
+    if (profile.empty()) {
+      throw std::invalid_argument("PathCompiler: Path " + entry.id + " has no points.");
+    }
+
+    out << "// " << entry.id << "\n"
+        << "inline constexpr okapi::StaticPathPoint path" << i << "Points[] = {\n";
+    for (const auto &point : profile) {
+      if (point.wheel_velocities.size() != 2) {
+        throw std::invalid_argument("PathCompiler: Path " + entry.id +
+                                    " does not have exactly two wheel velocities.");
+      }
+
+      const double values[] = {point.vector.pose.x,
+                               point.vector.pose.y,
+                               point.vector.pose.yaw,
+                               point.vector.vel,
+                               point.vector.accel,
+                               point.vector.jerk,
+                               point.curvature,
+                               point.time};
+      out << "  {";
+      for (const double value : values) {
+        emitValue(out, value, entry.id);
+        out << ", ";
+      }
+      out << "{";
+      emitValue(out, point.wheel_velocities[0], entry.id);
+      out << ", ";
+      emitValue(out, point.wheel_velocities[1], entry.id);
+      out << "}},\n";
+    }
+    out << "};\n\n";
+  }
+
+  out << "inline constexpr okapi::NamedPathView paths[] = {\n";
+  for (std::size_t i = 0; i < imanifest.paths.size(); ++i) {
+    out << "  {\"" << escape(imanifest.paths[i].id) << "\", okapi::PathView(path" << i
+        << "Points)},\n";
+  }
+  out << "};\n"
+      << "} // namespace " << inamespace << "\n";
+
+  // Only write the header once every path compiled so a failure never leaves half a header
+  iout << out.str();
+}
+} // namespace okapi
@@ -0,0 +1,62 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pathGenerationHandle.hpp"
+
+namespace okapi {
+PathGenerationHandle::PathGenerationHandle(std::string ipathId, const TimeUtil &itimeUtil)
+  : pathId(std::move(ipathId)), timeUtil(itimeUtil) {
+}
+
+const std::string &PathGenerationHandle::getPathId() const {
+  return pathId;
+}
+
+PathGenerationHandle::State PathGenerationHandle::getState() const {
+  return state.load(std::memory_order_acquire);
+}
+
+bool PathGenerationHandle::isDone() const {
+  const auto currentState = getState();
+  return currentState == State::done || currentState == State::failed ||
+         currentState == State::superseded;
+}
+
+bool PathGenerationHandle::waitUntilDone() const {
+  auto rate = timeUtil.getRate();
+  while (!isDone()) {
+    rate->delayUntil(1_ms);
+  }
+
+  return getState() == State::done;
+}
+
+std::string PathGenerationHandle::getErrorMessage() const {
+  if (getState() == State::failed) {
+    return errorMessage;
+  }
+
+  return "";
+}
+
+void PathGenerationHandle::markGenerating() {
+  // Don't bring a handle which was superseded while it was queued back to life
+  auto expected = State::queued;
+  state.compare_exchange_strong(expected, State::generating, std::memory_order_acq_rel);
+}
+
+void PathGenerationHandle::markDone() {
+  state.store(State::done, std::memory_order_release);
+}
+
+void PathGenerationHandle::markFailed(const std::string &ierrorMessage) {
+  errorMessage = ierrorMessage;
+  state.store(State::failed, std::memory_order_release);
+}
+
+void PathGenerationHandle::markSuperseded() {
+  state.store(State::superseded, std::memory_order_release);
+}
+} // namespace okapi
@@ -0,0 +1,123 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pathTable.hpp"
+#include "okapi/api/control/util/linearPath.hpp"
+#include "okapi/api/control/util/synchronizedProfile.hpp"
+
+namespace okapi {
+template <typename Path> PathHandle BasicPathTable<Path>::intern(const std::string &iname) {
+  if (auto handle = handles.find(iname); handle != handles.end()) {
+    return handle->second;
+  }
+
+  const PathHandle handle(static_cast<std::uint32_t>(slots.size()));
+  slots.push_back(Slot{iname});
+  handles.emplace(iname, handle);
+  return handle;
+}
+
+template <typename Path> PathHandle BasicPathTable<Path>::addUnnamed() {
+  const PathHandle handle(static_cast<std::uint32_t>(slots.size()));
+  slots.push_back(Slot{});
+  return handle;
+}
+
+template <typename Path> PathHandle BasicPathTable<Path>::find(const std::string &iname) const {
+  if (auto handle = handles.find(iname); handle != handles.end()) {
+    return handle->second;
+  }
+
+  return PathHandle();
+}
+
+template <typename Path>
+const std::string &BasicPathTable<Path>::getName(const PathHandle ihandle) const {
+  static const std::string empty;
+
+  if (const auto slot = findSlot(ihandle); slot) {
+    return slot->name;
+  }
+
+  return empty;
+}
+
+template <typename Path>
+typename BasicPathTable<Path>::PathPtr BasicPathTable<Path>::get(const PathHandle ihandle) const {
+  if (const auto slot = findSlot(ihandle); slot) {
+    return slot->path;
+  }
+
+  return nullptr;
+}
+
+template <typename Path>
+void BasicPathTable<Path>::set(const PathHandle ihandle, PathPtr ipath) {
+  slots.at(ihandle.getIndex()).path = std::move(ipath);
+}
+
+template <typename Path>
+std::shared_ptr<PathGenerationHandle>
+BasicPathTable<Path>::getPending(const PathHandle ihandle) const {
+  if (const auto slot = findSlot(ihandle); slot) {
+    return slot->pending;
+  }
+
+  return nullptr;
+}
+
+template <typename Path>
+void BasicPathTable<Path>::setPending(const PathHandle ihandle,
+                                      std::shared_ptr<PathGenerationHandle> ipending) {
+  slots.at(ihandle.getIndex()).pending = std::move(ipending);
+}
+
+template <typename Path> std::vector<std::string> BasicPathTable<Path>::getNames() const {
+  std::vector<std::string> names;
+
+  // The map is sorted by name
+  for (const auto &handle : handles) {
+    if (slots[handle.second.getIndex()].path) {
+      names.push_back(handle.first);
+    }
+  }
+
+  return names;
+}
+
+template <typename Path>
+std::vector<std::shared_ptr<PathGenerationHandle>> BasicPathTable<Path>::getAllPending() const {
+  std::vector<std::shared_ptr<PathGenerationHandle>> pending;
+
+  for (const auto &slot : slots) {
+    if (slot.pending) {
+      pending.push_back(slot.pending);
+    }
+  }
+
+  return pending;
+}
+
+template <typename Path> void BasicPathTable<Path>::clear() {
+  for (auto &slot : slots) {
+    slot.path = nullptr;
+    slot.pending = nullptr;
+  }
+}
+
+template <typename Path>
+const typename BasicPathTable<Path>::Slot *
+BasicPathTable<Path>::findSlot(const PathHandle ihandle) const {
+  if (ihandle.getIndex() < slots.size()) {
+    return &slots[ihandle.getIndex()];
+  }
+
+  return nullptr;
+}
+
+template class BasicPathTable<StoredPath>;
+template class BasicPathTable<LinearPath>;
+template class BasicPathTable<SynchronizedProfile>;
+} // namespace okapi
@@ -0,0 +1,154 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pathTransform.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace okapi {
+namespace {
+/**
+ * Rotates a pose about the origin and then moves it, all in the frame of the path.
+ */
+void moveRigidly(squiggles::Pose &ipose, const double iangle, const double idx, const double idy) {
+  const double cos = std::cos(iangle);
+  const double sin = std::sin(iangle);
+  const double x = ipose.x;
+  const double y = ipose.y;
+  ipose.x = cos * x - sin * y + idx;
+  ipose.y = sin * x + cos * y + idy;
+  ipose.yaw += iangle;
+}
+
+/**
+ * @return The largest change in velocity the path makes in one of its timesteps.
+ */
+double maxVelocityStep(const std::vector<squiggles::ProfilePoint> &ipath) {
+  if (ipath.size() < 2) {
+    return 0;
+  }
+
+  double maxAccel = 0;
+  for (const auto &point : ipath) {
+    maxAccel = std::max(maxAccel, std::abs(point.vector.accel));
+  }
+
+  return maxAccel * (ipath[1].time - ipath[0].time);
+}
+} // namespace
+
+std::vector<squiggles::ProfilePoint>
+PathTransform::transform(std::vector<squiggles::ProfilePoint> ipath,
+                         const PathfinderPoint &iorigin) {
+  // Paths have x and y swapped and their heading counterclockwise from x, so a clockwise turn of
+  // theta is a rotation by -theta
+  const double angle = -iorigin.theta.convert(radian);
+  const double dx = iorigin.y.convert(meter);
+  const double dy = iorigin.x.convert(meter);
+
+  for (auto &point : ipath) {
+    moveRigidly(point.vector.pose, angle, dx, dy);
+  }
+
+  return ipath;
+}
+
+std::vector<squiggles::ProfilePoint>
+PathTransform::mirror(std::vector<squiggles::ProfilePoint> ipath, const PathfinderPoint &iaxis) {
+  // Reflect across the line through the axis point at the axis heading, in the frame of the path
+  const double heading = (90_deg - iaxis.theta).convert(radian);
+  const double cos = std::cos(2 * heading);
+  const double sin = std::sin(2 * heading);
+  const double centerX = iaxis.y.convert(meter);
+  const double centerY = iaxis.x.convert(meter);
+
+  for (auto &point : ipath) {
+    auto &pose = point.vector.pose;
+    const double x = pose.x - centerX;
+    const double y = pose.y - centerY;
+    pose.x = centerX + cos * x + sin * y;
+    pose.y = centerY + sin * x - cos * y;
+    pose.yaw = 2 * heading - pose.yaw;
+
+    // A reflection turns the other way, so the wheels trade places
+    point.curvature = -point.curvature;
+    if (point.wheel_velocities.size() == 2) {
+      std::swap(point.wheel_velocities[0], point.wheel_velocities[1]);
+    }
+  }
+
+  return ipath;
+}
+
+std::vector<squiggles::ProfilePoint>
+PathTransform::reverse(std::vector<squiggles::ProfilePoint> ipath) {
+  if (ipath.empty()) {
+    return ipath;
+  }
+
+  const double duration = ipath.back().time;
+  std::reverse(ipath.begin(), ipath.end());
+
+  // Playing the path backwards in time negates every odd derivative of position. Curvature is the
+  // ratio of the angular and linear velocities, which are both negated, so it is unchanged.
+  for (auto &point : ipath) {
+    point.vector.vel = -point.vector.vel;
+    point.vector.jerk = -point.vector.jerk;
+    for (auto &velocity : point.wheel_velocities) {
+      velocity = -velocity;
+    }
+    point.time = duration - point.time;
+  }
+
+  return ipath;
+}
+
+std::vector<squiggles::ProfilePoint>
+PathTransform::stitch(std::vector<squiggles::ProfilePoint> ifirst,
+                      const std::vector<squiggles::ProfilePoint> &isecond,
+                      const double imaxVelocityJump) {
+  if (isecond.empty()) {
+    return ifirst;
+  } else if (ifirst.empty()) {
+    return isecond;
+  }
+
+  const auto end = ifirst.back();
+  const auto &start = isecond.front();
+
+  if (std::abs(end.vector.vel - start.vector.vel) > imaxVelocityJump) {
+    throw std::invalid_argument(
+      "PathTransform: Can't stitch a path ending at " + std::to_string(end.vector.vel) +
+      " m/s to a path starting at " + std::to_string(start.vector.vel) + " m/s.");
+  }
+
+  // Rotate the second path about its start so it leaves with the heading the first path ends
+  // with, then move its start onto the end of the first path
+  const double angle = end.vector.pose.yaw - start.vector.pose.yaw;
+  const double cos = std::cos(angle);
+  const double sin = std::sin(angle);
+  const double dx = end.vector.pose.x - (cos * start.vector.pose.x - sin * start.vector.pose.y);
+  const double dy = end.vector.pose.y - (sin * start.vector.pose.x + cos * start.vector.pose.y);
+
+  ifirst.reserve(ifirst.size() + isecond.size() - 1);
+  for (std::size_t i = 1; i < isecond.size(); ++i) {
+    auto point = isecond[i];
+    moveRigidly(point.vector.pose, angle, dx, dy);
+    point.time = end.time + point.time - start.time;
+    ifirst.push_back(std::move(point));
+  }
+
+  return ifirst;
+}
+
+std::vector<squiggles::ProfilePoint>
+PathTransform::stitch(std::vector<squiggles::ProfilePoint> ifirst,
+                      const std::vector<squiggles::ProfilePoint> &isecond) {
+  const double maxVelocityJump = std::max(maxVelocityStep(ifirst), maxVelocityStep(isecond));
+  return stitch(std::move(ifirst), isecond, maxVelocityJump);
+}
+} // namespace okapi
@@ -0,0 +1,30 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/ramsete.hpp"
+#include "okapi/api/units/RQuantity.hpp"
+#include <cmath>
+
+namespace okapi {
+Ramsete::Command Ramsete::calculate(const squiggles::Pose &ireference,
+                                    const double ilinear,
+                                    const double iangular,
+                                    const squiggles::Pose &iactual,
+                                    const RamseteGains &igains) {
+  // Rotate the error into the robot's frame so x is along the robot and y is to its left
+  const double dx = ireference.x - iactual.x;
+  const double dy = ireference.y - iactual.y;
+  const double errorX = std::cos(iactual.yaw) * dx + std::sin(iactual.yaw) * dy;
+  const double errorY = -std::sin(iactual.yaw) * dx + std::cos(iactual.yaw) * dy;
+  const double errorYaw = std::remainder(ireference.yaw - iactual.yaw, static_cast<double>(2_pi));
+
+  const double k =
+    2 * igains.zeta * std::sqrt(iangular * iangular + igains.b * ilinear * ilinear);
+  const double sinc = std::abs(errorYaw) < 1e-9 ? 1 : std::sin(errorYaw) / errorYaw;
+
+  return {ilinear * std::cos(errorYaw) + k * errorX,
+          iangular + k * errorYaw + igains.b * ilinear * sinc * errorY};
+}
+} // namespace okapi
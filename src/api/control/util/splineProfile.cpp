@@ -0,0 +1,39 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/splineProfile.hpp"
+#include "okapi/api/units/QAngle.hpp"
+#include <memory>
+
+namespace okapi {
+std::vector<squiggles::ProfilePoint>
+SplineProfile::generate(const std::vector<PathfinderPoint> &iwaypoints,
+                        const PathfinderLimits &ilimits,
+                        const QLength &iwheelTrack,
+                        const double idt,
+                        const double istartVel,
+                        const double iendVel) {
+  std::vector<squiggles::ControlVector> points;
+  points.reserve(iwaypoints.size());
+  for (auto &point : iwaypoints) {
+    points.emplace_back(squiggles::Pose{
+      point.y.convert(meter), point.x.convert(meter), (90_deg - point.theta).convert(radian)});
+  }
+
+  // Only override the velocities at the ends when they were asked for so the generator keeps its
+  // own defaults otherwise
+  if (!points.empty() && (istartVel != 0 || iendVel != 0)) {
+    points.front().vel = istartVel;
+    points.back().vel = iendVel;
+  }
+
+  auto constraints = squiggles::Constraints(ilimits.maxVel, ilimits.maxAccel, ilimits.maxJerk);
+  auto splineGenerator = squiggles::SplineGenerator(
+    constraints,
+    std::make_shared<squiggles::TankModel>(iwheelTrack.convert(meter), constraints),
+    idt);
+  return splineGenerator.generate(points);
+}
+} // namespace okapi
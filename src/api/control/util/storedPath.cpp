@@ -0,0 +1,122 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/storedPath.hpp"
+
+namespace okapi {
+StoredPath::StoredPath(std::vector<squiggles::ProfilePoint> iprofile,
+                       std::vector<MotorCommand> icommands)
+  : points(std::move(iprofile)), commands(std::move(icommands)) {
+}
+
+StoredPath::StoredPath(CompactTrajectory icompact, std::vector<MotorCommand> icommands)
+  : points(std::move(icompact)), commands(std::move(icommands)) {
+}
+
+StoredPath::StoredPath(const PathView iview) : points(iview) {
+}
+
+std::size_t StoredPath::size() const {
+  if (const auto compact = std::get_if<CompactTrajectory>(&points)) {
+    return compact->size();
+  } else if (const auto view = std::get_if<PathView>(&points)) {
+    return view->size();
+  }
+
+  return getProfile().size();
+}
+
+bool StoredPath::isCompact() const {
+  return std::holds_alternative<CompactTrajectory>(points);
+}
+
+bool StoredPath::isView() const {
+  return std::holds_alternative<PathView>(points);
+}
+
+const std::vector<squiggles::ProfilePoint> &StoredPath::getProfile() const {
+  return std::get<std::vector<squiggles::ProfilePoint>>(points);
+}
+
+const CompactTrajectory &StoredPath::getCompact() const {
+  return std::get<CompactTrajectory>(points);
+}
+
+const PathView &StoredPath::getView() const {
+  return std::get<PathView>(points);
+}
+
+double StoredPath::getWheelVelocity(const std::size_t iwheel, const std::size_t iindex) const {
+  if (const auto compact = std::get_if<CompactTrajectory>(&points)) {
+    return compact->getWheelVelocity(iwheel, iindex);
+  } else if (const auto view = std::get_if<PathView>(&points)) {
+    return (*view)[iindex].wheelVelocities[iwheel];
+  }
+
+  return getProfile()[iindex].wheel_velocities[iwheel];
+}
+
+squiggles::Pose StoredPath::getPose(const std::size_t iindex) const {
+  if (const auto compact = std::get_if<CompactTrajectory>(&points)) {
+    return {compact->get(CompactTrajectory::Field::x, iindex),
+            compact->get(CompactTrajectory::Field::y, iindex),
+            compact->get(CompactTrajectory::Field::yaw, iindex)};
+  } else if (const auto view = std::get_if<PathView>(&points)) {
+    const auto &point = (*view)[iindex];
+    return {point.x, point.y, point.yaw};
+  }
+
+  return getProfile()[iindex].vector.pose;
+}
+
+std::vector<squiggles::ProfilePoint> StoredPath::toProfile() const {
+  if (const auto compact = std::get_if<CompactTrajectory>(&points)) {
+    return compact->toProfile();
+  } else if (const auto view = std::get_if<PathView>(&points)) {
+    std::vector<squiggles::ProfilePoint> out;
+    out.reserve(view->size());
+    for (std::size_t i = 0; i < view->size(); ++i) {
+      const auto &point = (*view)[i];
+      out.emplace_back(squiggles::ControlVector(squiggles::Pose(point.x, point.y, point.yaw),
+                                                point.vel,
+                                                point.accel,
+                                                point.jerk),
+                       std::vector<double>{point.wheelVelocities[0], point.wheelVelocities[1]},
+                       point.curvature,
+                       point.time);
+    }
+    return out;
+  }
+
+  return getProfile();
+}
+
+std::size_t StoredPath::getBytesUsed() const {
+  std::size_t pointBytes = 0;
+  if (const auto compact = std::get_if<CompactTrajectory>(&points)) {
+    pointBytes = compact->getBytesUsed() - sizeof(CompactTrajectory);
+  } else if (!isView()) {
+    pointBytes = estimateBytes(getProfile()) - sizeof(std::vector<squiggles::ProfilePoint>);
+  }
+
+  return sizeof(StoredPath) + pointBytes + commands.capacity() * sizeof(MotorCommand);
+}
+
+bool StoredPath::hasCommands() const {
+  return !commands.empty();
+}
+
+const MotorCommand *StoredPath::getCommands(const bool imirrored, const bool ireversed) const {
+  return commands.data() + commandOffset(imirrored, ireversed, size());
+}
+
+std::size_t StoredPath::estimateBytes(const std::vector<squiggles::ProfilePoint> &iprofile) {
+  std::size_t bytes = sizeof(std::vector<squiggles::ProfilePoint>);
+  for (const auto &point : iprofile) {
+    bytes += sizeof(squiggles::ProfilePoint) + point.wheel_velocities.capacity() * sizeof(double);
+  }
+  return bytes;
+}
+} // namespace okapi
@@ -0,0 +1,57 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/streamingPath.hpp"
+#include <mutex>
+
+namespace okapi {
+StreamingPath::StreamingPath(const std::size_t ichunkCount, const QTime ileadTime)
+  : chunkCount(ichunkCount), leadTime(ileadTime) {
+  chunks.reserve(chunkCount);
+}
+
+void StreamingPath::append(StoredPathPtr ichunk) {
+  std::scoped_lock lock(mutex);
+  if (chunks.size() < chunkCount) {
+    availablePoints += ichunk->size();
+    chunks.emplace_back(std::move(ichunk));
+  }
+}
+
+void StreamingPath::markFailed() {
+  failed.store(true, std::memory_order_release);
+}
+
+StoredPathPtr StreamingPath::getChunk(const std::size_t iindex) const {
+  std::scoped_lock lock(mutex);
+  return iindex < chunks.size() ? chunks[iindex] : nullptr;
+}
+
+std::size_t StreamingPath::getChunkCount() const {
+  return chunkCount;
+}
+
+std::size_t StreamingPath::getAvailableChunkCount() const {
+  std::scoped_lock lock(mutex);
+  return chunks.size();
+}
+
+std::size_t StreamingPath::getAvailablePointCount() const {
+  std::scoped_lock lock(mutex);
+  return availablePoints;
+}
+
+bool StreamingPath::isComplete() const {
+  return getAvailableChunkCount() == chunkCount;
+}
+
+bool StreamingPath::hasFailed() const {
+  return failed.load(std::memory_order_acquire);
+}
+
+QTime StreamingPath::getLeadTime() const {
+  return leadTime;
+}
+} // namespace okapi
@@ -0,0 +1,58 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/synchronizedProfile.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace okapi {
+SynchronizedProfile::SynchronizedProfile(const LinearProfileShape ishape,
+                                         const std::vector<LinearMove> &imoves,
+                                         const std::vector<PathfinderLimits> &ilimits) {
+  if (imoves.empty()) {
+    throw std::invalid_argument("SynchronizedProfile: There must be at least one axis.");
+  }
+
+  if (imoves.size() != ilimits.size()) {
+    throw std::invalid_argument("SynchronizedProfile: Got " + std::to_string(imoves.size()) +
+                                " moves but limits for " + std::to_string(ilimits.size()) +
+                                " axes.");
+  }
+
+  profiles.reserve(imoves.size());
+  for (std::size_t i = 0; i < imoves.size(); ++i) {
+    profiles.emplace_back(ishape, imoves[i].start, imoves[i].end, ilimits[i]);
+    if (profiles[i].getDuration() > duration) {
+      duration = profiles[i].getDuration();
+      limitingAxis = i;
+    }
+  }
+
+  // Any axis can be slowed down to match a slower one, so the slowest axis sets the duration
+  for (auto &profile : profiles) {
+    profile = profile.stretchedTo(duration);
+  }
+}
+
+LinearProfile::State SynchronizedProfile::sample(const std::size_t iaxis, const QTime itime) const {
+  return profiles[iaxis].sample(itime);
+}
+
+QTime SynchronizedProfile::getDuration() const {
+  return duration;
+}
+
+std::size_t SynchronizedProfile::getAxisCount() const {
+  return profiles.size();
+}
+
+const LinearProfile &SynchronizedProfile::getProfile(const std::size_t iaxis) const {
+  return profiles[iaxis];
+}
+
+std::size_t SynchronizedProfile::getLimitingAxis() const {
+  return limitingAxis;
+}
+} // namespace okapi
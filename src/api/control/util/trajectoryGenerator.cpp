@@ -0,0 +1,326 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/trajectoryGenerator.hpp"
+#include "okapi/api/units/RQuantity.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace okapi {
+namespace {
+// Velocities closer than this are treated as equal when checking whether a path is possible
+constexpr double velocityTolerance = 1e-6;
+
+/**
+ * The coefficients of a quintic with the given value and first derivative at each end and a
+ * second derivative of zero at both ends.
+ */
+struct Quintic {
+  Quintic(const double ip0, const double id0, const double ip1, const double id1)
+    : c0(ip0),
+      c1(id0),
+      c3(10 * (ip1 - ip0) - 6 * id0 - 4 * id1),
+      c4(-15 * (ip1 - ip0) + 8 * id0 + 7 * id1),
+      c5(6 * (ip1 - ip0) - 3 * id0 - 3 * id1) {
+  }
+
+  double value(const double t) const {
+    return c0 + t * (c1 + t * t * (c3 + t * (c4 + t * c5)));
+  }
+
+  double first(const double t) const {
+    return c1 + t * t * (3 * c3 + t * (4 * c4 + t * 5 * c5));
+  }
+
+  double second(const double t) const {
+    return t * (6 * c3 + t * (12 * c4 + t * 20 * c5));
+  }
+
+  double c0, c1, c3, c4, c5;
+};
+} // namespace
+
+TrajectoryGenerator::TrajectoryGenerator(const PathfinderLimits &ilimits,
+                                         const QLength &iwheelTrack,
+                                         const double idt,
+                                         const std::size_t icapacity)
+  : limits(ilimits),
+    halfTrack(iwheelTrack.convert(meter) / 2),
+    dt(idt),
+    points(icapacity,
+           squiggles::ProfilePoint(squiggles::ControlVector(squiggles::Pose(0, 0, 0), 0, 0, 0),
+                                   std::vector<double>{0, 0},
+                                   0,
+                                   0)) {
+  if (idt <= 0) {
+    throw std::invalid_argument("TrajectoryGenerator: The timestep must be positive.");
+  }
+
+  if (ilimits.maxVel <= 0 || ilimits.maxAccel <= 0) {
+    throw std::invalid_argument(
+      "TrajectoryGenerator: The max velocity and acceleration must be positive.");
+  }
+}
+
+std::size_t TrajectoryGenerator::generate(const std::vector<PathfinderPoint> &iwaypoints,
+                                          const double istartVel,
+                                          const double iendVel) {
+  if (iwaypoints.size() < 2) {
+    throw std::invalid_argument("TrajectoryGenerator: A path needs at least two waypoints.");
+  }
+
+  waypoints = iwaypoints;
+  startVel = istartVel;
+  endVel = iendVel;
+
+  // Only the sample buffers depend on the number of waypoints, so they only grow when it changes
+  const auto segments = waypoints.size() - 1;
+  samples.resize(segments * (samplesPerSegment + 1));
+  velocities.resize(segments * samplesPerSegment + 1);
+  times.resize(velocities.size());
+
+  for (std::size_t segment = 0; segment < segments; ++segment) {
+    buildSegment(segment);
+  }
+  rebuiltSegments = segments;
+
+  return parameterize();
+}
+
+std::size_t TrajectoryGenerator::setWaypoint(const std::size_t iindex,
+                                             const PathfinderPoint &iwaypoint) {
+  if (iindex >= waypoints.size()) {
+    throw std::invalid_argument("TrajectoryGenerator: There is no waypoint " +
+                                std::to_string(iindex) + " to move.");
+  }
+
+  waypoints[iindex] = iwaypoint;
+
+  // The segments ending and starting at this waypoint are the only ones which use it
+  rebuiltSegments = 0;
+  if (iindex > 0) {
+    buildSegment(iindex - 1);
+    ++rebuiltSegments;
+  }
+  if (iindex + 1 < waypoints.size()) {
+    buildSegment(iindex);
+    ++rebuiltSegments;
+  }
+
+  return parameterize();
+}
+
+std::size_t TrajectoryGenerator::setLimits(const PathfinderLimits &ilimits) {
+  if (ilimits.maxVel <= 0 || ilimits.maxAccel <= 0) {
+    throw std::invalid_argument(
+      "TrajectoryGenerator: The max velocity and acceleration must be positive.");
+  }
+
+  limits = ilimits;
+
+  rebuiltSegments = 0;
+  if (waypoints.empty()) {
+    return 0;
+  }
+
+  return parameterize();
+}
+
+std::size_t TrajectoryGenerator::size() const {
+  return count;
+}
+
+std::size_t TrajectoryGenerator::getCapacity() const {
+  return points.size();
+}
+
+std::size_t TrajectoryGenerator::getRequiredCapacity() const {
+  return requiredCapacity;
+}
+
+const squiggles::ProfilePoint &TrajectoryGenerator::operator[](const std::size_t iindex) const {
+  return points[iindex];
+}
+
+std::vector<squiggles::ProfilePoint> TrajectoryGenerator::toProfile() const {
+  return std::vector<squiggles::ProfilePoint>(points.begin(), points.begin() + count);
+}
+
+std::size_t TrajectoryGenerator::getRebuiltSegmentCount() const {
+  return rebuiltSegments;
+}
+
+void TrajectoryGenerator::buildSegment(const std::size_t isegment) {
+  // Paths have x and y swapped relative to the waypoints and their heading counterclockwise
+  const auto &start = waypoints[isegment];
+  const auto &end = waypoints[isegment + 1];
+  const double x0 = start.y.convert(meter);
+  const double y0 = start.x.convert(meter);
+  const double yaw0 = (90_deg - start.theta).convert(radian);
+  const double x1 = end.y.convert(meter);
+  const double y1 = end.x.convert(meter);
+  const double yaw1 = (90_deg - end.theta).convert(radian);
+
+  const double tangent = tangentScale * std::hypot(x1 - x0, y1 - y0);
+  const Quintic x(x0, tangent * std::cos(yaw0), x1, tangent * std::cos(yaw1));
+  const Quintic y(y0, tangent * std::sin(yaw0), y1, tangent * std::sin(yaw1));
+
+  Sample *out = &samples[isegment * (samplesPerSegment + 1)];
+  double distance = 0;
+  for (std::size_t i = 0; i <= samplesPerSegment; ++i) {
+    const double t = static_cast<double>(i) / samplesPerSegment;
+    const double px = x.value(t);
+    const double py = y.value(t);
+    const double dx = x.first(t);
+    const double dy = y.first(t);
+    const double speed = std::hypot(dx, dy);
+
+    if (i > 0) {
+      distance += std::hypot(px - out[i - 1].x, py - out[i - 1].y);
+    }
+
+    // A segment between two waypoints at the same place has no length or direction, so keep the
+    // heading of its waypoints
+    const bool stationary = speed < 1e-9;
+    out[i] = {px,
+              py,
+              stationary ? yaw0 + (yaw1 - yaw0) * t : std::atan2(dy, dx),
+              stationary ? 0 : (dx * y.second(t) - dy * x.second(t)) / (speed * speed * speed),
+              distance};
+  }
+}
+
+std::size_t TrajectoryGenerator::parameterize() {
+  const std::size_t last = velocities.size() - 1;
+  const double maxAccel = limits.maxAccel;
+  requiredCapacity = 0;
+
+  // The fastest the robot can go at each sample without either wheel going faster than the max
+  // velocity, accelerating forwards from the start velocity
+  velocities[0] = startVel;
+  for (std::size_t i = 1; i <= last; ++i) {
+    const double wheelLimit = limits.maxVel / (1 + std::abs(sampleAt(i).curvature) * halfTrack);
+    const double previous = velocities[i - 1];
+    velocities[i] =
+      std::min(wheelLimit, std::sqrt(previous * previous + 2 * maxAccel * stepDistance(i)));
+  }
+
+  if (velocities[last] < endVel - velocityTolerance) {
+    count = 0;
+    throw std::runtime_error("TrajectoryGenerator: The path is too short to reach the end velocity "
+                             "of " +
+                             std::to_string(endVel) + " m/s.");
+  }
+
+  // Then decelerate backwards from the end velocity
+  velocities[last] = std::min(velocities[last], endVel);
+  for (std::size_t i = last; i > 0; --i) {
+    const double next = velocities[i];
+    velocities[i - 1] =
+      std::min(velocities[i - 1], std::sqrt(next * next + 2 * maxAccel * stepDistance(i)));
+  }
+
+  if (velocities[0] < startVel - velocityTolerance) {
+    count = 0;
+    throw std::runtime_error("TrajectoryGenerator: The path is too short to slow down from the "
+                             "start velocity of " +
+                             std::to_string(startVel) + " m/s.");
+  }
+
+  // The acceleration is constant between samples, so the time between them follows from the
+  // average velocity
+  times[0] = 0;
+  for (std::size_t i = 1; i <= last; ++i) {
+    const double distance = stepDistance(i);
+    const double speed = velocities[i - 1] + velocities[i];
+    if (distance > 0 && speed <= 0) {
+      count = 0;
+      throw std::runtime_error("TrajectoryGenerator: The path stops before it reaches its end.");
+    }
+    times[i] = times[i - 1] + (distance > 0 ? 2 * distance / speed : 0);
+  }
+
+  const double duration = times[last];
+  const auto needed = static_cast<std::size_t>(std::ceil(duration / dt - 1e-9)) + 1;
+  requiredCapacity = needed;
+  if (needed > points.size()) {
+    count = 0;
+    throw std::runtime_error("TrajectoryGenerator: The path needs " + std::to_string(needed) +
+                             " points but the generator only has room for " +
+                             std::to_string(points.size()) + ".");
+  }
+
+  std::size_t sample = 0;
+  double lastAccel = 0;
+  for (std::size_t i = 0; i < needed; ++i) {
+    const double time = std::min(i * dt, duration);
+    while (sample + 1 < last && times[sample + 1] < time) {
+      ++sample;
+    }
+
+    const auto &from = sampleAt(sample);
+    const auto &to = sampleAt(sample + 1);
+    const double distance = stepDistance(sample + 1);
+    const double v0 = velocities[sample];
+    const double v1 = velocities[sample + 1];
+    const double accel = distance > 0 ? (v1 * v1 - v0 * v0) / (2 * distance) : 0;
+    const double elapsed = std::max(time - times[sample], 0.0);
+    const double velocity = std::min(std::max(v0 + accel * elapsed, 0.0), std::max(v0, v1));
+    const double fraction =
+      distance > 0 ? std::clamp((v0 * elapsed + accel * elapsed * elapsed / 2) / distance, 0.0, 1.0)
+                   : 0;
+    const double curvature = from.curvature + (to.curvature - from.curvature) * fraction;
+
+    auto &point = points[i];
+    point.vector.pose.x = from.x + (to.x - from.x) * fraction;
+    point.vector.pose.y = from.y + (to.y - from.y) * fraction;
+    point.vector.pose.yaw =
+      from.yaw + std::remainder(to.yaw - from.yaw, static_cast<double>(2_pi)) * fraction;
+    point.vector.vel = velocity;
+    point.vector.accel = accel;
+    point.vector.jerk = i == 0 ? 0 : (accel - lastAccel) / dt;
+    point.wheel_velocities[0] = velocity * (1 - curvature * halfTrack);
+    point.wheel_velocities[1] = velocity * (1 + curvature * halfTrack);
+    point.curvature = curvature;
+    point.time = time;
+    lastAccel = accel;
+  }
+
+  // The last point is exactly at the end of the path
+  auto &end = points[needed - 1];
+  const auto &endSample = sampleAt(last);
+  end.vector.pose = squiggles::Pose(endSample.x, endSample.y, endSample.yaw);
+  end.vector.vel = velocities[last];
+  end.wheel_velocities[0] = velocities[last] * (1 - endSample.curvature * halfTrack);
+  end.wheel_velocities[1] = velocities[last] * (1 + endSample.curvature * halfTrack);
+  end.curvature = endSample.curvature;
+
+  count = needed;
+  return count;
+}
+
+const TrajectoryGenerator::Sample &TrajectoryGenerator::sampleAt(const std::size_t iindex) const {
+  if (iindex == 0) {
+    return samples[0];
+  }
+
+  const std::size_t segment = (iindex - 1) / samplesPerSegment;
+  const std::size_t offset = (iindex - 1) % samplesPerSegment + 1;
+  return samples[segment * (samplesPerSegment + 1) + offset];
+}
+
+double TrajectoryGenerator::stepDistance(const std::size_t iindex) const {
+  // The first sample of a segment is at distance zero and is skipped, so the step into it is
+  // measured from the start of the segment
+  const auto &sample = sampleAt(iindex);
+  if ((iindex - 1) % samplesPerSegment == 0) {
+    return sample.distance;
+  }
+
+  return sample.distance - sampleAt(iindex - 1).distance;
+}
+} // namespace okapi
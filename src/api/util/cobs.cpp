@@ -0,0 +1,64 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/cobs.hpp"
+
+namespace okapi {
+std::size_t
+Cobs::encode(const std::uint8_t *idata, const std::size_t ilength, std::uint8_t *oencoded) {
+  // Each block starts with a code byte which is one more than the number of bytes before the next
+  // zero. The code byte is filled in once the block ends.
+  std::size_t codeIndex = 0;
+  std::size_t writeIndex = 1;
+  std::uint8_t code = 1;
+
+  for (std::size_t i = 0; i < ilength; ++i) {
+    if (idata[i] == 0) {
+      oencoded[codeIndex] = code;
+      codeIndex = writeIndex++;
+      code = 1;
+    } else {
+      oencoded[writeIndex++] = idata[i];
+      if (++code == 0xFF) {
+        // A full block has no zero after it
+        oencoded[codeIndex] = code;
+        codeIndex = writeIndex++;
+        code = 1;
+      }
+    }
+  }
+
+  oencoded[codeIndex] = code;
+  return writeIndex;
+}
+
+bool Cobs::decode(const std::uint8_t *iencoded,
+                  const std::size_t ilength,
+                  std::uint8_t *odata,
+                  std::size_t &olength) {
+  std::size_t readIndex = 0;
+  olength = 0;
+
+  while (readIndex < ilength) {
+    const std::uint8_t code = iencoded[readIndex++];
+    if (code == 0 || readIndex + code - 1 > ilength) {
+      return false;
+    }
+
+    for (std::uint8_t i = 1; i < code; ++i) {
+      if (iencoded[readIndex] == 0) {
+        return false;
+      }
+      odata[olength++] = iencoded[readIndex++];
+    }
+
+    if (code != 0xFF && readIndex != ilength) {
+      odata[olength++] = 0;
+    }
+  }
+
+  return true;
+}
+} // namespace okapi
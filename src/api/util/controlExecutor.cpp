@@ -0,0 +1,189 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/controlExecutor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+namespace okapi {
+namespace {
+// How long to sleep when there are no loops
+constexpr std::uint32_t idlePeriod = 10;
+} // namespace
+
+ControlExecutor::ControlExecutor(const TimeUtil &itimeUtil,
+                                 const std::shared_ptr<Logger> &ilogger)
+  : logger(ilogger), timeUtil(itimeUtil), timer(itimeUtil.getTimer()) {
+}
+
+ControlExecutor::~ControlExecutor() {
+  dtorCalled.store(true, std::memory_order_release);
+  delete task;
+}
+
+std::uint32_t ControlExecutor::add(const std::string &iname,
+                                   const QTime iperiod,
+                                   std::function<void()> istep) {
+  const auto period = toPeriod(iperiod);
+
+  std::scoped_lock lock(loopMutex);
+  const auto id = nextId++;
+  loops.push_back(std::make_shared<Loop>(Loop{id, iname, period, now, std::move(istep)}));
+
+  LOG_INFO("ControlExecutor: Added " + iname + " with a period of " + std::to_string(period) +
+           " ms");
+  return id;
+}
+
+bool ControlExecutor::remove(const std::uint32_t iid) {
+  std::shared_ptr<Loop> removed;
+  {
+    std::scoped_lock lock(loopMutex);
+    const auto loopIt = std::find_if(
+      loops.begin(), loops.end(), [&](const auto &iloop) { return iloop->id == iid; });
+    if (loopIt == loops.end()) {
+      return false;
+    }
+
+    removed = *loopIt;
+    removed->removed = true;
+    loops.erase(loopIt);
+  }
+
+  // The step function may be running right now, so wait for it to finish
+  auto rate = timeUtil.getRate();
+  while (isStepping(*removed)) {
+    rate->delayUntil(1_ms);
+  }
+
+  LOG_INFO("ControlExecutor: Removed " + removed->name);
+  return true;
+}
+
+bool ControlExecutor::setPeriod(const std::uint32_t iid, const QTime iperiod) {
+  const auto period = toPeriod(iperiod);
+
+  std::scoped_lock lock(loopMutex);
+  const auto loopIt = std::find_if(
+    loops.begin(), loops.end(), [&](const auto &iloop) { return iloop->id == iid; });
+  if (loopIt == loops.end()) {
+    return false;
+  }
+
+  (*loopIt)->period = period;
+  return true;
+}
+
+QTime ControlExecutor::step() {
+  {
+    std::scoped_lock lock(loopMutex);
+
+    if (!hasStepped) {
+      startTime = timer->millis();
+      hasStepped = true;
+    }
+
+    // The clock only moves to the earliest deadline, so every loop which is due is due now.
+    // Running them in the order they were added keeps their phase the same every run.
+    dueLoops.clear();
+    for (const auto &entry : loops) {
+      if (entry->deadline <= now) {
+        dueLoops.push_back(entry);
+      }
+    }
+  }
+
+  // Run the step functions unlocked so they can change the loops. A loop removed by an earlier
+  // step function in this batch is skipped.
+  for (const auto &entry : dueLoops) {
+    {
+      std::scoped_lock lock(loopMutex);
+      if (entry->removed) {
+        continue;
+      }
+      entry->running = true;
+    }
+
+    entry->step();
+
+    std::scoped_lock lock(loopMutex);
+    entry->running = false;
+    entry->deadline = now + entry->period;
+  }
+  dueLoops.clear();
+
+  std::scoped_lock lock(loopMutex);
+  std::uint32_t next = now + idlePeriod;
+  if (!loops.empty()) {
+    const auto earliest =
+      std::min_element(loops.begin(), loops.end(), [](const auto &a, const auto &b) {
+        return a->deadline < b->deadline;
+      });
+    next = (*earliest)->deadline;
+  }
+
+  if ((timer->millis() - startTime).convert(millisecond) > next) {
+    overrunCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const auto untilNext = next - now;
+  now = next;
+  return untilNext * millisecond;
+}
+
+std::size_t ControlExecutor::getLoopCount() const {
+  std::scoped_lock lock(loopMutex);
+  return loops.size();
+}
+
+std::size_t ControlExecutor::getOverrunCount() const {
+  return overrunCount.load(std::memory_order_relaxed);
+}
+
+void ControlExecutor::startThread() {
+  if (!task) {
+    task = new CrossplatformThread(trampoline, this, "ControlExecutor");
+  }
+}
+
+CrossplatformThread *ControlExecutor::getThread() const {
+  return task;
+}
+
+bool ControlExecutor::isStepping(const Loop &iloop) const {
+  std::scoped_lock lock(loopMutex);
+  return iloop.running;
+}
+
+std::uint32_t ControlExecutor::toPeriod(const QTime iperiod) const {
+  const auto period = std::round(iperiod.convert(millisecond));
+  if (period < 1) {
+    std::string msg("ControlExecutor: The period must be at least 1 ms.");
+    LOG_ERROR(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  return static_cast<std::uint32_t>(period);
+}
+
+void ControlExecutor::trampoline(void *context) {
+  if (context) {
+    static_cast<ControlExecutor *>(context)->loop();
+  }
+}
+
+void ControlExecutor::loop() {
+  LOG_INFO_S("Started ControlExecutor task.");
+
+  auto rate = timeUtil.getRate();
+  while (!dtorCalled.load(std::memory_order_acquire) && !task->notifyTake(0)) {
+    rate->delayUntil(step());
+  }
+
+  LOG_INFO_S("Stopped ControlExecutor task.");
+}
+} // namespace okapi
@@ -0,0 +1,91 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/logRingBuffer.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace okapi {
+namespace {
+void copyTruncated(char *odest, const std::string_view isrc, const std::size_t imaxLength) {
+  const std::size_t length = std::min(isrc.size(), imaxLength);
+  std::memcpy(odest, isrc.data(), length);
+  odest[length] = '\0';
+}
+} // namespace
+
+LogRingBuffer::LogRingBuffer(const std::size_t icapacity) {
+  std::size_t capacity = 1;
+  while (capacity < icapacity) {
+    capacity <<= 1;
+  }
+
+  mask = capacity - 1;
+  slots = std::make_unique<Slot[]>(capacity);
+  for (std::size_t i = 0; i < capacity; ++i) {
+    // A slot is free for the writer whose index matches its sequence number
+    slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool LogRingBuffer::push(const long itime,
+                         const char *ilevelName,
+                         const std::string_view ithreadName,
+                         const std::string_view imessage) noexcept {
+  auto index = writeIndex.load(std::memory_order_relaxed);
+  Slot *slot;
+
+  while (true) {
+    slot = &slots[index & mask];
+    const auto sequence = slot->sequence.load(std::memory_order_acquire);
+    const auto difference =
+      static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(index);
+
+    if (difference == 0) {
+      if (writeIndex.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      // The reader has not freed this slot yet, so the buffer is full
+      droppedCount.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      // Another writer claimed this slot first
+      index = writeIndex.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->record.time = itime;
+  slot->record.levelName = ilevelName;
+  copyTruncated(slot->record.threadName, ithreadName, LogRecord::maxThreadNameLength);
+  copyTruncated(slot->record.message, imessage, LogRecord::maxMessageLength);
+
+  // Publish the record to the reader
+  slot->sequence.store(index + 1, std::memory_order_release);
+  return true;
+}
+
+bool LogRingBuffer::pop(LogRecord &orecord) noexcept {
+  Slot &slot = slots[readIndex & mask];
+  if (slot.sequence.load(std::memory_order_acquire) != readIndex + 1) {
+    return false;
+  }
+
+  orecord = slot.record;
+
+  // Free the slot for the writer which wraps around to it next
+  slot.sequence.store(readIndex + mask + 1, std::memory_order_release);
+  ++readIndex;
+  return true;
+}
+
+std::size_t LogRingBuffer::getDroppedCount() const noexcept {
+  return droppedCount.load(std::memory_order_relaxed);
+}
+
+std::size_t LogRingBuffer::getCapacity() const noexcept {
+  return mask + 1;
+}
+} // namespace okapi
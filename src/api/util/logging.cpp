@@ -27,13 +27,135 @@ Logger::Logger(std::unique_ptr<AbstractTimer> itimer,
   : timer(std::move(itimer)), logLevel(ilevel), logfile(ifile) {
 }
 
+Logger::Logger(std::unique_ptr<AbstractTimer> itimer,
+               std::string_view ifileName,
+               const Logger::LogLevel &ilevel,
+               std::unique_ptr<AbstractRate> iflusherRate,
+               const std::size_t ibufferCapacity) noexcept
+  : Logger(std::move(itimer),
+           fopen(ifileName.data(), isSerialStream(ifileName) ? "w" : "a"),
+           ilevel,
+           std::move(iflusherRate),
+           ibufferCapacity) {
+}
+
+Logger::Logger(std::unique_ptr<AbstractTimer> itimer,
+               FILE *const ifile,
+               const Logger::LogLevel &ilevel,
+               std::unique_ptr<AbstractRate> iflusherRate,
+               const std::size_t ibufferCapacity) noexcept
+  : timer(std::move(itimer)),
+    logLevel(ilevel),
+    logfile(ifile),
+    buffer(std::make_unique<LogRingBuffer>(ibufferCapacity)),
+    flusherRate(std::move(iflusherRate)) {
+  flusher = new CrossplatformThread(trampoline, this, "OkapiLibLogger");
+#ifndef THREADS_STD
+  // Writing to the file can block, so only do it when the control tasks are idle
+  pros::c::task_set_priority(flusher->thread, TASK_PRIORITY_MIN + 1);
+#endif
+}
+
 Logger::~Logger() {
+  close();
+}
+
+void Logger::close() noexcept {
+  if (flusher) {
+    flusherStopped.store(true, std::memory_order_release);
+#ifndef THREADS_STD
+    // Don't delete the flusher halfway through a write
+    while (!flusherExited.load(std::memory_order_acquire)) {
+      pros::c::task_delay(1);
+    }
+#endif
+    delete flusher;
+    flusher = nullptr;
+  }
+
+  std::scoped_lock lock(logfileMutex);
   if (logfile) {
+    drain();
     fclose(logfile);
     logfile = nullptr;
   }
 }
 
+void Logger::flush() noexcept {
+  std::scoped_lock lock(logfileMutex);
+  if (logfile) {
+    drain();
+  }
+}
+
+std::size_t Logger::getDroppedCount() const noexcept {
+  return buffer ? buffer->getDroppedCount() : 0;
+}
+
+void Logger::write(const char *ilevelName, const std::string &imessage) noexcept {
+  const auto time = static_cast<long>(timer->millis().convert(millisecond));
+
+  if (buffer) {
+    buffer->push(time, ilevelName, CrossplatformThread::getCurrentName(), imessage);
+    return;
+  }
+
+  std::scoped_lock lock(logfileMutex);
+  if (!logfile) {
+    return;
+  }
+
+  fprintf(logfile,
+          "%ld (%s) %s: %s\n",
+          time,
+          CrossplatformThread::getCurrentName(),
+          ilevelName,
+          imessage.c_str());
+}
+
+void Logger::drain() noexcept {
+  if (!buffer) {
+    return;
+  }
+
+  LogRecord record;
+  while (buffer->pop(record)) {
+    fprintf(logfile,
+            "%ld (%s) %s: %s\n",
+            record.time,
+            record.threadName,
+            record.levelName,
+            record.message);
+  }
+
+  const auto droppedCount = buffer->getDroppedCount();
+  if (droppedCount != reportedDroppedCount) {
+    fprintf(logfile,
+            "%ld (OkapiLibLogger) WARN: Logger: Dropped %lu log statements because the buffer was "
+            "full.\n",
+            static_cast<long>(timer->millis().convert(millisecond)),
+            static_cast<unsigned long>(droppedCount - reportedDroppedCount));
+    reportedDroppedCount = droppedCount;
+  }
+
+  fflush(logfile);
+}
+
+void Logger::trampoline(void *context) {
+  if (context) {
+    static_cast<Logger *>(context)->flusherLoop();
+  }
+}
+
+void Logger::flusherLoop() {
+  while (!flusherStopped.load(std::memory_order_acquire)) {
+    flush();
+    flusherRate->delayUntil(10_ms);
+  }
+
+  flusherExited.store(true, std::memory_order_release);
+}
+
 std::shared_ptr<Logger> Logger::getDefaultLogger() {
   return defaultLogger;
 }
@@ -0,0 +1,98 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/telemetryDecoder.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace okapi {
+namespace {
+template <typename T> T readValue(FILE *ifile) {
+  T value;
+  if (fread(&value, sizeof(T), 1, ifile) != 1) {
+    throw std::runtime_error("TelemetryDecoder: The file is cut short.");
+  }
+  return value;
+}
+
+template <typename T> std::vector<T> readColumn(FILE *ifile, const std::size_t icount) {
+  std::vector<T> column(icount);
+  if (fread(column.data(), sizeof(T), icount, ifile) != icount) {
+    throw std::runtime_error("TelemetryDecoder: The file is cut short.");
+  }
+  return column;
+}
+} // namespace
+
+std::size_t TelemetryLog::size() const {
+  return channels.size();
+}
+
+TelemetrySample TelemetryLog::getSample(const std::size_t iindex) const {
+  return {values[0][iindex],
+          values[1][iindex],
+          values[2][iindex],
+          values[3][iindex],
+          values[4][iindex],
+          values[5][iindex],
+          values[6][iindex],
+          values[7][iindex] * millisecond};
+}
+
+TelemetryLog TelemetryDecoder::decode(FILE *ifile) {
+  char magic[sizeof(TelemetryRecorder::magic)];
+  if (fread(magic, sizeof(magic), 1, ifile) != 1 ||
+      std::memcmp(magic, TelemetryRecorder::magic, sizeof(magic)) != 0) {
+    throw std::runtime_error("TelemetryDecoder: The file is not a telemetry file.");
+  }
+
+  const auto version = readValue<std::uint16_t>(ifile);
+  if (version != TelemetryRecorder::formatVersion) {
+    throw std::runtime_error("TelemetryDecoder: Unsupported format version " +
+                             std::to_string(version) + ".");
+  }
+
+  const auto channelCount = readValue<std::uint16_t>(ifile);
+  const auto sampleCount = readValue<std::uint32_t>(ifile);
+
+  TelemetryLog log;
+  log.channelNames.reserve(channelCount);
+  for (std::uint16_t i = 0; i < channelCount; ++i) {
+    const auto name = readColumn<char>(ifile, readValue<std::uint16_t>(ifile));
+    log.channelNames.emplace_back(name.begin(), name.end());
+  }
+
+  log.channels = readColumn<std::uint16_t>(ifile, sampleCount);
+  log.times = readColumn<std::uint32_t>(ifile, sampleCount);
+  for (auto &column : log.values) {
+    column = readColumn<float>(ifile, sampleCount);
+  }
+
+  for (const auto channel : log.channels) {
+    if (channel >= channelCount) {
+      throw std::runtime_error("TelemetryDecoder: A sample has an unknown channel.");
+    }
+  }
+
+  return log;
+}
+
+void TelemetryDecoder::writeCsv(FILE *ifile, const TelemetryLog &ilog) {
+  fprintf(ifile, "time_ms,channel,target,reading,error,p,i,d,output,dt_ms\n");
+
+  for (std::size_t i = 0; i < ilog.size(); ++i) {
+    fprintf(ifile,
+            "%lu,%s",
+            static_cast<unsigned long>(ilog.times[i]),
+            ilog.channelNames[ilog.channels[i]].c_str());
+
+    for (const auto &column : ilog.values) {
+      fprintf(ifile, ",%.9g", column[i]);
+    }
+
+    fprintf(ifile, "\n");
+  }
+}
+} // namespace okapi
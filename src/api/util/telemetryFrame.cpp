@@ -0,0 +1,52 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/telemetryFrame.hpp"
+#include "okapi/api/util/cobs.hpp"
+#include <cstring>
+
+namespace okapi {
+std::size_t TelemetryFrame::encode(const std::uint8_t *imessage,
+                                   const std::size_t ilength,
+                                   std::uint8_t *oframe) {
+  std::uint8_t checked[maxFrameLength];
+  std::memcpy(checked, imessage, ilength);
+
+  const auto crc = crc16(imessage, ilength);
+  checked[ilength] = static_cast<std::uint8_t>(crc);
+  checked[ilength + 1] = static_cast<std::uint8_t>(crc >> 8);
+
+  const auto length = Cobs::encode(checked, ilength + 2, oframe);
+  oframe[length] = 0;
+  return length + 1;
+}
+
+bool TelemetryFrame::decode(const std::uint8_t *iframe,
+                            const std::size_t ilength,
+                            std::uint8_t *omessage,
+                            std::size_t &olength) {
+  std::size_t length;
+  if (!Cobs::decode(iframe, ilength, omessage, length) || length < 3) {
+    return false;
+  }
+
+  // The last two bytes are the checksum of the message
+  olength = length - 2;
+  const auto crc = static_cast<std::uint16_t>(omessage[olength] | (omessage[olength + 1] << 8));
+  return crc == crc16(omessage, olength);
+}
+
+std::uint16_t TelemetryFrame::crc16(const std::uint8_t *idata, const std::size_t ilength) {
+  std::uint16_t crc = 0xFFFF;
+  for (std::size_t i = 0; i < ilength; ++i) {
+    crc ^= static_cast<std::uint16_t>(idata[i]) << 8;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? static_cast<std::uint16_t>((crc << 1) ^ 0x1021)
+                           : static_cast<std::uint16_t>(crc << 1);
+    }
+  }
+  return crc;
+}
+} // namespace okapi
@@ -0,0 +1,143 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/telemetryRecorder.hpp"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+namespace okapi {
+namespace {
+template <typename T> bool writeValue(FILE *ifile, const T ivalue) {
+  return fwrite(&ivalue, sizeof(T), 1, ifile) == 1;
+}
+
+/**
+ * Writes the entries of a column which belong to the given slots.
+ */
+template <typename T>
+bool writeColumn(FILE *ifile,
+                 const std::vector<T> &icolumn,
+                 const std::vector<std::size_t> &islots) {
+  std::vector<T> packed;
+  packed.reserve(islots.size());
+  for (const auto slot : islots) {
+    packed.push_back(icolumn[slot]);
+  }
+
+  return fwrite(packed.data(), sizeof(T), packed.size(), ifile) == packed.size();
+}
+} // namespace
+
+TelemetryRecorder::TelemetryRecorder(const TimeUtil &itimeUtil, const std::size_t icapacity)
+  : timer(itimeUtil.getTimer()),
+    capacity(icapacity),
+    channels(icapacity),
+    times(icapacity),
+    ready(std::make_unique<std::atomic_bool[]>(icapacity)) {
+  for (auto &column : values) {
+    column.resize(icapacity);
+  }
+
+  for (std::size_t i = 0; i < icapacity; ++i) {
+    ready[i].store(false, std::memory_order_relaxed);
+  }
+}
+
+std::uint16_t TelemetryRecorder::addChannel(const std::string &iname) {
+  std::scoped_lock lock(channelMutex);
+
+  const auto existing = std::find(channelNames.begin(), channelNames.end(), iname);
+  if (existing != channelNames.end()) {
+    return static_cast<std::uint16_t>(existing - channelNames.begin());
+  }
+
+  if (channelNames.size() > UINT16_MAX) {
+    throw std::runtime_error("TelemetryRecorder: Too many channels.");
+  }
+
+  channelNames.push_back(iname);
+  return static_cast<std::uint16_t>(channelNames.size() - 1);
+}
+
+bool TelemetryRecorder::record(const std::uint16_t ichannel,
+                               const TelemetrySample &isample) noexcept {
+  const auto slot = nextSlot.fetch_add(1, std::memory_order_relaxed);
+  if (slot >= capacity) {
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  channels[slot] = ichannel;
+  times[slot] = static_cast<std::uint32_t>(timer->millis().convert(millisecond));
+  values[0][slot] = static_cast<float>(isample.target);
+  values[1][slot] = static_cast<float>(isample.reading);
+  values[2][slot] = static_cast<float>(isample.error);
+  values[3][slot] = static_cast<float>(isample.p);
+  values[4][slot] = static_cast<float>(isample.i);
+  values[5][slot] = static_cast<float>(isample.d);
+  values[6][slot] = static_cast<float>(isample.output);
+  values[7][slot] = static_cast<float>(isample.dt.convert(millisecond));
+
+  ready[slot].store(true, std::memory_order_release);
+  return true;
+}
+
+std::size_t TelemetryRecorder::getSampleCount() const noexcept {
+  return std::min(nextSlot.load(std::memory_order_relaxed), capacity);
+}
+
+std::size_t TelemetryRecorder::getDroppedCount() const noexcept {
+  return droppedCount.load(std::memory_order_relaxed);
+}
+
+std::size_t TelemetryRecorder::getCapacity() const noexcept {
+  return capacity;
+}
+
+bool TelemetryRecorder::write(FILE *ifile) {
+  std::vector<std::size_t> slots;
+  const auto claimedCount = getSampleCount();
+  slots.reserve(claimedCount);
+  for (std::size_t i = 0; i < claimedCount; ++i) {
+    if (ready[i].load(std::memory_order_acquire)) {
+      slots.push_back(i);
+    }
+  }
+
+  std::vector<std::string> names;
+  {
+    std::scoped_lock lock(channelMutex);
+    names = channelNames;
+  }
+
+  bool ok = fwrite(magic, sizeof(magic), 1, ifile) == 1;
+  ok = ok && writeValue(ifile, formatVersion);
+  ok = ok && writeValue(ifile, static_cast<std::uint16_t>(names.size()));
+  ok = ok && writeValue(ifile, static_cast<std::uint32_t>(slots.size()));
+
+  for (const auto &name : names) {
+    const auto length = static_cast<std::uint16_t>(std::min<std::size_t>(name.size(), UINT16_MAX));
+    ok = ok && writeValue(ifile, length) && fwrite(name.data(), 1, length, ifile) == length;
+  }
+
+  ok = ok && writeColumn(ifile, channels, slots) && writeColumn(ifile, times, slots);
+  for (const auto &column : values) {
+    ok = ok && writeColumn(ifile, column, slots);
+  }
+
+  return ok;
+}
+
+bool TelemetryRecorder::save(const std::string_view ifileName) {
+  FILE *file = fopen(std::string(ifileName).c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+
+  const bool ok = write(file);
+  return fclose(file) == 0 && ok;
+}
+} // namespace okapi
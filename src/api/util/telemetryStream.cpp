@@ -0,0 +1,224 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/telemetryStream.hpp"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+namespace okapi {
+namespace {
+/**
+ * Appends little-endian values to a message.
+ */
+class MessageWriter {
+  public:
+  explicit MessageWriter(const TelemetryStream::MessageId iid) {
+    data[length++] = static_cast<std::uint8_t>(iid);
+  }
+
+  void putU8(const std::uint8_t ivalue) {
+    data[length++] = ivalue;
+  }
+
+  void putU16(const std::uint16_t ivalue) {
+    putU8(static_cast<std::uint8_t>(ivalue));
+    putU8(static_cast<std::uint8_t>(ivalue >> 8));
+  }
+
+  void putU32(const std::uint32_t ivalue) {
+    putU16(static_cast<std::uint16_t>(ivalue));
+    putU16(static_cast<std::uint16_t>(ivalue >> 16));
+  }
+
+  void putFloat(const double ivalue) {
+    const auto value = static_cast<float>(ivalue);
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU32(bits);
+  }
+
+  void putBytes(const char *idata, const std::size_t ilength) {
+    std::memcpy(data + length, idata, ilength);
+    length += ilength;
+  }
+
+  std::uint8_t data[TelemetryFrame::maxFrameLength];
+  std::size_t length{0};
+};
+} // namespace
+
+TelemetryStream::TelemetryStream(const TimeUtil &itimeUtil,
+                                 FILE *ifile,
+                                 const QTime iperiod,
+                                 const QTime iannouncePeriod,
+                                 const std::shared_ptr<Logger> &ilogger)
+  : logger(ilogger),
+    timeUtil(itimeUtil),
+    timer(itimeUtil.getTimer()),
+    file(ifile),
+    period(iperiod),
+    announcePeriod(iannouncePeriod) {
+  if (!ifile) {
+    std::string msg("TelemetryStream: The file must not be null.");
+    LOG_ERROR(msg);
+    throw std::invalid_argument(msg);
+  }
+}
+
+TelemetryStream::~TelemetryStream() {
+  dtorCalled.store(true, std::memory_order_release);
+  delete task;
+}
+
+std::uint16_t TelemetryStream::addChannel(const std::string &iname) {
+  return addChannelOfKind(iname, ChannelKind::controller, nullptr);
+}
+
+bool TelemetryStream::record(const std::uint16_t ichannel,
+                             const TelemetrySample &isample) noexcept {
+  const auto time = static_cast<std::uint32_t>(timer->millis().convert(millisecond));
+
+  std::scoped_lock lock(channelMutex);
+  if (ichannel >= channels.size()) {
+    return false;
+  }
+
+  auto &channel = channels[ichannel];
+  channel.sample = isample;
+  channel.time = time;
+  channel.changed = true;
+  return true;
+}
+
+std::uint16_t TelemetryStream::addOdometryChannel(const std::string &iname,
+                                                  std::shared_ptr<Odometry> iodometry) {
+  if (!iodometry) {
+    std::string msg("TelemetryStream: The odometry must not be null.");
+    LOG_ERROR(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  return addChannelOfKind(iname, ChannelKind::odometry, std::move(iodometry));
+}
+
+void TelemetryStream::publish() {
+  const auto now = timer->millis();
+  output.clear();
+
+  {
+    // Only build the frames while locked, so the controllers never wait for the file
+    std::scoped_lock lock(channelMutex);
+
+    if (!hasAnnounced || now - lastAnnounceTime >= announcePeriod) {
+      for (std::size_t i = 0; i < channels.size(); ++i) {
+        const auto &channel = channels[i];
+        MessageWriter message(MessageId::channelInfo);
+        message.putU16(static_cast<std::uint16_t>(i));
+        message.putU8(static_cast<std::uint8_t>(channel.kind));
+        message.putBytes(channel.name.data(),
+                         std::min(channel.name.size(), TelemetryFrame::maxChannelNameLength));
+        appendFrame(message.data, message.length);
+      }
+
+      lastAnnounceTime = now;
+      hasAnnounced = true;
+    }
+
+    for (std::size_t i = 0; i < channels.size(); ++i) {
+      auto &channel = channels[i];
+
+      if (channel.kind == ChannelKind::odometry) {
+        const auto state = channel.odometry->getState();
+        MessageWriter message(MessageId::odometrySample);
+        message.putU16(static_cast<std::uint16_t>(i));
+        message.putU32(static_cast<std::uint32_t>(now.convert(millisecond)));
+        message.putFloat(state.x.convert(meter));
+        message.putFloat(state.y.convert(meter));
+        message.putFloat(state.theta.convert(radian));
+        appendFrame(message.data, message.length);
+      } else if (channel.changed) {
+        const auto &sample = channel.sample;
+        MessageWriter message(MessageId::controllerSample);
+        message.putU16(static_cast<std::uint16_t>(i));
+        message.putU32(channel.time);
+        message.putFloat(sample.target);
+        message.putFloat(sample.reading);
+        message.putFloat(sample.error);
+        message.putFloat(sample.p);
+        message.putFloat(sample.i);
+        message.putFloat(sample.d);
+        message.putFloat(sample.output);
+        message.putFloat(sample.dt.convert(millisecond));
+        appendFrame(message.data, message.length);
+        channel.changed = false;
+      }
+    }
+  }
+
+  if (!output.empty()) {
+    const auto written = fwrite(output.data(), 1, output.size(), file);
+    fflush(file);
+    bytesWritten.fetch_add(written, std::memory_order_relaxed);
+  }
+}
+
+std::size_t TelemetryStream::getBytesWritten() const {
+  return bytesWritten.load(std::memory_order_relaxed);
+}
+
+void TelemetryStream::startThread() {
+  if (!task) {
+    task = new CrossplatformThread(trampoline, this, "TelemetryStream");
+  }
+}
+
+std::uint16_t TelemetryStream::addChannelOfKind(const std::string &iname,
+                                                const ChannelKind ikind,
+                                                std::shared_ptr<Odometry> iodometry) {
+  std::scoped_lock lock(channelMutex);
+
+  const auto existing =
+    std::find_if(channels.begin(), channels.end(), [&](const Channel &channel) {
+      return channel.name == iname;
+    });
+  if (existing != channels.end()) {
+    return static_cast<std::uint16_t>(existing - channels.begin());
+  }
+
+  if (channels.size() > UINT16_MAX) {
+    std::string msg("TelemetryStream: Too many channels.");
+    LOG_ERROR(msg);
+    throw std::runtime_error(msg);
+  }
+
+  channels.push_back(Channel{iname, ikind, std::move(iodometry)});
+
+  // Announce the new channel the next time the samples are sent
+  hasAnnounced = false;
+  return static_cast<std::uint16_t>(channels.size() - 1);
+}
+
+void TelemetryStream::appendFrame(const std::uint8_t *imessage, const std::size_t ilength) {
+  std::uint8_t frame[TelemetryFrame::maxFrameLength];
+  const auto length = TelemetryFrame::encode(imessage, ilength, frame);
+  output.insert(output.end(), frame, frame + length);
+}
+
+void TelemetryStream::trampoline(void *context) {
+  if (context) {
+    static_cast<TelemetryStream *>(context)->loop();
+  }
+}
+
+void TelemetryStream::loop() {
+  auto rate = timeUtil.getRate();
+  while (!dtorCalled.load(std::memory_order_acquire) && !task->notifyTake(0)) {
+    publish();
+    rate->delayUntil(period);
+  }
+}
+} // namespace okapi
@@ -0,0 +1,185 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/telemetryStreamDecoder.hpp"
+#include <cstring>
+
+namespace okapi {
+namespace {
+/**
+ * Reads little-endian values from a message. Reading past the end sets `isValid` to false.
+ */
+class MessageReader {
+  public:
+  MessageReader(const std::uint8_t *idata, const std::size_t ilength)
+    : data(idata), length(ilength) {
+  }
+
+  std::uint8_t getU8() {
+    if (index >= length) {
+      isValid = false;
+      return 0;
+    }
+    return data[index++];
+  }
+
+  std::uint16_t getU16() {
+    const std::uint16_t low = getU8();
+    return static_cast<std::uint16_t>(low | (getU8() << 8));
+  }
+
+  std::uint32_t getU32() {
+    const std::uint32_t low = getU16();
+    return low | (static_cast<std::uint32_t>(getU16()) << 16);
+  }
+
+  float getFloat() {
+    const auto bits = getU32();
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  std::string getRest() {
+    std::string rest(reinterpret_cast<const char *>(data + index), length - index);
+    index = length;
+    return rest;
+  }
+
+  const std::uint8_t *data;
+  std::size_t length;
+  std::size_t index{0};
+  bool isValid{true};
+};
+} // namespace
+
+std::vector<TelemetryStreamMessage> TelemetryStreamDecoder::feed(const std::uint8_t *idata,
+                                                                 const std::size_t ilength) {
+  std::vector<TelemetryStreamMessage> messages;
+
+  for (std::size_t i = 0; i < ilength; ++i) {
+    if (idata[i] != 0) {
+      if (frame.size() < TelemetryFrame::maxFrameLength) {
+        frame.push_back(idata[i]);
+      } else {
+        isFrameTooLong = true;
+      }
+      continue;
+    }
+
+    if (isFrameTooLong) {
+      ++corruptFrameCount;
+    } else if (!frame.empty()) {
+      decodeFrame(messages);
+    }
+
+    frame.clear();
+    isFrameTooLong = false;
+  }
+
+  return messages;
+}
+
+std::string TelemetryStreamDecoder::getChannelName(const std::uint16_t ichannel) const {
+  const auto name = channelNames.find(ichannel);
+  if (name == channelNames.end()) {
+    return "channel " + std::to_string(ichannel);
+  }
+  return name->second;
+}
+
+std::size_t TelemetryStreamDecoder::getCorruptFrameCount() const {
+  return corruptFrameCount;
+}
+
+void TelemetryStreamDecoder::writeCsvHeader(FILE *ifile) {
+  fprintf(ifile, "time_ms,channel,target,reading,error,p,i,d,output,dt_ms,x_m,y_m,theta_rad\n");
+}
+
+void TelemetryStreamDecoder::writeCsv(FILE *ifile, const TelemetryStreamMessage &imessage) const {
+  fprintf(ifile,
+          "%lu,%s,",
+          static_cast<unsigned long>(imessage.time),
+          getChannelName(imessage.channel).c_str());
+
+  if (imessage.id == TelemetryFrame::MessageId::controllerSample) {
+    const auto &sample = imessage.sample;
+    fprintf(ifile,
+            "%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,,,\n",
+            sample.target,
+            sample.reading,
+            sample.error,
+            sample.p,
+            sample.i,
+            sample.d,
+            sample.output,
+            sample.dt.convert(millisecond));
+  } else {
+    const auto &state = imessage.state;
+    fprintf(ifile,
+            ",,,,,,,,%.9g,%.9g,%.9g\n",
+            state.x.convert(meter),
+            state.y.convert(meter),
+            state.theta.convert(radian));
+  }
+}
+
+void TelemetryStreamDecoder::decodeFrame(std::vector<TelemetryStreamMessage> &omessages) {
+  std::uint8_t decoded[TelemetryFrame::maxFrameLength];
+  std::size_t length;
+  if (!TelemetryFrame::decode(frame.data(), frame.size(), decoded, length)) {
+    ++corruptFrameCount;
+    return;
+  }
+
+  MessageReader reader(decoded, length);
+  TelemetryStreamMessage message{};
+  message.id = static_cast<TelemetryFrame::MessageId>(reader.getU8());
+  message.channel = reader.getU16();
+
+  switch (message.id) {
+  case TelemetryFrame::MessageId::channelInfo: {
+    reader.getU8(); // The kind of channel is implied by the samples it sends
+    const auto name = reader.getRest();
+    if (reader.isValid) {
+      channelNames[message.channel] = name;
+    } else {
+      ++corruptFrameCount;
+    }
+    return;
+  }
+
+  case TelemetryFrame::MessageId::controllerSample:
+    message.time = reader.getU32();
+    message.sample.target = reader.getFloat();
+    message.sample.reading = reader.getFloat();
+    message.sample.error = reader.getFloat();
+    message.sample.p = reader.getFloat();
+    message.sample.i = reader.getFloat();
+    message.sample.d = reader.getFloat();
+    message.sample.output = reader.getFloat();
+    message.sample.dt = reader.getFloat() * millisecond;
+    break;
+
+  case TelemetryFrame::MessageId::odometrySample:
+    message.time = reader.getU32();
+    message.state.x = reader.getFloat() * meter;
+    message.state.y = reader.getFloat() * meter;
+    message.state.theta = reader.getFloat() * radian;
+    break;
+
+  default:
+    // A message from a newer version of the stream
+    return;
+  }
+
+  if (!reader.isValid) {
+    ++corruptFrameCount;
+    return;
+  }
+
+  omessages.push_back(message);
+}
+} // namespace okapi
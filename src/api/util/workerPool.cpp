@@ -0,0 +1,114 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/workerPool.hpp"
+#include <algorithm>
+#include <mutex>
+
+namespace okapi {
+WorkerPool::WorkerPool(const TimeUtil &itimeUtil,
+                       const std::size_t iworkerCount,
+                       const std::size_t imaxQueuedJobs,
+                       const std::shared_ptr<Logger> &ilogger)
+  : logger(ilogger), timeUtil(itimeUtil), maxQueuedJobs(imaxQueuedJobs) {
+  const std::size_t workerCount = std::max<std::size_t>(iworkerCount, 1);
+  workers.reserve(workerCount);
+  for (std::size_t i = 0; i < workerCount; ++i) {
+    auto worker = new CrossplatformThread(trampoline, this, "OkapiLibWorkerPool");
+    workers.push_back(worker);
+#ifndef THREADS_STD
+    // Jobs such as path generation run for a long time, so only run them when the control tasks
+    // are idle
+    pros::c::task_set_priority(worker->thread, TASK_PRIORITY_MIN + 1);
+#endif
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  dtorCalled.store(true, std::memory_order_release);
+
+  {
+    std::scoped_lock lock(queueMutex);
+    jobs.clear();
+    queuedJobs.store(0, std::memory_order_release);
+  }
+
+  // Let running jobs finish so they aren't deleted halfway through on the brain
+  auto rate = timeUtil.getRate();
+  while (activeJobs.load(std::memory_order_acquire) > 0) {
+    rate->delayUntil(1_ms);
+  }
+
+  for (auto worker : workers) {
+    delete worker;
+  }
+}
+
+bool WorkerPool::submit(std::function<void()> ijob) {
+  std::scoped_lock lock(queueMutex);
+
+  if (dtorCalled.load(std::memory_order_acquire) || jobs.size() >= maxQueuedJobs) {
+    LOG_WARN_S("WorkerPool: Job queue is full, rejecting job.");
+    return false;
+  }
+
+  jobs.push_back(std::move(ijob));
+  queuedJobs.fetch_add(1, std::memory_order_acq_rel);
+  return true;
+}
+
+std::size_t WorkerPool::getWorkerCount() const {
+  return workers.size();
+}
+
+std::size_t WorkerPool::getPendingJobCount() const {
+  return queuedJobs.load(std::memory_order_acquire) + activeJobs.load(std::memory_order_acquire);
+}
+
+std::size_t WorkerPool::getDefaultWorkerCount() {
+#ifdef THREADS_STD
+  return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+#else
+  return 1;
+#endif
+}
+
+void WorkerPool::trampoline(void *context) {
+  if (context) {
+    static_cast<WorkerPool *>(context)->loop();
+  }
+}
+
+void WorkerPool::loop() {
+  auto rate = timeUtil.getRate();
+
+  while (!dtorCalled.load(std::memory_order_acquire)) {
+    std::function<void()> job;
+
+    {
+      std::scoped_lock lock(queueMutex);
+      if (!jobs.empty()) {
+        job = std::move(jobs.front());
+        jobs.pop_front();
+        // Count the job as active before it leaves the queue count so the pool never looks idle
+        activeJobs.fetch_add(1, std::memory_order_acq_rel);
+        queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+      }
+    }
+
+    if (job) {
+      try {
+        job();
+      } catch (const std::exception &e) {
+        LOG_ERROR("WorkerPool: Job threw an exception: " + std::string(e.what()));
+      }
+
+      activeJobs.fetch_sub(1, std::memory_order_acq_rel);
+    } else {
+      rate->delayUntil(1_ms);
+    }
+  }
+}
+} // namespace okapi
@@ -327,6 +327,12 @@ ChassisControllerBuilder::withLogger(const std::shared_ptr<Logger> &ilogger) {
   return *this;
 }
 
+ChassisControllerBuilder &
+ChassisControllerBuilder::withExecutor(const std::shared_ptr<ControlExecutor> &iexecutor) {
+  executor = iexecutor;
+  return *this;
+}
+
 ChassisControllerBuilder &ChassisControllerBuilder::parentedToCurrentTask() {
   isParentedToCurrentTask = true;
   return *this;
@@ -404,6 +410,11 @@ ChassisControllerBuilder::buildDOCC(std::shared_ptr<ChassisController> chassisCo
                                                    turnThreshold,
                                                    controllerLogger);
 
+  if (executor) {
+    out->startOdomOnExecutor(executor);
+    return out;
+  }
+
   out->startOdomThread();
 
   if (isParentedToCurrentTask && NOT_INITIALIZE_TASK && NOT_COMP_INITIALIZE_TASK) {
@@ -439,6 +450,11 @@ std::shared_ptr<ChassisControllerPID> ChassisControllerBuilder::buildCCPID() {
     odomScales,
     controllerLogger);
 
+  if (executor) {
+    out->startOnExecutor(executor);
+    return out;
+  }
+
   out->startThread();
 
   if (isParentedToCurrentTask && NOT_INITIALIZE_TASK && NOT_COMP_INITIALIZE_TASK) {
@@ -37,6 +37,15 @@ AsyncMotionProfileControllerBuilder &AsyncMotionProfileControllerBuilder::withOu
   return *this;
 }
 
+AsyncMotionProfileControllerBuilder &AsyncMotionProfileControllerBuilder::withAxis(
+  const std::shared_ptr<ControllerOutput<double>> &ioutput,
+  const QLength &idiameter,
+  const AbstractMotor::GearsetRatioPair &ipair,
+  const PathfinderLimits &ilimits) {
+  axes.push_back({ioutput, idiameter, ipair, ilimits});
+  return *this;
+}
+
 AsyncMotionProfileControllerBuilder &
 AsyncMotionProfileControllerBuilder::withOutput(ChassisController &icontroller) {
   return withOutput(
@@ -68,6 +77,70 @@ AsyncMotionProfileControllerBuilder::withLimits(const PathfinderLimits &ilimits)
   return *this;
 }
 
+AsyncMotionProfileControllerBuilder &
+AsyncMotionProfileControllerBuilder::withPathCache(const std::shared_ptr<PathCache> &icache) {
+  pathCache = icache;
+  return *this;
+}
+
+AsyncMotionProfileControllerBuilder &
+AsyncMotionProfileControllerBuilder::withCompiledMotorCommands() {
+  compileMotorCommands = true;
+  return *this;
+}
+
+AsyncMotionProfileControllerBuilder &
+AsyncMotionProfileControllerBuilder::withCompactPathStorage() {
+  compactPathStorage = true;
+  return *this;
+}
+
+AsyncMotionProfileControllerBuilder &
+AsyncMotionProfileControllerBuilder::withNativeTrajectoryGeneration() {
+  nativeTrajectoryGeneration = true;
+  return *this;
+}
+
+AsyncMotionProfileControllerBuilder &
+AsyncMotionProfileControllerBuilder::withTimeIndexedFollowing() {
+  timeIndexedFollowing = true;
+  return *this;
+}
+
+AsyncMotionProfileControllerBuilder &
+AsyncMotionProfileControllerBuilder::withMoveToStreaming(const std::size_t isegmentsPerChunk,
+                                                         const QTime ileadTime) {
+  streamSegmentsPerChunk = isegmentsPerChunk;
+  streamLeadTime = ileadTime;
+  return *this;
+}
+
+AsyncMotionProfileControllerBuilder &
+AsyncMotionProfileControllerBuilder::withFeedforward(const FeedforwardGains &igains) {
+  feedforward = igains;
+  return *this;
+}
+
+AsyncMotionProfileControllerBuilder &
+AsyncMotionProfileControllerBuilder::withOdometry(const std::shared_ptr<Odometry> &iodometry,
+                                                  const RamseteGains &igains) {
+  odometry = iodometry;
+  ramseteGains = igains;
+  return *this;
+}
+
+AsyncMotionProfileControllerBuilder &
+AsyncMotionProfileControllerBuilder::withLinearMoveToShape(const LinearProfileShape ishape) {
+  linearMoveToShape = ishape;
+  return *this;
+}
+
+AsyncMotionProfileControllerBuilder &
+AsyncMotionProfileControllerBuilder::withActuationLatency(const QTime ilatency) {
+  actuationLatency = ilatency;
+  return *this;
+}
+
 AsyncMotionProfileControllerBuilder &
 AsyncMotionProfileControllerBuilder::withTimeUtilFactory(const TimeUtilFactory &itimeUtilFactory) {
   timeUtilFactory = itimeUtilFactory;
@@ -107,6 +180,27 @@ AsyncMotionProfileControllerBuilder::buildLinearMotionProfileController() {
 
   auto out = std::make_shared<AsyncLinearMotionProfileController>(
     timeUtilFactory.create(), limits, output, diameter, pair, controllerLogger);
+  out->setMoveToShape(linearMoveToShape);
+  out->setActuationLatency(actuationLatency);
+  out->startThread();
+
+  if (isParentedToCurrentTask && NOT_INITIALIZE_TASK && NOT_COMP_INITIALIZE_TASK) {
+    out->getThread()->notifyWhenDeletingRaw(pros::c::task_get_current());
+  }
+
+  return out;
+}
+
+std::shared_ptr<AsyncMultiAxisProfileController>
+AsyncMotionProfileControllerBuilder::buildMultiAxisMotionProfileController() {
+  if (axes.empty()) {
+    std::string msg("AsyncMotionProfileControllerBuilder: No axes given.");
+    LOG_ERROR(msg);
+    throw std::runtime_error(msg);
+  }
+
+  auto out = std::make_shared<AsyncMultiAxisProfileController>(
+    timeUtilFactory.create(), axes, controllerLogger);
   out->startThread();
 
   if (isParentedToCurrentTask && NOT_INITIALIZE_TASK && NOT_COMP_INITIALIZE_TASK) {
@@ -132,6 +226,15 @@ AsyncMotionProfileControllerBuilder::buildMotionProfileController() {
 
   auto out = std::make_shared<AsyncMotionProfileController>(
     timeUtilFactory.create(), limits, model, scales, pair, controllerLogger);
+  out->setPathCache(pathCache);
+  out->setCompileMotorCommands(compileMotorCommands);
+  out->setCompactPathStorage(compactPathStorage);
+  out->setNativeTrajectoryGeneration(nativeTrajectoryGeneration);
+  out->setTimeIndexedFollowing(timeIndexedFollowing);
+  out->setMoveToStreaming(streamSegmentsPerChunk, streamLeadTime);
+  out->setFeedforward(feedforward);
+  out->setOdometry(odometry, ramseteGains);
+  out->setActuationLatency(actuationLatency);
   out->startThread();
 
   if (isParentedToCurrentTask && NOT_INITIALIZE_TASK && NOT_COMP_INITIALIZE_TASK) {
@@ -94,6 +94,12 @@ AsyncPosControllerBuilder::withLogger(const std::shared_ptr<Logger> &ilogger) {
   return *this;
 }
 
+AsyncPosControllerBuilder &
+AsyncPosControllerBuilder::withExecutor(const std::shared_ptr<ControlExecutor> &iexecutor) {
+  executor = iexecutor;
+  return *this;
+}
+
 AsyncPosControllerBuilder &AsyncPosControllerBuilder::parentedToCurrentTask() {
   isParentedToCurrentTask = true;
   return *this;
@@ -139,6 +145,12 @@ std::shared_ptr<AsyncPosPIDController> AsyncPosControllerBuilder::buildAPPC() {
                                                      pair.ratio,
                                                      std::move(derivativeFilter),
                                                      controllerLogger);
+
+  if (executor) {
+    out->startOnExecutor(executor);
+    return out;
+  }
+
   out->startThread();
 
   if (isParentedToCurrentTask && NOT_INITIALIZE_TASK && NOT_COMP_INITIALIZE_TASK) {
@@ -101,6 +101,12 @@ AsyncVelControllerBuilder::withLogger(const std::shared_ptr<Logger> &ilogger) {
   return *this;
 }
 
+AsyncVelControllerBuilder &
+AsyncVelControllerBuilder::withExecutor(const std::shared_ptr<ControlExecutor> &iexecutor) {
+  executor = iexecutor;
+  return *this;
+}
+
 AsyncVelControllerBuilder &AsyncVelControllerBuilder::parentedToCurrentTask() {
   isParentedToCurrentTask = true;
   return *this;
@@ -154,6 +160,11 @@ std::shared_ptr<AsyncVelPIDController> AsyncVelControllerBuilder::buildAVPC() {
                                                      pair.ratio,
                                                      std::move(derivativeFilter),
                                                      controllerLogger);
+  if (executor) {
+    out->startOnExecutor(executor);
+    return out;
+  }
+
   out->startThread();
 
   if (isParentedToCurrentTask && NOT_INITIALIZE_TASK && NOT_COMP_INITIALIZE_TASK) {
@@ -12,6 +12,7 @@ using namespace okapi;
 class MockAsyncLinearMotionProfileController : public AsyncLinearMotionProfileController {
   public:
   using AsyncLinearMotionProfileController::AsyncLinearMotionProfileController;
+  using AsyncLinearMotionProfileController::findPath;
 
   void executeSinglePath(const std::vector<squiggles::ProfilePoint> &path,
                          std::unique_ptr<AbstractRate> rate) override {
@@ -19,7 +20,14 @@ class MockAsyncLinearMotionProfileController : public AsyncLinearMotionProfileCo
     AsyncLinearMotionProfileController::executeSinglePath(path, std::move(rate));
   }
 
+  void executeAnalyticPath(const LinearProfile &profile,
+                           std::unique_ptr<AbstractRate> rate) override {
+    executeAnalyticPathCalled = true;
+    AsyncLinearMotionProfileController::executeAnalyticPath(profile, std::move(rate));
+  }
+
   bool executeSinglePathCalled{false};
+  bool executeAnalyticPathCalled{false};
 };
 
 class AsyncLinearMotionProfileControllerTest : public ::testing::Test {
@@ -151,6 +159,46 @@ TEST_F(AsyncLinearMotionProfileControllerTest, RemoveAPathWhichDoesNotExist) {
   EXPECT_EQ(controller->getPaths().size(), 0);
 }
 
+TEST_F(AsyncLinearMotionProfileControllerTest, FollowPathWithHandle) {
+  const auto handle = controller->generatePath({0_m, 3_m}, "A");
+  ASSERT_TRUE(handle.isValid());
+  EXPECT_EQ(controller->getPathHandle("A"), handle);
+
+  controller->setTarget(handle);
+  EXPECT_EQ(controller->getTarget(), "A");
+  controller->waitUntilSettled();
+
+  EXPECT_EQ(output->lastControllerOutputSet, 0);
+  EXPECT_GT(output->maxControllerOutputSet, 0);
+}
+
+TEST_F(AsyncLinearMotionProfileControllerTest, HandleIsStableAcrossRegeneration) {
+  EXPECT_FALSE(controller->getPathHandle("A").isValid());
+
+  const auto handle = controller->generatePath({0_m, 3_m}, "A");
+  EXPECT_EQ(controller->getPathHandle("A"), handle);
+  EXPECT_TRUE(controller->removePath(handle));
+  EXPECT_EQ(controller->getPaths().size(), 0);
+
+  EXPECT_EQ(controller->generateAnalyticPath(0_m, 2_m, "A"), handle);
+  EXPECT_EQ(controller->getPaths().size(), 1);
+  EXPECT_FALSE(controller->getPathHandle("B").isValid());
+}
+
+TEST_F(AsyncLinearMotionProfileControllerTest, RemoveRunningPathWithHandle) {
+  const auto handle = controller->generatePath({0_m, 3_m}, "A");
+  controller->setTarget(handle);
+
+  EXPECT_FALSE(controller->removePath(handle));
+  EXPECT_EQ(controller->getPaths().size(), 1);
+}
+
+TEST_F(AsyncLinearMotionProfileControllerTest, UnknownIdsDoNotGrowThePathTable) {
+  controller->setTarget("Typo");
+  EXPECT_EQ(controller->getTarget(), "Typo");
+  EXPECT_FALSE(controller->getPathHandle("Typo").isValid());
+}
+
 TEST_F(AsyncLinearMotionProfileControllerTest, ControllerSetChangesTarget) {
   controller->controllerSet("A");
   EXPECT_EQ(controller->getTarget(), "A");
@@ -233,3 +281,130 @@ TEST_F(AsyncLinearMotionProfileControllerTest, FollowPathBackwards) {
   // still running
   controller->flipDisable(true);
 }
+
+TEST_F(AsyncLinearMotionProfileControllerTest, FollowAnalyticPath) {
+  controller->generateAnalyticPath(0_m, 0.5_m, "A");
+
+  EXPECT_EQ(controller->getPaths().front(), "A");
+  EXPECT_EQ(controller->getPaths().size(), 1);
+
+  controller->setTarget("A");
+  controller->waitUntilSettled();
+
+  EXPECT_TRUE(controller->executeAnalyticPathCalled);
+  EXPECT_FALSE(controller->executeSinglePathCalled);
+  EXPECT_EQ(output->lastControllerOutputSet, 0);
+  EXPECT_GT(output->maxControllerOutputSet, 0);
+  EXPECT_NEAR(controller->getError(), 0, 1e-9);
+}
+
+TEST_F(AsyncLinearMotionProfileControllerTest, FollowAnalyticPathBackwards) {
+  controller->generateAnalyticPath(0_m, 3_m, "A", LinearProfileShape::trapezoidal);
+  controller->setTarget("A", true);
+
+  auto rate = createTimeUtil().getRate();
+  while (!controller->executeAnalyticPathCalled) {
+    rate->delayUntil(1_ms);
+  }
+
+  // Wait a little longer so we get into the path
+  rate->delayUntil(200_ms);
+
+  EXPECT_LT(output->lastControllerOutputSet, 0);
+
+  controller->flipDisable(true);
+}
+
+TEST_F(AsyncLinearMotionProfileControllerTest, GetErrorWithAnalyticTarget) {
+  controller->generateAnalyticPath(0_m, 3_m, "A");
+  controller->setTarget("A");
+
+  EXPECT_NEAR(controller->getError(), 3, 0.1);
+
+  controller->flipDisable(true);
+}
+
+TEST_F(AsyncLinearMotionProfileControllerTest, AnalyticPathWithInvalidLimitsThrows) {
+  EXPECT_THROW(controller->generateAnalyticPath(0_m, 3_m, "A", {0, 2, 10}),
+               std::invalid_argument);
+  EXPECT_EQ(controller->getPaths().size(), 0);
+}
+
+TEST_F(AsyncLinearMotionProfileControllerTest, AnalyticAndGeneratedPathsCoexist) {
+  controller->generatePath({0_m, 3_m}, "A");
+  controller->generateAnalyticPath(0_m, 3_m, "B");
+
+  EXPECT_EQ(controller->getPaths().size(), 2);
+  EXPECT_FALSE(controller->findPath("A")->isAnalytic());
+  EXPECT_TRUE(controller->findPath("B")->isAnalytic());
+  EXPECT_EQ(controller->findPath("B")->size(), 0);
+  EXPECT_LT(controller->findPath("B")->getBytesUsed(), controller->findPath("A")->getBytesUsed());
+}
+
+TEST_F(AsyncLinearMotionProfileControllerTest, MoveToUsesGeneratePathByDefault) {
+  EXPECT_EQ(controller->getMoveToShape(), std::nullopt);
+
+  controller->moveTo(0_m, 0.5_m);
+
+  EXPECT_TRUE(controller->executeSinglePathCalled);
+  EXPECT_FALSE(controller->executeAnalyticPathCalled);
+}
+
+TEST_F(AsyncLinearMotionProfileControllerTest, MoveToWithShapeUsesAnalyticPath) {
+  controller->setMoveToShape(LinearProfileShape::sCurve);
+  EXPECT_EQ(controller->getMoveToShape(), LinearProfileShape::sCurve);
+
+  controller->moveTo(0_m, 0.5_m);
+
+  EXPECT_TRUE(controller->executeAnalyticPathCalled);
+  EXPECT_FALSE(controller->executeSinglePathCalled);
+  EXPECT_EQ(output->lastControllerOutputSet, 0);
+  EXPECT_GT(output->maxControllerOutputSet, 0);
+  EXPECT_EQ(controller->getPaths().size(), 0);
+}
+
+namespace {
+/**
+ * A rate which doesn't wait and instead records the output last set on every tick.
+ */
+class RecordingMockRate : public MockRate {
+  public:
+  RecordingMockRate(MockAsyncVelIntegratedController &ioutput, std::vector<double> &ioutputs)
+    : output(ioutput), outputs(ioutputs) {
+  }
+
+  void delayUntil(QTime) override {
+    outputs.push_back(output.lastControllerOutputSet);
+  }
+
+  MockAsyncVelIntegratedController &output;
+  std::vector<double> &outputs;
+};
+} // namespace
+
+TEST_F(AsyncLinearMotionProfileControllerTest, ActuationLatency) {
+  EXPECT_EQ(controller->getActuationLatency(), 0_ms);
+  controller->setActuationLatency(30_ms);
+  EXPECT_EQ(controller->getActuationLatency(), 30_ms);
+  EXPECT_THROW(controller->setActuationLatency(-1_ms), std::invalid_argument);
+  EXPECT_EQ(controller->getActuationLatency(), 30_ms);
+}
+
+TEST_F(AsyncLinearMotionProfileControllerTest, ActuationLatencySendsCommandsEarly) {
+  controller->generatePath({0_m, 0.5_m}, "A");
+  const auto &path = controller->findPath("A")->getProfile();
+
+  std::vector<double> onTime;
+  controller->executeSinglePath(path, std::make_unique<RecordingMockRate>(*output, onTime));
+
+  std::vector<double> early;
+  controller->setActuationLatency(30_ms);
+  controller->executeSinglePath(path, std::make_unique<RecordingMockRate>(*output, early));
+
+  // Every command is sent three ticks early and the last command is held at the end
+  ASSERT_EQ(onTime.size(), path.size());
+  ASSERT_EQ(early.size(), path.size());
+  for (std::size_t i = 0; i < early.size(); ++i) {
+    EXPECT_EQ(early[i], onTime[std::min<std::size_t>(i + 3, onTime.size() - 1)]) << i;
+  }
+}
@@ -19,23 +19,59 @@ using namespace okapi;
 class MockAsyncMotionProfileController : public AsyncMotionProfileController {
   public:
   using AsyncMotionProfileController::AsyncMotionProfileController;
+  using AsyncMotionProfileController::compileMotorCommandTable;
   using AsyncMotionProfileController::convertLinearToRotational;
+  using AsyncMotionProfileController::findPath;
+  using AsyncMotionProfileController::getPendingPath;
+  using AsyncMotionProfileController::internalLoadBinaryPath;
   using AsyncMotionProfileController::internalLoadPath;
   using AsyncMotionProfileController::internalLoadPathfinderPath;
+  using AsyncMotionProfileController::internalStoreBinaryPath;
   using AsyncMotionProfileController::internalStorePath;
   using AsyncMotionProfileController::makeFilePath;
-
-  void executeSinglePath(const std::vector<squiggles::ProfilePoint> &path,
-                         std::unique_ptr<AbstractRate> rate) override {
+  using AsyncMotionProfileController::planJunctionVelocities;
+  using AsyncMotionProfileController::publishGeneratedPath;
+  using AsyncMotionProfileController::sendMotorCommand;
+  using AsyncMotionProfileController::sendRamseteCommand;
+  using AsyncMotionProfileController::sendVoltageCommand;
+  using AsyncMotionProfileController::startMove;
+  using FeedforwardTracking = AsyncMotionProfileController::FeedforwardTracking;
+  using RamseteTracking = AsyncMotionProfileController::RamseteTracking;
+
+  void executeSinglePath(const StoredPath &path,
+                         std::unique_ptr<AbstractRate> rate,
+                         MoveTracking &itracking) override {
     executeSinglePathCalled = true;
-    AsyncMotionProfileController::executeSinglePath(path, std::move(rate));
+    executeSinglePathCount++;
+    AsyncMotionProfileController::executeSinglePath(path, std::move(rate), itracking);
+  }
+
+  /**
+   * Follows a path as its own move.
+   */
+  void followPath(const StoredPath &path, std::unique_ptr<AbstractRate> rate) {
+    auto tracking = startMove(path);
+    executeSinglePath(path, std::move(rate), tracking);
   }
 
-  std::vector<squiggles::ProfilePoint> &getPathData(std::string ipathId) {
-    return paths.at(ipathId);
+  const std::vector<squiggles::ProfilePoint> &getPathData(std::string ipathId) {
+    return findPath(ipathId)->getProfile();
   }
 
-  bool executeSinglePathCalled{false};
+  std::atomic_bool executeSinglePathCalled{false};
+  std::atomic_int executeSinglePathCount{0};
+};
+
+/**
+ * A rate which overruns every fifth delay by 40 ms, like a task which is occasionally starved.
+ */
+class OverrunningMockRate : public MockRate {
+  public:
+  void delayUntil(QTime itime) override {
+    MockRate::delayUntil(++count % 5 == 0 ? itime + 40_ms : itime);
+  }
+
+  std::size_t count{0};
 };
 
 class AsyncMotionProfileControllerTest : public ::testing::Test {
@@ -150,6 +186,201 @@ TEST_F(AsyncMotionProfileControllerTest, TwoPathsOverwriteEachOther) {
   EXPECT_GT(rightMotor->maxVelocity, 0);
 }
 
+TEST_F(AsyncMotionProfileControllerTest, GeneratePathAsync) {
+  auto handle = controller->generatePathAsync(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 45_deg}}, "A");
+
+  EXPECT_EQ(handle->getPathId(), "A");
+  EXPECT_TRUE(handle->waitUntilDone());
+  EXPECT_EQ(handle->getState(), PathGenerationHandle::State::done);
+  EXPECT_EQ(controller->getPaths().front(), "A");
+  EXPECT_EQ(controller->getPaths().size(), 1);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, GenerateManyPathsAsync) {
+  std::vector<std::shared_ptr<PathGenerationHandle>> handles;
+  for (int i = 0; i < 8; ++i) {
+    handles.push_back(controller->generatePathAsync(
+      {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{(i + 1) * 1_ft, 0_m, 0_deg}},
+      std::to_string(i)));
+  }
+
+  for (const auto &handle : handles) {
+    EXPECT_TRUE(handle->waitUntilDone());
+  }
+
+  EXPECT_EQ(controller->getPaths().size(), 8);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, NewerAsyncPathWinsWhenOlderFinishesLast) {
+  // The older path is longer, so it takes longer to generate than the newer one
+  auto older = controller->generatePathAsync(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{10_ft, 2_ft, 0_deg}}, "A");
+  auto newer = controller->generatePathAsync(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 0_m, 0_deg}}, "A");
+
+  EXPECT_TRUE(newer->waitUntilDone());
+  EXPECT_FALSE(older->waitUntilDone());
+  EXPECT_EQ(older->getState(), PathGenerationHandle::State::superseded);
+
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 0_m, 0_deg}},
+                           "Newer");
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{10_ft, 2_ft, 0_deg}},
+                           "Older");
+  EXPECT_EQ(controller->getPathData("A"), controller->getPathData("Newer"));
+
+  // The older request finishing after the newer one doesn't replace the newer path
+  EXPECT_FALSE(controller->publishGeneratedPath(
+    controller->getPathHandle("A"), older, controller->findPath("Older")));
+  EXPECT_EQ(controller->getPathData("A"), controller->getPathData("Newer"));
+  EXPECT_EQ(newer->getState(), PathGenerationHandle::State::done);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, SetTargetWaitsForAsyncPath) {
+  auto handle = controller->generatePathAsync(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 0_deg}}, "A");
+  controller->setTarget("A");
+  controller->waitUntilSettled();
+
+  EXPECT_TRUE(handle->isDone());
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+  EXPECT_GT(leftMotor->maxVelocity, 0);
+  EXPECT_GT(rightMotor->maxVelocity, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, ImpossibleAsyncPathFails) {
+  auto handle = controller->generatePathAsync(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{9999_m, 0_m, 0_deg}}, "A");
+
+  EXPECT_FALSE(handle->waitUntilDone());
+  EXPECT_EQ(handle->getState(), PathGenerationHandle::State::failed);
+  EXPECT_NE(handle->getErrorMessage(), "");
+  EXPECT_EQ(controller->getPaths().size(), 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, ZeroWaypointsAsyncFailsImmediately) {
+  auto handle = controller->generatePathAsync({}, "A");
+  EXPECT_EQ(handle->getState(), PathGenerationHandle::State::failed);
+  EXPECT_EQ(controller->getPaths().size(), 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, GeneratePathsFromManifest) {
+  PathManifest manifest;
+  manifest.paths = {{"A", {{0_m, 0_m, 0_deg}, {3_ft, 0_m, 0_deg}}, {1.0, 2.0, 10.0}},
+                    {"B", {{0_m, 0_m, 0_deg}, {3_ft, 1_ft, 0_deg}}, {0.5, 1.0, 5.0}},
+                    {"C", {{0_m, 0_m, 0_deg}, {9999_m, 0_m, 0_deg}}, {1.0, 2.0, 10.0}}};
+
+  const auto batch = controller->generatePaths(manifest);
+  ASSERT_EQ(batch->size(), 3);
+  EXPECT_FALSE(batch->waitUntilDone());
+
+  EXPECT_EQ(batch->getSucceededCount(), 2);
+  EXPECT_EQ(batch->getHandle(2)->getState(), PathGenerationHandle::State::failed);
+  EXPECT_EQ(batch->getBytesUsed(0), controller->getPathBytesUsed("A"));
+  EXPECT_EQ(batch->getBytesUsed(1), controller->getPathBytesUsed("B"));
+  EXPECT_GT(batch->getBytesUsed(0), 0);
+  EXPECT_EQ(batch->getBytesUsed(2), 0);
+  EXPECT_EQ(batch->getTotalBytesUsed(), batch->getBytesUsed(0) + batch->getBytesUsed(1));
+  EXPECT_GE(batch->getGenerationTime(0), 0_ms);
+  EXPECT_EQ(controller->getPaths().size(), 2);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, CancelledBatchKeepsFinishedPaths) {
+  PathManifest manifest;
+  for (int i = 0; i < 100; ++i) {
+    manifest.paths.push_back(
+      {std::to_string(i), {{0_m, 0_m, 0_deg}, {3_ft, (i % 5) * 1_ft, 0_deg}}, {1.0, 2.0, 10.0}});
+  }
+
+  const auto batch = controller->generatePaths(manifest);
+  batch->cancel();
+  batch->waitUntilDone();
+
+  EXPECT_TRUE(batch->isCancelled());
+  EXPECT_LT(batch->getSucceededCount(), manifest.paths.size());
+  EXPECT_EQ(controller->getPaths().size(), batch->getSucceededCount());
+
+  // Skipped paths don't hold up a target
+  controller->setTarget("99");
+  controller->waitUntilSettled();
+  EXPECT_EQ(leftMotor->maxVelocity, 0);
+
+  // The workers stop tracking the skipped paths once they see the cancel
+  auto rate = createTimeUtil().getRate();
+  const auto last = controller->getPathHandle("99");
+  for (int i = 0; i < 1000 && controller->getPendingPath(last); ++i) {
+    rate->delayUntil(1_ms);
+  }
+  EXPECT_EQ(controller->getPendingPath(last), nullptr);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, DestroyingTheControllerFinishesItsBatch) {
+  PathManifest manifest;
+  for (int i = 0; i < 100; ++i) {
+    manifest.paths.push_back(
+      {std::to_string(i), {{0_m, 0_m, 0_deg}, {3_ft, (i % 5) * 1_ft, 0_deg}}, {1.0, 2.0, 10.0}});
+  }
+
+  const auto batch = controller->generatePaths(manifest);
+  delete controller;
+  controller = nullptr;
+
+  // Every path is either done or failed, so nothing waits on the batch forever
+  EXPECT_FALSE(batch->waitUntilDone());
+  EXPECT_LT(batch->getSucceededCount(), manifest.paths.size());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, LaterBatchEntryWinsForTheSameId) {
+  PathManifest manifest;
+  manifest.paths.push_back({"A", {{0_m, 0_m, 0_deg}, {10_ft, 2_ft, 0_deg}}, {1.0, 2.0, 10.0}});
+  manifest.paths.push_back({"A", {{0_m, 0_m, 0_deg}, {1_ft, 0_m, 0_deg}}, {1.0, 2.0, 10.0}});
+
+  const auto batch = controller->generatePaths(manifest);
+  EXPECT_FALSE(batch->waitUntilDone());
+  EXPECT_EQ(batch->getHandle(0)->getState(), PathGenerationHandle::State::superseded);
+  EXPECT_EQ(batch->getHandle(1)->getState(), PathGenerationHandle::State::done);
+
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 0_m, 0_deg}},
+                           "Newer");
+  EXPECT_EQ(controller->getPathData("A"), controller->getPathData("Newer"));
+}
+
+TEST_F(AsyncMotionProfileControllerTest, SavingAPathDropsItsPendingGeneration) {
+  auto handle = controller->generatePathAsync(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{10_ft, 2_ft, 0_deg}}, "A");
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 0_m, 0_deg}},
+                           "A");
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 0_m, 0_deg}},
+                           "Newer");
+
+  // Either the generation finished first, or it was dropped and the saved path stays
+  handle->waitUntilDone();
+  EXPECT_EQ(controller->getPendingPath(controller->getPathHandle("A")), nullptr);
+  EXPECT_EQ(controller->getPathData("A"), controller->getPathData("Newer"));
+}
+
+TEST_F(AsyncMotionProfileControllerTest, EmptyManifestIsDone) {
+  const auto batch = controller->generatePaths(PathManifest{});
+  EXPECT_EQ(batch->size(), 0);
+  EXPECT_TRUE(batch->waitUntilDone());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, MoveToReusesCachedPath) {
+  auto cache = std::make_shared<PathCache>();
+  controller->setPathCache(cache);
+
+  controller->moveTo({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 0_m, 0_deg}});
+  EXPECT_EQ(cache->getMisses(), 1);
+  EXPECT_EQ(cache->getHits(), 0);
+
+  controller->moveTo({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 0_m, 0_deg}});
+  EXPECT_EQ(cache->getMisses(), 1);
+  EXPECT_EQ(cache->getHits(), 1);
+
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+  EXPECT_GT(leftMotor->maxVelocity, 0);
+}
+
 TEST_F(AsyncMotionProfileControllerTest, ImpossiblePathThrowsException) {
   // Path is too long to fit within the time window considered by Squiggles
   EXPECT_THROW(controller->generatePath(
@@ -198,9 +429,29 @@ TEST_F(AsyncMotionProfileControllerTest, ReplaceRunningPath) {
 
   controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 3_ft, 45_deg}},
                            "A");
-  EXPECT_EQ(controller->isDisabled(), true);
+  EXPECT_FALSE(controller->isDisabled());
 
   EXPECT_EQ(controller->getPaths().size(), 1);
+
+  // The robot finishes the path it started with
+  controller->waitUntilSettled();
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+  EXPECT_GT(leftMotor->maxVelocity, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, ReplacedPathSnapshotStaysValid) {
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 0_deg}},
+                           "A");
+  const auto snapshot = controller->findPath("A");
+  ASSERT_NE(snapshot, nullptr);
+  const auto oldProfile = snapshot->getProfile();
+
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 3_ft, 45_deg}},
+                           "A");
+  controller->removePath("A");
+
+  EXPECT_EQ(controller->findPath("A"), nullptr);
+  EXPECT_EQ(snapshot->getProfile(), oldProfile);
 }
 
 TEST_F(AsyncMotionProfileControllerTest, RemoveAPathWhichDoesNotExist) {
@@ -211,6 +462,164 @@ TEST_F(AsyncMotionProfileControllerTest, RemoveAPathWhichDoesNotExist) {
   EXPECT_EQ(controller->getPaths().size(), 0);
 }
 
+TEST_F(AsyncMotionProfileControllerTest, FollowPathWithHandle) {
+  const auto handle = controller->generatePath(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 0_deg}}, "A");
+  ASSERT_TRUE(handle.isValid());
+  EXPECT_EQ(controller->getPathHandle("A"), handle);
+
+  controller->setTarget(handle);
+  EXPECT_EQ(controller->getTarget(), "A");
+  controller->waitUntilSettled();
+
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+  EXPECT_GT(leftMotor->maxVelocity, 0);
+  EXPECT_GT(rightMotor->maxVelocity, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, HandleIsStableAcrossRegeneration) {
+  EXPECT_FALSE(controller->getPathHandle("A").isValid());
+
+  const auto handle = controller->generatePath(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 0_deg}}, "A");
+  EXPECT_EQ(controller->getPathHandle("A"), handle);
+  EXPECT_TRUE(controller->removePath(handle));
+  EXPECT_EQ(controller->findPath(handle), nullptr);
+  EXPECT_EQ(controller->getPaths().size(), 0);
+
+  EXPECT_EQ(controller->generatePath(
+              {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{2_ft, 0_m, 0_deg}}, "A"),
+            handle);
+  EXPECT_NE(controller->findPath(handle), nullptr);
+  EXPECT_FALSE(controller->getPathHandle("B").isValid());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, UnknownIdsDoNotGrowThePathTable) {
+  controller->setTarget("Typo");
+  EXPECT_EQ(controller->getTarget(), "Typo");
+  controller->enqueuePath("Typo");
+  controller->queuePaths({"Typo"});
+  controller->waitUntilSettled();
+
+  EXPECT_FALSE(controller->getPathHandle("Typo").isValid());
+  EXPECT_EQ(leftMotor->maxVelocity, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, RemoveRunningPathWithHandle) {
+  const auto handle = controller->generatePath(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 45_deg}}, "A");
+  controller->setTarget(handle);
+
+  EXPECT_FALSE(controller->removePath(handle));
+  EXPECT_EQ(controller->getPaths().size(), 1);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, ZeroWaypointsReturnsInvalidHandle) {
+  EXPECT_FALSE(controller->generatePath({}, "A").isValid());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, TransformPathKeepsTheProfile) {
+  const auto source = controller->generatePath(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 0_deg}}, "A");
+  const auto moved = controller->transformPath(source, "B", {1_m, 2_m, 90_deg});
+  ASSERT_TRUE(moved.isValid());
+  EXPECT_EQ(controller->getPaths(), (std::vector<std::string>{"A", "B"}));
+
+  const auto original = controller->findPath(source);
+  const auto copy = controller->findPath(moved);
+  ASSERT_EQ(copy->size(), original->size());
+  // Turned 90 degrees clockwise, forwards is +y in the field, which is +x in the frame of a path
+  EXPECT_NEAR(copy->getPose(0).x, original->getPose(0).y + 2, 1e-9);
+  EXPECT_NEAR(copy->getPose(0).y, -original->getPose(0).x + 1, 1e-9);
+  for (std::size_t i = 0; i < original->size(); ++i) {
+    EXPECT_EQ(copy->getWheelVelocity(0, i), original->getWheelVelocity(0, i));
+    EXPECT_EQ(copy->getWheelVelocity(1, i), original->getWheelVelocity(1, i));
+  }
+}
+
+TEST_F(AsyncMotionProfileControllerTest, MirrorPathSwapsTheWheels) {
+  const auto source = controller->generatePath(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 1_ft, 0_deg}}, "A");
+  const auto mirrored = controller->mirrorPath(source, "B");
+
+  const auto original = controller->findPath(source);
+  const auto copy = controller->findPath(mirrored);
+  ASSERT_EQ(copy->size(), original->size());
+  for (std::size_t i = 0; i < original->size(); ++i) {
+    EXPECT_EQ(copy->getWheelVelocity(0, i), original->getWheelVelocity(1, i));
+    EXPECT_EQ(copy->getWheelVelocity(1, i), original->getWheelVelocity(0, i));
+  }
+
+  // Following the mirrored copy turns the same way as following the original mirrored
+  controller->setTarget(mirrored);
+  controller->waitUntilSettled();
+  EXPECT_GT(rightMotor->maxVelocity, leftMotor->maxVelocity);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, StitchPathsFollowsBoth) {
+  const auto source = controller->generatePath(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{2_ft, 0_m, 0_deg}}, "A");
+  const auto stitched = controller->stitchPaths(source, source, "B");
+  ASSERT_TRUE(stitched.isValid());
+
+  const auto size = controller->findPath(source)->size();
+  const auto path = controller->findPath(stitched);
+  ASSERT_EQ(path->size(), 2 * size - 1);
+  // The second copy starts where the first one ends
+  const auto start = controller->findPath(source)->getPose(0);
+  const auto end = controller->findPath(source)->getPose(size - 1);
+  EXPECT_NEAR(path->getPose(path->size() - 1).y, 2 * end.y - start.y, 1e-9);
+
+  controller->setTarget(stitched);
+  controller->waitUntilSettled();
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+  EXPECT_GT(leftMotor->maxVelocity, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, StitchPathsWithAVelocityJumpThrows) {
+  // The first path of a chain ends moving, but every path starts stopped
+  controller->generatePathChain(
+    {{PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 0_deg}},
+     {PathfinderPoint{3_ft, 0_m, 0_deg}, PathfinderPoint{6_ft, 0_m, 0_deg}}},
+    {"A", "B"});
+  const auto first = controller->getPathHandle("A");
+  EXPECT_THROW(controller->stitchPaths(first, first, "C"), std::invalid_argument);
+  EXPECT_EQ(controller->findPath("C"), nullptr);
+
+  // The chain was planned so its paths join
+  EXPECT_TRUE(controller->stitchPaths(first, controller->getPathHandle("B"), "C").isValid());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, ReversePathDrivesBackwards) {
+  const auto source = controller->generatePath(
+    {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 0_deg}}, "A");
+  controller->setTarget(controller->reversePath(source, "B"));
+
+  auto rate = createTimeUtil().getRate();
+  while (!controller->executeSinglePathCalled) {
+    rate->delayUntil(1_ms);
+  }
+
+  // Wait a little longer so we get into the path
+  rate->delayUntil(200_ms);
+
+  EXPECT_LT(leftMotor->lastVelocity, 0);
+  EXPECT_LT(rightMotor->lastVelocity, 0);
+
+  // Disable the controller so gtest doesn't clean up the test fixture while the internal thread is
+  // still running
+  controller->flipDisable(true);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, DeriveFromMissingPathSavesNothing) {
+  const auto missing = controller->getPathHandle("A");
+  EXPECT_FALSE(controller->transformPath(missing, "B", {1_m, 0_m, 0_deg}).isValid());
+  EXPECT_FALSE(controller->mirrorPath(missing, "B").isValid());
+  EXPECT_FALSE(controller->reversePath(missing, "B").isValid());
+  EXPECT_FALSE(controller->stitchPaths(missing, missing, "B").isValid());
+  EXPECT_TRUE(controller->getPaths().empty());
+}
+
 TEST_F(AsyncMotionProfileControllerTest, ControllerSetChangesTarget) {
   controller->controllerSet("A");
   EXPECT_EQ(controller->getTarget(), "A");
@@ -334,6 +743,460 @@ TEST_F(AsyncMotionProfileControllerTest, FollowPathMirrored) {
   controller->flipDisable(true);
 }
 
+TEST_F(AsyncMotionProfileControllerTest, PathsAreNotCompiledByDefault) {
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 1_ft, 0_deg}},
+                           "A");
+  EXPECT_FALSE(controller->getCompileMotorCommands());
+  EXPECT_FALSE(controller->findPath("A")->hasCommands());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, CompiledMotorCommandsMatchConversion) {
+  controller->setCompileMotorCommands(true);
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 1_ft, 0_deg}},
+                           "A");
+
+  const auto path = controller->findPath("A");
+  ASSERT_TRUE(path->hasCommands());
+  EXPECT_EQ(path->commands.size(), path->getProfile().size() * StoredPath::commandVariantCount);
+
+  const auto forward = path->getCommands(false, false);
+  const auto mirrored = path->getCommands(true, false);
+  const auto reversed = path->getCommands(false, true);
+  const auto both = path->getCommands(true, true);
+  for (std::size_t i = 0; i < path->getProfile().size(); ++i) {
+    const double left =
+      controller->convertLinearToRotational(path->getProfile()[i].wheel_velocities[0] * mps)
+        .convert(rpm) /
+      200.0;
+    const double right =
+      controller->convertLinearToRotational(path->getProfile()[i].wheel_velocities[1] * mps)
+        .convert(rpm) /
+      200.0;
+
+    EXPECT_DOUBLE_EQ(forward[i].left, left);
+    EXPECT_DOUBLE_EQ(forward[i].right, right);
+    EXPECT_DOUBLE_EQ(mirrored[i].left, right);
+    EXPECT_DOUBLE_EQ(mirrored[i].right, left);
+    EXPECT_DOUBLE_EQ(reversed[i].left, -left);
+    EXPECT_DOUBLE_EQ(reversed[i].right, -right);
+    EXPECT_DOUBLE_EQ(both[i].left, -right);
+    EXPECT_DOUBLE_EQ(both[i].right, -left);
+  }
+}
+
+TEST_F(AsyncMotionProfileControllerTest, CompilePathWithoutWheelVelocities) {
+  std::vector<squiggles::ProfilePoint> path{
+    squiggles::ProfilePoint{squiggles::ControlVector{}, {}, 0, 0}};
+  EXPECT_TRUE(controller->compileMotorCommandTable(path).empty());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, FollowCompiledPathMirrored) {
+  controller->setCompileMotorCommands(true);
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 1_ft, 0_deg}},
+                           "A");
+  controller->setTarget("A", false, true);
+
+  auto rate = createTimeUtil().getRate();
+  while (!controller->executeSinglePathCalled) {
+    rate->delayUntil(1_ms);
+  }
+
+  // Wait a little longer so we get into the path
+  rate->delayUntil(200_ms);
+
+  EXPECT_NE(leftMotor->lastVelocity, 0);
+  EXPECT_NE(rightMotor->lastVelocity, 0);
+  EXPECT_GT(rightMotor->maxVelocity, leftMotor->maxVelocity);
+
+  // Disable the controller so gtest doesn't clean up the test fixture while the internal thread is
+  // still running
+  controller->flipDisable(true);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, CompactPathUsesLessMemory) {
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 1_ft, 0_deg}},
+                           "A");
+  controller->setCompactPathStorage(true);
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 1_ft, 0_deg}},
+                           "B");
+
+  EXPECT_FALSE(controller->findPath("A")->isCompact());
+  EXPECT_TRUE(controller->findPath("B")->isCompact());
+  EXPECT_LT(controller->getPathBytesUsed("B"), controller->getPathBytesUsed("A") / 3);
+  EXPECT_EQ(controller->getPathBytesUsed("C"), 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, FollowCompactPath) {
+  controller->setCompactPathStorage(true);
+  controller->moveTo({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 1_ft, 0_deg}});
+
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+  EXPECT_GT(leftMotor->maxVelocity, rightMotor->maxVelocity);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, NativeTrajectoryGenerationIsOffByDefault) {
+  EXPECT_FALSE(controller->getNativeTrajectoryGeneration());
+  controller->setNativeTrajectoryGeneration(true);
+  EXPECT_TRUE(controller->getNativeTrajectoryGeneration());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, FollowNativePath) {
+  controller->setNativeTrajectoryGeneration(true);
+  controller->moveTo({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 0_deg}});
+
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+  EXPECT_GT(leftMotor->maxVelocity, 0);
+  EXPECT_GT(rightMotor->maxVelocity, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, GenerateNativePathLongerThanTwentySeconds) {
+  controller->setNativeTrajectoryGeneration(true);
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{30_m, 0_m, 0_deg}},
+                           "A");
+
+  EXPECT_GT(controller->findPath("A")->size(), 3000);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, GenerateManyNativePathsAsync) {
+  controller->setNativeTrajectoryGeneration(true);
+
+  std::vector<std::shared_ptr<PathGenerationHandle>> handles;
+  for (int i = 0; i < 8; ++i) {
+    handles.push_back(controller->generatePathAsync(
+      {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{(i + 1) * 1_ft, i * 1_in, 0_deg}},
+      std::to_string(i)));
+  }
+
+  for (const auto &handle : handles) {
+    EXPECT_TRUE(handle->waitUntilDone());
+  }
+
+  // Generations which ran at the same time didn't share a generator
+  for (int i = 0; i < 8; ++i) {
+    controller->generatePath(
+      {PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{(i + 1) * 1_ft, i * 1_in, 0_deg}}, "B");
+    EXPECT_EQ(controller->getPathData(std::to_string(i)), controller->getPathData("B")) << i;
+  }
+}
+
+TEST_F(AsyncMotionProfileControllerTest, NativePathsAreCachedSeparately) {
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 1_ft, 0_deg}},
+                           "A");
+  controller->setNativeTrajectoryGeneration(true);
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 1_ft, 0_deg}},
+                           "B");
+
+  // The native path starts on the first waypoint, so a cached squiggles path wasn't reused
+  EXPECT_NE(controller->findPath("A")->getPose(0).y, 0);
+  EXPECT_EQ(controller->findPath("B")->getPose(0).y, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, SaveCompactPath) {
+  controller->setCompactPathStorage(true);
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 0_deg}},
+                           "A");
+  const auto stored = controller->findPath("A");
+
+  std::stringstream file;
+  controller->internalStoreBinaryPath(file, "A");
+  controller->setCompactPathStorage(false);
+  EXPECT_TRUE(controller->internalLoadBinaryPath(file, "B"));
+
+  const auto loaded = controller->findPath("B");
+  ASSERT_EQ(loaded->size(), stored->size());
+  for (std::size_t i = 0; i < loaded->size(); ++i) {
+    EXPECT_DOUBLE_EQ(loaded->getWheelVelocity(0, i), stored->getWheelVelocity(0, i));
+  }
+}
+
+class AsyncMotionProfileControllerOverrunTest : public ::testing::Test {
+  protected:
+  void SetUp() override {
+    leftMotor = std::make_shared<MockMotor>();
+    rightMotor = std::make_shared<MockMotor>();
+
+    auto model = std::make_shared<SkidSteerModel>(leftMotor,
+                                                  rightMotor,
+                                                  leftMotor->getEncoder(),
+                                                  rightMotor->getEncoder(),
+                                                  100,
+                                                  v5MotorMaxVoltage);
+
+    TimeUtil timeUtil(
+      Supplier<std::unique_ptr<AbstractTimer>>([]() { return std::make_unique<MockTimer>(); }),
+      Supplier<std::unique_ptr<AbstractRate>>(
+        []() { return std::make_unique<OverrunningMockRate>(); }),
+      Supplier<std::unique_ptr<SettledUtil>>([]() { return createSettledUtilPtr(); }));
+
+    controller = std::make_unique<MockAsyncMotionProfileController>(
+      timeUtil,
+      PathfinderLimits{1.0, 2.0, 10.0},
+      model,
+      ChassisScales{{4_in, 10.5_in}, quadEncoderTPR},
+      AbstractMotor::gearset::green * (1.0 / 2));
+    controller->startThread();
+
+    controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{2_ft, 0_m, 0_deg}},
+                             "A");
+    pathDuration = controller->findPath("A")->size() * 10_ms;
+  }
+
+  /**
+   * Follows path A and returns how long it took.
+   */
+  QTime followPath() {
+    MockTimer timer;
+    const QTime start = timer.millis();
+    controller->setTarget("A");
+    controller->waitUntilSettled();
+    return timer.millis() - start;
+  }
+
+  std::shared_ptr<MockMotor> leftMotor;
+  std::shared_ptr<MockMotor> rightMotor;
+  std::unique_ptr<MockAsyncMotionProfileController> controller;
+  QTime pathDuration{0_ms};
+};
+
+TEST_F(AsyncMotionProfileControllerOverrunTest, SegmentFollowingFallsBehind) {
+  const QTime elapsed = followPath();
+
+  // Every overrun pushes the rest of the path back
+  EXPECT_GT(elapsed, pathDuration + 0.5 * (pathDuration / 50_ms).getValue() * 40_ms);
+
+  const auto stats = controller->getFollowStatistics();
+  EXPECT_GT(stats.lateTicks, 0);
+  EXPECT_GE(stats.maxLateness, 35_ms);
+}
+
+TEST_F(AsyncMotionProfileControllerOverrunTest, TimeIndexedFollowingFinishesOnTime) {
+  controller->setTimeIndexedFollowing(true);
+  const QTime elapsed = followPath();
+
+  // The path ends on time, give or take one overrun and the settling time
+  EXPECT_LT(elapsed, pathDuration + 150_ms);
+
+  const auto stats = controller->getFollowStatistics();
+  EXPECT_GT(stats.lateTicks, 0);
+  EXPECT_GE(stats.maxLateness, 35_ms);
+  EXPECT_LT(stats.ticks, (pathDuration / 10_ms).getValue());
+  EXPECT_GT(leftMotor->maxVelocity, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, FollowStatisticsWithoutOverruns) {
+  controller->moveTo({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 0_m, 0_deg}});
+
+  const auto stats = controller->getFollowStatistics();
+  EXPECT_GT(stats.ticks, 0);
+  EXPECT_LT(stats.maxLateness, 10_ms);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, PlanJunctionVelocities) {
+  const std::vector<PathfinderPoint> waypoints{{0_m, 0_m, 0_deg},
+                                               {1_m, 0_m, 0_deg},
+                                               {2_m, 0_m, 0_deg},
+                                               {2.1_m, 0_m, 0_deg}};
+  const auto velocities =
+    MockAsyncMotionProfileController::planJunctionVelocities(waypoints, {0, 1, 2, 3}, {1, 2, 10});
+
+  ASSERT_EQ(velocities.size(), 4);
+  EXPECT_EQ(velocities[0], 0);
+  EXPECT_EQ(velocities[1], 1);                              // Limited by the max velocity
+  EXPECT_NEAR(velocities[2], std::sqrt(2 * 2 * 0.1), 1e-9); // Limited by stopping in 0.1 m
+  EXPECT_EQ(velocities[3], 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, StreamedMoveToFollowsEveryChunk) {
+  controller->setMoveToStreaming(1);
+  controller->moveTo({PathfinderPoint{0_m, 0_m, 0_deg},
+                      PathfinderPoint{1_ft, 0_m, 0_deg},
+                      PathfinderPoint{2_ft, 0_m, 0_deg},
+                      PathfinderPoint{3_ft, 0_m, 0_deg}});
+
+  EXPECT_EQ(controller->executeSinglePathCount, 3);
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+  EXPECT_GT(leftMotor->maxVelocity, 0);
+  EXPECT_TRUE(controller->isSettled());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, StreamedMoveToWithLeadTime) {
+  controller->setMoveToStreaming(2, 10_s);
+  controller->moveTo({PathfinderPoint{0_m, 0_m, 0_deg},
+                      PathfinderPoint{1_ft, 0_m, 0_deg},
+                      PathfinderPoint{2_ft, 0_m, 0_deg},
+                      PathfinderPoint{3_ft, 0_m, 0_deg}});
+
+  // The lead time is longer than the whole path, so following starts when generation finishes
+  EXPECT_EQ(controller->executeSinglePathCount, 2);
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, ShortMoveToIsNotStreamed) {
+  controller->setMoveToStreaming(2);
+  controller->moveTo({PathfinderPoint{0_m, 0_m, 0_deg},
+                      PathfinderPoint{1_ft, 0_m, 0_deg},
+                      PathfinderPoint{2_ft, 0_m, 0_deg}});
+
+  EXPECT_EQ(controller->executeSinglePathCount, 1);
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, StreamedMoveToWithImpossibleChunkThrows) {
+  controller->setMoveToStreaming(1);
+  EXPECT_THROW(controller->moveTo({PathfinderPoint{0_m, 0_m, 0_deg},
+                                   PathfinderPoint{1_ft, 0_m, 0_deg},
+                                   PathfinderPoint{100_m, 0_m, 0_deg}}),
+               std::runtime_error);
+
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+  EXPECT_TRUE(controller->isSettled());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, GeneratePathChainMatchesVelocities) {
+  controller->generatePathChain({{{0_m, 0_m, 0_deg}, {2_ft, 0_m, 0_deg}},
+                                 {{2_ft, 0_m, 0_deg}, {4_ft, 0_m, 0_deg}},
+                                 {{4_ft, 0_m, 0_deg}, {6_ft, 0_m, 0_deg}}},
+                                {"A", "B", "C"});
+
+  const auto a = controller->getPathData("A");
+  const auto b = controller->getPathData("B");
+  const auto c = controller->getPathData("C");
+
+  // The chain only stops at its ends
+  EXPECT_LT(a.front().vector.vel, 0.1);
+  EXPECT_GT(a.back().vector.vel, 0);
+  EXPECT_GT(b.front().vector.vel, 0.5 * a.back().vector.vel);
+  EXPECT_GT(b.back().vector.vel, 0);
+  EXPECT_GT(c.front().vector.vel, 0.5 * b.back().vector.vel);
+  EXPECT_EQ(c.back().vector.vel, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, GeneratePathChainPlansFromEachPathsOwnLength) {
+  // Both paths start at the origin, so the joined waypoints would count a 1 m gap between them
+  controller->generatePathChain(
+    {{{0_m, 0_m, 0_deg}, {1_m, 0_m, 0_deg}}, {{0_m, 0_m, 0_deg}, {0.1_m, 0_m, 0_deg}}},
+    {"A", "B"});
+
+  const auto a = controller->getPathData("A");
+  const auto b = controller->getPathData("B");
+
+  // B can only stop from sqrt(2 * maxAccel * 0.1 m) at its start, which is below the max velocity
+  const double maxJunctionVel = std::sqrt(2 * 2.0 * 0.1);
+  EXPECT_LE(a.back().vector.vel, maxJunctionVel + 1e-6);
+  EXPECT_LE(b.front().vector.vel, maxJunctionVel + 1e-6);
+  EXPECT_GT(b.front().vector.vel, 0);
+  EXPECT_EQ(b.back().vector.vel, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, PlanJunctionVelocitiesFromLengths) {
+  const std::vector<double> lengths{1, 0.1};
+  const auto velocities =
+    MockAsyncMotionProfileController::planJunctionVelocities(lengths, {1, 2, 10});
+
+  ASSERT_EQ(velocities.size(), 3);
+  EXPECT_EQ(velocities[0], 0);
+  EXPECT_NEAR(velocities[1], std::sqrt(2 * 2 * 0.1), 1e-9);
+  EXPECT_EQ(velocities[2], 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, GeneratePathChainWithMismatchedIdsThrows) {
+  EXPECT_THROW(controller->generatePathChain({{{0_m, 0_m, 0_deg}, {2_ft, 0_m, 0_deg}}}, {"A", "B"}),
+               std::invalid_argument);
+  EXPECT_THROW(controller->generatePathChain({{{0_m, 0_m, 0_deg}}}, {"A"}), std::invalid_argument);
+  EXPECT_TRUE(controller->getPaths().empty());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, QueuedPathsDoNotStopInBetween) {
+  controller->generatePathChain({{{0_m, 0_m, 0_deg}, {2_ft, 0_m, 0_deg}},
+                                 {{2_ft, 0_m, 0_deg}, {4_ft, 0_m, 0_deg}}},
+                                {"A", "B"});
+
+  controller->queuePaths({"A", "B"});
+
+  auto rate = createTimeUtil().getRate();
+  while (controller->executeSinglePathCount < 1) {
+    rate->delayUntil(1_ms);
+  }
+
+  // Wait until the chassis is moving, then make sure it doesn't stop until the second path is
+  // well underway
+  while (leftMotor->lastVelocity == 0) {
+    rate->delayUntil(1_ms);
+  }
+
+  while (controller->executeSinglePathCount < 2) {
+    EXPECT_NE(leftMotor->lastVelocity, 0) << "The chassis stopped between queued paths";
+    rate->delayUntil(2_ms);
+  }
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_NE(leftMotor->lastVelocity, 0) << "The chassis stopped between queued paths";
+    rate->delayUntil(2_ms);
+  }
+
+  controller->waitUntilSettled();
+  EXPECT_EQ(controller->executeSinglePathCount, 2);
+  EXPECT_TRUE(controller->getQueuedPaths().empty());
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, EnqueuePathWhileFollowingQueue) {
+  controller->generatePathChain({{{0_m, 0_m, 0_deg}, {2_ft, 0_m, 0_deg}},
+                                 {{2_ft, 0_m, 0_deg}, {4_ft, 0_m, 0_deg}}},
+                                {"A", "B"});
+
+  controller->queuePaths({"A"});
+  controller->enqueuePath("B");
+  controller->waitUntilSettled();
+
+  EXPECT_EQ(controller->executeSinglePathCount, 2);
+  EXPECT_EQ(controller->getTarget(), "B");
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, EnqueuePathWhenIdleStartsQueue) {
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 0_m, 0_deg}},
+                           "A");
+
+  controller->enqueuePath("A");
+  EXPECT_FALSE(controller->isSettled());
+  controller->waitUntilSettled();
+
+  EXPECT_EQ(controller->executeSinglePathCount, 1);
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+}
+
+TEST_F(AsyncMotionProfileControllerTest, SetTargetClearsQueue) {
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{1_ft, 0_m, 0_deg}},
+                           "A");
+
+  controller->flipDisable(true);
+  controller->queuePaths({"A", "A", "A"});
+  controller->setTarget("A");
+  EXPECT_TRUE(controller->getQueuedPaths().empty());
+  controller->flipDisable(false);
+  controller->waitUntilSettled();
+
+  EXPECT_EQ(controller->executeSinglePathCount, 1);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, DisablingDropsQueue) {
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 0_deg}},
+                           "A");
+
+  controller->queuePaths({"A", "A"});
+
+  auto rate = createTimeUtil().getRate();
+  while (!controller->executeSinglePathCalled) {
+    rate->delayUntil(1_ms);
+  }
+
+  controller->reset();
+  EXPECT_TRUE(controller->getQueuedPaths().empty());
+  EXPECT_EQ(controller->executeSinglePathCount, 1);
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+}
+
 TEST_F(AsyncMotionProfileControllerTest, FilePathJoin) {
   EXPECT_STREQ(MockAsyncMotionProfileController::makeFilePath("/usd/", "test").c_str(),
                "/usd/test");
@@ -384,6 +1247,28 @@ TEST_F(AsyncMotionProfileControllerTest, SaveLoadPath) {
   EXPECT_EQ(controller->getTarget(), "A");
 }
 
+TEST_F(AsyncMotionProfileControllerTest, SaveLoadBinaryPath) {
+  controller->generatePath(
+    {PathfinderPoint{0_in, 0_in, 0_deg}, PathfinderPoint{3_ft, 0_in, 45_deg}}, "A");
+
+  std::stringstream binaryPathFile;
+  controller->internalStoreBinaryPath(binaryPathFile, "A");
+
+  auto startingPath = controller->getPathData("A");
+
+  controller->removePath("A");
+  EXPECT_TRUE(controller->internalLoadBinaryPath(binaryPathFile, "A"));
+  EXPECT_EQ(controller->getPaths().front(), "A");
+  EXPECT_EQ(controller->getPaths().size(), 1);
+  EXPECT_EQ(controller->getPathData("A"), startingPath);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, LoadCorruptBinaryPathDoesNothing) {
+  std::stringstream binaryPathFile("not a path");
+  EXPECT_FALSE(controller->internalLoadBinaryPath(binaryPathFile, "A"));
+  EXPECT_EQ(controller->getPaths().size(), 0);
+}
+
 TEST_F(AsyncMotionProfileControllerTest, LoadPathfinderPath) {
   controller->removePath("A");
   controller->internalLoadPathfinderPath(leftPathFile, rightPathFile, "A");
@@ -402,3 +1287,489 @@ TEST_F(AsyncMotionProfileControllerTest, LoadPathfinderPath) {
   controller->setTarget("A");
   EXPECT_EQ(controller->getTarget(), "A");
 }
+
+TEST_F(AsyncMotionProfileControllerTest, GeneratedPathMatchesCompiledPath) {
+  const std::vector<PathfinderPoint> waypoints{{0_m, 0_m, 0_deg}, {3_ft, 1_ft, 30_deg}};
+  controller->generatePath({waypoints[0], waypoints[1]}, "A");
+
+  const auto compiled = SplineProfile::generate(waypoints, {1.0, 2.0, 10.0}, 10.5_in, 0.01);
+  const auto &generated = controller->getPathData("A");
+
+  ASSERT_EQ(generated.size(), compiled.size());
+  for (std::size_t i = 0; i < generated.size(); ++i) {
+    EXPECT_EQ(generated[i].vector.pose.x, compiled[i].vector.pose.x);
+    EXPECT_EQ(generated[i].wheel_velocities, compiled[i].wheel_velocities);
+  }
+}
+
+TEST_F(AsyncMotionProfileControllerTest, FollowPathView) {
+  const auto profile = SplineProfile::generate(
+    {{0_m, 0_m, 0_deg}, {3_ft, 0_m, 0_deg}}, {1.0, 2.0, 10.0}, 10.5_in, 0.01);
+
+  std::vector<StaticPathPoint> points;
+  for (const auto &point : profile) {
+    points.push_back({point.vector.pose.x,
+                      point.vector.pose.y,
+                      point.vector.pose.yaw,
+                      point.vector.vel,
+                      point.vector.accel,
+                      point.vector.jerk,
+                      point.curvature,
+                      point.time,
+                      {point.wheel_velocities[0], point.wheel_velocities[1]}});
+  }
+
+  controller->addPathView("A", PathView(points.data(), points.size()));
+
+  ASSERT_EQ(controller->getPaths().size(), 1);
+  EXPECT_EQ(controller->findPath("A")->getView().data(), points.data());
+  EXPECT_EQ(controller->getPathBytesUsed("A"), sizeof(StoredPath));
+
+  controller->setTarget("A");
+  controller->waitUntilSettled();
+
+  EXPECT_TRUE(controller->executeSinglePathCalled);
+  assertMotorsHaveBeenStopped(leftMotor.get(), rightMotor.get());
+  EXPECT_GT(leftMotor->maxVelocity, 0);
+  EXPECT_GT(rightMotor->maxVelocity, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, AddPathViews) {
+  static constexpr StaticPathPoint points[] = {
+    {0, 0, 0, 0.1, 0, 0, 0, 0.01, {0.1, 0.1}},
+    {0.001, 0, 0, 0.1, 0, 0, 0, 0.01, {0.1, 0.1}},
+  };
+  static constexpr NamedPathView paths[] = {{"A", PathView(points)}, {"B", PathView()}};
+
+  controller->setCompactPathStorage(true);
+  controller->addPathViews(paths);
+
+  // Empty views are skipped and views are never copied into compact storage
+  ASSERT_EQ(controller->getPaths().size(), 1);
+  EXPECT_TRUE(controller->findPath("A")->isView());
+  EXPECT_FALSE(controller->findPath("A")->isCompact());
+  EXPECT_EQ(controller->findPath("A")->size(), 2);
+}
+
+TEST(FeedforwardGainsTest, Calculate) {
+  const FeedforwardGains gains{0.5, 2, 0.1};
+  EXPECT_DOUBLE_EQ(gains.calculate(1, 10), 0.5 + 2 + 1);
+  EXPECT_DOUBLE_EQ(gains.calculate(-1, -10), -0.5 - 2 - 1);
+  // Static friction only applies while moving
+  EXPECT_DOUBLE_EQ(gains.calculate(0, 10), 1);
+}
+
+namespace {
+StoredPath makeWheelPath(const std::vector<std::pair<double, double>> &iwheelVelocities) {
+  std::vector<squiggles::ProfilePoint> profile;
+  for (const auto &[left, right] : iwheelVelocities) {
+    profile.emplace_back(squiggles::ControlVector(squiggles::Pose(0, 0, 0), 0, 0, 0),
+                         std::vector<double>{left, right},
+                         0,
+                         0.01);
+  }
+  return StoredPath(std::move(profile));
+}
+} // namespace
+
+TEST_F(AsyncMotionProfileControllerTest, SendVoltageCommandUsesVelocityAndAcceleration) {
+  controller->flipDisable(true);
+  const auto path = makeWheelPath({{0.5, 0.25}, {1, 0.5}, {1, 0.5}});
+  const FeedforwardGains gains{0.5, 2, 0.1};
+
+  MockAsyncMotionProfileController::FeedforwardTracking tracking;
+  controller->sendVoltageCommand(path, 0, 0, false, 1, gains, tracking);
+
+  // Left: 0.5 V + 2 V/(m/s) * 0.5 m/s + 0.1 V/(m/s/s) * 50 m/s/s = 6.5 V
+  // Right: 0.5 V + 2 V/(m/s) * 0.25 m/s + 0.1 V/(m/s/s) * 25 m/s/s = 3.5 V
+  EXPECT_NEAR(leftMotor->lastVoltage, 6500, 1);
+  EXPECT_NEAR(rightMotor->lastVoltage, 3500, 1);
+  EXPECT_EQ(leftMotor->maxVelocity, 0);
+
+  // Mirrored swaps the sides
+  controller->sendVoltageCommand(path, 0, 0, true, 1, gains, tracking);
+  EXPECT_NEAR(leftMotor->lastVoltage, 3500, 1);
+  EXPECT_NEAR(rightMotor->lastVoltage, 6500, 1);
+
+  // Reversed negates everything
+  controller->sendVoltageCommand(path, 0, 0, false, -1, gains, tracking);
+  EXPECT_NEAR(leftMotor->lastVoltage, -6500, 1);
+  EXPECT_NEAR(rightMotor->lastVoltage, -3500, 1);
+
+  // At a constant velocity there is no acceleration term
+  controller->sendVoltageCommand(path, 2, 2, false, 1, gains, tracking);
+  EXPECT_NEAR(leftMotor->lastVoltage, 2500, 1);
+  EXPECT_NEAR(rightMotor->lastVoltage, 1500, 1);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, SendVoltageCommandFeedbackCorrectsDistance) {
+  controller->flipDisable(true);
+  const auto path = makeWheelPath({{1, 1}, {1, 1}, {1, 1}});
+  const FeedforwardGains gains{0, 0, 0, 100};
+
+  MockAsyncMotionProfileController::FeedforwardTracking tracking;
+  tracking.startSensors = model->getSensorVals();
+  controller->sendVoltageCommand(path, 0, 0, false, 1, gains, tracking);
+  EXPECT_EQ(leftMotor->lastVoltage, 0);
+
+  // The wheels should have driven 2 cm by now but haven't moved, so push them forwards
+  controller->sendVoltageCommand(path, 2, 2, false, 1, gains, tracking);
+  EXPECT_NEAR(leftMotor->lastVoltage, 2000, 1);
+  EXPECT_NEAR(rightMotor->lastVoltage, 2000, 1);
+
+  // The left wheels overshot by 3 cm, so hold them back
+  const double ticksPerMeter = ChassisScales({4_in, 10.5_in}, quadEncoderTPR).straight;
+  leftMotor->encoder->value = static_cast<std::int32_t>(0.05 * ticksPerMeter);
+  controller->sendVoltageCommand(path, 2, 2, false, 1, gains, tracking);
+  EXPECT_LT(leftMotor->lastVoltage, -2000);
+  EXPECT_NEAR(rightMotor->lastVoltage, 2000, 1);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, FollowPathWithFeedforward) {
+  EXPECT_EQ(controller->getFeedforward(), std::nullopt);
+  controller->setFeedforward(FeedforwardGains{0.5, 5, 0.2});
+  ASSERT_TRUE(controller->getFeedforward());
+  EXPECT_DOUBLE_EQ(controller->getFeedforward()->kV, 5);
+
+  controller->generatePath({PathfinderPoint{0_m, 0_m, 0_deg}, PathfinderPoint{3_ft, 0_m, 0_deg}},
+                           "A");
+  controller->setTarget("A");
+
+  auto rate = createTimeUtil().getRate();
+  while (!controller->executeSinglePathCalled) {
+    rate->delayUntil(1_ms);
+  }
+
+  // Wait a little longer so we get into the path
+  rate->delayUntil(200_ms);
+
+  // Voltages are sent instead of velocity targets
+  EXPECT_GT(leftMotor->lastVoltage, 0);
+  EXPECT_GT(rightMotor->lastVoltage, 0);
+  EXPECT_EQ(leftMotor->maxVelocity, 0);
+  EXPECT_EQ(rightMotor->maxVelocity, 0);
+
+  controller->flipDisable(true);
+}
+
+namespace {
+/**
+ * A rate which doesn't wait and instead records the velocity last sent to a motor on every tick.
+ */
+class RecordingMockRate : public MockRate {
+  public:
+  RecordingMockRate(std::shared_ptr<MockMotor> imotor, std::vector<double> &ivelocities)
+    : motor(std::move(imotor)), velocities(ivelocities) {
+  }
+
+  void delayUntil(QTime) override {
+    velocities.push_back(motor->lastVelocity);
+  }
+
+  std::shared_ptr<MockMotor> motor;
+  std::vector<double> &velocities;
+};
+} // namespace
+
+TEST_F(AsyncMotionProfileControllerTest, ActuationLatency) {
+  EXPECT_EQ(controller->getActuationLatency(), 0_ms);
+  controller->setActuationLatency(50_ms);
+  EXPECT_EQ(controller->getActuationLatency(), 50_ms);
+  EXPECT_THROW(controller->setActuationLatency(-1_ms), std::invalid_argument);
+  EXPECT_EQ(controller->getActuationLatency(), 50_ms);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, ActuationLatencySendsCommandsEarly) {
+  std::vector<std::pair<double, double>> wheelVelocities;
+  for (int i = 0; i < 20; ++i) {
+    wheelVelocities.emplace_back(i * 0.05, i * 0.05);
+  }
+  const auto path = makeWheelPath(wheelVelocities);
+
+  std::vector<double> onTime;
+  controller->followPath(path, std::make_unique<RecordingMockRate>(leftMotor, onTime));
+
+  std::vector<double> early;
+  controller->setActuationLatency(50_ms);
+  controller->followPath(path, std::make_unique<RecordingMockRate>(leftMotor, early));
+
+  // Every command is sent five ticks early and the last command is held at the end
+  ASSERT_EQ(onTime.size(), wheelVelocities.size());
+  ASSERT_EQ(early.size(), wheelVelocities.size());
+  for (std::size_t i = 0; i < early.size(); ++i) {
+    EXPECT_EQ(early[i], onTime[std::min<std::size_t>(i + 5, onTime.size() - 1)]) << i;
+  }
+  EXPECT_GT(onTime.back(), onTime.front());
+}
+
+namespace {
+/**
+ * A rate which doesn't wait and instead moves both wheels as far as a path at a constant velocity
+ * says they should be by the next tick, recording the voltage last sent to the left motor.
+ */
+class TrackingMockRate : public MockRate {
+  public:
+  TrackingMockRate(std::shared_ptr<MockMotor> ileft,
+                   std::shared_ptr<MockMotor> iright,
+                   const double iticksPerTick,
+                   std::vector<std::int16_t> &ivoltages)
+    : left(std::move(ileft)),
+      right(std::move(iright)),
+      ticksPerTick(iticksPerTick),
+      voltages(ivoltages) {
+  }
+
+  void delayUntil(QTime) override {
+    voltages.push_back(left->lastVoltage);
+    ++ticks;
+    const auto value = static_cast<std::int32_t>(std::lround(ticks * ticksPerTick));
+    left->encoder->value = value;
+    right->encoder->value = value;
+  }
+
+  std::shared_ptr<MockMotor> left;
+  std::shared_ptr<MockMotor> right;
+  double ticksPerTick;
+  std::vector<std::int16_t> &voltages;
+  int ticks{0};
+};
+} // namespace
+
+TEST_F(AsyncMotionProfileControllerTest, ActuationLatencyDoesNotBiasFeedback) {
+  // Only the feedback term sends a voltage
+  controller->setFeedforward(FeedforwardGains{0, 0, 0, 100});
+  controller->setActuationLatency(50_ms);
+
+  const auto path = makeWheelPath(std::vector<std::pair<double, double>>(20, {1, 1}));
+  const double ticksPerMeter = ChassisScales({4_in, 10.5_in}, quadEncoderTPR).straight;
+
+  std::vector<std::int16_t> voltages;
+  controller->followPath(path,
+                         std::make_unique<TrackingMockRate>(
+                           leftMotor, rightMotor, 0.01 * ticksPerMeter, voltages));
+
+  // The robot is exactly where the path says it should be, so apart from rounding the encoders
+  // there is no error. A reference five ticks ahead would be off by 5 cm, which is 5 V.
+  ASSERT_EQ(voltages.size(), 20);
+  for (std::size_t i = 0; i < voltages.size(); ++i) {
+    EXPECT_NEAR(voltages[i], 0, 100) << i;
+  }
+}
+
+TEST_F(AsyncMotionProfileControllerTest, FeedbackCarriesAcrossTheChunksOfAMove) {
+  // Only the feedback term sends a voltage
+  controller->setFeedforward(FeedforwardGains{0, 0, 0, 10});
+  const auto chunk = makeWheelPath(std::vector<std::pair<double, double>>(20, {1, 1}));
+
+  // The wheels never move, so the robot falls further behind the move with every tick
+  std::vector<std::int16_t> first;
+  std::vector<std::int16_t> second;
+  auto tracking = controller->startMove(chunk);
+  controller->executeSinglePath(
+    chunk, std::make_unique<TrackingMockRate>(leftMotor, rightMotor, 0, first), tracking);
+  controller->executeSinglePath(
+    chunk, std::make_unique<TrackingMockRate>(leftMotor, rightMotor, 0, second), tracking);
+
+  // The second chunk starts with the error the first one built up instead of starting over
+  ASSERT_EQ(first.size(), 20);
+  ASSERT_EQ(second.size(), 20);
+  EXPECT_NEAR(first.back(), 1900, 1);
+  EXPECT_NEAR(second.front(), first.back(), 1);
+  EXPECT_NEAR(second.back(), 3800, 1);
+}
+
+namespace {
+class MockOdometry : public Odometry {
+  public:
+  void setScales(const ChassisScales &) override {
+  }
+
+  void step() override {
+  }
+
+  OdomState getState(const StateMode & = StateMode::FRAME_TRANSFORMATION) const override {
+    return state;
+  }
+
+  void setState(const OdomState &istate,
+                const StateMode & = StateMode::FRAME_TRANSFORMATION) override {
+    state = istate;
+  }
+
+  std::shared_ptr<ReadOnlyChassisModel> getModel() override {
+    return nullptr;
+  }
+
+  ChassisScales getScales() override {
+    return {{4_in, 10.5_in}, quadEncoderTPR};
+  }
+
+  OdomState state;
+};
+
+/**
+ * A path which drives straight forwards at 1 m/s for some number of meters.
+ */
+StoredPath makeStraightPath(const int imeters = 1) {
+  std::vector<squiggles::ProfilePoint> profile;
+  for (int i = 0; i <= imeters * 100; ++i) {
+    profile.emplace_back(squiggles::ControlVector(squiggles::Pose(0, i * 0.01, M_PI / 2), 1, 0, 0),
+                         std::vector<double>{1, 1},
+                         0,
+                         i * 0.01);
+  }
+  return StoredPath(std::move(profile));
+}
+
+/**
+ * A rate which doesn't wait and instead moves a simulated chassis as far as the motors would
+ * drive it in one timestep, then writes its pose to the odometry. The left wheels slip for the
+ * first few timesteps, like they would while spinning up, so they only cover part of the distance
+ * they are driven.
+ */
+class SlippingChassisMockRate : public MockRate {
+  public:
+  SlippingChassisMockRate(std::shared_ptr<MockMotor> ileftMotor,
+                          std::shared_ptr<MockMotor> irightMotor,
+                          std::shared_ptr<MockOdometry> iodometry,
+                          const double iunitsPerMps,
+                          const double ileftTraction)
+    : leftMotor(std::move(ileftMotor)),
+      rightMotor(std::move(irightMotor)),
+      odometry(std::move(iodometry)),
+      unitsPerMps(iunitsPerMps),
+      leftTraction(ileftTraction) {
+  }
+
+  void delayUntil(QTime) override {
+    const double track = (10.5_in).convert(meter);
+    const double traction = ++ticks <= slippingTicks ? leftTraction : 1;
+    const double left = leftMotor->lastVelocity / unitsPerMps * traction;
+    const double right = rightMotor->lastVelocity / unitsPerMps;
+    const double velocity = (left + right) / 2;
+
+    // Odometry measures theta clockwise, so driving the left side faster increases it
+    auto &state = odometry->state;
+    state.theta += (left - right) / track * 0.01 * radian;
+    state.x += velocity * std::cos(state.theta.convert(radian)) * 0.01 * meter;
+    state.y += velocity * std::sin(state.theta.convert(radian)) * 0.01 * meter;
+  }
+
+  std::shared_ptr<MockMotor> leftMotor;
+  std::shared_ptr<MockMotor> rightMotor;
+  std::shared_ptr<MockOdometry> odometry;
+  double unitsPerMps;
+  double leftTraction;
+  std::size_t ticks{0};
+  static constexpr std::size_t slippingTicks = 20;
+};
+} // namespace
+
+TEST_F(AsyncMotionProfileControllerTest, SetOdometry) {
+  EXPECT_EQ(controller->getOdometry(), nullptr);
+
+  auto odometry = std::make_shared<MockOdometry>();
+  controller->setOdometry(odometry, RamseteGains{3, 0.5});
+  EXPECT_EQ(controller->getOdometry(), odometry);
+  EXPECT_DOUBLE_EQ(controller->getRamseteGains().b, 3);
+  EXPECT_DOUBLE_EQ(controller->getRamseteGains().zeta, 0.5);
+
+  EXPECT_THROW(controller->setOdometry(odometry, RamseteGains{0, 0.5}), std::invalid_argument);
+  EXPECT_THROW(controller->setOdometry(odometry, RamseteGains{2, 1.5}), std::invalid_argument);
+  EXPECT_DOUBLE_EQ(controller->getRamseteGains().b, 3);
+
+  controller->setOdometry(nullptr);
+  EXPECT_EQ(controller->getOdometry(), nullptr);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, SendRamseteCommandOnThePathMatchesOpenLoop) {
+  const auto path = makeStraightPath();
+  MockAsyncMotionProfileController::RamseteTracking tracking{std::make_shared<MockOdometry>()};
+  tracking.origin = path.getPose(0);
+
+  controller->sendMotorCommand(path, 0, false, 1);
+  const auto openLoop = leftMotor->lastVelocity;
+  ASSERT_GT(openLoop, 0);
+
+  controller->sendRamseteCommand(path, 0, 0, false, 1, tracking, std::nullopt);
+  EXPECT_EQ(leftMotor->lastVelocity, openLoop);
+  EXPECT_EQ(rightMotor->lastVelocity, openLoop);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, SendRamseteCommandCorrectsTowardsThePath) {
+  const auto path = makeStraightPath();
+  auto odometry = std::make_shared<MockOdometry>();
+  MockAsyncMotionProfileController::RamseteTracking tracking{odometry};
+  tracking.origin = path.getPose(0);
+
+  // Behind the path, so speed up
+  controller->sendMotorCommand(path, 50, false, 1);
+  const auto openLoop = leftMotor->lastVelocity;
+  odometry->state = {0.4_m, 0_m, 0_deg};
+  controller->sendRamseteCommand(path, 50, 50, false, 1, tracking, std::nullopt);
+  EXPECT_GT(leftMotor->lastVelocity, openLoop);
+  EXPECT_EQ(leftMotor->lastVelocity, rightMotor->lastVelocity);
+
+  // To the right of the path, so turn left whether or not the path is mirrored
+  odometry->state = {0.5_m, 0.1_m, 0_deg};
+  for (const bool mirrored : {false, true}) {
+    controller->sendRamseteCommand(path, 50, 50, mirrored, 1, tracking, std::nullopt);
+    EXPECT_LT(leftMotor->lastVelocity, rightMotor->lastVelocity) << mirrored;
+  }
+
+  // Backing up to the right of the path, so the right side backs up faster to swing the robot
+  // back towards it
+  odometry->state = {-0.5_m, 0.1_m, 0_deg};
+  controller->sendRamseteCommand(path, 50, 50, false, -1, tracking, std::nullopt);
+  EXPECT_LT(rightMotor->lastVelocity, leftMotor->lastVelocity);
+  EXPECT_LT(leftMotor->lastVelocity, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, SendRamseteCommandIsRelativeToTheStart) {
+  const auto path = makeStraightPath();
+  auto odometry = std::make_shared<MockOdometry>();
+  MockAsyncMotionProfileController::RamseteTracking tracking{odometry};
+  tracking.origin = path.getPose(0);
+  tracking.start = {1_m, 1_m, 90_deg};
+
+  // Facing along +y from (1, 1), half a meter along the path is exactly on it
+  odometry->state = {1_m, 1.5_m, 90_deg};
+  controller->sendMotorCommand(path, 50, false, 1);
+  const auto openLoop = leftMotor->lastVelocity;
+  controller->sendRamseteCommand(path, 50, 50, false, 1, tracking, std::nullopt);
+  EXPECT_EQ(leftMotor->lastVelocity, openLoop);
+  EXPECT_EQ(rightMotor->lastVelocity, openLoop);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, SendRamseteCommandWithFeedforward) {
+  const auto path = makeStraightPath();
+  MockAsyncMotionProfileController::RamseteTracking tracking{std::make_shared<MockOdometry>()};
+  tracking.origin = path.getPose(0);
+
+  // On the path at a constant 1 m/s, so the feedforward sends kS + kV volts
+  controller->sendRamseteCommand(path, 0, 0, false, 1, tracking, FeedforwardGains{0.5, 2, 0.1});
+  EXPECT_NEAR(leftMotor->lastVoltage, 2500, 1);
+  EXPECT_NEAR(rightMotor->lastVoltage, 2500, 1);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, OdometryCorrectsWheelSlip) {
+  const auto path = makeStraightPath(3);
+  const double unitsPerMps = controller->convertLinearToRotational(1_mps).convert(rpm) /
+                             toUnderlyingType(AbstractMotor::gearset::green) * 100;
+
+  const auto followWithSlip = [&](const bool iclosedLoop) {
+    auto odometry = std::make_shared<MockOdometry>();
+    controller->setOdometry(iclosedLoop ? odometry : nullptr);
+    controller->followPath(
+      path,
+      std::make_unique<SlippingChassisMockRate>(leftMotor, rightMotor, odometry, unitsPerMps, 0.5));
+    return std::hypot((odometry->state.x - 3_m).convert(meter), odometry->state.y.convert(meter));
+  };
+
+  const double openLoopError = followWithSlip(false);
+  const double closedLoopError = followWithSlip(true);
+
+  // The slip turns the robot, so open-loop it ends up a long way off the end of the path
+  EXPECT_GT(openLoopError, 0.5);
+  EXPECT_LT(closedLoopError, 0.05);
+}
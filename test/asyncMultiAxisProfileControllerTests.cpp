@@ -0,0 +1,184 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/async/asyncMultiAxisProfileController.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <gtest/gtest.h>
+
+using namespace okapi;
+
+class MockAsyncMultiAxisProfileController : public AsyncMultiAxisProfileController {
+  public:
+  using AsyncMultiAxisProfileController::AsyncMultiAxisProfileController;
+
+  void executeProfile(const SynchronizedProfile &profile,
+                      std::unique_ptr<AbstractRate> rate) override {
+    executeProfileCount++;
+    AsyncMultiAxisProfileController::executeProfile(profile, std::move(rate));
+  }
+
+  std::atomic_int executeProfileCount{0};
+};
+
+class AsyncMultiAxisProfileControllerTest : public ::testing::Test {
+  protected:
+  void SetUp() override {
+    lift = std::make_shared<MockAsyncVelIntegratedController>();
+    arm = std::make_shared<MockAsyncVelIntegratedController>();
+
+    controller = new MockAsyncMultiAxisProfileController(
+      createTimeUtil(),
+      {{lift, 1_m, AbstractMotor::gearset::red, {1.0, 2.0, 10.0}},
+       {arm, 1_m, AbstractMotor::gearset::red, {0.5, 1.0, 5.0}}});
+    controller->startThread();
+  }
+
+  void TearDown() override {
+    delete controller;
+  }
+
+  std::shared_ptr<MockAsyncVelIntegratedController> lift;
+  std::shared_ptr<MockAsyncVelIntegratedController> arm;
+  MockAsyncMultiAxisProfileController *controller;
+};
+
+TEST_F(AsyncMultiAxisProfileControllerTest, ConstructWithNoAxes) {
+  EXPECT_THROW(AsyncMultiAxisProfileController(createTimeUtil(), {}), std::invalid_argument);
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, ConstructWithGearRatioOf0) {
+  EXPECT_THROW(AsyncMultiAxisProfileController(
+                 createTimeUtil(),
+                 {{lift, 1_m, AbstractMotor::gearset::green * 0, {1.0, 2.0, 10.0}}}),
+               std::invalid_argument);
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, SettledWhenDisabled) {
+  controller->generatePath({{0_m, 0.5_m}, {0_m, 0.2_m}}, "A");
+  assertControllerIsSettledWhenDisabled(*controller, std::string("A"));
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, WaitUntilSettledWorksWhenDisabled) {
+  assertWaitUntilSettledWorksWhenDisabled(*controller);
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, MoveToDrivesEveryAxisWithOneFollower) {
+  EXPECT_EQ(controller->getAxisCount(), 2);
+  controller->moveTo({{0_m, 0.5_m}, {0_m, 0.2_m}});
+
+  EXPECT_EQ(controller->executeProfileCount, 1);
+  EXPECT_EQ(lift->lastControllerOutputSet, 0);
+  EXPECT_EQ(arm->lastControllerOutputSet, 0);
+  EXPECT_GT(arm->maxControllerOutputSet, 0);
+
+  // Both axes take the same time, so the axis which goes further goes faster
+  EXPECT_GT(lift->maxControllerOutputSet, arm->maxControllerOutputSet);
+
+  EXPECT_DOUBLE_EQ(controller->getAxisPosition(0), 0.5);
+  EXPECT_DOUBLE_EQ(controller->getAxisPosition(1), 0.2);
+  EXPECT_TRUE(controller->getPaths().empty());
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, MoveToLeavesUserPathsAlone) {
+  // moveTo() has no path ID of its own, so any ID is free for the user
+  controller->generatePath({{0_m, 0.3_m}, {0_m, 0.1_m}}, "__moveTo");
+  controller->moveTo({{0_m, 0.5_m}, {0_m, 0.2_m}});
+  EXPECT_DOUBLE_EQ(controller->getAxisPosition(0), 0.5);
+  EXPECT_EQ(controller->getPaths(), std::vector<std::string>{"__moveTo"});
+
+  controller->setTarget("__moveTo");
+  controller->waitUntilSettled();
+  EXPECT_EQ(controller->executeProfileCount, 2);
+  EXPECT_DOUBLE_EQ(controller->getAxisPosition(0), 0.3);
+  EXPECT_DOUBLE_EQ(controller->getAxisPosition(1), 0.1);
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, SetTargetWithAHandle) {
+  const auto handle = controller->generatePath({{0_m, 0.5_m}, {0_m, 0.2_m}}, "A");
+  EXPECT_EQ(controller->getPathHandle("A"), handle);
+
+  controller->setTarget(handle);
+  EXPECT_EQ(controller->getTarget(), "A");
+  controller->waitUntilSettled();
+  EXPECT_EQ(controller->executeProfileCount, 1);
+  EXPECT_DOUBLE_EQ(controller->getAxisPosition(0), 0.5);
+
+  EXPECT_TRUE(controller->removePath(handle));
+  EXPECT_TRUE(controller->getPaths().empty());
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, UnknownIdsDoNotGrowThePathTable) {
+  controller->setTarget("Typo");
+  EXPECT_EQ(controller->getTarget(), "Typo");
+  EXPECT_FALSE(controller->getPathHandle("Typo").isValid());
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, WrongNumberOfMovesThrows) {
+  EXPECT_THROW(controller->generatePath({{0_m, 0.5_m}}, "A"), std::invalid_argument);
+  EXPECT_TRUE(controller->getPaths().empty());
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, WrongPathNameDoesNotMoveAnything) {
+  controller->setTarget("A");
+  controller->waitUntilSettled();
+
+  EXPECT_EQ(controller->executeProfileCount, 0);
+  EXPECT_EQ(lift->maxControllerOutputSet, 0);
+  EXPECT_EQ(arm->maxControllerOutputSet, 0);
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, RemoveAPath) {
+  controller->generatePath({{0_m, 0.5_m}, {0_m, 0.2_m}}, "A");
+  EXPECT_EQ(controller->getPaths(), std::vector<std::string>{"A"});
+
+  EXPECT_TRUE(controller->removePath("A"));
+  EXPECT_TRUE(controller->getPaths().empty());
+  EXPECT_TRUE(controller->removePath("B"));
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, RemoveRunningPath) {
+  controller->generatePath({{0_m, 0.5_m}, {0_m, 0.2_m}}, "A");
+  controller->setTarget("A");
+
+  EXPECT_FALSE(controller->removePath("A"));
+  controller->forceRemovePath("A");
+  EXPECT_TRUE(controller->isDisabled());
+  EXPECT_TRUE(controller->getPaths().empty());
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, GetErrorIsTheErrorOfTheFurthestAxis) {
+  EXPECT_EQ(controller->getError(), 0);
+
+  controller->generatePath({{0_m, 0.5_m}, {0_m, -1_m}}, "A");
+  controller->setTarget("A");
+  EXPECT_NEAR(controller->getError(), -1, 0.1);
+
+  controller->waitUntilSettled();
+  EXPECT_NEAR(controller->getError(), 0, 1e-9);
+}
+
+TEST_F(AsyncMultiAxisProfileControllerTest, DisabledStopsEveryAxis) {
+  controller->generatePath({{0_m, 0.5_m}, {0_m, 0.2_m}}, "A");
+  controller->setTarget("A");
+
+  auto rate = createTimeUtil().getRate();
+  while (controller->executeProfileCount == 0) {
+    rate->delayUntil(1_ms);
+  }
+
+  // Wait a little longer so we get into the path
+  rate->delayUntil(200_ms);
+  EXPECT_GT(lift->lastControllerOutputSet, 0);
+  EXPECT_GT(arm->lastControllerOutputSet, 0);
+
+  controller->flipDisable(true);
+
+  // Wait a bit because the loop() thread is what cleans up
+  rate->delayUntil(20_ms);
+
+  EXPECT_TRUE(controller->isSettled());
+  EXPECT_EQ(lift->lastControllerOutputSet, 0);
+  EXPECT_EQ(arm->lastControllerOutputSet, 0);
+}
@@ -5,7 +5,10 @@
  */
 #include "okapi/api/control/async/asyncPosPidController.hpp"
 #include "test/tests/api/implMocks.hpp"
+#include <atomic>
+#include <chrono>
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace okapi;
 
@@ -49,3 +52,57 @@ TEST_F(AsyncPosPIDControllerTest, TestSetAndGetGains) {
   controller->setGains(gains);
   EXPECT_EQ(controller->getGains(), gains);
 }
+
+TEST(AsyncPosPIDControllerExecutorTest, RunsFromExecutor) {
+  auto executor = std::make_shared<ControlExecutor>(createConstantTimeUtil(10_ms));
+  auto input = std::make_shared<MockControllerInput>();
+  auto output = std::make_shared<MockMotor>();
+  auto controller = std::make_unique<AsyncPosPIDController>(
+    input, output, createConstantTimeUtil(10_ms), 0.5, 0, 0);
+
+  controller->startOnExecutor(executor);
+  EXPECT_EQ(controller->getThread(), nullptr);
+  EXPECT_EQ(executor->getLoopCount(), 1);
+
+  input->reading = 0;
+  controller->setTarget(100);
+  executor->step();
+  EXPECT_EQ(controller->getError(), 100);
+  EXPECT_EQ(output->lastVelocity, 1);
+
+  controller->setSampleTime(20_ms);
+  executor->step();
+  EXPECT_EQ(executor->step(), 20_ms);
+
+  controller.reset();
+  EXPECT_EQ(executor->getLoopCount(), 0);
+}
+
+TEST(AsyncPosPIDControllerExecutorTest, SetSampleTimeWhileTheExecutorIsRunning) {
+  auto executor = std::make_shared<ControlExecutor>(createTimeUtil());
+  auto controller = std::make_unique<AsyncPosPIDController>(std::make_shared<MockControllerInput>(),
+                                                            std::make_shared<MockMotor>(),
+                                                            createTimeUtil(),
+                                                            0.5,
+                                                            0,
+                                                            0);
+  controller->startOnExecutor(executor);
+
+  // Another loop changes the sample time from inside its step
+  std::atomic_int changes{0};
+  const auto tuner = executor->add("tuner", 5_ms, [&] {
+    controller->setSampleTime(changes++ % 2 == 0 ? 10_ms : 5_ms);
+  });
+  executor->startThread();
+
+  for (int i = 0; i < 100 && changes < 5; ++i) {
+    // The executor's task is stepping too
+    controller->setSampleTime(10_ms);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_GE(changes, 5);
+
+  EXPECT_TRUE(executor->remove(tuner));
+  controller.reset();
+  EXPECT_EQ(executor->getLoopCount(), 0);
+}
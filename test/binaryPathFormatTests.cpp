@@ -0,0 +1,81 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/binaryPathFormat.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace okapi;
+
+class BinaryPathFormatTest : public ::testing::Test {
+  protected:
+  void SetUp() override {
+    for (int i = 0; i < 50; ++i) {
+      path.emplace_back(
+        squiggles::ControlVector(squiggles::Pose(i * 0.01, i * 0.02, i * 0.001), i * 0.1, 0.5, 2),
+        std::vector<double>{i * 0.09, i * 0.11},
+        0.25,
+        i * 0.01);
+    }
+  }
+
+  std::vector<squiggles::ProfilePoint> path;
+};
+
+TEST_F(BinaryPathFormatTest, RoundTrip) {
+  auto encoded = BinaryPathFormat::encode(path);
+  EXPECT_EQ(encoded.size(), BinaryPathFormat::headerSize + path.size() * 10 * sizeof(double));
+
+  auto decoded = BinaryPathFormat::decode(encoded.data(), encoded.size());
+  ASSERT_TRUE(decoded.has_value());
+  ASSERT_EQ(decoded->size(), path.size());
+  for (std::size_t i = 0; i < path.size(); ++i) {
+    EXPECT_EQ(decoded->at(i), path[i]);
+  }
+}
+
+TEST_F(BinaryPathFormatTest, RoundTripThroughStream) {
+  std::stringstream file;
+  BinaryPathFormat::write(file, path);
+
+  auto decoded = BinaryPathFormat::read(file);
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(decoded.value(), path);
+}
+
+TEST_F(BinaryPathFormatTest, EmptyPath) {
+  auto encoded = BinaryPathFormat::encode({});
+  auto decoded = BinaryPathFormat::decode(encoded.data(), encoded.size());
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_TRUE(decoded->empty());
+}
+
+TEST_F(BinaryPathFormatTest, CorruptRecordFailsChecksum) {
+  auto encoded = BinaryPathFormat::encode(path);
+  encoded[BinaryPathFormat::headerSize + 3] ^= 0x10;
+  EXPECT_FALSE(BinaryPathFormat::decode(encoded.data(), encoded.size()).has_value());
+}
+
+TEST_F(BinaryPathFormatTest, TruncatedFileIsRejected) {
+  auto encoded = BinaryPathFormat::encode(path);
+  EXPECT_FALSE(BinaryPathFormat::decode(encoded.data(), encoded.size() - 1).has_value());
+  EXPECT_FALSE(BinaryPathFormat::decode(encoded.data(), 4).has_value());
+}
+
+TEST_F(BinaryPathFormatTest, WrongMagicOrVersionIsRejected) {
+  auto encoded = BinaryPathFormat::encode(path);
+  encoded[0] = 'X';
+  EXPECT_FALSE(BinaryPathFormat::decode(encoded.data(), encoded.size()).has_value());
+
+  encoded = BinaryPathFormat::encode(path);
+  encoded[4] = BinaryPathFormat::version + 1;
+  EXPECT_FALSE(BinaryPathFormat::decode(encoded.data(), encoded.size()).has_value());
+}
+
+TEST(Crc32Test, KnownValue) {
+  const std::string data = "123456789";
+  EXPECT_EQ(BinaryPathFormat::crc32(reinterpret_cast<const std::uint8_t *>(data.data()), data.size()),
+            0xCBF43926u);
+}
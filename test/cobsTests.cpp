@@ -0,0 +1,69 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/cobs.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace okapi;
+
+namespace {
+std::vector<std::uint8_t> encode(const std::vector<std::uint8_t> &idata) {
+  std::vector<std::uint8_t> encoded(Cobs::maxEncodedLength(idata.size()));
+  encoded.resize(Cobs::encode(idata.data(), idata.size(), encoded.data()));
+  return encoded;
+}
+
+std::vector<std::uint8_t> roundTrip(const std::vector<std::uint8_t> &idata) {
+  const auto encoded = encode(idata);
+  EXPECT_EQ(std::count(encoded.begin(), encoded.end(), 0), 0);
+  EXPECT_LE(encoded.size(), Cobs::maxEncodedLength(idata.size()));
+
+  std::vector<std::uint8_t> decoded(encoded.size());
+  std::size_t length = 0;
+  EXPECT_TRUE(Cobs::decode(encoded.data(), encoded.size(), decoded.data(), length));
+  decoded.resize(length);
+  return decoded;
+}
+} // namespace
+
+TEST(CobsTest, EncodesKnownVectors) {
+  EXPECT_EQ(encode({0}), (std::vector<std::uint8_t>{1, 1}));
+  EXPECT_EQ(encode({0, 0}), (std::vector<std::uint8_t>{1, 1, 1}));
+  EXPECT_EQ(encode({0x11, 0x22, 0, 0x33}), (std::vector<std::uint8_t>{3, 0x11, 0x22, 2, 0x33}));
+  EXPECT_EQ(encode({0x11, 0, 0, 0}), (std::vector<std::uint8_t>{2, 0x11, 1, 1, 1}));
+}
+
+TEST(CobsTest, RoundTripsBuffersWithZeros) {
+  const std::vector<std::vector<std::uint8_t>> buffers{
+    {}, {0}, {1}, {0, 0, 0}, {1, 0, 2, 0, 3}, {0, 255, 0, 255}};
+  for (const auto &buffer : buffers) {
+    EXPECT_EQ(roundTrip(buffer), buffer);
+  }
+}
+
+TEST(CobsTest, RoundTripsLongRunsWithoutZeros) {
+  for (const std::size_t length : {253, 254, 255, 508, 600}) {
+    std::vector<std::uint8_t> buffer(length);
+    for (std::size_t i = 0; i < length; ++i) {
+      buffer[i] = static_cast<std::uint8_t>(i % 255 + 1);
+    }
+    EXPECT_EQ(roundTrip(buffer), buffer) << length;
+  }
+}
+
+TEST(CobsTest, RejectsInvalidBuffers) {
+  std::uint8_t decoded[8];
+  std::size_t length;
+
+  // A code which runs past the end of the buffer
+  const std::uint8_t tooShort[]{5, 1, 2};
+  EXPECT_FALSE(Cobs::decode(tooShort, sizeof(tooShort), decoded, length));
+
+  // A zero byte inside an encoded buffer
+  const std::uint8_t withZero[]{3, 1, 0};
+  EXPECT_FALSE(Cobs::decode(withZero, sizeof(withZero), decoded, length));
+}
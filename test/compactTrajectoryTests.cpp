@@ -0,0 +1,123 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/compactTrajectory.hpp"
+#include "okapi/api/control/util/storedPath.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+
+using namespace okapi;
+using Field = CompactTrajectory::Field;
+
+class CompactTrajectoryTest : public ::testing::Test {
+  protected:
+  void SetUp() override {
+    for (int i = 0; i < 500; ++i) {
+      path.emplace_back(
+        squiggles::ControlVector(
+          squiggles::Pose(std::sin(i * 0.01) * 3, i * 0.002, std::cos(i * 0.03)),
+          i * 0.004,
+          -0.7 + i * 0.001,
+          i % 7 == 0 ? 12.0 : -3.0),
+        std::vector<double>{std::sin(i * 0.05) * 1.5, i * 0.003},
+        std::tan(i * 0.001),
+        i * 0.01);
+    }
+  }
+
+  std::vector<squiggles::ProfilePoint> path;
+};
+
+TEST_F(CompactTrajectoryTest, ErrorIsBounded) {
+  CompactTrajectory compact(path);
+  ASSERT_EQ(compact.size(), path.size());
+  ASSERT_EQ(compact.getWheelCount(), 2);
+
+  for (std::size_t i = 0; i < path.size(); ++i) {
+    const auto point = compact.at(i);
+    EXPECT_LE(std::abs(point.vector.pose.x - path[i].vector.pose.x), compact.getMaxError(Field::x));
+    EXPECT_LE(std::abs(point.vector.pose.y - path[i].vector.pose.y), compact.getMaxError(Field::y));
+    EXPECT_LE(std::abs(point.vector.pose.yaw - path[i].vector.pose.yaw),
+              compact.getMaxError(Field::yaw));
+    EXPECT_LE(std::abs(point.vector.vel - path[i].vector.vel), compact.getMaxError(Field::vel));
+    EXPECT_LE(std::abs(point.vector.accel - path[i].vector.accel),
+              compact.getMaxError(Field::accel));
+    EXPECT_LE(std::abs(point.vector.jerk - path[i].vector.jerk), compact.getMaxError(Field::jerk));
+    EXPECT_LE(std::abs(point.curvature - path[i].curvature), compact.getMaxError(Field::curvature));
+    EXPECT_LE(std::abs(point.time - path[i].time), compact.getMaxError(Field::time));
+    for (std::size_t wheel = 0; wheel < 2; ++wheel) {
+      EXPECT_LE(std::abs(point.wheel_velocities[wheel] - path[i].wheel_velocities[wheel]),
+                compact.getWheelVelocityMaxError(wheel));
+    }
+  }
+}
+
+TEST_F(CompactTrajectoryTest, ErrorBoundIsHalfAStep) {
+  CompactTrajectory compact(path);
+
+  // The time column spans 0 to 4.99 seconds
+  EXPECT_NEAR(compact.getMaxError(Field::time), 4.99 / 65535 / 2, 1e-12);
+}
+
+TEST_F(CompactTrajectoryTest, ConstantColumnIsExact) {
+  for (auto &point : path) {
+    point.curvature = 0.25;
+  }
+
+  CompactTrajectory constant(path);
+  EXPECT_EQ(constant.getMaxError(Field::curvature), 0);
+  for (std::size_t i = 0; i < path.size(); ++i) {
+    EXPECT_EQ(constant.get(Field::curvature, i), 0.25);
+  }
+}
+
+TEST_F(CompactTrajectoryTest, EndpointsAreExact) {
+  CompactTrajectory compact(path);
+  EXPECT_DOUBLE_EQ(compact.get(Field::time, 0), 0);
+  EXPECT_DOUBLE_EQ(compact.get(Field::time, path.size() - 1), path.back().time);
+}
+
+TEST_F(CompactTrajectoryTest, UsesLessMemory) {
+  CompactTrajectory compact(path);
+  EXPECT_EQ(compact.getBytesUsed(), sizeof(CompactTrajectory) + path.size() * 10 * 2);
+  EXPECT_LT(compact.getBytesUsed() * 4, StoredPath::estimateBytes(path));
+}
+
+TEST_F(CompactTrajectoryTest, EmptyPath) {
+  CompactTrajectory compact(std::vector<squiggles::ProfilePoint>{});
+  EXPECT_TRUE(compact.empty());
+  EXPECT_EQ(compact.size(), 0);
+  EXPECT_TRUE(compact.toProfile().empty());
+}
+
+TEST_F(CompactTrajectoryTest, NonFiniteValueThrows) {
+  path[3].vector.vel = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(CompactTrajectory{path}, std::invalid_argument);
+}
+
+TEST_F(CompactTrajectoryTest, MismatchedWheelCountThrows) {
+  path[3].wheel_velocities.push_back(1);
+  EXPECT_THROW(CompactTrajectory{path}, std::invalid_argument);
+}
+
+TEST_F(CompactTrajectoryTest, TooManyWheelsThrows) {
+  for (auto &point : path) {
+    point.wheel_velocities = std::vector<double>(CompactTrajectory::maxWheelCount + 1, 0);
+  }
+  EXPECT_THROW(CompactTrajectory{path}, std::invalid_argument);
+}
+
+TEST_F(CompactTrajectoryTest, StoredPathReadsCompactPoints) {
+  StoredPath stored(CompactTrajectory{path});
+  EXPECT_TRUE(stored.isCompact());
+  EXPECT_FALSE(stored.isView());
+  ASSERT_EQ(stored.size(), path.size());
+  EXPECT_NEAR(stored.getWheelVelocity(0, 100),
+              path[100].wheel_velocities[0],
+              stored.getCompact().getWheelVelocityMaxError(0));
+  EXPECT_EQ(stored.toProfile().size(), path.size());
+  EXPECT_LT(stored.getBytesUsed(), StoredPath(path).getBytesUsed());
+}
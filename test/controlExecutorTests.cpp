@@ -0,0 +1,208 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/controlExecutor.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace okapi;
+
+namespace {
+/**
+ * A timer whose time is set by the test.
+ */
+class SetTimer : public AbstractTimer {
+  public:
+  explicit SetTimer(const std::shared_ptr<QTime> &itime) : AbstractTimer(0_ms), time(itime) {
+  }
+
+  QTime millis() const override {
+    return *time;
+  }
+
+  std::shared_ptr<QTime> time;
+};
+} // namespace
+
+TEST(ControlExecutorTest, PeriodMustBeAtLeastOneMillisecond) {
+  ControlExecutor executor(createConstantTimeUtil(10_ms));
+  EXPECT_THROW(executor.add("zero", 0_ms, [] {}), std::invalid_argument);
+  EXPECT_THROW(executor.add("short", 0.4_ms, [] {}), std::invalid_argument);
+
+  const auto id = executor.add("loop", 10_ms, [] {});
+  EXPECT_THROW(executor.setPeriod(id, -1_ms), std::invalid_argument);
+  EXPECT_EQ(executor.getLoopCount(), 1);
+}
+
+TEST(ControlExecutorTest, RunsLoopsInDeadlineOrder) {
+  ControlExecutor executor(createConstantTimeUtil(10_ms));
+  std::string order;
+  executor.add("odom", 10_ms, [&] { order += 'o'; });
+  executor.add("fast", 5_ms, [&] { order += 'f'; });
+  executor.add("slow", 20_ms, [&] { order += 's'; });
+
+  std::vector<double> sleeps;
+  for (int i = 0; i < 5; ++i) {
+    sleeps.push_back(executor.step().convert(millisecond));
+    order += '|';
+  }
+
+  // Loops which are due at the same time run in the order they were added
+  EXPECT_EQ(order, "ofs|f|of|f|ofs|");
+  EXPECT_EQ(sleeps, (std::vector<double>{5, 5, 5, 5, 5}));
+}
+
+TEST(ControlExecutorTest, SleepsUntilTheNextDeadline) {
+  ControlExecutor executor(createConstantTimeUtil(10_ms));
+  std::string order;
+  executor.add("a", 7_ms, [&] { order += 'a'; });
+  executor.add("b", 10_ms, [&] { order += 'b'; });
+
+  std::vector<double> sleeps;
+  for (int i = 0; i < 5; ++i) {
+    sleeps.push_back(executor.step().convert(millisecond));
+  }
+
+  // a runs at 0, 7, and 14 ms, and b runs at 0, 10, and 20 ms
+  EXPECT_EQ(order, "ababab");
+  EXPECT_EQ(sleeps, (std::vector<double>{7, 3, 4, 6, 1}));
+}
+
+TEST(ControlExecutorTest, RemovedLoopDoesNotRun) {
+  ControlExecutor executor(createConstantTimeUtil(10_ms));
+  int aCount = 0;
+  int bCount = 0;
+  const auto a = executor.add("a", 10_ms, [&] { ++aCount; });
+  executor.add("b", 10_ms, [&] { ++bCount; });
+
+  executor.step();
+  EXPECT_TRUE(executor.remove(a));
+  EXPECT_FALSE(executor.remove(a));
+  executor.step();
+
+  EXPECT_EQ(aCount, 1);
+  EXPECT_EQ(bCount, 2);
+  EXPECT_EQ(executor.getLoopCount(), 1);
+}
+
+TEST(ControlExecutorTest, StepFunctionsCanChangeTheLoops) {
+  ControlExecutor executor(createConstantTimeUtil(10_ms));
+  std::string order;
+  std::uint32_t a = 0;
+  std::uint32_t c = 0;
+  a = executor.add("a", 10_ms, [&] {
+    order += 'a';
+    executor.setPeriod(a, 20_ms);
+    executor.remove(c);
+    executor.add("d", 10_ms, [&] { order += 'd'; });
+  });
+  executor.add("b", 10_ms, [&] { order += 'b'; });
+  c = executor.add("c", 10_ms, [&] { order += 'c'; });
+
+  // c is removed before its turn, and d first runs in the next step, which is due right away
+  EXPECT_EQ(executor.step(), 0_ms);
+  EXPECT_EQ(order, "ab");
+  EXPECT_EQ(executor.step(), 10_ms);
+  EXPECT_EQ(order, "abd");
+  EXPECT_EQ(executor.getLoopCount(), 3);
+}
+
+TEST(ControlExecutorTest, RemoveWaitsForARunningStep) {
+  auto executor = std::make_unique<ControlExecutor>(createTimeUtil());
+  std::atomic_bool stepping{false};
+  std::atomic_bool release{false};
+  std::atomic_int count{0};
+  const auto id = executor->add("slow", 5_ms, [&] {
+    stepping = true;
+    while (!release) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ++count;
+  });
+  executor->startThread();
+
+  for (int i = 0; i < 1000 && !stepping; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_TRUE(stepping);
+
+  // The executor is not locked while the step runs, so its period can change meanwhile
+  EXPECT_TRUE(executor->setPeriod(id, 10_ms));
+
+  std::atomic_bool removed{false};
+  std::thread remover([&] {
+    executor->remove(id);
+    removed = true;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_FALSE(removed);
+
+  release = true;
+  remover.join();
+  EXPECT_TRUE(removed);
+  EXPECT_EQ(count, 1);
+  EXPECT_EQ(executor->getLoopCount(), 0);
+}
+
+TEST(ControlExecutorTest, IdlesWithoutLoops) {
+  ControlExecutor executor(createConstantTimeUtil(10_ms));
+  EXPECT_EQ(executor.step(), 10_ms);
+}
+
+TEST(ControlExecutorTest, LateLoopStartsAtTheNextStep) {
+  ControlExecutor executor(createConstantTimeUtil(10_ms));
+  std::string order;
+  executor.add("a", 10_ms, [&] { order += 'a'; });
+  executor.step();
+
+  executor.add("b", 10_ms, [&] { order += 'b'; });
+  executor.step();
+  executor.step();
+
+  EXPECT_EQ(order, "aabab");
+}
+
+TEST(ControlExecutorTest, SetPeriodTakesEffectAfterTheNextStep) {
+  ControlExecutor executor(createConstantTimeUtil(10_ms));
+  const auto id = executor.add("a", 10_ms, [] {});
+  EXPECT_EQ(executor.step(), 10_ms);
+
+  EXPECT_TRUE(executor.setPeriod(id, 20_ms));
+  EXPECT_FALSE(executor.setPeriod(id + 1, 20_ms));
+  EXPECT_EQ(executor.step(), 20_ms);
+}
+
+TEST(ControlExecutorTest, CountsOverruns) {
+  auto time = std::make_shared<QTime>(0_ms);
+  ControlExecutor executor(createTimeUtil(Supplier<std::unique_ptr<AbstractTimer>>(
+    [=]() { return std::make_unique<SetTimer>(time); })));
+  executor.add("a", 10_ms, [=] { *time += 3_ms; });
+
+  executor.step();
+  EXPECT_EQ(executor.getOverrunCount(), 0);
+
+  executor.add("slow", 10_ms, [=] { *time += 20_ms; });
+  executor.step();
+  EXPECT_EQ(executor.getOverrunCount(), 1);
+}
+
+TEST(ControlExecutorTest, TaskRunsLoops) {
+  auto executor = std::make_unique<ControlExecutor>(createTimeUtil());
+  std::atomic_int count{0};
+  executor->add("a", 5_ms, [&] { ++count; });
+  executor->startThread();
+  EXPECT_NE(executor->getThread(), nullptr);
+
+  for (int i = 0; i < 100 && count < 5; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  executor.reset();
+
+  EXPECT_GE(count, 5);
+}
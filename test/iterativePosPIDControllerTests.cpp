@@ -4,8 +4,11 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 #include "okapi/api/control/iterative/iterativePosPidController.hpp"
+#include "okapi/api/util/telemetryDecoder.hpp"
 #include "test/tests/api/implMocks.hpp"
+#include <atomic>
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace okapi;
 
@@ -153,3 +156,55 @@ TEST_F(IterativePosPIDControllerTest, TestGetGainsReturnsTheOriginalGains) {
   EXPECT_FLOAT_EQ(gains.kD, 0.3);
   EXPECT_FLOAT_EQ(gains.kBias, 0.4);
 }
+
+TEST_F(IterativePosPIDControllerTest, RecordsTelemetry) {
+  auto recorder = std::make_shared<TelemetryRecorder>(createConstantTimeUtil(10_ms), 4);
+  controller->setTelemetry(recorder, "pid");
+  controller->setGains({0.1, 0, 0.0001, 0});
+  controller->setTarget(2);
+  controller->step(1);
+
+  ASSERT_EQ(recorder->getSampleCount(), 1);
+
+  FILE *file = tmpfile();
+  recorder->write(file);
+  rewind(file);
+  const auto log = TelemetryDecoder::decode(file);
+  fclose(file);
+
+  const auto sample = log.getSample(0);
+  EXPECT_EQ(log.channelNames[log.channels[0]], "pid");
+  EXPECT_FLOAT_EQ(sample.target, 2);
+  EXPECT_FLOAT_EQ(sample.reading, 1);
+  EXPECT_FLOAT_EQ(sample.error, 1);
+  EXPECT_FLOAT_EQ(sample.p, 0.1);
+  EXPECT_FLOAT_EQ(sample.d, -0.01);
+  EXPECT_FLOAT_EQ(sample.output, controller->getOutput());
+  EXPECT_FLOAT_EQ(sample.dt.convert(millisecond), 10);
+
+  controller->setTelemetry(nullptr);
+  controller->step(1);
+  EXPECT_EQ(recorder->getSampleCount(), 1);
+}
+
+TEST_F(IterativePosPIDControllerTest, SetTelemetryWhileStepping) {
+  constexpr int stepCount = 2000;
+  auto recorder = std::make_shared<TelemetryRecorder>(createConstantTimeUtil(10_ms), stepCount);
+  controller->setTarget(2);
+
+  std::atomic_bool done{false};
+  std::thread swapper([&] {
+    while (!done.load()) {
+      controller->setTelemetry(recorder, "pid");
+      controller->setTelemetry(nullptr);
+    }
+  });
+
+  for (int i = 0; i < stepCount; ++i) {
+    controller->step(1);
+  }
+  done.store(true);
+  swapper.join();
+
+  EXPECT_LE(recorder->getSampleCount(), stepCount);
+}
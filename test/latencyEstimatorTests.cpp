@@ -0,0 +1,101 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/latencyEstimator.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace okapi;
+
+namespace {
+/**
+ * A trapezoidal velocity profile sampled every 10 ms, followed by a rest.
+ */
+std::vector<double> makeCommands() {
+  std::vector<double> commands;
+  for (int i = 0; i < 200; ++i) {
+    const double t = i * 0.01;
+    commands.push_back(std::clamp(std::min(t * 2, (1.5 - t) * 2), 0.0, 1.0));
+  }
+  return commands;
+}
+
+/**
+ * Simulates a motor which starts applying a command `idelay` samples after it is sent and then
+ * approaches it as a first order system with the given smoothing.
+ */
+std::vector<double> simulateMotor(const std::vector<double> &icommands,
+                                  const std::size_t idelay,
+                                  const double ismoothing,
+                                  const double iscale) {
+  std::vector<double> measured;
+  double velocity = 0;
+  for (std::size_t i = 0; i < icommands.size(); ++i) {
+    const double applied = i >= idelay ? icommands[i - idelay] : 0;
+    velocity += (applied - velocity) * (1 - ismoothing);
+    measured.push_back(velocity * iscale);
+  }
+  return measured;
+}
+} // namespace
+
+TEST(LatencyEstimatorTest, NoLatency) {
+  const auto commands = makeCommands();
+  const auto estimate = LatencyEstimator::estimate(commands, commands, 10_ms, 100_ms);
+  EXPECT_EQ(estimate.latency, 0_ms);
+  EXPECT_NEAR(estimate.correlation, 1, 1e-12);
+}
+
+TEST(LatencyEstimatorTest, PureDelay) {
+  const auto commands = makeCommands();
+  const auto measured = simulateMotor(commands, 3, 0, 1);
+
+  const auto estimate = LatencyEstimator::estimate(commands, measured, 10_ms, 100_ms);
+  EXPECT_EQ(estimate.latency, 30_ms);
+  EXPECT_NEAR(estimate.correlation, 1, 1e-12);
+}
+
+TEST(LatencyEstimatorTest, DelayInDifferentUnits) {
+  // Commands as a fraction of max speed, measurements in RPM
+  const auto commands = makeCommands();
+  const auto measured = simulateMotor(commands, 5, 0, 200);
+
+  EXPECT_EQ(LatencyEstimator::estimate(commands, measured, 10_ms, 100_ms).latency, 50_ms);
+}
+
+TEST(LatencyEstimatorTest, DelayWithSmoothing) {
+  const auto commands = makeCommands();
+  const auto measured = simulateMotor(commands, 2, 0.5, 1);
+
+  // The smoothing lags the response by about one more sample
+  const auto estimate = LatencyEstimator::estimate(commands, measured, 10_ms, 100_ms);
+  EXPECT_GE(estimate.latency, 20_ms);
+  EXPECT_LE(estimate.latency, 40_ms);
+  EXPECT_GT(estimate.correlation, 0.99);
+}
+
+TEST(LatencyEstimatorTest, LatencyBeyondTheSearchIsNotFound) {
+  const auto commands = makeCommands();
+  const auto measured = simulateMotor(commands, 8, 0, 1);
+
+  EXPECT_LE(LatencyEstimator::estimate(commands, measured, 10_ms, 50_ms).latency, 50_ms);
+}
+
+TEST(LatencyEstimatorTest, ConstantLogsHaveNoCorrelation) {
+  const std::vector<double> constant(100, 1);
+  const auto estimate = LatencyEstimator::estimate(constant, constant, 10_ms, 100_ms);
+  EXPECT_EQ(estimate.latency, 0_ms);
+  EXPECT_EQ(estimate.correlation, 0);
+}
+
+TEST(LatencyEstimatorTest, InvalidArgumentsThrow) {
+  const auto commands = makeCommands();
+  EXPECT_THROW(LatencyEstimator::estimate(commands, {1, 2}, 10_ms, 100_ms), std::invalid_argument);
+  EXPECT_THROW(LatencyEstimator::estimate({}, {}, 10_ms, 100_ms), std::invalid_argument);
+  EXPECT_THROW(LatencyEstimator::estimate(commands, commands, 0_ms, 100_ms),
+               std::invalid_argument);
+  EXPECT_THROW(LatencyEstimator::estimate({1, 2, 3, 4}, {1, 2, 3, 4}, 10_ms, 30_ms),
+               std::invalid_argument);
+}
@@ -0,0 +1,89 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/limitOptimizer.hpp"
+#include "okapi/api/control/util/trajectoryGenerator.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace okapi;
+
+class LimitOptimizerTest : public ::testing::Test {
+  protected:
+  LimitOptimizer makeOptimizer(const double imaxTractionAccel) {
+    return LimitOptimizer(createTimeUtil(),
+                          scales,
+                          AbstractMotor::gearset::green,
+                          {3.0, imaxTractionAccel, 10.0},
+                          8,
+                          4);
+  }
+
+  const ChassisScales scales{{4_in, 11.5_in}, imev5GreenTPR};
+  const std::vector<PathfinderPoint> turn{{0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}};
+};
+
+TEST_F(LimitOptimizerTest, MaxWheelSpeedComesFromTheGearset) {
+  // 200 rpm on a 4 inch wheel, of which 90% is usable
+  EXPECT_NEAR(makeOptimizer(5).getMaxWheelSpeed().convert(mps),
+              200.0 / 60 * 1_pi * 0.1016 * 0.9,
+              1e-9);
+}
+
+TEST_F(LimitOptimizerTest, StraightPathUsesEverythingTheMotorsHave) {
+  auto optimizer = makeOptimizer(5);
+  const auto result = optimizer.optimize({{0_m, 0_m, 0_deg}, {3_m, 0_m, 0_deg}});
+
+  // Nothing turns, so only the motors limit the path
+  EXPECT_DOUBLE_EQ(result.limits.maxVel, optimizer.getMaxWheelSpeed().convert(mps));
+  EXPECT_DOUBLE_EQ(result.limits.maxAccel, 3);
+  EXPECT_EQ(result.limits.maxJerk, 10);
+  EXPECT_EQ(result.binding, LimitConstraint::motorSpeed);
+  EXPECT_LE(result.tractionUsage, 1);
+  EXPECT_EQ(result.evaluatedCount, 2 * 8 * 8);
+}
+
+TEST_F(LimitOptimizerTest, LowTractionSlowsDownTurns) {
+  auto grippy = makeOptimizer(20);
+  auto slippery = makeOptimizer(0.8);
+  const auto fast = grippy.optimize(turn);
+  const auto slow = slippery.optimize(turn);
+
+  EXPECT_EQ(slow.binding, LimitConstraint::traction);
+  EXPECT_LE(slow.tractionUsage, 1);
+  EXPECT_GT(slow.tractionUsage, 0.9);
+  EXPECT_GT(slow.duration, fast.duration);
+}
+
+TEST_F(LimitOptimizerTest, ResultMatchesGeneratingWithTheLimits) {
+  auto optimizer = makeOptimizer(2);
+  const auto result = optimizer.optimize(turn);
+
+  TrajectoryGenerator generator(result.limits, scales.wheelTrack);
+  const auto size = generator.generate(turn);
+  EXPECT_NEAR(generator[size - 1].time, result.duration.convert(second), 1e-9);
+}
+
+TEST_F(LimitOptimizerTest, ImpossiblePathThrows) {
+  // Even the gentlest acceleration tried slips
+  auto optimizer = makeOptimizer(0.1);
+  EXPECT_THROW(optimizer.optimize(turn), std::runtime_error);
+}
+
+TEST_F(LimitOptimizerTest, TooFewWaypointsThrows) {
+  auto optimizer = makeOptimizer(5);
+  EXPECT_THROW(optimizer.optimize({}), std::invalid_argument);
+  EXPECT_THROW(optimizer.optimize({{0_m, 0_m, 0_deg}}), std::invalid_argument);
+}
+
+TEST_F(LimitOptimizerTest, InvalidConstraintsThrow) {
+  EXPECT_THROW(
+    LimitOptimizer(createTimeUtil(), scales, AbstractMotor::gearset::green, {0, 1, 1}),
+    std::invalid_argument);
+  EXPECT_THROW(
+    LimitOptimizer(createTimeUtil(), scales, AbstractMotor::gearset::green, {1, 1, 1, 0}),
+    std::invalid_argument);
+}
@@ -0,0 +1,207 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/linearProfile.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace okapi;
+
+namespace {
+/**
+ * Steps through a profile checking that it respects its limits and that the position and velocity
+ * agree with integrating the acceleration.
+ */
+void assertProfileIsConsistent(const LinearProfile &profile, const PathfinderLimits &limits) {
+  const double dt = 0.0005;
+  const double duration = profile.getDuration().convert(second);
+  auto last = profile.sample(0_s);
+
+  for (double t = dt; t <= duration + dt; t += dt) {
+    const auto state = profile.sample(t * second);
+
+    EXPECT_LE(std::abs(state.velocity), limits.maxVel + 1e-9) << "t=" << t;
+    EXPECT_LE(std::abs(state.acceleration), limits.maxAccel + 1e-9) << "t=" << t;
+    if (profile.getShape() == LinearProfileShape::sCurve) {
+      // The acceleration is continuous, so it can't change by more than the jerk limit allows
+      EXPECT_LE(std::abs(state.acceleration - last.acceleration), limits.maxJerk * dt + 1e-9)
+        << "t=" << t;
+    }
+
+    EXPECT_NEAR(state.position - last.position, (state.velocity + last.velocity) / 2 * dt, 1e-5)
+      << "t=" << t;
+    last = state;
+  }
+}
+} // namespace
+
+TEST(LinearProfileTest, ZeroDistanceDoesNotMove) {
+  LinearProfile profile(LinearProfileShape::sCurve, 1_m, 1_m, {1, 2, 10});
+  EXPECT_EQ(profile.getDuration(), 0_s);
+
+  const auto state = profile.sample(1_s);
+  EXPECT_DOUBLE_EQ(state.position, 1);
+  EXPECT_DOUBLE_EQ(state.velocity, 0);
+  EXPECT_DOUBLE_EQ(state.acceleration, 0);
+}
+
+TEST(LinearProfileTest, DefaultProfileDoesNotMove) {
+  LinearProfile profile;
+  EXPECT_EQ(profile.getDuration(), 0_s);
+  EXPECT_DOUBLE_EQ(profile.sample(1_s).position, 0);
+}
+
+TEST(LinearProfileTest, NonPositiveLimitsThrow) {
+  EXPECT_THROW(LinearProfile(LinearProfileShape::trapezoidal, 0_m, 1_m, {0, 2, 10}),
+               std::invalid_argument);
+  EXPECT_THROW(LinearProfile(LinearProfileShape::trapezoidal, 0_m, 1_m, {1, -2, 10}),
+               std::invalid_argument);
+  EXPECT_THROW(LinearProfile(LinearProfileShape::sCurve, 0_m, 1_m, {1, 2, 0}),
+               std::invalid_argument);
+}
+
+TEST(LinearProfileTest, TrapezoidalIgnoresJerkLimit) {
+  EXPECT_NO_THROW(LinearProfile(LinearProfileShape::trapezoidal, 0_m, 1_m, {1, 2, 0}));
+}
+
+TEST(LinearProfileTest, TrapezoidalWithCruise) {
+  const PathfinderLimits limits{1, 2, 10};
+  LinearProfile profile(LinearProfileShape::trapezoidal, 0_m, 3_m, limits);
+
+  // 0.5 s to speed up, 2.5 s cruising, 0.5 s to slow down
+  EXPECT_NEAR(profile.getDuration().convert(second), 3.5, 1e-12);
+  EXPECT_DOUBLE_EQ(profile.getPeakVelocity(), 1);
+
+  EXPECT_NEAR(profile.sample(0.25_s).velocity, 0.5, 1e-12);
+  EXPECT_NEAR(profile.sample(0.25_s).acceleration, 2, 1e-12);
+  EXPECT_NEAR(profile.sample(0.5_s).position, 0.25, 1e-12);
+  EXPECT_NEAR(profile.sample(2_s).velocity, 1, 1e-12);
+  EXPECT_NEAR(profile.sample(2_s).acceleration, 0, 1e-12);
+  EXPECT_NEAR(profile.sample(3.25_s).acceleration, -2, 1e-12);
+  EXPECT_NEAR(profile.sample(3.25_s).velocity, 0.5, 1e-12);
+
+  const auto end = profile.sample(3.5_s);
+  EXPECT_DOUBLE_EQ(end.position, 3);
+  EXPECT_DOUBLE_EQ(end.velocity, 0);
+
+  assertProfileIsConsistent(profile, limits);
+}
+
+TEST(LinearProfileTest, TrapezoidalShortMoveIsTriangular) {
+  const PathfinderLimits limits{1, 2, 10};
+  LinearProfile profile(LinearProfileShape::trapezoidal, 0_m, 0.18_m, limits);
+
+  // Peak is sqrt(0.18 * 2) = 0.6 m/s, reached after 0.3 s
+  EXPECT_NEAR(profile.getPeakVelocity(), 0.6, 1e-12);
+  EXPECT_NEAR(profile.getDuration().convert(second), 0.6, 1e-12);
+  EXPECT_NEAR(profile.sample(0.3_s).velocity, 0.6, 1e-12);
+  EXPECT_NEAR(profile.sample(0.3_s).position, 0.09, 1e-12);
+
+  assertProfileIsConsistent(profile, limits);
+}
+
+TEST(LinearProfileTest, SCurveWithCruise) {
+  const PathfinderLimits limits{1, 2, 10};
+  LinearProfile profile(LinearProfileShape::sCurve, 0_m, 3_m, limits);
+
+  // 0.2 s of jerk on either side of 0.3 s of constant acceleration, so speeding up takes 0.7 s and
+  // covers 0.35 m. Cruising covers the remaining 2.3 m.
+  EXPECT_DOUBLE_EQ(profile.getPeakVelocity(), 1);
+  EXPECT_NEAR(profile.getDuration().convert(second), 0.7 + 2.3 + 0.7, 1e-12);
+
+  EXPECT_NEAR(profile.sample(0.1_s).acceleration, 1, 1e-12);
+  EXPECT_NEAR(profile.sample(0.35_s).acceleration, 2, 1e-12);
+  EXPECT_NEAR(profile.sample(0.7_s).velocity, 1, 1e-12);
+  EXPECT_NEAR(profile.sample(0.7_s).position, 0.35, 1e-12);
+  EXPECT_NEAR(profile.sample(3.35_s).acceleration, -2, 1e-12);
+
+  const auto end = profile.sample(profile.getDuration());
+  EXPECT_DOUBLE_EQ(end.position, 3);
+  EXPECT_DOUBLE_EQ(end.velocity, 0);
+  EXPECT_NEAR(profile.sample(profile.getDuration() - 1_ms).position, 3, 1e-6);
+
+  assertProfileIsConsistent(profile, limits);
+}
+
+TEST(LinearProfileTest, SCurveShortMoveStillReachesMaxAccel) {
+  const PathfinderLimits limits{1, 2, 10};
+  LinearProfile profile(LinearProfileShape::sCurve, 0_m, 0.3_m, limits);
+
+  EXPECT_LT(profile.getPeakVelocity(), 1);
+  EXPECT_GE(profile.getPeakVelocity() * limits.maxJerk, limits.maxAccel * limits.maxAccel);
+
+  const double half = profile.getDuration().convert(second) / 2;
+  EXPECT_NEAR(profile.sample(half * second).position, 0.15, 1e-12);
+  EXPECT_NEAR(profile.sample(half * second).velocity, profile.getPeakVelocity(), 1e-12);
+  EXPECT_NEAR(profile.sample(0.25_s).acceleration, 2, 1e-12);
+
+  assertProfileIsConsistent(profile, limits);
+}
+
+TEST(LinearProfileTest, SCurveVeryShortMoveDoesNotReachMaxAccel) {
+  const PathfinderLimits limits{1, 2, 10};
+  LinearProfile profile(LinearProfileShape::sCurve, 0_m, 0.02_m, limits);
+
+  // Peak is cbrt(0.02^2 * 10 / 4) = 0.1 m/s, reached after 2 * sqrt(0.1 / 10) = 0.2 s
+  EXPECT_NEAR(profile.getPeakVelocity(), 0.1, 1e-12);
+  EXPECT_NEAR(profile.getDuration().convert(second), 0.4, 1e-12);
+  EXPECT_NEAR(profile.sample(0.1_s).acceleration, 1, 1e-12);
+
+  assertProfileIsConsistent(profile, limits);
+}
+
+TEST(LinearProfileTest, BackwardsMove) {
+  const PathfinderLimits limits{1, 2, 10};
+  LinearProfile forward(LinearProfileShape::sCurve, 1_m, 3_m, limits);
+  LinearProfile backward(LinearProfileShape::sCurve, 1_m, -1_m, limits);
+
+  EXPECT_EQ(forward.getDuration(), backward.getDuration());
+  for (double t = 0; t < 3; t += 0.1) {
+    const auto f = forward.sample(t * second);
+    const auto b = backward.sample(t * second);
+    EXPECT_NEAR(b.position, 1 - (f.position - 1), 1e-12);
+    EXPECT_NEAR(b.velocity, -f.velocity, 1e-12);
+    EXPECT_NEAR(b.acceleration, -f.acceleration, 1e-12);
+  }
+
+  EXPECT_DOUBLE_EQ(backward.getStart(), 1);
+  EXPECT_DOUBLE_EQ(backward.getEnd(), -1);
+}
+
+TEST(LinearProfileTest, SampleOutsideProfileHoldsEnds) {
+  LinearProfile profile(LinearProfileShape::trapezoidal, 2_m, 5_m, {1, 2, 10});
+
+  EXPECT_DOUBLE_EQ(profile.sample(-1_s).position, 2);
+  EXPECT_DOUBLE_EQ(profile.sample(-1_s).velocity, 0);
+  EXPECT_DOUBLE_EQ(profile.sample(100_s).position, 5);
+  EXPECT_DOUBLE_EQ(profile.sample(100_s).velocity, 0);
+}
+
+TEST(LinearProfileTest, StretchedProfileTakesLongerWithinTheLimits) {
+  const PathfinderLimits limits{1, 2, 10};
+  LinearProfile profile(LinearProfileShape::sCurve, 1_m, 3_m, limits);
+  const auto stretched = profile.stretchedTo(profile.getDuration() * 2);
+
+  EXPECT_EQ(stretched.getDuration(), profile.getDuration() * 2);
+  EXPECT_DOUBLE_EQ(stretched.getPeakVelocity(), profile.getPeakVelocity() / 2);
+  EXPECT_DOUBLE_EQ(stretched.getStart(), 1);
+  EXPECT_DOUBLE_EQ(stretched.getEnd(), 3);
+
+  // Halfway through, both profiles are at the same place at half the speed
+  const auto halfway = profile.sample(profile.getDuration() / 2);
+  const auto stretchedHalfway = stretched.sample(stretched.getDuration() / 2);
+  EXPECT_NEAR(stretchedHalfway.position, halfway.position, 1e-12);
+  EXPECT_NEAR(stretchedHalfway.velocity, halfway.velocity / 2, 1e-12);
+
+  assertProfileIsConsistent(stretched, {0.5, 0.5, 1.25});
+}
+
+TEST(LinearProfileTest, StretchingToAShorterDurationThrows) {
+  LinearProfile profile(LinearProfileShape::trapezoidal, 0_m, 1_m, {1, 2, 10});
+  EXPECT_THROW(profile.stretchedTo(profile.getDuration() / 2), std::invalid_argument);
+  EXPECT_EQ(profile.stretchedTo(profile.getDuration()).getDuration(), profile.getDuration());
+  EXPECT_EQ(LinearProfile().stretchedTo(1_s).getDuration(), 0_s);
+}
@@ -0,0 +1,111 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/logRingBuffer.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace okapi;
+
+TEST(LogRingBufferTest, CapacityIsRoundedUpToAPowerOfTwo) {
+  EXPECT_EQ(LogRingBuffer(5).getCapacity(), 8);
+  EXPECT_EQ(LogRingBuffer(8).getCapacity(), 8);
+  EXPECT_EQ(LogRingBuffer(0).getCapacity(), 1);
+}
+
+TEST(LogRingBufferTest, RecordsComeOutInOrder) {
+  LogRingBuffer buffer(4);
+  EXPECT_TRUE(buffer.push(1, "INFO", "a", "first"));
+  EXPECT_TRUE(buffer.push(2, "WARN", "b", "second"));
+
+  LogRecord record;
+  ASSERT_TRUE(buffer.pop(record));
+  EXPECT_EQ(record.time, 1);
+  EXPECT_STREQ(record.levelName, "INFO");
+  EXPECT_STREQ(record.threadName, "a");
+  EXPECT_STREQ(record.message, "first");
+
+  ASSERT_TRUE(buffer.pop(record));
+  EXPECT_EQ(record.time, 2);
+  EXPECT_STREQ(record.message, "second");
+
+  EXPECT_FALSE(buffer.pop(record));
+}
+
+TEST(LogRingBufferTest, LongMessagesAreTruncated) {
+  LogRingBuffer buffer(1);
+  const std::string message(LogRecord::maxMessageLength + 10, 'x');
+  const std::string threadName(LogRecord::maxThreadNameLength + 10, 't');
+  buffer.push(0, "INFO", threadName, message);
+
+  LogRecord record;
+  ASSERT_TRUE(buffer.pop(record));
+  EXPECT_EQ(std::string(record.message), message.substr(0, LogRecord::maxMessageLength));
+  EXPECT_EQ(std::string(record.threadName), threadName.substr(0, LogRecord::maxThreadNameLength));
+}
+
+TEST(LogRingBufferTest, FullBufferDropsAndCounts) {
+  LogRingBuffer buffer(2);
+  EXPECT_TRUE(buffer.push(0, "INFO", "a", "1"));
+  EXPECT_TRUE(buffer.push(0, "INFO", "a", "2"));
+  EXPECT_FALSE(buffer.push(0, "INFO", "a", "3"));
+  EXPECT_FALSE(buffer.push(0, "INFO", "a", "4"));
+  EXPECT_EQ(buffer.getDroppedCount(), 2);
+
+  LogRecord record;
+  ASSERT_TRUE(buffer.pop(record));
+  EXPECT_STREQ(record.message, "1");
+
+  // Popping frees a slot for the next record
+  EXPECT_TRUE(buffer.push(0, "INFO", "a", "5"));
+  ASSERT_TRUE(buffer.pop(record));
+  EXPECT_STREQ(record.message, "2");
+  ASSERT_TRUE(buffer.pop(record));
+  EXPECT_STREQ(record.message, "5");
+  EXPECT_EQ(buffer.getDroppedCount(), 2);
+}
+
+TEST(LogRingBufferTest, ManyWritersOneReader) {
+  constexpr int writerCount = 4;
+  constexpr int recordsPerWriter = 5000;
+  LogRingBuffer buffer(64);
+
+  std::vector<std::thread> writers;
+  for (int writer = 0; writer < writerCount; ++writer) {
+    writers.emplace_back([&buffer, writer] {
+      for (int i = 0; i < recordsPerWriter; ++i) {
+        buffer.push(i, "INFO", std::to_string(writer), std::to_string(i));
+      }
+    });
+  }
+
+  // Each writer's records must come out in the order it wrote them
+  std::vector<long> lastTime(writerCount, -1);
+  std::size_t poppedCount = 0;
+  LogRecord record;
+  const auto popAll = [&] {
+    while (buffer.pop(record)) {
+      const int writer = std::stoi(record.threadName);
+      EXPECT_GT(record.time, lastTime[writer]);
+      EXPECT_EQ(std::to_string(record.time), std::string(record.message));
+      lastTime[writer] = record.time;
+      ++poppedCount;
+    }
+  };
+
+  for (std::size_t i = 0; i < 1000; ++i) {
+    popAll();
+    std::this_thread::yield();
+  }
+
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  popAll();
+
+  EXPECT_EQ(poppedCount + buffer.getDroppedCount(), writerCount * recordsPerWriter);
+}
@@ -5,7 +5,9 @@
  */
 #include "okapi/api/util/logging.hpp"
 #include "test/tests/api/implMocks.hpp"
+#include <atomic>
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace okapi;
 
@@ -172,3 +174,103 @@ TEST_F(LoggerTest, TestLazyLogging) {
     free(line);
   }
 }
+
+/**
+ * Holds the flusher until it is released, so tests can fill the buffer.
+ */
+class HeldRate : public AbstractRate {
+  public:
+  explicit HeldRate(std::atomic_bool &ireleased) : released(ireleased) {
+  }
+
+  void delay(QFrequency) override {
+    delayUntil(0_ms);
+  }
+
+  void delayUntil(QTime) override {
+    while (!released.load()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  void delayUntil(uint32_t) override {
+    delayUntil(0_ms);
+  }
+
+  std::atomic_bool &released;
+};
+
+TEST_F(LoggerTest, FlusherWritesBufferedStatements) {
+  logger = std::make_shared<Logger>(std::make_unique<ConstantMockTimer>(0_ms),
+                                    logFile,
+                                    Logger::LogLevel::info,
+                                    std::make_unique<MockRate>());
+
+  logData(logger);
+  logger->close();
+
+  const std::string name = CrossplatformThread::getName();
+  EXPECT_EQ(std::string(logBuffer, logSize),
+            "0 (" + name + ") ERROR: MSG\n0 (" + name + ") WARN: MSG\n0 (" + name +
+              ") INFO: MSG\n");
+  EXPECT_EQ(logger->getDroppedCount(), 0);
+}
+
+TEST_F(LoggerTest, FlushWritesImmediately) {
+  std::atomic_bool released{false};
+  logger = std::make_shared<Logger>(std::make_unique<ConstantMockTimer>(0_ms),
+                                    logFile,
+                                    Logger::LogLevel::info,
+                                    std::make_unique<HeldRate>(released));
+
+  LOG_INFO_S("MSG");
+  logger->flush();
+  EXPECT_EQ(std::string(logBuffer, logSize),
+            "0 (" + CrossplatformThread::getName() + ") INFO: MSG\n");
+
+  released.store(true);
+  logger->close();
+}
+
+TEST_F(LoggerTest, FullBufferDropsStatements) {
+  std::atomic_bool released{false};
+  logger = std::make_shared<Logger>(std::make_unique<ConstantMockTimer>(0_ms),
+                                    logFile,
+                                    Logger::LogLevel::info,
+                                    std::make_unique<HeldRate>(released),
+                                    2);
+
+  // The flusher may take the first statements before it is held, so log until some are dropped
+  for (int i = 0; i < 10; ++i) {
+    LOG_INFO("MSG " + std::to_string(i));
+  }
+  EXPECT_GT(logger->getDroppedCount(), 0);
+
+  released.store(true);
+  logger->close();
+
+  const std::string output(logBuffer, logSize);
+  EXPECT_NE(output.find("INFO: MSG 0\n"), std::string::npos);
+  EXPECT_NE(output.find("WARN: Logger: Dropped " + std::to_string(logger->getDroppedCount()) +
+                        " log statements"),
+            std::string::npos);
+}
+
+TEST(LoggerLevelTest, EveryLevelIsCompiledInByDefault) {
+  static_assert(Logger::isCompiledIn(Logger::LogLevel::debug));
+  static_assert(Logger::isCompiledIn(Logger::LogLevel::info));
+  static_assert(Logger::isCompiledIn(Logger::LogLevel::warn));
+  static_assert(Logger::isCompiledIn(Logger::LogLevel::error));
+  SUCCEED();
+}
+
+TEST(CrossplatformThreadTest, CurrentNameIsCached) {
+  const char *name = CrossplatformThread::getCurrentName();
+  EXPECT_STREQ(name, CrossplatformThread::getName().c_str());
+  EXPECT_EQ(CrossplatformThread::getCurrentName(), name);
+
+  std::string otherName;
+  std::thread other([&] { otherName = CrossplatformThread::getCurrentName(); });
+  other.join();
+  EXPECT_STRNE(otherName.c_str(), name);
+}
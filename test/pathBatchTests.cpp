@@ -0,0 +1,78 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pathBatch.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <gtest/gtest.h>
+
+using namespace okapi;
+
+class PathBatchTest : public ::testing::Test {
+  protected:
+  void SetUp() override {
+    std::vector<std::shared_ptr<PathGenerationHandle>> handles;
+    for (const auto *id : {"A", "B", "C"}) {
+      handles.push_back(std::make_shared<PathGenerationHandle>(id, createTimeUtil()));
+    }
+    batch = std::make_unique<PathBatch>(handles, createTimeUtil());
+  }
+
+  std::unique_ptr<PathBatch> batch;
+};
+
+TEST_F(PathBatchTest, ClaimsPathsInOrder) {
+  EXPECT_EQ(batch->claimNext(), 0);
+  EXPECT_EQ(batch->claimNext(), 1);
+  EXPECT_EQ(batch->claimNext(), 2);
+  EXPECT_EQ(batch->claimNext(), batch->size());
+  EXPECT_EQ(batch->claimNext(), batch->size());
+}
+
+TEST_F(PathBatchTest, DoneWhenEveryHandleIsDone) {
+  EXPECT_FALSE(batch->isDone());
+
+  batch->recordResult(0, 5_ms, 100);
+  batch->getHandle(0)->markDone();
+  batch->getHandle(1)->markFailed("bad");
+  EXPECT_FALSE(batch->isDone());
+
+  batch->recordResult(2, 7_ms, 50);
+  batch->getHandle(2)->markDone();
+  EXPECT_TRUE(batch->isDone());
+  EXPECT_FALSE(batch->waitUntilDone());
+  EXPECT_EQ(batch->getSucceededCount(), 2);
+}
+
+TEST_F(PathBatchTest, ResultsOnlyCountOncePathsAreDone) {
+  batch->recordResult(0, 5_ms, 100);
+  EXPECT_EQ(batch->getGenerationTime(0), 0_ms);
+  EXPECT_EQ(batch->getBytesUsed(0), 0);
+
+  batch->getHandle(0)->markDone();
+  EXPECT_EQ(batch->getGenerationTime(0), 5_ms);
+  EXPECT_EQ(batch->getBytesUsed(0), 100);
+  EXPECT_EQ(batch->getTotalBytesUsed(), 100);
+}
+
+TEST_F(PathBatchTest, CancelSkipsUnclaimedPaths) {
+  EXPECT_EQ(batch->claimNext(), 0);
+  batch->getHandle(0)->markGenerating();
+
+  EXPECT_EQ(batch->getFirstSkipped(), batch->size());
+  batch->cancel();
+  EXPECT_TRUE(batch->isCancelled());
+  EXPECT_EQ(batch->claimNext(), batch->size());
+  EXPECT_EQ(batch->getFirstSkipped(), 1);
+
+  // The claimed path is left to finish
+  EXPECT_EQ(batch->getHandle(0)->getState(), PathGenerationHandle::State::generating);
+  EXPECT_EQ(batch->getHandle(1)->getState(), PathGenerationHandle::State::failed);
+  EXPECT_EQ(batch->getHandle(2)->getState(), PathGenerationHandle::State::failed);
+  EXPECT_NE(batch->getHandle(1)->getErrorMessage(), "");
+
+  batch->getHandle(0)->markDone();
+  EXPECT_FALSE(batch->waitUntilDone());
+  EXPECT_EQ(batch->getSucceededCount(), 1);
+}
@@ -0,0 +1,140 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pathCache.hpp"
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace okapi;
+
+class PathCacheTest : public ::testing::Test {
+  protected:
+  static PathCache::Path makePath(const std::size_t ilength) {
+    std::vector<squiggles::ProfilePoint> path;
+    for (std::size_t i = 0; i < ilength; ++i) {
+      path.emplace_back(squiggles::ControlVector(squiggles::Pose(i, 0, 0), 1.0),
+                        std::vector<double>{1.0, 1.0},
+                        0,
+                        i * 0.01);
+    }
+    return std::make_shared<const std::vector<squiggles::ProfilePoint>>(path);
+  }
+
+  static PathCache::Key testKey(const std::uint64_t ihash) {
+    return PathCache::Key{ihash, std::to_string(ihash)};
+  }
+};
+
+TEST_F(PathCacheTest, KeyDependsOnEveryInput) {
+  const std::vector<PathfinderPoint> points{{0_m, 0_m, 0_deg}, {1_m, 0_m, 0_deg}};
+  const PathfinderLimits limits{1, 2, 10};
+  const auto key = PathCache::makeKey(points, limits, 10_in, 0.01);
+
+  EXPECT_EQ(key, PathCache::makeKey(points, limits, 10_in, 0.01));
+  EXPECT_NE(key,
+            PathCache::makeKey({{0_m, 0_m, 0_deg}, {1_m, 0_m, 1_deg}}, limits, 10_in, 0.01));
+  EXPECT_NE(key, PathCache::makeKey(points, {1, 2, 11}, 10_in, 0.01));
+  EXPECT_NE(key, PathCache::makeKey(points, limits, 11_in, 0.01));
+  EXPECT_NE(key, PathCache::makeKey(points, limits, 10_in, 0.02));
+  EXPECT_NE(key, PathCache::makeKey(points, limits, 10_in, 0.01, 0.5));
+  EXPECT_NE(key, PathCache::makeKey(points, limits, 10_in, 0.01, 0, 0.5));
+  EXPECT_NE(key, PathCache::makeKey(points, limits, 10_in, 0.01, 0, 0, true));
+}
+
+TEST_F(PathCacheTest, KeyLayoutIsUnambiguous) {
+  // The same doubles split differently between the waypoints and the other inputs
+  const std::vector<PathfinderPoint> points{{0_m, 0_m, 0_deg}, {1_m, 0_m, 0_deg}};
+  auto morePoints = points;
+  morePoints.push_back({1_m, 2_m, 10_rad});
+
+  EXPECT_NE(PathCache::makeKey(points, {1, 2, 10}, 10_in, 0.01, 0.5, 0.25, true),
+            PathCache::makeKey(morePoints, {(10_in).convert(meter), 0.01, 0.5}, 0.25_m, 1));
+}
+
+TEST_F(PathCacheTest, CountsHitsAndMisses) {
+  PathCache cache;
+
+  EXPECT_EQ(cache.get(testKey(1)), nullptr);
+  cache.put(testKey(1), makePath(10));
+  EXPECT_NE(cache.get(testKey(1)), nullptr);
+  EXPECT_NE(cache.get(testKey(1)), nullptr);
+
+  EXPECT_EQ(cache.getHits(), 2);
+  EXPECT_EQ(cache.getMisses(), 1);
+}
+
+TEST_F(PathCacheTest, EvictsLeastRecentlyUsed) {
+  // Each key stores one byte of inputs
+  const auto pathBytes = PathCache::estimateBytes(*makePath(10)) + 1;
+  PathCache cache(pathBytes * 2);
+
+  cache.put(testKey(1), makePath(10));
+  cache.put(testKey(2), makePath(10));
+  cache.get(testKey(1)); // 2 is now the least recently used path
+  cache.put(testKey(3), makePath(10));
+
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_LE(cache.getBytesUsed(), cache.getMaxBytes());
+  EXPECT_NE(cache.get(testKey(1)), nullptr);
+  EXPECT_EQ(cache.get(testKey(2)), nullptr);
+  EXPECT_NE(cache.get(testKey(3)), nullptr);
+}
+
+TEST_F(PathCacheTest, PathLargerThanBudgetIsNotKept) {
+  PathCache cache(16);
+  cache.put(testKey(1), makePath(10));
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.getBytesUsed(), 0);
+}
+
+TEST_F(PathCacheTest, PersistedPathsSurviveClear) {
+  char directory[] = "/tmp/okapiPathCacheXXXXXX";
+  ASSERT_NE(mkdtemp(directory), nullptr);
+
+  PathCache cache;
+  cache.setPersistenceDirectory(directory);
+  const auto path = makePath(10);
+  cache.put(testKey(42), path);
+
+  // A new cache (e.g. after a reboot) loads the path from the directory
+  PathCache rebooted;
+  rebooted.setPersistenceDirectory(directory);
+  auto loaded = rebooted.get(testKey(42));
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(*loaded, *path);
+  EXPECT_EQ(rebooted.getHits(), 1);
+
+  std::remove((std::string(directory) + "/000000000000002a.bin").c_str());
+  rmdir(directory);
+}
+
+TEST_F(PathCacheTest, CollidingKeysMiss) {
+  PathCache cache;
+  cache.put({1, "A"}, makePath(10));
+
+  // Same hash, different inputs
+  EXPECT_EQ(cache.get({1, "B"}), nullptr);
+  EXPECT_NE(cache.get({1, "A"}), nullptr);
+  EXPECT_EQ(cache.getHits(), 1);
+  EXPECT_EQ(cache.getMisses(), 1);
+}
+
+TEST_F(PathCacheTest, CollidingPersistedKeysMiss) {
+  char directory[] = "/tmp/okapiPathCacheXXXXXX";
+  ASSERT_NE(mkdtemp(directory), nullptr);
+
+  PathCache cache;
+  cache.setPersistenceDirectory(directory);
+  cache.put({42, "A"}, makePath(10));
+
+  PathCache rebooted;
+  rebooted.setPersistenceDirectory(directory);
+  EXPECT_EQ(rebooted.get({42, "B"}), nullptr);
+  EXPECT_NE(rebooted.get({42, "A"}), nullptr);
+
+  std::remove((std::string(directory) + "/000000000000002a.bin").c_str());
+  rmdir(directory);
+}
@@ -0,0 +1,167 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pathCompiler.hpp"
+#include "okapi/api/control/util/splineProfile.hpp"
+#include "okapi/api/control/util/storedPath.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace okapi;
+
+namespace {
+constexpr StaticPathPoint testPoints[] = {
+  {0, 0, 0, 0.1, 1, 0, 0, 0.01, {0.1, 0.2}},
+  {0.001, 0, 0, 0.2, 1, 0, 0, 0.01, {0.3, 0.4}},
+  {0.003, 0, 0, 0.3, 1, 0, 0, 0.01, {0.5, 0.6}},
+};
+
+constexpr PathView testView(testPoints);
+static_assert(testView.size() == 3, "A view of an array sees every point");
+static_assert(testView[1].wheelVelocities[1] == 0.4, "A view can be read at compile time");
+
+PathManifest parse(const std::string &imanifest) {
+  std::istringstream in(imanifest);
+  return PathCompiler::parseManifest(in);
+}
+} // namespace
+
+TEST(PathCompilerTest, ParseManifest) {
+  const auto manifest = parse("# A comment\n"
+                              "wheelTrack 0.3\n"
+                              "\n"
+                              "limits 1 2 10\n"
+                              "path A 0 0 0 1 0 0  # Trailing comment\n"
+                              "limits 0.5 1 5\n"
+                              "path B 0 0 0 1 2 90 3 4 45\n");
+
+  EXPECT_EQ(manifest.wheelTrack, 0.3_m);
+  ASSERT_EQ(manifest.paths.size(), 2);
+
+  EXPECT_EQ(manifest.paths[0].id, "A");
+  ASSERT_EQ(manifest.paths[0].waypoints.size(), 2);
+  EXPECT_EQ(manifest.paths[0].waypoints[1].x, 1_m);
+  EXPECT_DOUBLE_EQ(manifest.paths[0].limits.maxVel, 1);
+
+  EXPECT_EQ(manifest.paths[1].id, "B");
+  ASSERT_EQ(manifest.paths[1].waypoints.size(), 3);
+  EXPECT_EQ(manifest.paths[1].waypoints[1].y, 2_m);
+  EXPECT_DOUBLE_EQ(manifest.paths[1].waypoints[1].theta.convert(degree), 90);
+  EXPECT_DOUBLE_EQ(manifest.paths[1].limits.maxVel, 0.5);
+  EXPECT_DOUBLE_EQ(manifest.paths[1].limits.maxJerk, 5);
+}
+
+TEST(PathCompilerTest, MalformedManifestsThrow) {
+  EXPECT_THROW(parse("wheelTrack 0.3\nfoo 1\n"), std::invalid_argument);
+  EXPECT_THROW(parse("wheelTrack 0.3\npath A 0 0 0\n"), std::invalid_argument);
+  EXPECT_THROW(parse("wheelTrack 0.3\nlimits 1 2\n"), std::invalid_argument);
+  EXPECT_THROW(parse("wheelTrack -1\n"), std::invalid_argument);
+  EXPECT_THROW(parse("wheelTrack 0.3\nlimits 1 2 10\npath A 0 0\n"), std::invalid_argument);
+  EXPECT_THROW(parse("wheelTrack 0.3\nlimits 1 2 10\npath A 0 0 x\n"), std::invalid_argument);
+  EXPECT_THROW(parse("wheelTrack 0.3\nlimits 1 2 10\npath A\n"), std::invalid_argument);
+  EXPECT_THROW(parse("wheelTrack 0.3\nlimits 1 2 10\npath A 0 0 0\npath A 1 1 1\n"),
+               std::invalid_argument);
+  EXPECT_THROW(parse("limits 1 2 10\npath A 0 0 0 1 0 0\n"), std::invalid_argument);
+}
+
+TEST(PathCompilerTest, ErrorsNameTheLine) {
+  try {
+    parse("wheelTrack 0.3\n\nfoo\n");
+    FAIL() << "Expected std::invalid_argument";
+  } catch (const std::invalid_argument &e) {
+    EXPECT_NE(std::string(e.what()).find("Line 3"), std::string::npos) << e.what();
+  }
+}
+
+TEST(PathCompilerTest, EmitHeader) {
+  const auto manifest = parse("wheelTrack 0.3\n"
+                              "limits 1 2 10\n"
+                              "path A 0 0 0 1 0 0\n"
+                              "path \"B\" 0 0 0 0.5 0 0\n");
+
+  std::ostringstream out;
+  PathCompiler::emitHeader(out, manifest, "autonPaths", 0.01);
+  const auto header = out.str();
+
+  EXPECT_NE(header.find("#pragma once"), std::string::npos);
+  EXPECT_NE(header.find("#include \"okapi/api/control/util/pathView.hpp\""), std::string::npos);
+  EXPECT_NE(header.find("namespace autonPaths {"), std::string::npos);
+  EXPECT_NE(header.find("inline constexpr okapi::StaticPathPoint path0Points[] = {"),
+            std::string::npos);
+  EXPECT_NE(header.find("inline constexpr okapi::StaticPathPoint path1Points[] = {"),
+            std::string::npos);
+  EXPECT_NE(header.find("{\"A\", okapi::PathView(path0Points)},"), std::string::npos);
+  EXPECT_NE(header.find("{\"\\\"B\\\"\", okapi::PathView(path1Points)},"), std::string::npos);
+
+  // One line per point of each path
+  const auto a = SplineProfile::generate(
+    manifest.paths[0].waypoints, manifest.paths[0].limits, manifest.wheelTrack, 0.01);
+  const auto b = SplineProfile::generate(
+    manifest.paths[1].waypoints, manifest.paths[1].limits, manifest.wheelTrack, 0.01);
+
+  std::size_t pointLines = 0;
+  std::istringstream lines(header);
+  for (std::string line; std::getline(lines, line);) {
+    if (line.rfind("  {", 0) == 0 && line.find("PathView") == std::string::npos) {
+      ++pointLines;
+    }
+  }
+  EXPECT_EQ(pointLines, a.size() + b.size());
+}
+
+TEST(PathCompilerTest, EmittedValuesRoundTrip) {
+  const auto manifest = parse("wheelTrack 0.3\nlimits 1 2 10\npath A 0 0 0 1 0.5 30\n");
+
+  std::ostringstream out;
+  PathCompiler::emitHeader(out, manifest, "p", 0.01);
+  const auto profile = SplineProfile::generate(
+    manifest.paths[0].waypoints, manifest.paths[0].limits, manifest.wheelTrack, 0.01);
+
+  // Read the first point back the way the compiler will
+  const auto header = out.str();
+  auto line = header.substr(header.find("  {") + 3);
+  for (char &c : line) {
+    if (c == ',' || c == '{' || c == '}') {
+      c = ' ';
+    }
+  }
+
+  std::istringstream values(line);
+  double x, y, yaw, vel, accel, jerk, curvature, time, left, right;
+  values >> x >> y >> yaw >> vel >> accel >> jerk >> curvature >> time >> left >> right;
+
+  const auto &first = profile.front();
+  EXPECT_EQ(x, first.vector.pose.x);
+  EXPECT_EQ(y, first.vector.pose.y);
+  EXPECT_EQ(yaw, first.vector.pose.yaw);
+  EXPECT_EQ(vel, first.vector.vel);
+  EXPECT_EQ(time, first.time);
+  EXPECT_EQ(left, first.wheel_velocities[0]);
+  EXPECT_EQ(right, first.wheel_velocities[1]);
+}
+
+TEST(PathCompilerTest, EmptyManifestThrows) {
+  std::ostringstream out;
+  EXPECT_THROW(PathCompiler::emitHeader(out, PathManifest{}, "p", 0.01), std::invalid_argument);
+  EXPECT_TRUE(out.str().empty());
+}
+
+TEST(PathCompilerTest, StoredPathReadsViewInPlace) {
+  StoredPath path(testView);
+
+  EXPECT_TRUE(path.isView());
+  EXPECT_FALSE(path.isCompact());
+  EXPECT_EQ(path.size(), 3);
+  EXPECT_EQ(path.getView().data(), testPoints);
+  EXPECT_DOUBLE_EQ(path.getWheelVelocity(0, 2), 0.5);
+  EXPECT_DOUBLE_EQ(path.getWheelVelocity(1, 2), 0.6);
+  EXPECT_EQ(path.getBytesUsed(), sizeof(StoredPath));
+
+  const auto profile = path.toProfile();
+  ASSERT_EQ(profile.size(), 3);
+  EXPECT_DOUBLE_EQ(profile[1].vector.pose.x, 0.001);
+  EXPECT_DOUBLE_EQ(profile[1].vector.vel, 0.2);
+  EXPECT_DOUBLE_EQ(profile[1].wheel_velocities[1], 0.4);
+}
@@ -0,0 +1,109 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pathTable.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <gtest/gtest.h>
+
+using namespace okapi;
+
+static StoredPathPtr makePath() {
+  return std::make_shared<const StoredPath>(
+    std::vector<squiggles::ProfilePoint>{squiggles::ProfilePoint()});
+}
+
+TEST(PathHandleTest, DefaultHandleIsInvalid) {
+  EXPECT_FALSE(PathHandle().isValid());
+  EXPECT_TRUE(PathHandle(0).isValid());
+  EXPECT_EQ(PathHandle(), PathHandle(PathHandle::invalidIndex));
+  EXPECT_NE(PathHandle(0), PathHandle(1));
+}
+
+TEST(PathTableTest, InternIsStable) {
+  PathTable table;
+  const auto a = table.intern("A");
+  const auto b = table.intern("B");
+  EXPECT_TRUE(a.isValid());
+  EXPECT_NE(a, b);
+  EXPECT_EQ(table.intern("A"), a);
+  EXPECT_EQ(table.find("B"), b);
+  EXPECT_EQ(table.getName(a), "A");
+}
+
+TEST(PathTableTest, FindUnknownNameIsInvalid) {
+  PathTable table;
+  EXPECT_FALSE(table.find("A").isValid());
+  EXPECT_EQ(table.getName(PathHandle()), "");
+  EXPECT_EQ(table.get(PathHandle()), nullptr);
+  EXPECT_EQ(table.getPending(PathHandle(3)), nullptr);
+}
+
+TEST(PathTableTest, GetNamesIsSortedAndSkipsRemovedPaths) {
+  PathTable table;
+  const auto c = table.intern("C");
+  const auto a = table.intern("A");
+  const auto b = table.intern("B");
+  table.set(c, makePath());
+  table.set(a, makePath());
+  table.set(b, makePath());
+  EXPECT_EQ(table.getNames(), (std::vector<std::string>{"A", "B", "C"}));
+
+  table.set(b, nullptr);
+  EXPECT_EQ(table.getNames(), (std::vector<std::string>{"A", "C"}));
+  EXPECT_EQ(table.find("B"), b);
+}
+
+TEST(PathTableTest, UnnamedSlotsHaveNoName) {
+  PathTable table;
+  const auto unnamed = table.addUnnamed();
+  EXPECT_TRUE(unnamed.isValid());
+  EXPECT_NE(table.addUnnamed(), unnamed);
+  EXPECT_EQ(table.getName(unnamed), "");
+  EXPECT_FALSE(table.find("").isValid());
+
+  table.set(unnamed, makePath());
+  EXPECT_NE(table.get(unnamed), nullptr);
+  EXPECT_TRUE(table.getNames().empty());
+  EXPECT_NE(table.intern(""), unnamed);
+}
+
+TEST(PathTableTest, SetReplacesThePath) {
+  PathTable table;
+  const auto a = table.intern("A");
+  const auto first = makePath();
+  const auto second = makePath();
+  table.set(a, first);
+  EXPECT_EQ(table.get(a), first);
+  table.set(a, second);
+  EXPECT_EQ(table.get(a), second);
+}
+
+TEST(PathTableTest, PendingGenerations) {
+  PathTable table;
+  const auto a = table.intern("A");
+  const auto b = table.intern("B");
+  const auto pending = std::make_shared<PathGenerationHandle>("A", createTimeUtil());
+  table.setPending(b, pending);
+  EXPECT_EQ(table.getPending(a), nullptr);
+  EXPECT_EQ(table.getPending(b), pending);
+  EXPECT_EQ(table.getAllPending().size(), 1u);
+
+  table.setPending(b, nullptr);
+  EXPECT_TRUE(table.getAllPending().empty());
+}
+
+TEST(PathTableTest, ClearKeepsHandles) {
+  PathTable table;
+  const auto a = table.intern("A");
+  table.set(a, makePath());
+  table.setPending(a, std::make_shared<PathGenerationHandle>("A", createTimeUtil()));
+  table.clear();
+
+  EXPECT_EQ(table.get(a), nullptr);
+  EXPECT_TRUE(table.getAllPending().empty());
+  EXPECT_TRUE(table.getNames().empty());
+  EXPECT_EQ(table.find("A"), a);
+  EXPECT_EQ(table.getName(a), "A");
+}
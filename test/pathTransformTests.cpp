@@ -0,0 +1,164 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pathTransform.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace okapi;
+
+static squiggles::ProfilePoint makePoint(const double x,
+                                         const double y,
+                                         const double yaw,
+                                         const double vel,
+                                         const double time) {
+  return squiggles::ProfilePoint(squiggles::ControlVector(squiggles::Pose(x, y, yaw), vel, 1, 2),
+                                 std::vector<double>{vel * 0.9, vel * 1.1},
+                                 0.5,
+                                 time);
+}
+
+/**
+ * A path which drives one meter forwards from `{0_m, 0_m, 0_deg}`. In the frame of a path that is
+ * along +y with a heading of pi/2.
+ */
+static std::vector<squiggles::ProfilePoint> makeForwardPath() {
+  return {makePoint(0, 0, M_PI / 2, 0, 0),
+          makePoint(0, 0.5, M_PI / 2, 1, 0.5),
+          makePoint(0, 1, M_PI / 2, 0, 1)};
+}
+
+static void expectPose(const squiggles::ProfilePoint &ipoint,
+                       const double ix,
+                       const double iy,
+                       const double iyaw) {
+  EXPECT_NEAR(ipoint.vector.pose.x, ix, 1e-9);
+  EXPECT_NEAR(ipoint.vector.pose.y, iy, 1e-9);
+  EXPECT_NEAR(std::remainder(ipoint.vector.pose.yaw - iyaw, 2 * M_PI), 0, 1e-9);
+}
+
+TEST(PathTransformTest, TransformMovesTheOrigin) {
+  const auto path = makeForwardPath();
+  const auto moved = PathTransform::transform(path, {1_m, 2_m, 90_deg});
+  ASSERT_EQ(moved.size(), path.size());
+
+  // Turned 90 degrees clockwise, forwards is +y in the field, which is +x in the frame of a path
+  expectPose(moved[0], 2, 1, 0);
+  expectPose(moved[1], 2.5, 1, 0);
+  expectPose(moved[2], 3, 1, 0);
+
+  for (std::size_t i = 0; i < path.size(); ++i) {
+    EXPECT_EQ(moved[i].vector.vel, path[i].vector.vel);
+    EXPECT_EQ(moved[i].wheel_velocities, path[i].wheel_velocities);
+    EXPECT_EQ(moved[i].curvature, path[i].curvature);
+    EXPECT_EQ(moved[i].time, path[i].time);
+  }
+}
+
+TEST(PathTransformTest, TransformByTheOriginChangesNothing) {
+  const auto path = makeForwardPath();
+  const auto moved = PathTransform::transform(path, {0_m, 0_m, 0_deg});
+  for (std::size_t i = 0; i < path.size(); ++i) {
+    const auto &pose = path[i].vector.pose;
+    expectPose(moved[i], pose.x, pose.y, pose.yaw);
+  }
+}
+
+TEST(PathTransformTest, MirrorAcrossTheStartingHeading) {
+  const std::vector<squiggles::ProfilePoint> path{makePoint(0.5, 1, M_PI / 3, 1, 0)};
+  const auto mirrored = PathTransform::mirror(path);
+
+  expectPose(mirrored[0], -0.5, 1, 2 * M_PI / 3);
+  EXPECT_EQ(mirrored[0].curvature, -0.5);
+  EXPECT_EQ(mirrored[0].wheel_velocities, (std::vector<double>{1.1, 0.9}));
+  EXPECT_EQ(mirrored[0].vector.vel, 1);
+}
+
+TEST(PathTransformTest, MirrorAcrossAnArbitraryLine) {
+  // The line x = 0 in the field, pointing along +y
+  const auto path = makeForwardPath();
+  const auto mirrored = PathTransform::mirror(path, {0_m, 1_m, 90_deg});
+
+  expectPose(mirrored[0], 0, 0, -M_PI / 2);
+  expectPose(mirrored[2], 0, -1, -M_PI / 2);
+}
+
+TEST(PathTransformTest, MirrorTwiceChangesNothing) {
+  const std::vector<squiggles::ProfilePoint> path{makePoint(0.3, -1.2, 0.4, 1, 0)};
+  const PathfinderPoint axis{0.7_m, -0.2_m, 33_deg};
+  const auto twice = PathTransform::mirror(PathTransform::mirror(path, axis), axis);
+
+  const auto &pose = path[0].vector.pose;
+  expectPose(twice[0], pose.x, pose.y, pose.yaw);
+  EXPECT_EQ(twice[0].wheel_velocities, path[0].wheel_velocities);
+  EXPECT_EQ(twice[0].curvature, path[0].curvature);
+}
+
+TEST(PathTransformTest, ReverseRetracesThePathBackwards) {
+  const auto path = makeForwardPath();
+  const auto reversed = PathTransform::reverse(path);
+  ASSERT_EQ(reversed.size(), path.size());
+
+  // The robot drives backwards from the end to the start and keeps facing the same way
+  expectPose(reversed[0], 0, 1, M_PI / 2);
+  expectPose(reversed[2], 0, 0, M_PI / 2);
+  EXPECT_EQ(reversed[1].vector.vel, -1);
+  EXPECT_EQ(reversed[1].vector.accel, 1);
+  EXPECT_EQ(reversed[1].vector.jerk, -2);
+  EXPECT_EQ(reversed[1].wheel_velocities, (std::vector<double>{-0.9, -1.1}));
+  EXPECT_EQ(reversed[1].curvature, 0.5);
+
+  EXPECT_EQ(reversed[0].time, 0);
+  EXPECT_EQ(reversed[1].time, 0.5);
+  EXPECT_EQ(reversed[2].time, 1);
+}
+
+TEST(PathTransformTest, ReverseTwiceChangesNothing) {
+  const auto path = makeForwardPath();
+  EXPECT_EQ(PathTransform::reverse(PathTransform::reverse(path)), path);
+  EXPECT_TRUE(PathTransform::reverse({}).empty());
+}
+
+TEST(PathTransformTest, StitchStartsTheSecondPathAtTheEndOfTheFirst) {
+  // The second path starts somewhere else facing +x in the frame of a path
+  const std::vector<squiggles::ProfilePoint> second{makePoint(5, 5, 0, 0, 2),
+                                                    makePoint(6, 5, 0, 1, 3),
+                                                    makePoint(6, 6, M_PI / 2, 0, 4)};
+  const auto stitched = PathTransform::stitch(makeForwardPath(), second, 0);
+  ASSERT_EQ(stitched.size(), 5);
+
+  // The joint is not duplicated and the second path keeps its shape relative to its start
+  expectPose(stitched[2], 0, 1, M_PI / 2);
+  expectPose(stitched[3], 0, 2, M_PI / 2);
+  expectPose(stitched[4], -1, 2, M_PI);
+
+  EXPECT_EQ(stitched[3].vector.vel, 1);
+  EXPECT_EQ(stitched[3].time, 2);
+  EXPECT_EQ(stitched[4].time, 3);
+}
+
+TEST(PathTransformTest, StitchWithAVelocityJumpThrows) {
+  auto first = makeForwardPath();
+  first.back().vector.vel = 0.5;
+  EXPECT_THROW(PathTransform::stitch(first, makeForwardPath(), 0.1), std::invalid_argument);
+  EXPECT_NO_THROW(PathTransform::stitch(first, makeForwardPath(), 0.5));
+}
+
+TEST(PathTransformTest, StitchAllowsOneTimestepOfThePathsAcceleration) {
+  // Each path accelerates at 1 m/s^2 with a timestep of 0.5 s
+  auto first = makeForwardPath();
+  first.back().vector.vel = 0.5;
+  EXPECT_NO_THROW(PathTransform::stitch(first, makeForwardPath()));
+
+  first.back().vector.vel = 0.6;
+  EXPECT_THROW(PathTransform::stitch(first, makeForwardPath()), std::invalid_argument);
+}
+
+TEST(PathTransformTest, StitchWithAnEmptyPath) {
+  const auto path = makeForwardPath();
+  EXPECT_EQ(PathTransform::stitch(path, {}, 0), path);
+  EXPECT_EQ(PathTransform::stitch({}, path, 0), path);
+}
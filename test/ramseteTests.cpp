@@ -0,0 +1,59 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/ramsete.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace okapi;
+
+TEST(RamseteTest, NoErrorFollowsTheReference) {
+  const squiggles::Pose pose(1, 2, 0.5);
+  const auto command = Ramsete::calculate(pose, 1.5, 0.25, pose, RamseteGains{});
+  EXPECT_DOUBLE_EQ(command.linear, 1.5);
+  EXPECT_DOUBLE_EQ(command.angular, 0.25);
+}
+
+TEST(RamseteTest, BehindSpeedsUp) {
+  const auto command =
+    Ramsete::calculate({0, 1, M_PI / 2}, 1, 0, {0, 0.9, M_PI / 2}, RamseteGains{});
+  EXPECT_GT(command.linear, 1);
+  EXPECT_NEAR(command.angular, 0, 1e-9);
+}
+
+TEST(RamseteTest, AheadSlowsDown) {
+  const auto command = Ramsete::calculate({1, 0, 0}, 1, 0, {1.1, 0, 0}, RamseteGains{});
+  EXPECT_LT(command.linear, 1);
+  EXPECT_NEAR(command.angular, 0, 1e-9);
+}
+
+TEST(RamseteTest, RightOfThePathTurnsLeft) {
+  // Driving along +x, so the path is to the robot's left
+  const auto command = Ramsete::calculate({1, 0, 0}, 1, 0, {1, -0.1, 0}, RamseteGains{});
+  EXPECT_GT(command.angular, 0);
+
+  const auto mirrored = Ramsete::calculate({1, 0, 0}, 1, 0, {1, 0.1, 0}, RamseteGains{});
+  EXPECT_DOUBLE_EQ(mirrored.angular, -command.angular);
+}
+
+TEST(RamseteTest, HeadingErrorTurnsBack) {
+  const auto command = Ramsete::calculate({1, 0, 0}, 1, 0, {1, 0, -0.2}, RamseteGains{});
+  EXPECT_GT(command.angular, 0);
+  EXPECT_LT(command.linear, 1);
+}
+
+TEST(RamseteTest, HeadingErrorWrapsTheShortWay) {
+  // Just under pi and just over -pi are close together, so turn clockwise a little
+  const auto command =
+    Ramsete::calculate({0, 0, M_PI - 0.1}, 1, 0, {0, 0, -M_PI + 0.1}, RamseteGains{});
+  EXPECT_LT(command.angular, 0);
+  EXPECT_GT(command.angular, -2);
+}
+
+TEST(RamseteTest, LargerBCorrectsHarder) {
+  const auto soft = Ramsete::calculate({1, 0, 0}, 1, 0, {1, -0.1, 0}, RamseteGains{1, 0.7});
+  const auto hard = Ramsete::calculate({1, 0, 0}, 1, 0, {1, -0.1, 0}, RamseteGains{4, 0.7});
+  EXPECT_GT(hard.angular, soft.angular);
+}
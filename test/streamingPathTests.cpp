@@ -0,0 +1,59 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/streamingPath.hpp"
+#include <gtest/gtest.h>
+
+using namespace okapi;
+
+static StoredPathPtr makeChunk(const std::size_t ipoints) {
+  return std::make_shared<const StoredPath>(std::vector<squiggles::ProfilePoint>(
+    ipoints, squiggles::ProfilePoint{squiggles::ControlVector{}, {0, 0}, 0, 0}));
+}
+
+TEST(StreamingPathTest, StartsEmpty) {
+  StreamingPath path(2, 100_ms);
+  EXPECT_EQ(path.getChunkCount(), 2);
+  EXPECT_EQ(path.getAvailableChunkCount(), 0);
+  EXPECT_EQ(path.getAvailablePointCount(), 0);
+  EXPECT_EQ(path.getChunk(0), nullptr);
+  EXPECT_EQ(path.getLeadTime(), 100_ms);
+  EXPECT_FALSE(path.isComplete());
+  EXPECT_FALSE(path.hasFailed());
+}
+
+TEST(StreamingPathTest, AppendChunks) {
+  StreamingPath path(2, 0_ms);
+  const auto first = makeChunk(3);
+  const auto second = makeChunk(5);
+
+  path.append(first);
+  EXPECT_EQ(path.getChunk(0), first);
+  EXPECT_EQ(path.getChunk(1), nullptr);
+  EXPECT_EQ(path.getAvailablePointCount(), 3);
+  EXPECT_FALSE(path.isComplete());
+
+  path.append(second);
+  EXPECT_EQ(path.getChunk(1), second);
+  EXPECT_EQ(path.getAvailablePointCount(), 8);
+  EXPECT_TRUE(path.isComplete());
+}
+
+TEST(StreamingPathTest, ExtraChunksAreIgnored) {
+  StreamingPath path(1, 0_ms);
+  path.append(makeChunk(3));
+  path.append(makeChunk(5));
+  EXPECT_EQ(path.getAvailableChunkCount(), 1);
+  EXPECT_EQ(path.getAvailablePointCount(), 3);
+}
+
+TEST(StreamingPathTest, MarkFailed) {
+  StreamingPath path(2, 0_ms);
+  path.append(makeChunk(3));
+  path.markFailed();
+  EXPECT_TRUE(path.hasFailed());
+  EXPECT_FALSE(path.isComplete());
+  EXPECT_NE(path.getChunk(0), nullptr);
+}
@@ -0,0 +1,75 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/synchronizedProfile.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace okapi;
+
+TEST(SynchronizedProfileTest, AllAxesFinishTogether) {
+  const PathfinderLimits lift{1, 2, 10};
+  const PathfinderLimits arm{0.5, 1, 5};
+  const SynchronizedProfile profile(
+    LinearProfileShape::sCurve, {{0_m, 1_m}, {0_m, 0.2_m}, {2_m, 1_m}}, {lift, arm, lift});
+
+  ASSERT_EQ(profile.getAxisCount(), 3);
+  for (std::size_t i = 0; i < profile.getAxisCount(); ++i) {
+    EXPECT_EQ(profile.getProfile(i).getDuration(), profile.getDuration());
+  }
+
+  EXPECT_DOUBLE_EQ(profile.sample(0, profile.getDuration()).position, 1);
+  EXPECT_DOUBLE_EQ(profile.sample(1, profile.getDuration()).position, 0.2);
+  EXPECT_DOUBLE_EQ(profile.sample(2, profile.getDuration()).position, 1);
+}
+
+TEST(SynchronizedProfileTest, TheSlowestAxisSetsTheDuration) {
+  const PathfinderLimits lift{1, 2, 10};
+  const PathfinderLimits arm{0.5, 1, 5};
+  const SynchronizedProfile profile(
+    LinearProfileShape::trapezoidal, {{0_m, 1_m}, {0_m, 1_m}}, {lift, arm});
+
+  // The arm can't go any faster, so its profile is not stretched
+  const LinearProfile armAlone(LinearProfileShape::trapezoidal, 0_m, 1_m, arm);
+  EXPECT_EQ(profile.getLimitingAxis(), 1);
+  EXPECT_EQ(profile.getDuration(), armAlone.getDuration());
+  EXPECT_DOUBLE_EQ(profile.getProfile(1).getPeakVelocity(), armAlone.getPeakVelocity());
+  EXPECT_LT(profile.getProfile(0).getPeakVelocity(), lift.maxVel);
+}
+
+TEST(SynchronizedProfileTest, EveryAxisStaysWithinItsLimits) {
+  const PathfinderLimits lift{1, 2, 10};
+  const PathfinderLimits arm{0.5, 1, 5};
+  const SynchronizedProfile profile(
+    LinearProfileShape::sCurve, {{0_m, 0.3_m}, {1_m, -1_m}}, {lift, arm});
+
+  const std::vector<PathfinderLimits> limits{lift, arm};
+  const double duration = profile.getDuration().convert(second);
+  for (double t = 0; t <= duration; t += 0.001) {
+    for (std::size_t i = 0; i < limits.size(); ++i) {
+      const auto state = profile.sample(i, t * second);
+      EXPECT_LE(std::abs(state.velocity), limits[i].maxVel + 1e-9);
+      EXPECT_LE(std::abs(state.acceleration), limits[i].maxAccel + 1e-9);
+    }
+  }
+}
+
+TEST(SynchronizedProfileTest, AnAxisWhichDoesNotMoveHoldsItsPosition) {
+  const SynchronizedProfile profile(
+    LinearProfileShape::sCurve, {{1_m, 1_m}, {0_m, 1_m}}, {{1, 2, 10}, {1, 2, 10}});
+
+  EXPECT_EQ(profile.getLimitingAxis(), 1);
+  EXPECT_DOUBLE_EQ(profile.sample(0, profile.getDuration() / 2).position, 1);
+  EXPECT_DOUBLE_EQ(profile.sample(0, profile.getDuration() / 2).velocity, 0);
+}
+
+TEST(SynchronizedProfileTest, MismatchedOrMissingAxesThrow) {
+  EXPECT_THROW(SynchronizedProfile(LinearProfileShape::sCurve, {}, {}), std::invalid_argument);
+  EXPECT_THROW(SynchronizedProfile(LinearProfileShape::sCurve, {{0_m, 1_m}}, {}),
+               std::invalid_argument);
+  EXPECT_THROW(SynchronizedProfile(LinearProfileShape::sCurve, {{0_m, 1_m}}, {{0, 2, 10}}),
+               std::invalid_argument);
+}
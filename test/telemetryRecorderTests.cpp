@@ -0,0 +1,156 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/telemetryDecoder.hpp"
+#include "okapi/api/util/telemetryRecorder.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace okapi;
+
+class TelemetryRecorderTest : public ::testing::Test {
+  protected:
+  /**
+   * Writes the recorder to a temporary file and decodes it.
+   */
+  TelemetryLog roundTrip(TelemetryRecorder &irecorder) {
+    FILE *file = tmpfile();
+    EXPECT_TRUE(irecorder.write(file));
+    rewind(file);
+    auto log = TelemetryDecoder::decode(file);
+    fclose(file);
+    return log;
+  }
+};
+
+TEST_F(TelemetryRecorderTest, AddingAChannelTwiceReturnsTheSameChannel) {
+  TelemetryRecorder recorder(createConstantTimeUtil(10_ms), 4);
+  const auto left = recorder.addChannel("left");
+  const auto right = recorder.addChannel("right");
+  EXPECT_NE(left, right);
+  EXPECT_EQ(recorder.addChannel("left"), left);
+}
+
+TEST_F(TelemetryRecorderTest, SamplesRoundTrip) {
+  TelemetryRecorder recorder(createConstantTimeUtil(10_ms), 4);
+  const auto left = recorder.addChannel("left");
+  const auto right = recorder.addChannel("right");
+
+  EXPECT_TRUE(recorder.record(left, {1, 2, 3, 4, 5, 6, 7, 10_ms}));
+  EXPECT_TRUE(recorder.record(right, {-1, -2, -3, -4, -5, -6, -7, 20_ms}));
+  EXPECT_EQ(recorder.getSampleCount(), 2);
+
+  const auto log = roundTrip(recorder);
+  ASSERT_EQ(log.size(), 2);
+  EXPECT_EQ(log.channelNames, (std::vector<std::string>{"left", "right"}));
+  EXPECT_EQ(log.channels[0], left);
+  EXPECT_EQ(log.channels[1], right);
+  EXPECT_EQ(log.times[0], 0);
+
+  const auto first = log.getSample(0);
+  EXPECT_FLOAT_EQ(first.target, 1);
+  EXPECT_FLOAT_EQ(first.reading, 2);
+  EXPECT_FLOAT_EQ(first.error, 3);
+  EXPECT_FLOAT_EQ(first.p, 4);
+  EXPECT_FLOAT_EQ(first.i, 5);
+  EXPECT_FLOAT_EQ(first.d, 6);
+  EXPECT_FLOAT_EQ(first.output, 7);
+  EXPECT_FLOAT_EQ(first.dt.convert(millisecond), 10);
+
+  const auto second = log.getSample(1);
+  EXPECT_FLOAT_EQ(second.output, -7);
+  EXPECT_FLOAT_EQ(second.dt.convert(millisecond), 20);
+}
+
+TEST_F(TelemetryRecorderTest, FullRecorderDropsAndCounts) {
+  TelemetryRecorder recorder(createConstantTimeUtil(10_ms), 2);
+  const auto channel = recorder.addChannel("pid");
+
+  EXPECT_TRUE(recorder.record(channel, {1}));
+  EXPECT_TRUE(recorder.record(channel, {2}));
+  EXPECT_FALSE(recorder.record(channel, {3}));
+  EXPECT_EQ(recorder.getSampleCount(), 2);
+  EXPECT_EQ(recorder.getDroppedCount(), 1);
+
+  const auto log = roundTrip(recorder);
+  ASSERT_EQ(log.size(), 2);
+  EXPECT_FLOAT_EQ(log.values[0][1], 2);
+}
+
+TEST_F(TelemetryRecorderTest, ManyTasksRecordAtOnce) {
+  constexpr int taskCount = 4;
+  constexpr int samplesPerTask = 1000;
+  TelemetryRecorder recorder(createConstantTimeUtil(10_ms), taskCount * samplesPerTask);
+
+  std::vector<std::thread> tasks;
+  for (int task = 0; task < taskCount; ++task) {
+    const auto channel = recorder.addChannel(std::to_string(task));
+    tasks.emplace_back([&recorder, channel] {
+      for (int i = 0; i < samplesPerTask; ++i) {
+        recorder.record(channel, {static_cast<double>(i)});
+      }
+    });
+  }
+
+  for (auto &task : tasks) {
+    task.join();
+  }
+
+  const auto log = roundTrip(recorder);
+  ASSERT_EQ(log.size(), taskCount * samplesPerTask);
+  EXPECT_EQ(recorder.getDroppedCount(), 0);
+
+  // Each task's samples keep their order
+  std::vector<float> lastTarget(taskCount, -1);
+  for (std::size_t i = 0; i < log.size(); ++i) {
+    EXPECT_GT(log.values[0][i], lastTarget[log.channels[i]]);
+    lastTarget[log.channels[i]] = log.values[0][i];
+  }
+}
+
+TEST_F(TelemetryRecorderTest, DecodeRejectsOtherFiles) {
+  FILE *file = tmpfile();
+  fputs("not telemetry", file);
+  rewind(file);
+  EXPECT_THROW(TelemetryDecoder::decode(file), std::runtime_error);
+  fclose(file);
+}
+
+TEST_F(TelemetryRecorderTest, DecodeRejectsTruncatedFiles) {
+  TelemetryRecorder recorder(createConstantTimeUtil(10_ms), 4);
+  recorder.record(recorder.addChannel("pid"), {1});
+
+  FILE *file = tmpfile();
+  recorder.write(file);
+  const auto length = ftell(file);
+  rewind(file);
+
+  std::vector<char> bytes(length - 1);
+  ASSERT_EQ(fread(bytes.data(), 1, bytes.size(), file), bytes.size());
+  fclose(file);
+
+  file = tmpfile();
+  fwrite(bytes.data(), 1, bytes.size(), file);
+  rewind(file);
+  EXPECT_THROW(TelemetryDecoder::decode(file), std::runtime_error);
+  fclose(file);
+}
+
+TEST_F(TelemetryRecorderTest, WritesCsv) {
+  TelemetryRecorder recorder(createConstantTimeUtil(10_ms), 4);
+  recorder.record(recorder.addChannel("pid"), {1, 0.5, 0.5, 0.25, 0, 0, 0.25, 10_ms});
+
+  char *buffer = nullptr;
+  size_t size = 0;
+  FILE *csv = open_memstream(&buffer, &size);
+  TelemetryDecoder::writeCsv(csv, roundTrip(recorder));
+  fclose(csv);
+
+  EXPECT_EQ(std::string(buffer, size),
+            "time_ms,channel,target,reading,error,p,i,d,output,dt_ms\n"
+            "0,pid,1,0.5,0.5,0.25,0,0,0.25,10\n");
+  free(buffer);
+}
@@ -0,0 +1,242 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/telemetryStream.hpp"
+#include "okapi/api/util/telemetryStreamDecoder.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <chrono>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace okapi;
+
+namespace {
+class MockOdometry : public Odometry {
+  public:
+  void setScales(const ChassisScales &) override {
+  }
+
+  void step() override {
+  }
+
+  OdomState getState(const StateMode & = StateMode::FRAME_TRANSFORMATION) const override {
+    return state;
+  }
+
+  void setState(const OdomState &istate,
+                const StateMode & = StateMode::FRAME_TRANSFORMATION) override {
+    state = istate;
+  }
+
+  std::shared_ptr<ReadOnlyChassisModel> getModel() override {
+    return nullptr;
+  }
+
+  ChassisScales getScales() override {
+    return {{4_in, 10.5_in}, quadEncoderTPR};
+  }
+
+  OdomState state;
+};
+} // namespace
+
+class TelemetryStreamTest : public ::testing::Test {
+  protected:
+  void SetUp() override {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    readEnd = fds[0];
+    fcntl(readEnd, F_SETFL, O_NONBLOCK);
+    writeEnd = fdopen(fds[1], "wb");
+  }
+
+  void TearDown() override {
+    fclose(writeEnd);
+    close(readEnd);
+  }
+
+  /**
+   * Reads everything which is in the pipe.
+   */
+  std::vector<std::uint8_t> readBytes() {
+    std::vector<std::uint8_t> bytes;
+    std::uint8_t buffer[256];
+    ssize_t length;
+    while ((length = read(readEnd, buffer, sizeof(buffer))) > 0) {
+      bytes.insert(bytes.end(), buffer, buffer + length);
+    }
+    return bytes;
+  }
+
+  /**
+   * Decodes everything which is in the pipe.
+   */
+  std::vector<TelemetryStreamMessage> readMessages() {
+    const auto bytes = readBytes();
+    return decoder.feed(bytes.data(), bytes.size());
+  }
+
+  int readEnd{-1};
+  FILE *writeEnd{nullptr};
+  TelemetryStreamDecoder decoder;
+};
+
+TEST_F(TelemetryStreamTest, NullFileThrows) {
+  EXPECT_THROW(TelemetryStream(createConstantTimeUtil(10_ms), nullptr), std::invalid_argument);
+}
+
+TEST_F(TelemetryStreamTest, ControllerSampleRoundTrips) {
+  TelemetryStream stream(createConstantTimeUtil(10_ms), writeEnd);
+  const auto channel = stream.addChannel("turn");
+  EXPECT_EQ(stream.addChannel("turn"), channel);
+  EXPECT_TRUE(stream.record(channel, {1, 2, 3, 4, 5, 6, 7, 10_ms}));
+  EXPECT_FALSE(stream.record(channel + 1, {}));
+
+  stream.publish();
+  const auto messages = readMessages();
+
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(decoder.getChannelName(channel), "turn");
+  EXPECT_EQ(messages[0].id, TelemetryFrame::MessageId::controllerSample);
+  EXPECT_EQ(messages[0].channel, channel);
+  EXPECT_EQ(messages[0].time, 0);
+  EXPECT_FLOAT_EQ(messages[0].sample.target, 1);
+  EXPECT_FLOAT_EQ(messages[0].sample.reading, 2);
+  EXPECT_FLOAT_EQ(messages[0].sample.error, 3);
+  EXPECT_FLOAT_EQ(messages[0].sample.p, 4);
+  EXPECT_FLOAT_EQ(messages[0].sample.i, 5);
+  EXPECT_FLOAT_EQ(messages[0].sample.d, 6);
+  EXPECT_FLOAT_EQ(messages[0].sample.output, 7);
+  EXPECT_FLOAT_EQ(messages[0].sample.dt.convert(millisecond), 10);
+  EXPECT_EQ(decoder.getCorruptFrameCount(), 0);
+}
+
+TEST_F(TelemetryStreamTest, OdometrySampleRoundTrips) {
+  TelemetryStream stream(createConstantTimeUtil(10_ms), writeEnd);
+  auto odom = std::make_shared<MockOdometry>();
+  odom->state = {1_m, -2_m, 90_deg};
+  EXPECT_THROW(stream.addOdometryChannel("odom", nullptr), std::invalid_argument);
+  const auto channel = stream.addOdometryChannel("odom", odom);
+
+  stream.publish();
+  const auto messages = readMessages();
+
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(decoder.getChannelName(channel), "odom");
+  EXPECT_EQ(messages[0].id, TelemetryFrame::MessageId::odometrySample);
+  EXPECT_FLOAT_EQ(messages[0].state.x.convert(meter), 1);
+  EXPECT_FLOAT_EQ(messages[0].state.y.convert(meter), -2);
+  EXPECT_FLOAT_EQ(messages[0].state.theta.convert(degree), 90);
+}
+
+TEST_F(TelemetryStreamTest, OnlyChangedSamplesAreSentAgain) {
+  TelemetryStream stream(createConstantTimeUtil(10_ms), writeEnd);
+  const auto left = stream.addChannel("left");
+  const auto right = stream.addChannel("right");
+  stream.record(left, {1});
+  stream.record(right, {2});
+  stream.publish();
+  EXPECT_EQ(readMessages().size(), 2);
+
+  stream.publish();
+  EXPECT_TRUE(readMessages().empty());
+
+  stream.record(right, {3});
+  stream.publish();
+  const auto messages = readMessages();
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(messages[0].channel, right);
+  EXPECT_FLOAT_EQ(messages[0].sample.target, 3);
+}
+
+TEST_F(TelemetryStreamTest, ControllerSampleFrameIsCompact) {
+  TelemetryStream stream(createConstantTimeUtil(10_ms), writeEnd);
+  const auto channel = stream.addChannel("c");
+  stream.publish();
+  readMessages();
+
+  stream.record(channel, {1, 2, 3, 4, 5, 6, 7, 10_ms});
+  const auto before = stream.getBytesWritten();
+  stream.publish();
+  EXPECT_EQ(stream.getBytesWritten() - before, 43);
+}
+
+TEST_F(TelemetryStreamTest, DecoderSkipsACorruptFrame) {
+  TelemetryStream stream(createConstantTimeUtil(10_ms), writeEnd);
+  const auto channel = stream.addChannel("c");
+  stream.publish();
+  readMessages();
+
+  stream.record(channel, {1});
+  stream.publish();
+  stream.record(channel, {2});
+  stream.publish();
+
+  auto bytes = readBytes();
+  bytes[5] ^= 0x40;
+  const auto messages = decoder.feed(bytes.data(), bytes.size());
+
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_FLOAT_EQ(messages[0].sample.target, 2);
+  EXPECT_EQ(decoder.getCorruptFrameCount(), 1);
+}
+
+TEST_F(TelemetryStreamTest, DecoderReadsBytesOneAtATime) {
+  TelemetryStream stream(createConstantTimeUtil(10_ms), writeEnd);
+  stream.record(stream.addChannel("c"), {4});
+  stream.publish();
+
+  std::vector<TelemetryStreamMessage> messages;
+  for (const auto byte : readBytes()) {
+    for (const auto &message : decoder.feed(&byte, 1)) {
+      messages.push_back(message);
+    }
+  }
+
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_FLOAT_EQ(messages[0].sample.target, 4);
+}
+
+TEST_F(TelemetryStreamTest, WritesCsvRows) {
+  TelemetryStream stream(createConstantTimeUtil(10_ms), writeEnd);
+  auto odom = std::make_shared<MockOdometry>();
+  odom->state = {1_m, 2_m, 0_rad};
+  stream.record(stream.addChannel("c"), {1, 2, 3, 4, 5, 6, 7, 10_ms});
+  stream.addOdometryChannel("odom", odom);
+  stream.publish();
+
+  char *buffer = nullptr;
+  std::size_t size = 0;
+  FILE *csv = open_memstream(&buffer, &size);
+  TelemetryStreamDecoder::writeCsvHeader(csv);
+  for (const auto &message : readMessages()) {
+    decoder.writeCsv(csv, message);
+  }
+  fclose(csv);
+
+  EXPECT_EQ(std::string(buffer, size),
+            "time_ms,channel,target,reading,error,p,i,d,output,dt_ms,x_m,y_m,theta_rad\n"
+            "0,c,1,2,3,4,5,6,7,10,,,\n"
+            "0,odom,,,,,,,,,1,2,0\n");
+  free(buffer);
+}
+
+TEST_F(TelemetryStreamTest, TaskStreamsSamples) {
+  auto stream = std::make_unique<TelemetryStream>(createTimeUtil(), writeEnd, 10_ms);
+  stream->record(stream->addChannel("c"), {5});
+  stream->startThread();
+
+  std::vector<TelemetryStreamMessage> messages;
+  for (int i = 0; i < 100 && messages.empty(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    messages = readMessages();
+  }
+  stream.reset();
+
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_FLOAT_EQ(messages[0].sample.target, 5);
+}
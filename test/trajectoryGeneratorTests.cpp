@@ -0,0 +1,182 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/trajectoryGenerator.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace okapi;
+
+class TrajectoryGeneratorTest : public ::testing::Test {
+  protected:
+  static constexpr double dt = 0.01;
+  const PathfinderLimits limits{1.0, 2.0, 10.0};
+  TrajectoryGenerator generator{limits, 10.5_in, dt};
+};
+
+TEST_F(TrajectoryGeneratorTest, StraightPathEndsAtTheLastWaypoint) {
+  const auto size = generator.generate({{0_m, 0_m, 0_deg}, {1_m, 0_m, 0_deg}});
+  ASSERT_GT(size, 2);
+  EXPECT_EQ(generator.size(), size);
+
+  // Paths have x and y swapped and their heading counterclockwise from x
+  const auto &start = generator[0];
+  const auto &end = generator[size - 1];
+  EXPECT_NEAR(start.vector.pose.x, 0, 1e-9);
+  EXPECT_NEAR(start.vector.pose.y, 0, 1e-9);
+  EXPECT_NEAR(start.vector.pose.yaw, M_PI / 2, 1e-9);
+  EXPECT_NEAR(end.vector.pose.x, 0, 1e-9);
+  EXPECT_NEAR(end.vector.pose.y, 1, 1e-9);
+  EXPECT_NEAR(end.vector.pose.yaw, M_PI / 2, 1e-9);
+
+  EXPECT_EQ(start.vector.vel, 0);
+  EXPECT_EQ(end.vector.vel, 0);
+  EXPECT_EQ(start.time, 0);
+
+  // A meter at 1 m/s with 2 m/s/s of acceleration takes 1.5 s
+  EXPECT_NEAR(end.time, 1.5, 0.02);
+}
+
+TEST_F(TrajectoryGeneratorTest, PointsAreOneTimestepApart) {
+  const auto size = generator.generate({{0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}});
+  for (std::size_t i = 1; i + 1 < size; ++i) {
+    EXPECT_NEAR(generator[i].time - generator[i - 1].time, dt, 1e-9);
+  }
+  EXPECT_LE(generator[size - 1].time - generator[size - 2].time, dt + 1e-9);
+}
+
+TEST_F(TrajectoryGeneratorTest, StaysWithinTheLimits) {
+  const auto size =
+    generator.generate({{0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}, {0_m, 2_m, 180_deg}});
+
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto &point = generator[i];
+    EXPECT_LE(point.vector.vel, limits.maxVel + 1e-9);
+    // The limit is exact at each sample, and the curvature between samples is interpolated
+    EXPECT_LE(std::abs(point.wheel_velocities[0]), limits.maxVel + 1e-3);
+    EXPECT_LE(std::abs(point.wheel_velocities[1]), limits.maxVel + 1e-3);
+    if (i > 0) {
+      EXPECT_LE(std::abs(point.vector.vel - generator[i - 1].vector.vel) / dt,
+                limits.maxAccel + 1e-6);
+    }
+  }
+}
+
+TEST_F(TrajectoryGeneratorTest, SlowsDownInTurns) {
+  const auto size = generator.generate({{0_m, 0_m, 0_deg}, {1_m, 1_m, 90_deg}});
+
+  double fastestInTurn = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto &point = generator[i];
+    if (std::abs(point.curvature) > 1) {
+      fastestInTurn = std::max(fastestInTurn, point.vector.vel);
+    }
+
+    // The outside wheel is the one at the limit
+    if (point.curvature > 0) {
+      EXPECT_GE(point.wheel_velocities[1], point.wheel_velocities[0]);
+    }
+  }
+
+  EXPECT_GT(fastestInTurn, 0);
+  EXPECT_LT(fastestInTurn, limits.maxVel);
+}
+
+TEST_F(TrajectoryGeneratorTest, StartAndEndVelocities) {
+  const auto size = generator.generate({{0_m, 0_m, 0_deg}, {2_m, 0_m, 0_deg}}, 0.5, 0.8);
+  EXPECT_NEAR(generator[0].vector.vel, 0.5, 1e-9);
+  EXPECT_NEAR(generator[size - 1].vector.vel, 0.8, 1e-9);
+}
+
+TEST_F(TrajectoryGeneratorTest, ImpossibleVelocitiesThrow) {
+  // Reaching 1 m/s from rest takes a quarter of a meter
+  EXPECT_THROW(generator.generate({{0_m, 0_m, 0_deg}, {0.1_m, 0_m, 0_deg}}, 0, 1),
+               std::runtime_error);
+  EXPECT_THROW(generator.generate({{0_m, 0_m, 0_deg}, {0.1_m, 0_m, 0_deg}}, 1, 0),
+               std::runtime_error);
+  EXPECT_EQ(generator.size(), 0);
+}
+
+TEST_F(TrajectoryGeneratorTest, TooFewWaypointsThrows) {
+  EXPECT_THROW(generator.generate({}), std::invalid_argument);
+  EXPECT_THROW(generator.generate({{0_m, 0_m, 0_deg}}), std::invalid_argument);
+}
+
+TEST_F(TrajectoryGeneratorTest, TooManyPointsThrows) {
+  TrajectoryGenerator small(limits, 10.5_in, dt, 10);
+  EXPECT_THROW(small.generate({{0_m, 0_m, 0_deg}, {1_m, 0_m, 0_deg}}), std::runtime_error);
+  EXPECT_EQ(small.size(), 0);
+
+  const auto required = small.getRequiredCapacity();
+  EXPECT_GT(required, 10);
+  EXPECT_EQ(generator.generate({{0_m, 0_m, 0_deg}, {1_m, 0_m, 0_deg}}), required);
+}
+
+TEST_F(TrajectoryGeneratorTest, GeneratingAgainReusesTheBuffer) {
+  generator.generate({{0_m, 0_m, 0_deg}, {1_m, 0_m, 0_deg}});
+  const auto *first = &generator[0];
+  const auto *wheels = generator[0].wheel_velocities.data();
+
+  generator.generate({{0_m, 0_m, 0_deg}, {2_m, 1_m, 45_deg}});
+  EXPECT_EQ(&generator[0], first);
+  EXPECT_EQ(generator[0].wheel_velocities.data(), wheels);
+  EXPECT_EQ(generator.getCapacity(), 2000);
+}
+
+TEST_F(TrajectoryGeneratorTest, SetWaypointMatchesGeneratingAgain) {
+  const std::vector<PathfinderPoint> waypoints{
+    {0_m, 0_m, 0_deg}, {1_m, 0_m, 0_deg}, {2_m, 1_m, 90_deg}, {2_m, 2_m, 90_deg}};
+  generator.generate(waypoints);
+  EXPECT_EQ(generator.getRebuiltSegmentCount(), 3);
+
+  const PathfinderPoint moved{1.2_m, 0.3_m, 20_deg};
+  generator.setWaypoint(1, moved);
+  EXPECT_EQ(generator.getRebuiltSegmentCount(), 2);
+
+  auto edited = waypoints;
+  edited[1] = moved;
+  TrajectoryGenerator fresh(limits, 10.5_in, dt);
+  fresh.generate(edited);
+
+  EXPECT_EQ(generator.toProfile(), fresh.toProfile());
+}
+
+TEST_F(TrajectoryGeneratorTest, SetEndWaypointRebuildsOneSegment) {
+  generator.generate({{0_m, 0_m, 0_deg}, {1_m, 0_m, 0_deg}, {2_m, 0_m, 0_deg}});
+  generator.setWaypoint(2, {3_m, 0_m, 0_deg});
+  EXPECT_EQ(generator.getRebuiltSegmentCount(), 1);
+  EXPECT_NEAR(generator[generator.size() - 1].vector.pose.y, 3, 1e-9);
+
+  generator.setWaypoint(0, {-1_m, 0_m, 0_deg});
+  EXPECT_EQ(generator.getRebuiltSegmentCount(), 1);
+  EXPECT_NEAR(generator[0].vector.pose.y, -1, 1e-9);
+}
+
+TEST_F(TrajectoryGeneratorTest, SetWaypointOutOfRangeThrows) {
+  EXPECT_THROW(generator.setWaypoint(0, {0_m, 0_m, 0_deg}), std::invalid_argument);
+  generator.generate({{0_m, 0_m, 0_deg}, {1_m, 0_m, 0_deg}});
+  EXPECT_THROW(generator.setWaypoint(2, {0_m, 0_m, 0_deg}), std::invalid_argument);
+}
+
+TEST_F(TrajectoryGeneratorTest, SetLimitsMatchesGeneratingAgain) {
+  EXPECT_EQ(generator.setLimits({0.5, 1.0, 10.0}), 0);
+
+  const std::vector<PathfinderPoint> waypoints{
+    {0_m, 0_m, 0_deg}, {1_m, 0_m, 0_deg}, {2_m, 1_m, 90_deg}};
+  generator.generate(waypoints);
+  generator.setLimits(limits);
+  EXPECT_EQ(generator.getRebuiltSegmentCount(), 0);
+
+  TrajectoryGenerator fresh(limits, 10.5_in, dt);
+  fresh.generate(waypoints);
+  EXPECT_EQ(generator.toProfile(), fresh.toProfile());
+}
+
+TEST_F(TrajectoryGeneratorTest, InvalidLimitsThrow) {
+  EXPECT_THROW(TrajectoryGenerator({0, 2, 10}, 10.5_in), std::invalid_argument);
+  EXPECT_THROW(TrajectoryGenerator(limits, 10.5_in, 0), std::invalid_argument);
+  EXPECT_THROW(generator.setLimits({1, 0, 10}), std::invalid_argument);
+}
@@ -0,0 +1,73 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/workerPool.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <gtest/gtest.h>
+
+using namespace okapi;
+
+class WorkerPoolTest : public ::testing::Test {
+  protected:
+  void waitForPool(const WorkerPool &ipool) {
+    auto rate = createTimeUtil().getRate();
+    while (ipool.getPendingJobCount() > 0) {
+      rate->delayUntil(1_ms);
+    }
+  }
+};
+
+TEST_F(WorkerPoolTest, RunsAllSubmittedJobs) {
+  WorkerPool pool(createTimeUtil(), 4, 100);
+  std::atomic_int count{0};
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(pool.submit([&]() { count.fetch_add(1); }));
+  }
+
+  waitForPool(pool);
+  EXPECT_EQ(count.load(), 100);
+}
+
+TEST_F(WorkerPoolTest, AtLeastOneWorker) {
+  WorkerPool pool(createTimeUtil(), 0, 1);
+  EXPECT_EQ(pool.getWorkerCount(), 1);
+}
+
+TEST_F(WorkerPoolTest, FullQueueRejectsJobs) {
+  WorkerPool pool(createTimeUtil(), 1, 1);
+  std::atomic_bool started{false};
+  std::atomic_bool release{false};
+
+  // Occupy the only worker
+  EXPECT_TRUE(pool.submit([&]() {
+    started.store(true);
+    while (!release.load()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }));
+
+  auto rate = createTimeUtil().getRate();
+  while (!started.load()) {
+    rate->delayUntil(1_ms);
+  }
+
+  EXPECT_TRUE(pool.submit([]() {}));
+  EXPECT_FALSE(pool.submit([]() {}));
+
+  release.store(true);
+  waitForPool(pool);
+}
+
+TEST_F(WorkerPoolTest, ThrowingJobDoesNotKillWorker) {
+  WorkerPool pool(createTimeUtil(), 1, 10);
+  std::atomic_bool ran{false};
+
+  pool.submit([]() { throw std::runtime_error("test"); });
+  pool.submit([&]() { ran.store(true); });
+
+  waitForPool(pool);
+  EXPECT_TRUE(ran.load());
+}
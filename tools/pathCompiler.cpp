@@ -0,0 +1,60 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Compiles a path manifest into a header of constexpr paths on the host. Run it as part of the
+ * build, include the header it writes, and pass its `paths` array to
+ * AsyncMotionProfileController::addPathViews().
+ *
+ * Usage: okapi-path-compiler <manifest> <output header> [namespace]
+ */
+#include "okapi/api/control/util/pathCompiler.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+// The timestep AsyncMotionProfileController generates and follows paths with
+constexpr double pathDT = 0.01;
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 3 || argc > 4) {
+    std::cerr << "Usage: " << argv[0] << " <manifest> <output header> [namespace]\n";
+    return 2;
+  }
+
+  std::ifstream manifestFile(argv[1]);
+  if (!manifestFile) {
+    std::cerr << "Could not open manifest " << argv[1] << "\n";
+    return 1;
+  }
+
+  const std::string ns = argc == 4 ? argv[3] : "compiled_paths";
+
+  try {
+    const auto manifest = okapi::PathCompiler::parseManifest(manifestFile);
+
+    // Compile into memory first so a failed compile leaves the old header in place
+    std::ostringstream header;
+    okapi::PathCompiler::emitHeader(header, manifest, ns, pathDT);
+
+    std::ofstream out(argv[2], std::ios::trunc);
+    out << header.str();
+    if (!out) {
+      std::cerr << "Could not write " << argv[2] << "\n";
+      return 1;
+    }
+
+    std::cout << "Compiled " << manifest.paths.size() << " paths into " << argv[2] << "\n";
+  } catch (const std::exception &e) {
+    std::cerr << argv[1] << ": " << e.what() << "\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Converts a telemetry file written by TelemetryRecorder into CSV on the host.
+ *
+ * Usage: okapi-telemetry-decoder <telemetry file> [output csv]
+ *
+ * The CSV is written to stdout if no output file is given.
+ */
+#include "okapi/api/util/telemetryDecoder.hpp"
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " <telemetry file> [output csv]\n";
+    return 2;
+  }
+
+  FILE *in = fopen(argv[1], "rb");
+  if (!in) {
+    std::cerr << "Could not open " << argv[1] << "\n";
+    return 1;
+  }
+
+  okapi::TelemetryLog log;
+  try {
+    log = okapi::TelemetryDecoder::decode(in);
+  } catch (const std::exception &e) {
+    std::cerr << argv[1] << ": " << e.what() << "\n";
+    fclose(in);
+    return 1;
+  }
+  fclose(in);
+
+  FILE *out = argc == 3 ? fopen(argv[2], "w") : stdout;
+  if (!out) {
+    std::cerr << "Could not write " << argv[2] << "\n";
+    return 1;
+  }
+
+  okapi::TelemetryDecoder::writeCsv(out, log);
+  if (out != stdout) {
+    fclose(out);
+    std::cerr << "Decoded " << log.size() << " samples into " << argv[2] << "\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Reads a live TelemetryStream from the brain and prints each sample as a CSV row as it arrives,
+ * which can be piped into a plotting tool or saved for later.
+ *
+ * Usage: okapi-telemetry-stream <serial port | -> [output csv]
+ *
+ * Pass `-` to read the stream from stdin. The CSV is written to stdout if no output file is given.
+ */
+#include "okapi/api/util/telemetryStreamDecoder.hpp"
+#include <cstdio>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+/**
+ * Puts a serial port into raw mode so the frames are read exactly as they were sent.
+ */
+void makeRaw(const int ifd) {
+  termios options{};
+  if (tcgetattr(ifd, &options) != 0) {
+    return;
+  }
+
+  cfmakeraw(&options);
+  options.c_cc[VMIN] = 1;
+  options.c_cc[VTIME] = 0;
+  tcsetattr(ifd, TCSANOW, &options);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " <serial port | -> [output csv]\n";
+    return 2;
+  }
+
+  const std::string device(argv[1]);
+  const int in = device == "-" ? STDIN_FILENO : open(argv[1], O_RDONLY | O_NOCTTY);
+  if (in < 0) {
+    std::cerr << "Could not open " << argv[1] << "\n";
+    return 1;
+  }
+
+  if (isatty(in)) {
+    makeRaw(in);
+  }
+
+  FILE *out = argc == 3 ? fopen(argv[2], "w") : stdout;
+  if (!out) {
+    std::cerr << "Could not write " << argv[2] << "\n";
+    return 1;
+  }
+
+  okapi::TelemetryStreamDecoder decoder;
+  okapi::TelemetryStreamDecoder::writeCsvHeader(out);
+
+  std::uint8_t buffer[512];
+  std::size_t corruptFrameCount = 0;
+  for (;;) {
+    const auto length = read(in, buffer, sizeof(buffer));
+    if (length <= 0) {
+      break;
+    }
+
+    for (const auto &message : decoder.feed(buffer, static_cast<std::size_t>(length))) {
+      decoder.writeCsv(out, message);
+    }
+    fflush(out);
+
+    if (decoder.getCorruptFrameCount() != corruptFrameCount) {
+      corruptFrameCount = decoder.getCorruptFrameCount();
+      std::cerr << "Skipped " << corruptFrameCount << " damaged frames\n";
+    }
+  }
+
+  if (in != STDIN_FILENO) {
+    close(in);
+  }
+  if (out != stdout) {
+    fclose(out);
+  }
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Times TrajectoryGenerator against squiggles on the same waypoints on the host. For each set of
+ * waypoints it prints the time per path of generating with squiggles, generating with
+ * TrajectoryGenerator, and moving one waypoint with TrajectoryGenerator::setWaypoint().
+ *
+ * Usage: okapi-trajectory-benchmark [iterations]
+ */
+#include "okapi/api/control/util/splineProfile.hpp"
+#include "okapi/api/control/util/trajectoryGenerator.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace okapi;
+
+namespace {
+// The timestep AsyncMotionProfileController generates and follows paths with
+constexpr double pathDT = 0.01;
+
+struct Case {
+  std::string name;
+  std::vector<PathfinderPoint> waypoints;
+};
+
+/**
+ * Runs a function some number of times and returns the mean time per run in microseconds.
+ */
+template <typename F> double timeEach(const int iiterations, F &&ifunc) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iiterations; ++i) {
+    ifunc(i);
+  }
+  const std::chrono::duration<double, std::micro> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count() / iiterations;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+  if (argc > 2 || iterations <= 0) {
+    std::cerr << "Usage: " << argv[0] << " [iterations]\n";
+    return 2;
+  }
+
+  const PathfinderLimits limits{1.0, 2.0, 10.0};
+  const QLength wheelTrack = 11.5_in;
+
+  const std::vector<Case> cases{
+    {"straight", {{0_m, 0_m, 0_deg}, {3_ft, 0_m, 0_deg}}},
+    {"s-curve", {{0_m, 0_m, 0_deg}, {3_ft, 2_ft, 0_deg}}},
+    {"turn", {{0_m, 0_m, 0_deg}, {2_ft, 2_ft, 90_deg}, {0_ft, 4_ft, 180_deg}}},
+    {"slalom",
+     {{0_m, 0_m, 0_deg},
+      {2_ft, 1_ft, 0_deg},
+      {4_ft, -1_ft, 0_deg},
+      {6_ft, 1_ft, 0_deg},
+      {8_ft, 0_ft, 0_deg}}}};
+
+  TrajectoryGenerator generator(limits, wheelTrack, pathDT);
+
+  std::cout << std::left << std::setw(10) << "path" << std::right << std::setw(14)
+            << "squiggles us" << std::setw(14) << "native us" << std::setw(14) << "moved us"
+            << std::setw(12) << "squiggles" << std::setw(10) << "native" << "\n";
+
+  for (const auto &test : cases) {
+    std::size_t squigglesPoints = 0;
+    const double squigglesTime = timeEach(iterations, [&](int) {
+      squigglesPoints =
+        SplineProfile::generate(test.waypoints, limits, wheelTrack, pathDT).size();
+    });
+
+    std::size_t nativePoints = 0;
+    const double nativeTime =
+      timeEach(iterations, [&](int) { nativePoints = generator.generate(test.waypoints); });
+
+    // Nudge a middle waypoint back and forth, as when tuning a path by hand
+    const std::size_t moved = test.waypoints.size() / 2;
+    const double movedTime = timeEach(iterations, [&](int i) {
+      auto waypoint = test.waypoints[moved];
+      waypoint.x += (i % 2 == 0 ? 1 : -1) * 1_cm;
+      generator.setWaypoint(moved, waypoint);
+    });
+
+    std::cout << std::left << std::setw(10) << test.name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(14) << squigglesTime << std::setw(14)
+              << nativeTime << std::setw(14) << movedTime << std::setw(12) << squigglesPoints
+              << std::setw(10) << nativePoints << "\n";
+  }
+
+  return 0;
+}